@@ -11,6 +11,14 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
+#include <functional>
+#include <exception>
+#include <utility>
+#include <unordered_map>
+#include <filesystem>
+#include <system_error>
+#include <algorithm>
 
 #include "Tools_ErrorHandling.hpp"
 
@@ -18,8 +26,69 @@ namespace GFX_ImageHandling
 {
 
 
+	// Batch loading of images
+	//
+	// 1. Enumerate all needed images with RequestImage() / RequestTexture() / RequestImageView() / RequestTextureHandle() - each request gets a commit function
+	// 2. LoadBatch() decodes all images in parallel on the threadpool
+	// 3. After decoding, the commit functions run on the main thread in the order of the requests
+	//
+	// Commit functions are the place for everything that has to stay on the main thread (OpenGL uploads, logging of results)
+	// The result is independent of the number of threads and of the order the decodes finish in
+	//
+	// If the batch has an asset pack, images found in it are not decoded at all:
+	// view commits get a view straight into the mapped pack, texture commits get a plain copy of the pre-decoded pixels
+	//
+	// Handle commits get a shared texture from the TextureCache - it is only decoded (or copied from the pack) if the cache
+	// has no texture with the same name and content hash, so assets shared by several levels are decoded only once
+	//
+	// Images found in the prefetched images of the batch (see Game_LevelStreaming) were already decoded in the background
+	// and are served like packed images, they take precedence over the asset pack
+
+	struct ImageRequestStruct final
+	{
+		std::string FileName{};
+		std::int_fast32_t Size{};
+		std::function<void(lwmf::TextureStruct&)> Commit{};
+		std::function<void(const lwmf::TextureViewStruct&)> ViewCommit{};
+		std::function<void(const lwmf::TextureHandle&)> HandleCommit{};
+		lwmf::TextureStruct Texture{};
+		lwmf::TextureViewStruct View{};
+		lwmf::TextureHandle Handle{};
+		std::uint64_t ContentHash{};
+		std::exception_ptr Exception{};
+		bool FromPack{};
+		bool Prefetched{};
+	};
+
+	using PrefetchedImages = std::unordered_map<std::string, lwmf::TextureHandle>;
+
+	struct ImageBatchStruct final
+	{
+		std::vector<ImageRequestStruct> Requests{};
+		const lwmf::PackFile* Pack{};
+		const PrefetchedImages* Prefetched{};
+	};
+
 	lwmf::TextureStruct ImportImage(const std::string& ImageFileName);
 	lwmf::TextureStruct ImportTexture(const std::string& ImageFileName, std::int_fast32_t Size);
+	void RequestImage(ImageBatchStruct& Batch, const std::string& ImageFileName, std::function<void(lwmf::TextureStruct&)> Commit);
+	void RequestTexture(ImageBatchStruct& Batch, const std::string& ImageFileName, std::int_fast32_t Size, std::function<void(lwmf::TextureStruct&)> Commit);
+	void RequestImageView(ImageBatchStruct& Batch, const std::string& ImageFileName, std::function<void(const lwmf::TextureViewStruct&)> ViewCommit);
+	void RequestTextureHandle(ImageBatchStruct& Batch, const std::string& ImageFileName, std::int_fast32_t Size, std::function<void(const lwmf::TextureHandle&)> HandleCommit);
+	lwmf::TextureHandle LoadTextureHandle(const std::string& ImageFileName, const lwmf::TextureViewStruct* PackedView, std::uint64_t ContentHash);
+	void LoadRequest(ImageRequestStruct& Request);
+	void LoadBatch(ImageBatchStruct& Batch, lwmf::Multithreading& ThreadPool);
+	bool BenchmarkDecoding(const std::string& Folder);
+
+	//
+	// Variables and constants
+	//
+
+	// Decoded textures are kept across level switches (budget is set in GameConfig.ini)
+	inline lwmf::TextureCache TextureCache{};
+
+	// Number of times BenchmarkDecoding() decodes every image
+	inline constexpr std::int_fast32_t DecodingBenchmarkPasses{ 20 };
 
 	//
 	// Functions
@@ -46,5 +115,207 @@ namespace GFX_ImageHandling
 		return TempTexture;
 	}
 
+	inline void RequestImage(ImageBatchStruct& Batch, const std::string& ImageFileName, std::function<void(lwmf::TextureStruct&)> Commit)
+	{
+		RequestTexture(Batch, ImageFileName, 0, std::move(Commit));
+	}
+
+	// Size == 0 means any size is accepted
+	inline void RequestTexture(ImageBatchStruct& Batch, const std::string& ImageFileName, const std::int_fast32_t Size, std::function<void(lwmf::TextureStruct&)> Commit)
+	{
+		Batch.Requests.emplace_back();
+		Batch.Requests.back().FileName = ImageFileName;
+		Batch.Requests.back().Size = Size;
+		Batch.Requests.back().Commit = std::move(Commit);
+	}
+
+	// For images which are only read once (e.g. uploaded to the GPU) - with an asset pack, no pixel is copied at all
+	// The view is only valid while the commit function runs
+	inline void RequestImageView(ImageBatchStruct& Batch, const std::string& ImageFileName, std::function<void(const lwmf::TextureViewStruct&)> ViewCommit)
+	{
+		Batch.Requests.emplace_back();
+		Batch.Requests.back().FileName = ImageFileName;
+		Batch.Requests.back().ViewCommit = std::move(ViewCommit);
+	}
+
+	// Size == 0 means any size is accepted
+	inline void RequestTextureHandle(ImageBatchStruct& Batch, const std::string& ImageFileName, const std::int_fast32_t Size, std::function<void(const lwmf::TextureHandle&)> HandleCommit)
+	{
+		Batch.Requests.emplace_back();
+		Batch.Requests.back().FileName = ImageFileName;
+		Batch.Requests.back().Size = Size;
+		Batch.Requests.back().HandleCommit = std::move(HandleCommit);
+	}
+
+	// Packed textures carry the content hash of their PNG file, so only unpacked files have to be read and hashed
+	// Thread-safe, used by the batch workers and by the level streaming
+	inline lwmf::TextureHandle LoadTextureHandle(const std::string& ImageFileName, const lwmf::TextureViewStruct* PackedView, std::uint64_t ContentHash)
+	{
+		std::vector<unsigned char> Buffer;
+
+		if (PackedView == nullptr)
+		{
+			if (!lwmf::ReadPNGFile(Buffer, ImageFileName))
+			{
+				return std::make_shared<const lwmf::TextureStruct>();
+			}
+
+			ContentHash = lwmf::HashContent(Buffer.data(), Buffer.size());
+		}
+
+		lwmf::TextureHandle Handle{ TextureCache.Find(ImageFileName, ContentHash) };
+
+		if (Handle == nullptr)
+		{
+			lwmf::TextureStruct Texture;
+			PackedView != nullptr ? lwmf::CreateTextureFromView(Texture, *PackedView) : lwmf::DecodePNG(Texture, Buffer, ImageFileName);
+			Handle = TextureCache.Insert(ImageFileName, ContentHash, std::move(Texture));
+		}
+
+		return Handle;
+	}
+
+	inline void LoadRequest(ImageRequestStruct& Request)
+	{
+		if (!Request.HandleCommit)
+		{
+			lwmf::LoadPNG(Request.Texture, Request.FileName);
+			Request.View = lwmf::GetTextureView(Request.Texture);
+			return;
+		}
+
+		Request.Handle = LoadTextureHandle(Request.FileName, Request.FromPack ? &Request.View : nullptr, Request.ContentHash);
+		Request.View = lwmf::GetTextureView(*Request.Handle);
+	}
+
+	inline void LoadBatch(ImageBatchStruct& Batch, lwmf::Multithreading& ThreadPool)
+	{
+		std::size_t NumberOfPrefetchedImages{};
+		std::size_t NumberOfPackedImages{};
+
+		if (Batch.Prefetched != nullptr)
+		{
+			for (auto&& Request : Batch.Requests)
+			{
+				if (const auto Image{ Batch.Prefetched->find(Request.FileName) }; Image != Batch.Prefetched->end())
+				{
+					Request.Handle = Image->second;
+					Request.View = lwmf::GetTextureView(*Request.Handle);
+					Request.Prefetched = true;
+					++NumberOfPrefetchedImages;
+				}
+			}
+		}
+
+		if (Batch.Pack != nullptr && Batch.Pack->IsOpen())
+		{
+			for (auto&& Request : Batch.Requests)
+			{
+				if (Request.Prefetched)
+				{
+					continue;
+				}
+
+				Request.FromPack = Batch.Pack->GetTextureView(Request.FileName, Request.View);
+
+				if (Request.FromPack)
+				{
+					Request.ContentHash = Batch.Pack->FindEntry(Request.FileName)->ContentHash;
+					++NumberOfPackedImages;
+				}
+			}
+		}
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load " + std::to_string(Batch.Requests.size()) + " images (" + std::to_string(NumberOfPrefetchedImages) + " prefetched, " + std::to_string(NumberOfPackedImages) + " taken from asset pack)...");
+
+		for (auto&& Request : Batch.Requests)
+		{
+			// Prefetched images, views and copies of packed textures need no work in advance
+			if (Request.Prefetched || (Request.FromPack && !Request.HandleCommit))
+			{
+				continue;
+			}
+
+			ThreadPool.AddThread([&Request]
+			{
+				// Errors in a worker are stored and raised on the main thread, so the order of error reports stays deterministic
+				try
+				{
+					LoadRequest(Request);
+				}
+				catch (...)
+				{
+					Request.Exception = std::current_exception();
+				}
+			});
+		}
+
+		ThreadPool.WaitForThreads();
+
+		for (auto&& Request : Batch.Requests)
+		{
+			if (Request.Exception)
+			{
+				std::rethrow_exception(Request.Exception);
+			}
+
+			if (Request.Size > 0 && Tools_ErrorHandling::CheckTextureSize(Request.View.Width, Request.View.Height, Request.Size, StopOnError))
+			{
+				// Dummy, just check Size
+			}
+
+			if (Request.ViewCommit)
+			{
+				Request.ViewCommit(Request.View);
+				continue;
+			}
+
+			if (Request.HandleCommit)
+			{
+				Request.HandleCommit(Request.Handle);
+				continue;
+			}
+
+			if (Request.FromPack || Request.Prefetched)
+			{
+				lwmf::CreateTextureFromView(Request.Texture, Request.View);
+			}
+
+			Request.Commit(Request.Texture);
+		}
+
+		Batch.Requests.clear();
+		Batch.Requests.shrink_to_fit();
+
+		// Textures of the previous level which were not requested again are released now and may be evicted
+		TextureCache.Trim();
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, TextureCache.GetStatistics());
+	}
+
+	inline bool BenchmarkDecoding(const std::string& Folder)
+	{
+		// Decodes every PNG below Folder (result is written to the lwmf system log)
+		std::vector<std::string> FileNames;
+		std::error_code Error;
+
+		for (std::filesystem::recursive_directory_iterator Entry(Folder, std::filesystem::directory_options::skip_permission_denied, Error), End; !Error && Entry != End; Entry.increment(Error))
+		{
+			if (Entry->path().extension() == ".png")
+			{
+				FileNames.emplace_back(Entry->path().generic_string());
+			}
+		}
+
+		if (Error || FileNames.empty())
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Error, __FILENAME__, __LINE__, "BenchmarkDecoding(): No PNG files found in " + Folder + "!");
+			return false;
+		}
+
+		std::sort(FileNames.begin(), FileNames.end());
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Benchmark decoding of " + std::to_string(FileNames.size()) + " PNG files in " + Folder + "...");
+
+		return lwmf::BenchmarkPNGDecoding(FileNames, DecodingBenchmarkPasses);
+	}
 
-} // namespace GFX_ImageHandling
+} // namespace GFX_ImageHandling
\ No newline at end of file
@@ -52,6 +52,9 @@ inline void GFX_TextClass::InitFont(const std::string& INIFileName, const std::s
 {
 	NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Init font...");
 
+	// Font baking shows up as a phase of the calling init step
+	LoadTimeline.BeginPhase("GFX_TextClass::InitFont(" + Section + ")");
+
 	if (Tools_ErrorHandling::CheckFileExistence(INIFileName, StopOnError))
 	{
 		const std::string FontName{ lwmf::ReadINIValue<std::string>(INIFileName, Section, "FontName") };
@@ -100,7 +103,7 @@ inline void GFX_TextClass::InitFont(const std::string& INIFileName, const std::s
 			stbtt_BakeFontBitmap(FontBuffer, 0, static_cast<float>(FontSize), BakedFontGreyscale, Width, Height, 0, LastASCIIChar, CharData);
 
 			// Since the glyphs were rendered in greyscale, they need to be colored...
-			std::vector<std::int_fast32_t> FontColor(Size);
+			std::vector<lwmf::PixelType> FontColor(Size);
 
 			for (std::size_t i{}; i < Size; ++i)
 			{
@@ -127,7 +130,7 @@ inline void GFX_TextClass::InitFont(const std::string& INIFileName, const std::s
 
 				for (std::int_fast32_t DestY{}, SrcY{ Pos.Y }; SrcY < Pos.Y + Glyphs[Char].Height; ++SrcY, ++DestY)
 				{
-					const std::int_fast32_t TempDestY{ DestY * TempGlyphTexture.Width };
+					const std::int_fast32_t TempDestY{ DestY * TempGlyphTexture.Stride };
 					const std::int_fast32_t TempSrcY{ SrcY * Width };
 
 					for (std::int_fast32_t DestX{}, SrcX{ Pos.X }; SrcX < Pos.X + Glyphs[Char].Width; ++SrcX, ++DestX)
@@ -140,6 +143,8 @@ inline void GFX_TextClass::InitFont(const std::string& INIFileName, const std::s
 			}
 		}
 	}
+
+	LoadTimeline.EndPhase();
 }
 
 inline void GFX_TextClass::RenderText(const std::string_view Text, std::int_fast32_t x, const std::int_fast32_t y)
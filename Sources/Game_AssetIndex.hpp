@@ -0,0 +1,212 @@
+/*
+*****************************************
+*                                       *
+* Game_AssetIndex.hpp                   *
+*                                       *
+* (c) 2017 - 2020 Stefan Kubsch         *
+*****************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <filesystem>
+#include <system_error>
+#include <algorithm>
+#include <chrono>
+#include <tuple>
+#include <cctype>
+
+namespace Game_AssetIndex
+{
+
+
+	// In-memory index of the asset folders (DATA and GFX), scanned once at startup
+	//
+	// Numbered assets (entity data "0.ini", "1.ini"..., animation frames, "Door_1_Data.ini", level folders...) are found by querying the index
+	// instead of probing the file system until a file is missing - every probe used to open a file and write a log line
+	//
+	// File and folder names are split into prefix, number and suffix ("Door_12_Data.ini" -> "Door_", 12, "_Data.ini") and stored sorted per folder,
+	// so a run of consecutive numbers is a binary search followed by a short walk
+	//
+	// Names are compared case-insensitively, same as the Windows file system
+	// The index is not updated while the game runs - assets are not added or removed at runtime
+
+	struct NumberedEntryStruct final
+	{
+		std::string Prefix{};
+		std::string Suffix{};
+		std::int_fast32_t Number{};
+		bool FolderFlag{};
+	};
+
+	void Init();
+	std::string ToLower(std::string_view Text);
+	std::string GetKey(std::string_view Path);
+	void AddEntry(const std::filesystem::directory_entry& Entry);
+	bool CompareEntries(const NumberedEntryStruct& A, const NumberedEntryStruct& B);
+	std::int_fast32_t CountNumberedEntries(const std::string& Folder, const std::string& Prefix, const std::string& Suffix, std::int_fast32_t FirstNumber, bool FolderFlag);
+	std::int_fast32_t CountNumberedFiles(const std::string& Folder, const std::string& Prefix, const std::string& Suffix, std::int_fast32_t FirstNumber);
+	std::int_fast32_t CountNumberedFolders(const std::string& Folder, std::int_fast32_t FirstNumber);
+
+	//
+	// Variables and constants
+	//
+
+	inline const std::vector<std::string> IndexedFolders{ "./DATA", "./GFX" };
+
+	// Key is the lower case path of the folder relative to the game folder, e.g. "gfx/entities/64/soldier"
+	inline std::unordered_map<std::string, std::vector<NumberedEntryStruct>> NumberedEntries{};
+
+	//
+	// Functions
+	//
+
+	inline void Init()
+	{
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Build asset index...");
+
+		const auto StartTime{ std::chrono::steady_clock::now() };
+		std::size_t NumberOfEntries{};
+
+		NumberedEntries.clear();
+
+		for (const auto& Folder : IndexedFolders)
+		{
+			std::error_code Error;
+
+			for (std::filesystem::recursive_directory_iterator Entry(Folder, std::filesystem::directory_options::skip_permission_denied, Error), End; !Error && Entry != End; Entry.increment(Error))
+			{
+				AddEntry(*Entry);
+				++NumberOfEntries;
+			}
+
+			if (Error)
+			{
+				NARCLog.AddEntry(lwmf::LogLevel::Warn, __FILENAME__, __LINE__, "Init(): Error scanning " + Folder + ": " + Error.message());
+			}
+		}
+
+		for (auto&& [Key, Entries] : NumberedEntries)
+		{
+			std::sort(Entries.begin(), Entries.end(), CompareEntries);
+		}
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Indexed " + std::to_string(NumberOfEntries) + " files and folders in " + std::to_string(NumberedEntries.size()) + " folders (" +
+			std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - StartTime).count()) + " ms)...");
+	}
+
+	inline std::string ToLower(const std::string_view Text)
+	{
+		std::string Result(Text);
+		std::transform(Result.begin(), Result.end(), Result.begin(), [](const unsigned char Char) { return static_cast<char>(std::tolower(Char)); });
+
+		return Result;
+	}
+
+	inline std::string GetKey(const std::string_view Path)
+	{
+		std::string Key{ std::filesystem::path(Path).lexically_normal().generic_string() };
+
+		while (!Key.empty() && Key.back() == '/')
+		{
+			Key.pop_back();
+		}
+
+		return ToLower(Key);
+	}
+
+	inline void AddEntry(const std::filesystem::directory_entry& Entry)
+	{
+		std::error_code Error;
+		const bool FolderFlag{ Entry.is_directory(Error) };
+
+		if (!FolderFlag && !Entry.is_regular_file(Error))
+		{
+			return;
+		}
+
+		// Every folder gets an entry, even if it holds no numbered files
+		if (FolderFlag)
+		{
+			NumberedEntries.try_emplace(GetKey(Entry.path().generic_string()));
+		}
+
+		const std::string Name{ ToLower(Entry.path().filename().generic_string()) };
+		const std::size_t NumberPos{ Name.find_first_of("0123456789") };
+
+		if (NumberPos == std::string::npos)
+		{
+			return;
+		}
+
+		std::size_t NumberEnd{ Name.find_first_not_of("0123456789", NumberPos) };
+		NumberEnd = NumberEnd == std::string::npos ? Name.size() : NumberEnd;
+
+		// Numbers are always written without leading zeros (std::to_string)
+		if ((Name[NumberPos] == '0' && NumberEnd - NumberPos > 1) || NumberEnd - NumberPos > 9)
+		{
+			return;
+		}
+
+		NumberedEntryStruct NumberedEntry{};
+		NumberedEntry.Prefix = Name.substr(0, NumberPos);
+		NumberedEntry.Suffix = Name.substr(NumberEnd);
+		NumberedEntry.Number = std::stoi(Name.substr(NumberPos, NumberEnd - NumberPos));
+		NumberedEntry.FolderFlag = FolderFlag;
+
+		NumberedEntries[GetKey(Entry.path().parent_path().generic_string())].emplace_back(std::move(NumberedEntry));
+	}
+
+	inline bool CompareEntries(const NumberedEntryStruct& A, const NumberedEntryStruct& B)
+	{
+		return std::tie(A.FolderFlag, A.Prefix, A.Suffix, A.Number) < std::tie(B.FolderFlag, B.Prefix, B.Suffix, B.Number);
+	}
+
+	// Returns how many entries Prefix + FirstNumber + Suffix, Prefix + (FirstNumber + 1) + Suffix... exist without a gap
+	inline std::int_fast32_t CountNumberedEntries(const std::string& Folder, const std::string& Prefix, const std::string& Suffix, const std::int_fast32_t FirstNumber, const bool FolderFlag)
+	{
+		const auto Entries{ NumberedEntries.find(GetKey(Folder)) };
+
+		if (Entries == NumberedEntries.end())
+		{
+			return 0;
+		}
+
+		NumberedEntryStruct Search{};
+		Search.Prefix = ToLower(Prefix);
+		Search.Suffix = ToLower(Suffix);
+		Search.Number = FirstNumber;
+		Search.FolderFlag = FolderFlag;
+
+		std::int_fast32_t Count{};
+
+		for (auto Entry{ std::lower_bound(Entries->second.begin(), Entries->second.end(), Search, CompareEntries) }; Entry != Entries->second.end(); ++Entry)
+		{
+			if (Entry->FolderFlag != FolderFlag || Entry->Prefix != Search.Prefix || Entry->Suffix != Search.Suffix || Entry->Number != FirstNumber + Count)
+			{
+				break;
+			}
+
+			++Count;
+		}
+
+		return Count;
+	}
+
+	inline std::int_fast32_t CountNumberedFiles(const std::string& Folder, const std::string& Prefix, const std::string& Suffix, const std::int_fast32_t FirstNumber)
+	{
+		return CountNumberedEntries(Folder, Prefix, Suffix, FirstNumber, false);
+	}
+
+	inline std::int_fast32_t CountNumberedFolders(const std::string& Folder, const std::int_fast32_t FirstNumber)
+	{
+		return CountNumberedEntries(Folder, "", "", FirstNumber, true);
+	}
+
+
+} // namespace Game_AssetIndex
\ No newline at end of file
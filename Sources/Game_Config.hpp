@@ -11,15 +11,21 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <map>
+#include <algorithm>
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_ErrorHandling.hpp"
+#include "Game_AssetIndex.hpp"
+#include "GFX_ImageHandling.hpp"
+#include "Game_PathFinding.hpp"
 
 namespace Game_Config
 {
 
 
+	void ParseCommandLine(std::string_view CommandLine);
 	void Init();
 	void GatherNumberOfLevels();
 
@@ -27,6 +33,54 @@ namespace Game_Config
 	// Functions
 	//
 
+	// Supported switches:
+	// -exitafterload		load the start level without asking for options and exit right afterwards (for benchmarking startup times)
+	// -checksimd			compare all SIMD kernel variants supported by the CPU with the scalar reference and exit (result is written to the lwmf system log)
+	// -benchpng			decode all PNG files in ./GFX/ several times, log the decoding speed and exit (result is written to the lwmf system log)
+	// -benchpath			search paths on synthetic maps of several sizes, log the search times and exit (result is written to NARC.log)
+	// -timeline=text|json	format of the load timeline report ("LoadTimeline.txt" or "LoadTimeline.json", written after every load)
+	inline void ParseCommandLine(const std::string_view CommandLine)
+	{
+		std::size_t Pos{ CommandLine.find_first_not_of(" \t") };
+
+		while (Pos != std::string_view::npos)
+		{
+			const std::size_t End{ CommandLine.find_first_of(" \t", Pos) };
+			const std::string_view Switch{ CommandLine.substr(Pos, End == std::string_view::npos ? std::string_view::npos : End - Pos) };
+
+			if (Switch == "-exitafterload")
+			{
+				ExitAfterLoadFlag = true;
+			}
+			else if (Switch == "-checksimd")
+			{
+				CheckSIMDFlag = true;
+			}
+			else if (Switch == "-benchpng")
+			{
+				BenchPNGFlag = true;
+			}
+			else if (Switch == "-benchpath")
+			{
+				BenchPathFlag = true;
+			}
+			else if (Switch == "-timeline=text")
+			{
+				LoadTimelineFormat = lwmf::TimelineFormat::Text;
+			}
+			else if (Switch == "-timeline=json")
+			{
+				LoadTimelineFormat = lwmf::TimelineFormat::JSON;
+			}
+			else
+			{
+				NARCLog.AddEntry(lwmf::LogLevel::Warn, __FILENAME__, __LINE__, "ParseCommandLine(): Unknown switch " + std::string(Switch) + " is ignored!");
+			}
+
+			Pos = CommandLine.find_first_not_of(" \t", End == std::string_view::npos ? CommandLine.size() : End);
+		}
+	}
+
 	inline void Init()
 	{
 		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Init general game config...");
@@ -65,7 +119,38 @@ namespace Game_Config
 				NARCLog.AddEntry(lwmf::LogLevel::Critical, __FILENAME__, __LINE__, "Init(): EntitySize has an incorrect value!");
 			}
 
+			const std::int_fast32_t TextureCacheBudget{ lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "TEXTURES", "TextureCacheBudget") };
+			GFX_ImageHandling::TextureCache.SetBudget(static_cast<std::size_t>(std::max<std::int_fast32_t>(TextureCacheBudget, 0)) << 20);
+
 			FrameLock = lwmf::ReadINIValue<std::uint_fast32_t>(INIFile, "GENERAL", "FrameLock");
+
+			if (const std::string PathFindingMode{ lwmf::ReadINIValue<std::string>(INIFile, "PATHFINDING", "Mode") }; PathFindingMode == "AStar")
+			{
+				Game_PathFinding::Mode = Game_PathFinding::Modes::AStar;
+			}
+			else if (PathFindingMode == "JumpPointSearch")
+			{
+				Game_PathFinding::Mode = Game_PathFinding::Modes::JumpPointSearch;
+			}
+			else if (PathFindingMode == "Hierarchical")
+			{
+				Game_PathFinding::Mode = Game_PathFinding::Modes::Hierarchical;
+			}
+			else if (PathFindingMode == "Incremental")
+			{
+				Game_PathFinding::Mode = Game_PathFinding::Modes::Incremental;
+			}
+			else if (PathFindingMode == "FlowField")
+			{
+				Game_PathFinding::Mode = Game_PathFinding::Modes::FlowField;
+			}
+			else
+			{
+				NARCLog.AddEntry(lwmf::LogLevel::Critical, __FILENAME__, __LINE__, "Init(): PathFinding mode has an incorrect value!");
+			}
+
+			Game_PathFinding::RequestTimeBudget = std::max<std::int_fast32_t>(lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "PATHFINDING", "TimeBudget"), 0);
+			Game_PathFinding::RequestNodeBudget = std::max<std::int_fast32_t>(lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "PATHFINDING", "NodeBudget"), 0);
 		}
 	}
 
@@ -73,14 +158,9 @@ namespace Game_Config
 	{
 		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Gathering number of levels...");
 
-		NumberOfLevels = StartLevel;
-
-		while (Tools_ErrorHandling::CheckFolderExistence(LevelFolder + std::to_string(NumberOfLevels), ContinueOnError))
-		{
-			++NumberOfLevels;
-		}
+		NumberOfLevels = StartLevel - 1 + Game_AssetIndex::CountNumberedFolders(LevelFolder, StartLevel);
 
-		--NumberOfLevels == StartLevel - 1 ? NARCLog.AddEntry(lwmf::LogLevel::Critical, __FILENAME__, __LINE__, "GatherNumberOfLevels(): No Leveldata found.") :
+		NumberOfLevels == StartLevel - 1 ? NARCLog.AddEntry(lwmf::LogLevel::Critical, __FILENAME__, __LINE__, "GatherNumberOfLevels(): No Leveldata found.") :
 			NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Data of " + std::to_string(NumberOfLevels) + " level(s) was found!");
 	}
 
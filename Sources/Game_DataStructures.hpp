@@ -24,9 +24,9 @@
 
 struct EntityAssetStruct final
 {
-	std::vector<std::vector<lwmf::TextureStruct>> WalkingTextures{};
-	std::vector<lwmf::TextureStruct> AttackTextures{};
-	std::vector<lwmf::TextureStruct> KillTextures{};
+	std::vector<std::vector<lwmf::TextureHandle>> WalkingTextures{};
+	std::vector<lwmf::TextureHandle> AttackTextures{};
+	std::vector<lwmf::TextureHandle> KillTextures{};
 	std::vector<lwmf::MP3Player> Sounds{};
 	std::string Name;
 	std::int_fast32_t Number{};
@@ -46,47 +46,67 @@ enum class EntityTypes : std::int_fast32_t
 	Turret
 };
 
-struct EntityStruct final
+// Entity data is split by how often it is used - the data every tick or frame works on is stored as one array per component
+// (EntityTransforms, EntityStates, EntityAnimations), the rest stays in EntityStruct (Entities)
+// All arrays use the same index, so the loops over all entities only load the components they need
+
+struct EntityTransformStruct final
 {
-	std::list<lwmf::IntPointStruct> PathFindingWayPoints{};
-	std::map<std::string, std::int_fast32_t> ContainedItem{};
-	EntityTypes Type{};
 	lwmf::FloatPointStruct Pos{};
 	lwmf::FloatPointStruct Dir{};
-	std::string TypeName;
-	std::int_fast32_t Number{};
+	float MoveSpeed{};
+	float MoveV{};
+};
+
+struct EntityStateStruct final
+{
+	EntityTypes Type{};
 	std::int_fast32_t TypeNumber{};
+	std::int_fast32_t MovementBehaviour{};
+	std::int_fast32_t AttackMode{};
+	std::int_fast32_t RotationFactor{};
+	char Direction{ '\0' };
+	bool AttackFinished{};
+	bool AttackAnimEnabled{};
+	bool KillAnimEnabled{};
+	bool IsPickedUp{};
+	bool IsDead{};
+	bool IsHit{};
+};
+
+struct EntityAnimationStruct final
+{
 	std::int_fast32_t WaitTimer{};
-	std::int_fast32_t Hitpoints{};
 	std::int_fast32_t WalkAnimCounter{};
 	std::int_fast32_t WalkAnimStep{};
 	std::int_fast32_t WalkAnimStepWidth{};
-	std::int_fast32_t AttackMode{};
 	std::int_fast32_t AttackAnimCounter{};
 	std::int_fast32_t AttackAnimStep{};
 	std::int_fast32_t AttackAnimStepWidth{};
-	std::int_fast32_t HitAnimDuration{};
 	std::int_fast32_t HitAnimCounter{};
+	std::int_fast32_t KillAnimCounter{};
 	std::int_fast32_t KillAnimStep{};
 	std::int_fast32_t KillAnimStepWidth{};
-	std::int_fast32_t KillAnimCounter{};
-	std::int_fast32_t MovementBehaviour{};
-	std::int_fast32_t RotationFactor{};
+};
+
+struct EntityStruct final
+{
+	std::vector<lwmf::IntPointStruct> PathFindingWayPoints{};
+	std::map<std::string, std::int_fast32_t> ContainedItem{};
+	std::string TypeName;
+	std::int_fast32_t Number{};
+	std::int_fast32_t Hitpoints{};
+	std::int_fast32_t HitAnimDuration{};
 	std::int_fast32_t DamagePoints{};
 	std::int_fast32_t DamageHitrate{};
 	std::int_fast32_t DamageHitrateCounter{};
-	std::int_fast32_t PathFindingStart{};
-	std::int_fast32_t PathFindingTarget{};
-	float MoveSpeed{};
-	float MoveV{};
-	char Direction{ '\0' };
-	bool AttackFinished{};
-	bool AttackAnimEnabled{};
-	bool KillAnimEnabled{};
-	bool IsPickedUp{};
-	bool IsDead{};
-	bool IsHit{};
+	std::int_fast32_t PathFindingStart{ -1 };
+	std::int_fast32_t PathFindingTarget{ -1 };
+	std::int_fast32_t PathFindingNextTile{ -1 };
+	std::uint_fast32_t PathFindingTopologyVersion{};
+	std::uint_fast32_t PathFindingTick{};
 	bool ValidPathFound{};
+	bool PathRequestedFlag{};
 };
 
 //
@@ -159,6 +179,9 @@ struct DoorStruct final
 
 inline std::vector<EntityAssetStruct> EntityAssets{};
 inline std::vector<EntityStruct> Entities{};
+inline std::vector<EntityTransformStruct> EntityTransforms{};
+inline std::vector<EntityStateStruct> EntityStates{};
+inline std::vector<EntityAnimationStruct> EntityAnimations{};
 inline std::vector<WeaponStruct> Weapons{};
 inline std::vector<DoorTypeStruct> DoorTypes{};
 inline std::vector<DoorStruct> Doors{};
@@ -11,12 +11,16 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_ErrorHandling.hpp"
+#include "Game_AssetIndex.hpp"
 #include "Game_DataStructures.hpp"
+#include "GFX_ImageHandling.hpp"
 #include "Game_LevelHandling.hpp"
 #include "Game_EntityHandling.hpp"
+#include "Game_PathFinding.hpp"
 
 namespace Game_Doors
 {
@@ -27,7 +31,7 @@ namespace Game_Doors
 		OpenCloseSound
 	};
 
-	void InitDoorAssets();
+	void InitDoorAssets(GFX_ImageHandling::ImageBatchStruct& ImageBatch);
 	void InitDoors();
 	void TriggerDoor();
 	void ModifyDoorTexture(DoorStruct& Door);
@@ -48,7 +52,7 @@ namespace Game_Doors
 	// Functions
 	//
 
-	inline void InitDoorAssets()
+	inline void InitDoorAssets(GFX_ImageHandling::ImageBatchStruct& ImageBatch)
 	{
 		CloseAudio();
 
@@ -59,39 +63,34 @@ namespace Game_Doors
 		DoorTypes.resize(1);
 
 		// We start our DoorTypes counting at "1", since in the map definition it has to be greater zero!
-		std::int_fast32_t Index{ 1 };
+		const std::int_fast32_t NumberOfDoorTypes{ Game_AssetIndex::CountNumberedFiles(AssetsDoorsFolder, "Door_", "_Data.ini", 1) };
 
-		while (true)
+		for (std::int_fast32_t Index{ 1 }; Index <= NumberOfDoorTypes; ++Index)
 		{
 			std::string INIFile{ AssetsDoorsFolder };
 			INIFile += "Door_";
 			INIFile += std::to_string(Index);
 			INIFile += "_Data.ini";
 
-			if (Tools_ErrorHandling::CheckFileExistence(INIFile, ContinueOnError))
-			{
-				DoorTypes.emplace_back();
-
-				lwmf::LoadPNG(DoorTypes[Index].OriginalTexture, lwmf::ReadINIValue<std::string>(INIFile, "TEXTURE", "DoorTexture"));
-
-				DoorTypes[Index].Sounds.emplace_back();
-				DoorTypes[Index].Sounds[static_cast<std::int_fast32_t>(DoorSounds::OpenCloseSound)].Load(lwmf::ReadINIValue<std::string>(INIFile, "AUDIO", "OpenCloseSound"));
-				DoorTypes[Index].OpenCloseSpeed = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "GENERAL", "OpenCloseSpeed");
-				DoorTypes[Index].StayOpenTime = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "GENERAL", "StayOpenTime") * static_cast<std::int_fast32_t>(FrameLock);
-				DoorTypes[Index].MaximumOpenPercent = lwmf::ReadINIValue<float>(INIFile, "GENERAL", "MaximumOpenPercent");
-				DoorTypes[Index].MinimumOpenPercent = lwmf::ReadINIValue<float>(INIFile, "GENERAL", "MinimumOpenPercent");
-
-				Tools_ErrorHandling::CheckAndClampRange(DoorTypes[Index].MaximumOpenPercent, MaximumOpenPercentLowerLimit, MaximumOpenPercentUpperLimit, __FILENAME__, "MaximumOpenPercent");
-				Tools_ErrorHandling::CheckAndClampRange(DoorTypes[Index].MinimumOpenPercent, MinimumOpenPercentLowerLimit, MinimumOpenPercentUpperLimit, __FILENAME__, "MinimumOpenPercent");
+			DoorTypes.emplace_back();
 
-				++Index;
-			}
-			else
+			GFX_ImageHandling::RequestImage(ImageBatch, lwmf::ReadINIValue<std::string>(INIFile, "TEXTURE", "DoorTexture"), [Index](lwmf::TextureStruct& Texture)
 			{
-				NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "No more doortype data found.");
-				break;
-			}
+				DoorTypes[Index].OriginalTexture = std::move(Texture);
+			});
+
+			DoorTypes[Index].Sounds.emplace_back();
+			DoorTypes[Index].Sounds[static_cast<std::int_fast32_t>(DoorSounds::OpenCloseSound)].Load(lwmf::ReadINIValue<std::string>(INIFile, "AUDIO", "OpenCloseSound"));
+			DoorTypes[Index].OpenCloseSpeed = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "GENERAL", "OpenCloseSpeed");
+			DoorTypes[Index].StayOpenTime = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "GENERAL", "StayOpenTime") * static_cast<std::int_fast32_t>(FrameLock);
+			DoorTypes[Index].MaximumOpenPercent = lwmf::ReadINIValue<float>(INIFile, "GENERAL", "MaximumOpenPercent");
+			DoorTypes[Index].MinimumOpenPercent = lwmf::ReadINIValue<float>(INIFile, "GENERAL", "MinimumOpenPercent");
+
+			Tools_ErrorHandling::CheckAndClampRange(DoorTypes[Index].MaximumOpenPercent, MaximumOpenPercentLowerLimit, MaximumOpenPercentUpperLimit, __FILENAME__, "MaximumOpenPercent");
+			Tools_ErrorHandling::CheckAndClampRange(DoorTypes[Index].MinimumOpenPercent, MinimumOpenPercentLowerLimit, MinimumOpenPercentUpperLimit, __FILENAME__, "MinimumOpenPercent");
 		}
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, std::to_string(NumberOfDoorTypes) + " doortype(s) found.");
 	}
 
 	inline void InitDoors()
@@ -121,6 +120,7 @@ namespace Game_Doors
 					ModifyDoorTexture(Doors[Index]);
 
 					Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][MapPosX][MapPosY] = INT_MAX;
+					Game_PathFinding::SetWalkable(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, MapPosX, MapPosY, false);
 
 					++Index;
 				}
@@ -149,7 +149,7 @@ namespace Game_Doors
 
 		for (std::int_fast32_t y{}; y < TextureSize; ++y)
 		{
-			const std::int_fast32_t TempY{ y * TextureSize };
+			const std::int_fast32_t TempY{ y * Door.AnimTexture.Stride };
 			const auto SourceY{ DoorTypes[Door.DoorType].OriginalTexture.Pixels.begin() + TempY };
 			std::copy(SourceY, SourceY + TextureSize - OpenPercent, Door.AnimTexture.Pixels.begin() + TempY + OpenPercent);
 		}
@@ -174,12 +174,13 @@ namespace Game_Doors
 					Door.StayOpenCounter = DoorTypes[Door.DoorType].StayOpenTime;
 					Door.CurrentOpenPercent = DoorTypes[Door.DoorType].MaximumOpenPercent;
 					Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][static_cast<std::int_fast32_t>(Door.Pos.X)][static_cast<std::int_fast32_t>(Door.Pos.Y)] = 0;
+					Game_PathFinding::SetWalkable(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, static_cast<std::int_fast32_t>(Door.Pos.X), static_cast<std::int_fast32_t>(Door.Pos.Y), true);
 				}
 			}
 
 			// Close door - but first check if door is not blocked!
 			if (Door.State == DoorStruct::States::Open
-				&& Game_EntityHandling::EntityMap[static_cast<std::int_fast32_t>(Door.Pos.X)][static_cast<std::int_fast32_t>(Door.Pos.Y)] == EntityTypes::Clear
+				&& !Game_EntityHandling::IsTileOccupied(static_cast<std::int_fast32_t>(Door.Pos.X), static_cast<std::int_fast32_t>(Door.Pos.Y), Game_EntityHandling::AnyTypeMask)
 				&& (std::abs(Player.Pos.X - Door.Pos.X) > FLT_EPSILON || std::abs(Player.Pos.Y - Door.Pos.Y) > FLT_EPSILON))
 			{
 				if (--Door.StayOpenCounter <= 0)
@@ -203,6 +204,7 @@ namespace Game_Doors
 					Door.CloseAudioFlag = false;
 					Door.CurrentOpenPercent = DoorTypes[Door.DoorType].MinimumOpenPercent;
 					Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][static_cast<std::int_fast32_t>(Door.Pos.X)][static_cast<std::int_fast32_t>(Door.Pos.Y)] = INT_MAX;
+					Game_PathFinding::SetWalkable(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, static_cast<std::int_fast32_t>(Door.Pos.X), static_cast<std::int_fast32_t>(Door.Pos.Y), false);
 				}
 			}
 		}
@@ -12,14 +12,18 @@
 #include <cstdint>
 #include <string>
 #include <vector>
-#include <random>
+#include <array>
+#include <bit>
 #include <algorithm>
 #include <map>
 #include <utility>
 #include <tuple>
+#include <chrono>
+#include <cmath>
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_ErrorHandling.hpp"
+#include "Game_AssetIndex.hpp"
 #include "Game_DataStructures.hpp"
 #include "GFX_ImageHandling.hpp"
 #include "Game_LevelHandling.hpp"
@@ -36,27 +40,63 @@ namespace Game_EntityHandling
 		Attack			= 1
 	};
 
-	enum class SortOrder : std::int_fast32_t
+	enum class PathCacheResults : std::int_fast32_t
 	{
-		FrontToBack,
-		BackToFront
+		None,
+		Hit,
+		Miss
 	};
 
-	void InitEntityAssets();
-	void LoadWalkAnimTextures(std::int_fast32_t AssetIndex, const std::string& AssetTypeName);
-	void LoadAdditionalAnimTextures(const std::string& AnimType, const std::string& AssetTypeName, std::vector<lwmf::TextureStruct>& AnimVector);
+	// Every random decision of an entity has its own stream, see GetEntityRandomNumber()
+	enum class RandomStreams : std::int_fast32_t
+	{
+		Wait,
+		WaitDuration,
+		Turn
+	};
+
+	// Everything an entity wants to change outside of its own data during a tick, applied by CommitEntity()
+	struct EntityIntentStruct final
+	{
+		lwmf::FloatPointStruct PreviousPos{};
+		std::int_fast32_t DamagePoints{};
+		PathCacheResults PathCacheResult{};
+		bool AttackSoundFlag{};
+		bool HurtPlayerFlag{};
+	};
+
+	void InitEntityAssets(GFX_ImageHandling::ImageBatchStruct& ImageBatch);
+	void LoadWalkAnimTextures(GFX_ImageHandling::ImageBatchStruct& ImageBatch, std::int_fast32_t AssetIndex, const std::string& AssetTypeName);
+	void LoadAdditionalAnimTextures(GFX_ImageHandling::ImageBatchStruct& ImageBatch, const std::string& AnimType, std::int_fast32_t AssetIndex, const std::string& AssetTypeName, std::vector<lwmf::TextureHandle> EntityAssetStruct::* AnimVector);
 	void InitEntities();
 	void RenderEntities();
 	std::int_fast32_t GetEntityTextureIndex(std::int_fast32_t EntityNumber);
-	void HandleEntityHit(EntityStruct& Entity);
-	void SwitchDirection(EntityStruct& Entity, char Direction);
-	void ChangeEntityDirection(EntityStruct& Entity, char NewDirection);
-	void TurnEntityBackwards(EntityStruct& Entity);
-	void CalculateEntityPath(EntityStruct& Entity);
-	void MoveEntities();
-	void GetEntityDistance();
-	void SortEntities(SortOrder SortOrder);
-	void MarkEntityPositionOnMap(const EntityStruct& Entity);
+	void HandleEntityHit(std::int_fast32_t Index);
+	void SwitchDirection(std::int_fast32_t Index, char Direction);
+	void ChangeEntityDirection(std::int_fast32_t Index, char NewDirection);
+	void TurnEntityBackwards(std::int_fast32_t Index);
+	PathCacheResults CalculateEntityPath(std::int_fast32_t Index);
+	void FollowWayPoints(EntityStruct& Entity, std::int_fast32_t Start);
+	void SteerEntity(std::int_fast32_t Index);
+	std::uint_fast32_t SearchEntityPath(std::int_fast32_t Index);
+	void ProcessPathRequests(lwmf::Multithreading& ThreadPool);
+	void TrimIncrementalSearches();
+	std::string GetPathCacheReport();
+	void MoveEntities(lwmf::Multithreading& ThreadPool);
+	void UpdateEntity(std::int_fast32_t Index);
+	void CommitEntity(std::int_fast32_t Index);
+	std::uint_fast32_t GetEntityRandomNumber(std::int_fast32_t Index, RandomStreams Stream, std::uint_fast32_t Range);
+	void UpdateEntityOrder();
+	void RadixSortEntityOrder();
+	constexpr std::uint_fast32_t GetTypeMask(EntityTypes Type);
+	std::int_fast32_t GetTile(std::int_fast32_t X, std::int_fast32_t Y);
+	void UpdateTileTypeMask(std::int_fast32_t Tile);
+	void LinkEntityToTile(std::int_fast32_t Index);
+	void UnlinkEntityFromTile(std::int_fast32_t Index);
+	void UpdateEntityTile(std::int_fast32_t Index);
+	void SetPlayerTile(std::int_fast32_t X, std::int_fast32_t Y);
+	bool IsTileOccupied(std::int_fast32_t X, std::int_fast32_t Y, std::uint_fast32_t TypeMask);
+	bool IsOtherEntityOnTile(std::int_fast32_t X, std::int_fast32_t Y, std::uint_fast32_t TypeMask, std::int_fast32_t Index);
 	void PlayAudio(std::int_fast32_t TypeNumber, EntitySounds EntitySound);
 	void CloseAudio();
 
@@ -80,25 +120,63 @@ namespace Game_EntityHandling
 		DirectionTuple(0.0F, -1.0F, 'W', 6)
 	};
 
-	// Populate the Mersenne-Twister-Random Engine with proper distributions
-	inline std::uniform_int_distribution<std::int_fast32_t> Distribution200(1, 200);
-	inline std::uniform_int_distribution<std::int_fast32_t> Distribution666(1, 666);
+	// Random numbers of the entities are counter based (seed, entity, tick and stream), so they do not depend on the thread or the order an entity is updated in
+	inline std::uint64_t EntityRandomSeed{};
+	inline std::uint64_t SimulationTick{};
 
 	inline constexpr float EntityCollisionDetectionWallDist{ 0.5F };
 
-	inline std::vector<std::vector<EntityTypes>> EntityMap{};
-
-	// Vector used to sort the entities
+	// Occupancy grid (tile index is LevelMapWidth * Y + X, same as Game_PathFinding::FlattenedMap)
+	// Every tile holds the first entity on it and a bitmask of all types on it (see GetTypeMask()), the entities on a tile are linked by EntityNextOnTile
+	// EntityTiles holds the tile an entity is linked to (-1 if dead or picked up), so an entity is only relinked once it enters another tile
+	// The player is no entity - it only sets its bit on PlayerTile
+	inline std::vector<std::int_fast32_t> TileFirstEntities{};
+	inline std::vector<std::uint_fast32_t> TileTypeMasks{};
+	inline std::vector<std::int_fast32_t> EntityNextOnTile{};
+	inline std::vector<std::int_fast32_t> EntityTiles{};
+	inline std::int_fast32_t PlayerTile{ -1 };
+	inline constexpr std::uint_fast32_t AnyTypeMask{ ~0U };
+	inline const std::uint_fast32_t BlockingTypeMask{ GetTypeMask(EntityTypes::Enemy) | GetTypeMask(EntityTypes::Neutral) | GetTypeMask(EntityTypes::Turret) };
+
+	// Entities sorted front to back by their squared distance to the player, see UpdateEntityOrder()
+	// Only the first NumberOfVisibleEntities are sorted - the hit test iterates them forwards, the renderer backwards
 	inline std::vector<std::pair<std::int_fast32_t, float>> EntityOrder{};
+	inline std::vector<std::pair<std::int_fast32_t, float>> EntityOrderBuffer{};
+	inline std::int_fast32_t NumberOfVisibleEntities{};
+	inline constexpr std::int_fast32_t EntityOrderRadixSortThreshold{ 512 };
 
 	// 1D Zbuffer
 	inline std::vector<float> ZBuffer{};
 
+	// Statistics of the path cache in CalculateEntityPath(), gathered in CommitEntity() and ProcessPathRequests()
+	inline std::uint_fast64_t PathCacheHits{};
+	inline std::uint_fast64_t PathCacheMisses{};
+
+	// Queued A* searches, see ProcessPathRequests()
+	// Every tick of waiting counts as much as the entity being one tile nearer to the player
+	inline constexpr float PathRequestAgingFactor{ 1.0F };
+	inline std::vector<std::pair<float, std::int_fast32_t>> PathRequests{};
+	inline std::vector<std::uint_fast32_t> PathRequestExpandedNodes{};
+	inline std::uint_fast32_t PathFindingTick{};
+	inline std::uint_fast64_t DeferredPathRequests{};
+
+	// Queued searches are done in batches of this size on the thread pool, the budget is checked between the batches
+	// Independent of the number of cores, so the same requests are served on every machine
+	inline constexpr std::size_t PathRequestBatchSize{ 16 };
+
+	// Search trees of the entities in Incremental mode (same index as Entities), kept from one search to the next
+	inline std::vector<Game_PathFinding::IncrementalSearchStruct> IncrementalSearches{};
+
+	// Entities are updated in two phases, see MoveEntities() - the intents of the current tick (same index as Entities)
+	// The first phase is done in batches of this size on the thread pool
+	inline std::vector<EntityIntentStruct> EntityIntents{};
+	inline constexpr std::int_fast32_t EntityUpdateBatchSize{ 256 };
+
 	//
 	// Functions
 	//
 
-	inline void InitEntityAssets()
+	inline void InitEntityAssets(GFX_ImageHandling::ImageBatchStruct& ImageBatch)
 	{
 		CloseAudio();
 
@@ -107,168 +185,142 @@ namespace Game_EntityHandling
 		EntityAssets.clear();
 		EntityAssets.shrink_to_fit();
 
-		std::int_fast32_t AssetFileIndex{};
+		std::string EntityDataFolder{ LevelFolder };
+		EntityDataFolder += std::to_string(SelectedLevel);
+		EntityDataFolder += "/EntityData/";
+
+		const std::int_fast32_t NumberOfEntityDataFiles{ Game_AssetIndex::CountNumberedFiles(EntityDataFolder, "", ".ini", 0) };
 		std::int_fast32_t AssetIndex{};
 
-		while (true) //-V776
+		for (std::int_fast32_t AssetFileIndex{}; AssetFileIndex < NumberOfEntityDataFiles; ++AssetFileIndex)
 		{
 			bool SkipAssetFlag{};
 
-			std::string EntityDataFile{ LevelFolder };
-			EntityDataFile += std::to_string(SelectedLevel);
-			EntityDataFile += "/EntityData/";
+			std::string EntityDataFile{ EntityDataFolder };
 			EntityDataFile += std::to_string(AssetFileIndex);
 			EntityDataFile += ".ini";
 
-			if (Tools_ErrorHandling::CheckFileExistence(EntityDataFile, ContinueOnError))
-			{
-				const std::string AssetTypeName{ lwmf::ReadINIValue<std::string>(EntityDataFile, "ENTITY", "EntityTypeName") };
+			const std::string AssetTypeName{ lwmf::ReadINIValue<std::string>(EntityDataFile, "ENTITY", "EntityTypeName") };
 
-				// If asset type was already loaded, skip this...
-				for (const auto& Asset : EntityAssets)
+			// If asset type was already loaded, skip this...
+			for (const auto& Asset : EntityAssets)
+			{
+				if (Asset.Name == AssetTypeName)
 				{
-					if (Asset.Name == AssetTypeName)
-					{
-						SkipAssetFlag = true;
-						break;
-					}
+					SkipAssetFlag = true;
+					break;
 				}
+			}
 
-				std::string INIFile{ AssetsEntitiesFolder };
-				INIFile += AssetTypeName;
-				INIFile += "/AssetData.ini";
-
-				if (!SkipAssetFlag && Tools_ErrorHandling::CheckFileExistence(INIFile, StopOnError))
-				{
-					EntityAssets.emplace_back();
-					EntityAssets[AssetIndex].Number = AssetIndex;
-					EntityAssets[AssetIndex].Name = AssetTypeName;
+			std::string INIFile{ AssetsEntitiesFolder };
+			INIFile += AssetTypeName;
+			INIFile += "/AssetData.ini";
 
-					//
-					// Get GFX
-					//
+			if (!SkipAssetFlag && Tools_ErrorHandling::CheckFileExistence(INIFile, StopOnError))
+			{
+				EntityAssets.emplace_back();
+				EntityAssets[AssetIndex].Number = AssetIndex;
+				EntityAssets[AssetIndex].Name = AssetTypeName;
 
-					NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load entity textures...");
+				//
+				// Get GFX
+				//
 
-					LoadWalkAnimTextures(AssetIndex, AssetTypeName);
-					LoadAdditionalAnimTextures("Attack", AssetTypeName, EntityAssets[AssetIndex].AttackTextures);
-					LoadAdditionalAnimTextures("Kill", AssetTypeName, EntityAssets[AssetIndex].KillTextures);
+				NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load entity textures...");
 
-					//
-					// Get SFX
-					//
+				LoadWalkAnimTextures(ImageBatch, AssetIndex, AssetTypeName);
+				LoadAdditionalAnimTextures(ImageBatch, "Attack", AssetIndex, AssetTypeName, &EntityAssetStruct::AttackTextures);
+				LoadAdditionalAnimTextures(ImageBatch, "Kill", AssetIndex, AssetTypeName, &EntityAssetStruct::KillTextures);
 
-					NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load entity audio...");
+				//
+				// Get SFX
+				//
 
-					EntityAssets[AssetIndex].Sounds.clear();
-					EntityAssets[AssetIndex].Sounds.shrink_to_fit();
+				NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load entity audio...");
 
-					if (const std::string AssetType{ lwmf::ReadINIValue<std::string>(INIFile, "GENERAL", "AssetType") }; AssetType == "AmmoBox")
-					{
-						// Get Pickup audio
-						EntityAssets[AssetIndex].Sounds.emplace_back();
-						EntityAssets[AssetIndex].Sounds[0].Load(lwmf::ReadINIValue<std::string>(INIFile, "AUDIO", "AmmoPickup"));
-					}
-					else if (AssetType == "Enemy" || AssetType == "Turret")
-					{
-						// Get KillSound audio
-						EntityAssets[AssetIndex].Sounds.emplace_back();
-						EntityAssets[AssetIndex].Sounds[0].Load(lwmf::ReadINIValue<std::string>(INIFile, "AUDIO", "KillSound"));
+				EntityAssets[AssetIndex].Sounds.clear();
+				EntityAssets[AssetIndex].Sounds.shrink_to_fit();
 
-						// Get AttackSound audio
-						EntityAssets[AssetIndex].Sounds.emplace_back();
-						EntityAssets[AssetIndex].Sounds[1].Load(lwmf::ReadINIValue<std::string>(INIFile, "AUDIO", "AttackSound"));
-					}
+				if (const std::string AssetType{ lwmf::ReadINIValue<std::string>(INIFile, "GENERAL", "AssetType") }; AssetType == "AmmoBox")
+				{
+					// Get Pickup audio
+					EntityAssets[AssetIndex].Sounds.emplace_back();
+					EntityAssets[AssetIndex].Sounds[0].Load(lwmf::ReadINIValue<std::string>(INIFile, "AUDIO", "AmmoPickup"));
+				}
+				else if (AssetType == "Enemy" || AssetType == "Turret")
+				{
+					// Get KillSound audio
+					EntityAssets[AssetIndex].Sounds.emplace_back();
+					EntityAssets[AssetIndex].Sounds[0].Load(lwmf::ReadINIValue<std::string>(INIFile, "AUDIO", "KillSound"));
 
-					++AssetIndex;
+					// Get AttackSound audio
+					EntityAssets[AssetIndex].Sounds.emplace_back();
+					EntityAssets[AssetIndex].Sounds[1].Load(lwmf::ReadINIValue<std::string>(INIFile, "AUDIO", "AttackSound"));
 				}
 
-				++AssetFileIndex;
-			}
-			else
-			{
-				break;
+				++AssetIndex;
 			}
 		}
 	}
 
-	inline void LoadWalkAnimTextures(const std::int_fast32_t AssetIndex, const std::string& AssetTypeName)
+	inline void LoadWalkAnimTextures(GFX_ImageHandling::ImageBatchStruct& ImageBatch, const std::int_fast32_t AssetIndex, const std::string& AssetTypeName)
 	{
 		EntityAssets[AssetIndex].WalkingTextures.clear(); //-V807
 		EntityAssets[AssetIndex].WalkingTextures.shrink_to_fit();
 
-		std::int_fast32_t DirectionIndex{};
+		std::string AssetPath{ GFXEntitiesFolder };
+		AssetPath += std::to_string(EntitySize);
+		AssetPath += "/";
+		AssetPath += AssetTypeName;
+		AssetPath += "/";
 
-		while (true)
+		const std::int_fast32_t NumberOfDirections{ Game_AssetIndex::CountNumberedFolders(AssetPath, 0) };
+
+		for (std::int_fast32_t DirectionIndex{}; DirectionIndex < NumberOfDirections; ++DirectionIndex)
 		{
-			std::string Path{ GFXEntitiesFolder };
-			Path += std::to_string(EntitySize);
-			Path += "/";
-			Path += AssetTypeName;
-			Path += "/";
-			Path += std::to_string(DirectionIndex);
+			const std::string Path{ AssetPath + std::to_string(DirectionIndex) };
+			const std::int_fast32_t NumberOfTextures{ Game_AssetIndex::CountNumberedFiles(Path, "", ".png", 0) };
 
-			if (Tools_ErrorHandling::CheckFolderExistence(Path, ContinueOnError))
-			{
-				EntityAssets[AssetIndex].WalkingTextures.emplace_back();
+			EntityAssets[AssetIndex].WalkingTextures.emplace_back(static_cast<std::size_t>(NumberOfTextures));
 
-				std::int_fast32_t TextureIndex{};
+			for (std::int_fast32_t TextureIndex{}; TextureIndex < NumberOfTextures; ++TextureIndex)
+			{
+				std::string Texture{ Path };
+				Texture += "/";
+				Texture += std::to_string(TextureIndex);
+				Texture += ".png";
 
-				while (true)
+				// EntityAssets still grows while requests are collected, so the commit addresses the texture by its indices
+				GFX_ImageHandling::RequestTextureHandle(ImageBatch, Texture, EntitySize, [AssetIndex, DirectionIndex, TextureIndex](const lwmf::TextureHandle& LoadedTexture)
 				{
-					std::string Texture{ Path };
-					Texture += "/";
-					Texture += std::to_string(TextureIndex);
-					Texture += ".png";
-
-					if (Tools_ErrorHandling::CheckFileExistence(Texture, ContinueOnError))
-					{
-						EntityAssets[AssetIndex].WalkingTextures[DirectionIndex].emplace_back(GFX_ImageHandling::ImportTexture(Texture, EntitySize));
-						++TextureIndex;
-					}
-					else
-					{
-						break;
-					}
-				}
-
-				++DirectionIndex;
-			}
-			else
-			{
-				break;
+					EntityAssets[AssetIndex].WalkingTextures[DirectionIndex][TextureIndex] = LoadedTexture;
+				});
 			}
 		}
 	}
 
-	inline void LoadAdditionalAnimTextures(const std::string& AnimType, const std::string& AssetTypeName, std::vector<lwmf::TextureStruct>& AnimVector)
+	inline void LoadAdditionalAnimTextures(GFX_ImageHandling::ImageBatchStruct& ImageBatch, const std::string& AnimType, const std::int_fast32_t AssetIndex, const std::string& AssetTypeName, std::vector<lwmf::TextureHandle> EntityAssetStruct::* AnimVector)
 	{
-		AnimVector.clear();
-		AnimVector.shrink_to_fit();
+		std::string Path{ GFXEntitiesFolder };
+		Path += std::to_string(EntitySize);
+		Path += "/";
+		Path += AssetTypeName;
+		Path += "/";
+		Path += AnimType;
+		Path += "/";
 
-		std::int_fast32_t TextureIndex{};
+		const std::int_fast32_t NumberOfTextures{ Game_AssetIndex::CountNumberedFiles(Path, "", ".png", 0) };
 
-		while (true)
-		{
-			std::string Texture{ GFXEntitiesFolder };
-			Texture += std::to_string(EntitySize);
-			Texture += "/";
-			Texture += AssetTypeName;
-			Texture += "/";
-			Texture += AnimType;
-			Texture += "/";
-			Texture += std::to_string(TextureIndex);
-			Texture += ".png";
+		(EntityAssets[AssetIndex].*AnimVector).clear();
+		(EntityAssets[AssetIndex].*AnimVector).shrink_to_fit();
+		(EntityAssets[AssetIndex].*AnimVector).resize(static_cast<std::size_t>(NumberOfTextures));
 
-			if (Tools_ErrorHandling::CheckFileExistence(Texture, ContinueOnError))
-			{
-				AnimVector.emplace_back(GFX_ImageHandling::ImportTexture(Texture, EntitySize));
-				++TextureIndex;
-			}
-			else
+		for (std::int_fast32_t TextureIndex{}; TextureIndex < NumberOfTextures; ++TextureIndex)
+		{
+			GFX_ImageHandling::RequestTextureHandle(ImageBatch, Path + std::to_string(TextureIndex) + ".png", EntitySize, [AssetIndex, AnimVector, TextureIndex](const lwmf::TextureHandle& LoadedTexture)
 			{
-				break;
-			}
+				(EntityAssets[AssetIndex].*AnimVector)[TextureIndex] = LoadedTexture;
+			});
 		}
 	}
 
@@ -278,153 +330,176 @@ namespace Game_EntityHandling
 
 		Entities.clear();
 		Entities.shrink_to_fit();
-		EntityMap.clear();
-		EntityMap.shrink_to_fit();
+		EntityTransforms.clear();
+		EntityTransforms.shrink_to_fit();
+		EntityStates.clear();
+		EntityStates.shrink_to_fit();
+		EntityAnimations.clear();
+		EntityAnimations.shrink_to_fit();
+		TileFirstEntities.clear();
+		TileFirstEntities.shrink_to_fit();
+		TileTypeMasks.clear();
+		TileTypeMasks.shrink_to_fit();
+		EntityNextOnTile.clear();
+		EntityNextOnTile.shrink_to_fit();
+		EntityTiles.clear();
+		EntityTiles.shrink_to_fit();
 		EntityOrder.clear();
 		EntityOrder.shrink_to_fit();
+		EntityOrderBuffer.clear();
+		EntityOrderBuffer.shrink_to_fit();
+		NumberOfVisibleEntities = 0;
+		IncrementalSearches.clear();
+		IncrementalSearches.shrink_to_fit();
+		EntityIntents.clear();
+		EntityIntents.shrink_to_fit();
 		ZBuffer.clear();
 		ZBuffer.shrink_to_fit();
 		ZBuffer.resize(static_cast<size_t>(Canvas.Width));
 
-		EntityMap = std::vector<std::vector<EntityTypes>>(static_cast<size_t>(Game_LevelHandling::LevelMapWidth), std::vector<EntityTypes>(static_cast<size_t>(Game_LevelHandling::LevelMapHeight), EntityTypes::Clear));
+		TileFirstEntities.resize(static_cast<std::size_t>(Game_LevelHandling::LevelMapWidth) * static_cast<std::size_t>(Game_LevelHandling::LevelMapHeight), -1);
+		TileTypeMasks.resize(TileFirstEntities.size());
+		PlayerTile = -1;
+
+		std::string EntityDataFolder{ LevelFolder };
+		EntityDataFolder += std::to_string(SelectedLevel);
+		EntityDataFolder += "/EntityData/";
 
-		std::int_fast32_t Index{};
+		const std::int_fast32_t NumberOfEntities{ Game_AssetIndex::CountNumberedFiles(EntityDataFolder, "", ".ini", 0) };
 
-		while (true)
+		for (std::int_fast32_t Index{}; Index < NumberOfEntities; ++Index)
 		{
-			std::string INIFile{ LevelFolder };
-			INIFile += std::to_string(SelectedLevel);
-			INIFile += "/EntityData/";
+			std::string INIFile{ EntityDataFolder };
 			INIFile += std::to_string(Index);
 			INIFile += ".ini";
 
-			if (Tools_ErrorHandling::CheckFileExistence(INIFile, ContinueOnError))
-			{
-				EntityOrder.emplace_back();
-				Entities.emplace_back();
-				Entities[Index].Number = Index;
-				Entities[Index].TypeName = lwmf::ReadINIValue<std::string>(INIFile, "ENTITY", "EntityTypeName");
-
-				const std::string EntityTypeString{ lwmf::ReadINIValue<std::string>(INIFile, "ENTITY", "EntityType") }; //-V808
-
-				const std::map<std::string, EntityTypes> EntityTypeCompare //-V808
-				{
-					{ "Clear", EntityTypes::Clear },
-					{ "Neutral", EntityTypes::Neutral },
-					{ "Enemy", EntityTypes::Enemy },
-					{ "Player", EntityTypes::Player },
-					{ "AmmoBox", EntityTypes::AmmoBox },
-					{ "Turret", EntityTypes::Turret }
-				};
-
-				if (const auto Type{ EntityTypeCompare.find(EntityTypeString) }; Type != EntityTypeCompare.end())
-				{
-					Entities[Index].Type = Type->second;
-				}
-				else
-				{
-					NARCLog.AddEntry(lwmf::LogLevel::Critical, __FILENAME__, __LINE__, "InitEntities(): Entity type wrong or not found!");
-				}
+			EntityOrder.emplace_back(Index, 0.0F);
+			Entities.emplace_back();
+			EntityTransforms.emplace_back();
+			EntityStates.emplace_back();
+			EntityAnimations.emplace_back();
+			EntityNextOnTile.emplace_back(-1);
+			EntityTiles.emplace_back(-1);
+			Entities[Index].Number = Index;
+			Entities[Index].TypeName = lwmf::ReadINIValue<std::string>(INIFile, "ENTITY", "EntityTypeName");
 
-				Entities[Index].WalkAnimStepWidth = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "ENTITY", "WalkAnimStepWidth");
-				Entities[Index].AttackAnimStepWidth = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "ENTITY", "AttackAnimStepWidth");
-				Entities[Index].KillAnimStepWidth = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "ENTITY", "KillAnimStepWidth");
-				Entities[Index].MoveV = lwmf::ReadINIValue<float>(INIFile, "ENTITY", "EntityMoveV");
-				Entities[Index].MoveSpeed = lwmf::ReadINIValue<float>(INIFile, "MOVEMENT", "MoveSpeed");
-				Entities[Index].MovementBehaviour = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "MOVEMENT", "MovementBehaviour");
-				Entities[Index].AttackMode = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "MOVEMENT", "AttackMode");
-				Entities[Index].Pos = { lwmf::ReadINIValue<float>(INIFile, "POSITION", "StartPosX"), lwmf::ReadINIValue<float>(INIFile, "POSITION", "StartPosY") };
-
-				// Load/set direction data: Dir.X, Dir.Y, Direction, Rotationfactor
-				SwitchDirection(Entities[Index], lwmf::ReadINIValue<char>(INIFile, "DIRECTION", "Direction"));
-
-				Entities[Index].Hitpoints = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "STATUS", "Hitpoints");
-				Entities[Index].HitAnimDuration = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "STATUS", "HitAnimDuration");
-				Entities[Index].DamagePoints = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DAMAGE", "DamagePoints");
-				Entities[Index].DamageHitrate = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DAMAGE", "DamageHitrate");
-				Entities[Index].ContainedItem[lwmf::ReadINIValue<std::string>(INIFile, "CONTAINS", "ContainedItem")] = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "CONTAINS", "ContainedItemValue");
-
-				// Assign proper asset data (= texture set) to entity
-				for (const auto& Asset : EntityAssets)
-				{
-					if (Entities[Index].TypeName == Asset.Name)
-					{
-						Entities[Index].TypeNumber = Asset.Number;
-						break;
-					}
-				}
+			const std::string EntityTypeString{ lwmf::ReadINIValue<std::string>(INIFile, "ENTITY", "EntityType") }; //-V808
 
-				MarkEntityPositionOnMap(Entities[Index]);
-				++Index;
+			const std::map<std::string, EntityTypes> EntityTypeCompare //-V808
+			{
+				{ "Clear", EntityTypes::Clear },
+				{ "Neutral", EntityTypes::Neutral },
+				{ "Enemy", EntityTypes::Enemy },
+				{ "Player", EntityTypes::Player },
+				{ "AmmoBox", EntityTypes::AmmoBox },
+				{ "Turret", EntityTypes::Turret }
+			};
+
+			if (const auto Type{ EntityTypeCompare.find(EntityTypeString) }; Type != EntityTypeCompare.end())
+			{
+				EntityStates[Index].Type = Type->second;
 			}
 			else
 			{
-				break;
+				NARCLog.AddEntry(lwmf::LogLevel::Critical, __FILENAME__, __LINE__, "InitEntities(): Entity type wrong or not found!");
+			}
+
+			EntityAnimations[Index].WalkAnimStepWidth = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "ENTITY", "WalkAnimStepWidth");
+			EntityAnimations[Index].AttackAnimStepWidth = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "ENTITY", "AttackAnimStepWidth");
+			EntityAnimations[Index].KillAnimStepWidth = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "ENTITY", "KillAnimStepWidth");
+			EntityTransforms[Index].MoveV = lwmf::ReadINIValue<float>(INIFile, "ENTITY", "EntityMoveV");
+			EntityTransforms[Index].MoveSpeed = lwmf::ReadINIValue<float>(INIFile, "MOVEMENT", "MoveSpeed");
+			EntityStates[Index].MovementBehaviour = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "MOVEMENT", "MovementBehaviour");
+			EntityStates[Index].AttackMode = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "MOVEMENT", "AttackMode");
+			EntityTransforms[Index].Pos = { lwmf::ReadINIValue<float>(INIFile, "POSITION", "StartPosX"), lwmf::ReadINIValue<float>(INIFile, "POSITION", "StartPosY") };
+
+			// Load/set direction data: Dir.X, Dir.Y, Direction, Rotationfactor
+			SwitchDirection(Index, lwmf::ReadINIValue<char>(INIFile, "DIRECTION", "Direction"));
+
+			Entities[Index].Hitpoints = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "STATUS", "Hitpoints");
+			Entities[Index].HitAnimDuration = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "STATUS", "HitAnimDuration");
+			Entities[Index].DamagePoints = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DAMAGE", "DamagePoints");
+			Entities[Index].DamageHitrate = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DAMAGE", "DamageHitrate");
+			Entities[Index].ContainedItem[lwmf::ReadINIValue<std::string>(INIFile, "CONTAINS", "ContainedItem")] = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "CONTAINS", "ContainedItemValue");
+
+			// Assign proper asset data (= texture set) to entity
+			for (const auto& Asset : EntityAssets)
+			{
+				if (Entities[Index].TypeName == Asset.Name)
+				{
+					EntityStates[Index].TypeNumber = Asset.Number;
+					break;
+				}
 			}
+
+			LinkEntityToTile(Index);
 		}
+
+		IncrementalSearches.resize(Entities.size());
+		EntityIntents.resize(Entities.size());
+
+		EntityRandomSeed = (static_cast<std::uint64_t>(RNG()) << 32) | RNG();
+		SimulationTick = 0;
 	}
 
 	inline void RenderEntities()
 	{
 		const float InverseMatrix{ 1.0F / (Plane.X * Player.Dir.Y - Player.Dir.X * Plane.Y) };
 		const std::int_fast32_t VerticalLookTemp{ Canvas.Height + VerticalLook };
-		const std::int_fast32_t NumberOfEntities{ static_cast<std::int_fast32_t>(Entities.size()) };
+		std::vector<lwmf::PixelType> SpanTexels(static_cast<std::size_t>(Canvas.Height));
+		std::vector<lwmf::PixelType> SpanShaded(static_cast<std::size_t>(Canvas.Height));
 
-		for (std::int_fast32_t Index{}; Index < NumberOfEntities; ++Index)
+		// Back to front
+		for (std::int_fast32_t Index{ NumberOfVisibleEntities - 1 }; Index >= 0; --Index)
 		{
-			// Additional check if Loot is not picked up...
-			if (!Entities[EntityOrder[Index].first].IsPickedUp)
+			const EntityStateStruct& State{ EntityStates[EntityOrder[Index].first] };
+			const EntityTransformStruct& Transform{ EntityTransforms[EntityOrder[Index].first] };
+			const EntityAnimationStruct& Animation{ EntityAnimations[EntityOrder[Index].first] };
+			const lwmf::FloatPointStruct EntityPos{ Transform.Pos.X - Player.Pos.X, Transform.Pos.Y - Player.Pos.Y };
+			const float TransY{ InverseMatrix * (-Plane.Y * EntityPos.X + Plane.X * EntityPos.Y) };
+			const std::int_fast32_t vScreen{ static_cast<std::int_fast32_t>(Transform.MoveV / TransY) };
+			const std::int_fast32_t EntitySizeTemp{ static_cast<std::int_fast32_t>(Canvas.Height / TransY) };
+			const std::int_fast32_t Temp{ (VerticalLookTemp >> 1) + vScreen };
+			const std::int_fast32_t LineStartY{ std::max(-(EntitySizeTemp >> 1) + Temp, 0) };
+			const std::int_fast32_t LineEndY{ std::min((EntitySizeTemp >> 1) + Temp, Canvas.Height) };
+			const std::int_fast32_t EntitySX{ static_cast<std::int_fast32_t>(Canvas.WidthMid * (1.0F + InverseMatrix * (Player.Dir.Y * EntityPos.X - Player.Dir.X * EntityPos.Y) / TransY)) };
+			const std::int_fast32_t LineEndX{ std::min((EntitySizeTemp >> 1) + EntitySX, Canvas.Width) };
+			const std::int_fast32_t Temp1{ (-EntitySizeTemp >> 1) + EntitySX };
+			const std::int_fast32_t Temp2{ VerticalLookTemp << 7 };
+			const std::int_fast32_t Temp3{ EntitySizeTemp << 7 };
+			const std::int_fast32_t TextureIndex{ GetEntityTextureIndex(Index) };
+			const bool HitFlashFlag{ State.IsHit && !State.KillAnimEnabled };
+
+			for (std::int_fast32_t x{ (-EntitySizeTemp >> 1) + EntitySX }; x < LineEndX; ++x)
 			{
-				const lwmf::FloatPointStruct EntityPos{ Entities[EntityOrder[Index].first].Pos.X - Player.Pos.X, Entities[EntityOrder[Index].first].Pos.Y - Player.Pos.Y };
-				const float TransY{ InverseMatrix * (-Plane.Y * EntityPos.X + Plane.X * EntityPos.Y) };
-				const std::int_fast32_t vScreen{ static_cast<std::int_fast32_t>(Entities[EntityOrder[Index].first].MoveV / TransY) };
-				const std::int_fast32_t EntitySizeTemp{ static_cast<std::int_fast32_t>(Canvas.Height / TransY) };
-				const std::int_fast32_t Temp{ (VerticalLookTemp >> 1) + vScreen };
-				const std::int_fast32_t LineStartY{ std::max(-(EntitySizeTemp >> 1) + Temp, 0) };
-				const std::int_fast32_t LineEndY{ std::min((EntitySizeTemp >> 1) + Temp, Canvas.Height) };
-				const std::int_fast32_t EntitySX{ static_cast<std::int_fast32_t>(Canvas.WidthMid * (1.0F + InverseMatrix * (Player.Dir.Y * EntityPos.X - Player.Dir.X * EntityPos.Y) / TransY)) };
-				const std::int_fast32_t LineEndX{ std::min((EntitySizeTemp >> 1) + EntitySX, Canvas.Width) };
-				const std::int_fast32_t Temp1{ (-EntitySizeTemp >> 1) + EntitySX };
-				const std::int_fast32_t Temp2{ VerticalLookTemp << 7 };
-				const std::int_fast32_t Temp3{ EntitySizeTemp << 7 };
-				const std::int_fast32_t TextureIndex{ GetEntityTextureIndex(Index) };
-
-				for (std::int_fast32_t x{ (-EntitySizeTemp >> 1) + EntitySX }; x < LineEndX; ++x)
+				if (TransY > 0.0F && (static_cast<std::uint_fast32_t>(x) < static_cast<std::uint_fast32_t>(Canvas.Width)) && TransY < ZBuffer[x])
 				{
-					if (TransY > 0.0F && (static_cast<std::uint_fast32_t>(x) < static_cast<std::uint_fast32_t>(Canvas.Width)) && TransY < ZBuffer[x])
+					const std::int_fast32_t TextureX{ (x - Temp1) * EntitySize / EntitySizeTemp };
+
+					const lwmf::TextureStruct& Texture{ State.AttackAnimEnabled ? *EntityAssets[State.TypeNumber].AttackTextures[Animation.AttackAnimStep] :
+						(State.KillAnimEnabled ? *EntityAssets[State.TypeNumber].KillTextures[Animation.KillAnimStep] : *EntityAssets[State.TypeNumber].WalkingTextures[TextureIndex][Animation.WalkAnimStep]) };
+
+					for (std::int_fast32_t y{ LineStartY }; y < LineEndY; ++y)
 					{
-						const std::int_fast32_t TextureX{ (x - Temp1) * EntitySize / EntitySizeTemp };
+						const std::int_fast32_t TextureY{ (((((y - vScreen) << 8) - Temp2 + Temp3) * EntitySize) / EntitySizeTemp) >> 8 };
+						SpanTexels[y - LineStartY] = lwmf::GetPixel(Texture, TextureX, TextureY);
+					}
 
-						for (std::int_fast32_t y{ LineStartY }; y < LineEndY; ++y)
-						{
-							std::int_fast32_t Color{};
-							const std::int_fast32_t PixelOffset{ ((((((y - vScreen) << 8) - Temp2 + Temp3) * EntitySize) / EntitySizeTemp) >> 8) * EntitySize + TextureX };
+					// Shade factor (distance) is the same for the whole entity, so every column is shaded as one span
+					const lwmf::PixelType* Span{ SpanTexels.data() };
 
-							if (Entities[Entities[EntityOrder[Index].first].Number].AttackAnimEnabled)
-							{
-								Color = EntityAssets[Entities[Entities[EntityOrder[Index].first].Number].TypeNumber].AttackTextures[Entities[EntityOrder[Index].first].AttackAnimStep].Pixels[PixelOffset];
-							}
-							else if (Entities[Entities[EntityOrder[Index].first].Number].KillAnimEnabled)
-							{
-								Color = EntityAssets[Entities[Entities[EntityOrder[Index].first].Number].TypeNumber].KillTextures[Entities[EntityOrder[Index].first].KillAnimStep].Pixels[PixelOffset];
-							}
-							else
-							{
-								Color = EntityAssets[Entities[Entities[EntityOrder[Index].first].Number].TypeNumber].WalkingTextures[TextureIndex][Entities[EntityOrder[Index].first].WalkAnimStep].Pixels[PixelOffset];
-							}
+					if (Game_LevelHandling::LightingFlag && !HitFlashFlag && LineEndY > LineStartY)
+					{
+						lwmf::SIMDKernels.ShadePixels(SpanTexels.data(), SpanShaded.data(), static_cast<std::size_t>(LineEndY - LineStartY), TransY, FogOfWarDistance);
+						Span = SpanShaded.data();
+					}
 
-							// Check if alphachannel of pixel ist not transparent and draw pixel
-							if ((Color & lwmf::AMask) != 0)
-							{
-								if (Entities[EntityOrder[Index].first].IsHit && !Entities[EntityOrder[Index].first].KillAnimEnabled)
-								{
-									lwmf::SetPixel(Canvas, x, y, Color | 0xFFFFFF00);
-								}
-								else
-								{
-									Game_LevelHandling::LightingFlag ? (lwmf::SetPixel(Canvas, x, y, lwmf::ShadeColor(Color, TransY, FogOfWarDistance))) : lwmf::SetPixel(Canvas, x, y, Color);
-								}
-							}
+					for (std::int_fast32_t y{ LineStartY }; y < LineEndY; ++y)
+					{
+						// Check if alphachannel of pixel ist not transparent and draw pixel
+						if ((SpanTexels[y - LineStartY] & lwmf::AMask) != 0)
+						{
+							lwmf::SetPixel(Canvas, x, y, HitFlashFlag ? SpanTexels[y - LineStartY] | 0xFFFFFF00 : Span[y - LineStartY]);
 						}
 					}
 				}
@@ -437,7 +512,7 @@ namespace Game_EntityHandling
 		// Get angle between player and entity without atan2
 		// Returns TextureIndex (0..7) for adressing correct texture
 
-		const lwmf::FloatPointStruct EntityTemp{ Entities[Entities[EntityOrder[EntityNumber].first].Number].Pos.X - Player.Pos.X, Entities[Entities[EntityOrder[EntityNumber].first].Number].Pos.Y - Player.Pos.Y };
+		const lwmf::FloatPointStruct EntityTemp{ EntityTransforms[EntityOrder[EntityNumber].first].Pos.X - Player.Pos.X, EntityTransforms[EntityOrder[EntityNumber].first].Pos.Y - Player.Pos.Y };
 		const float CosTheta1{ (EntityTemp.X + EntityTemp.Y) * lwmf::SQRT1_2 };
 		const float CosTheta3{ (EntityTemp.Y - EntityTemp.X) * lwmf::SQRT1_2 };
 		float ClosestTheta{ EntityTemp.X };
@@ -486,47 +561,55 @@ namespace Game_EntityHandling
 		}
 
 		// Add rotation factor to Textureindex dependent on heading direction of entity
-		const std::int_fast32_t TextureIndexTemp{ TextureIndex + Entities[Entities[EntityOrder[EntityNumber].first].Number].RotationFactor };
+		const std::int_fast32_t TextureIndexTemp{ TextureIndex + EntityStates[EntityOrder[EntityNumber].first].RotationFactor };
 		return TextureIndexTemp < 8 ? TextureIndexTemp : TextureIndexTemp - 8;
 	}
 
-	inline void HandleEntityHit(EntityStruct& Entity)
+	inline void HandleEntityHit(const std::int_fast32_t Index)
 	{
-		if (Entity.Type != EntityTypes::AmmoBox)
+		EntityStruct& Entity{ Entities[Index] };
+		EntityStateStruct& State{ EntityStates[Index] };
+
+		if (State.Type != EntityTypes::AmmoBox)
 		{
-			Entity.IsHit = true;
-			Entity.AttackMode = 1;
-			Entity.Type = EntityTypes::Enemy;
+			State.IsHit = true;
+			State.AttackMode = 1;
+			State.Type = EntityTypes::Enemy;
+
+			if (EntityTiles[Index] != -1)
+			{
+				UpdateTileTypeMask(EntityTiles[Index]);
+			}
 
 			// Is entity still alive?
 			if (Entity.Hitpoints > 0)
 			{
 				Entity.Hitpoints -= Weapons[Player.SelectedWeapon].Damage;
-				Entity.HitAnimCounter += Entity.HitAnimDuration;
+				EntityAnimations[Index].HitAnimCounter += Entity.HitAnimDuration;
 			}
 
-			if (Entity.Hitpoints <= 0 && !Entity.KillAnimEnabled)
+			if (Entity.Hitpoints <= 0 && !State.KillAnimEnabled)
 			{
-				PlayAudio(Entity.TypeNumber, EntitySounds::Kill);
+				PlayAudio(State.TypeNumber, EntitySounds::Kill);
 
 				// Entity is killed, now the death animation needs to be rendered...
 				// Will be set to "IsDead" in MoveEntities()
-				Entity.KillAnimEnabled = true;
-				Entity.AttackAnimEnabled = false;
-				Entity.AttackFinished = true;
+				State.KillAnimEnabled = true;
+				State.AttackAnimEnabled = false;
+				State.AttackFinished = true;
 			}
 		}
 	}
 
-	inline void SwitchDirection(EntityStruct& Entity, const char Direction)
+	inline void SwitchDirection(const std::int_fast32_t Index, const char Direction)
 	{
 		const auto it{ std::find_if(Directions.begin(), Directions.end(), [&](const auto &e) {return std::get<2>(e) == Direction; }) };
 
 		if (it != Directions.end())
 		{
-			Entity.Dir = { std::get<0>(*it), std::get<1>(*it) };
-			Entity.Direction = std::get<2>(*it);
-			Entity.RotationFactor = std::get<3>(*it);
+			EntityTransforms[Index].Dir = { std::get<0>(*it), std::get<1>(*it) };
+			EntityStates[Index].Direction = std::get<2>(*it);
+			EntityStates[Index].RotationFactor = std::get<3>(*it);
 		}
 		else
 		{
@@ -535,36 +618,36 @@ namespace Game_EntityHandling
 		}
 	}
 
-	inline void ChangeEntityDirection(EntityStruct& Entity, const char NewDirection)
+	inline void ChangeEntityDirection(const std::int_fast32_t Index, const char NewDirection)
 	{
 		switch (NewDirection)
 		{
 			case 'l':
 			{
-				switch (Entity.Direction)
+				switch (EntityStates[Index].Direction)
 				{
 					case 'N':
 					{
 						// Turn left (-> West) if moved North previously
-						SwitchDirection(Entity, 'W');
+						SwitchDirection(Index, 'W');
 						break;
 					}
 					case 'S':
 					{
 						// Turn left (-> East) if moved South previously
-						SwitchDirection(Entity, 'E');
+						SwitchDirection(Index, 'E');
 						break;
 					}
 					case 'E':
 					{
 						// Turn left (-> North) if moved East previously
-						SwitchDirection(Entity, 'N');
+						SwitchDirection(Index, 'N');
 						break;
 					}
 					case 'W':
 					{
 						// Turn left (-> South) if moved West previously
-						SwitchDirection(Entity, 'S');
+						SwitchDirection(Index, 'S');
 						break;
 					}
 					default: {}
@@ -573,30 +656,30 @@ namespace Game_EntityHandling
 			}
 			case 'r':
 			{
-				switch (Entity.Direction)
+				switch (EntityStates[Index].Direction)
 				{
 					case 'N':
 					{
 						// Turn right (-> East) if moved North previously
-						SwitchDirection(Entity, 'E');
+						SwitchDirection(Index, 'E');
 						break;
 					}
 					case 'S':
 					{
 						// Turn right (-> West) if moved South previously
-						SwitchDirection(Entity, 'W');
+						SwitchDirection(Index, 'W');
 						break;
 					}
 					case 'E':
 					{
 						// Turn right (-> South) if moved East previously
-						SwitchDirection(Entity, 'S');
+						SwitchDirection(Index, 'S');
 						break;
 					}
 					case 'W':
 					{
 						// Turn right (-> North) if moved West previously
-						SwitchDirection(Entity, 'N');
+						SwitchDirection(Index, 'N');
 						break;
 					}
 					default: {}
@@ -607,246 +690,782 @@ namespace Game_EntityHandling
 		}
 	}
 
-	inline void TurnEntityBackwards(EntityStruct& Entity)
+	inline void TurnEntityBackwards(const std::int_fast32_t Index)
 	{
-		switch (Entity.Direction)
+		switch (EntityStates[Index].Direction)
 		{
 			case 'N':
 			{
-				SwitchDirection(Entity, 'S');
+				SwitchDirection(Index, 'S');
 				break;
 			}
 			case 'E':
 			{
-				SwitchDirection(Entity, 'W');
+				SwitchDirection(Index, 'W');
 				break;
 			}
 			case 'S':
 			{
-				SwitchDirection(Entity, 'N');
+				SwitchDirection(Index, 'N');
 				break;
 			}
 			case 'W':
 			{
-				SwitchDirection(Entity, 'E');
+				SwitchDirection(Index, 'E');
 				break;
 			}
 			default:{}
 		}
 	}
 
-	inline void CalculateEntityPath(EntityStruct& Entity)
+	inline PathCacheResults CalculateEntityPath(const std::int_fast32_t Index)
 	{
-		if (Entity.Type == EntityTypes::Enemy || Entity.Type == EntityTypes::Neutral)
+		if (EntityStates[Index].Type == EntityTypes::Enemy || EntityStates[Index].Type == EntityTypes::Neutral)
 		{
-			Entity.PathFindingWayPoints.clear();
+			EntityStruct& Entity{ Entities[Index] };
+			const std::int_fast32_t Start{ Game_LevelHandling::LevelMapWidth * static_cast<std::int_fast32_t>(EntityTransforms[Index].Pos.Y) + static_cast<std::int_fast32_t>(EntityTransforms[Index].Pos.X) };
+			const std::int_fast32_t Target{ Game_LevelHandling::LevelMapWidth * static_cast<std::int_fast32_t>(Player.Pos.Y) + static_cast<std::int_fast32_t>(Player.Pos.X) }; //-V778
+
+			// The path of the last tick is still valid as long as neither the entity nor the player entered another tile and no door opened or closed
+			if (Start == Entity.PathFindingStart && Target == Entity.PathFindingTarget && Entity.PathFindingTopologyVersion == Game_PathFinding::TopologyVersion)
+			{
+				return PathCacheResults::Hit;
+			}
+
+			// The flow field towards the player is updated once per tick in MoveEntities(), the next step is just looked up
+			// Waypoints are not stored - the minimap follows the flow field itself, SteerEntity() only needs the next tile
+			if (Game_PathFinding::Mode == Game_PathFinding::Modes::FlowField)
+			{
+				Entity.PathFindingStart = Start;
+				Entity.PathFindingTarget = Target;
+				Entity.PathFindingTopologyVersion = Game_PathFinding::TopologyVersion;
+				Entity.PathFindingNextTile = Game_PathFinding::GetNextTile(Game_PathFinding::PlayerFlowField, Entity.PathFindingStart);
+				Entity.ValidPathFound = Entity.PathFindingNextTile != -1 || Entity.PathFindingStart == Entity.PathFindingTarget;
+				return PathCacheResults::Miss;
+			}
 
-			Entity.PathFindingStart = Game_LevelHandling::LevelMapWidth * static_cast<std::int_fast32_t>(Entity.Pos.Y) + static_cast<std::int_fast32_t>(Entity.Pos.X);
-			Entity.PathFindingTarget = Game_LevelHandling::LevelMapWidth * static_cast<std::int_fast32_t>(Player.Pos.Y) + static_cast<std::int_fast32_t>(Player.Pos.X); //-V778
+			// Searches of the other modes are queued and done in ProcessPathRequests() - until then the entity keeps following its previous path
+			Entity.PathRequestedFlag = true;
+			FollowWayPoints(Entity, Start);
+		}
+
+		return PathCacheResults::None;
+	}
+
+	inline void FollowWayPoints(EntityStruct& Entity, const std::int_fast32_t Start)
+	{
+		if (Start == Entity.PathFindingTarget)
+		{
+			Entity.PathFindingNextTile = -1;
+			return;
+		}
 
-			Entity.ValidPathFound = Game_PathFinding::CalculatePath(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, Game_LevelHandling::LevelMapHeight, Entity.PathFindingStart, Entity.PathFindingTarget, false, Entity.PathFindingWayPoints);
+		// Waypoints run from the tile the path was searched from to the tile before the target
+		for (std::size_t i{}; i < Entity.PathFindingWayPoints.size(); ++i)
+		{
+			if (Game_LevelHandling::LevelMapWidth * Entity.PathFindingWayPoints[i].Y + Entity.PathFindingWayPoints[i].X == Start)
+			{
+				Entity.PathFindingNextTile = i + 1 < Entity.PathFindingWayPoints.size() ?
+					Game_LevelHandling::LevelMapWidth * Entity.PathFindingWayPoints[i + 1].Y + Entity.PathFindingWayPoints[i + 1].X : Entity.PathFindingTarget;
+				return;
+			}
 		}
 	}
 
-	inline void MoveEntities()
+	// Only writes to the entity, its incremental search and the search context of the calling thread, so searches of different entities can run in parallel
+	// Returns the number of expanded nodes
+	inline std::uint_fast32_t SearchEntityPath(const std::int_fast32_t Index)
 	{
-		for (auto&& Entity : Entities)
+		EntityStruct& Entity{ Entities[Index] };
+		Game_PathFinding::IncrementalSearchStruct& IncrementalSearch{ IncrementalSearches[Index] };
+
+		Entity.PathFindingStart = Game_LevelHandling::LevelMapWidth * static_cast<std::int_fast32_t>(EntityTransforms[Index].Pos.Y) + static_cast<std::int_fast32_t>(EntityTransforms[Index].Pos.X);
+		Entity.PathFindingTarget = Game_LevelHandling::LevelMapWidth * static_cast<std::int_fast32_t>(Player.Pos.Y) + static_cast<std::int_fast32_t>(Player.Pos.X); //-V778
+		Entity.PathFindingTopologyVersion = Game_PathFinding::TopologyVersion;
+		Entity.PathFindingTick = PathFindingTick;
+		Entity.PathRequestedFlag = false;
+
+		switch (Game_PathFinding::Mode)
 		{
-			if (Entity.IsHit && --Entity.HitAnimCounter == 0)
+			case Game_PathFinding::Modes::JumpPointSearch:
+			{
+				Entity.ValidPathFound = Game_PathFinding::CalculateJumpPointPath(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, Game_LevelHandling::LevelMapHeight, Entity.PathFindingStart, Entity.PathFindingTarget, false, Entity.PathFindingWayPoints);
+				break;
+			}
+			case Game_PathFinding::Modes::Hierarchical:
+			{
+				Entity.ValidPathFound = Game_PathFinding::CalculateHierarchicalPath(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, Game_LevelHandling::LevelMapHeight, Entity.PathFindingStart, Entity.PathFindingTarget, false, Entity.PathFindingWayPoints);
+				break;
+			}
+			case Game_PathFinding::Modes::Incremental:
+			{
+				Entity.ValidPathFound = Game_PathFinding::CalculateIncrementalPath(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, Game_LevelHandling::LevelMapHeight, Entity.PathFindingStart, Entity.PathFindingTarget, false, Entity.PathFindingWayPoints, IncrementalSearch);
+				break;
+			}
+			default:
 			{
-				Entity.IsHit = false;
+				Entity.ValidPathFound = Game_PathFinding::CalculatePath(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, Game_LevelHandling::LevelMapHeight, Entity.PathFindingStart, Entity.PathFindingTarget, false, Entity.PathFindingWayPoints);
 			}
+		}
+
+		// First waypoint is the tile of the entity itself
+		if (!Entity.ValidPathFound || Entity.PathFindingStart == Entity.PathFindingTarget)
+		{
+			Entity.PathFindingNextTile = -1;
+		}
+		else if (Entity.PathFindingWayPoints.size() > 1)
+		{
+			const lwmf::IntPointStruct& NextWayPoint{ Entity.PathFindingWayPoints[1] };
+			Entity.PathFindingNextTile = Game_LevelHandling::LevelMapWidth * NextWayPoint.Y + NextWayPoint.X;
+		}
+		else
+		{
+			Entity.PathFindingNextTile = Entity.PathFindingTarget;
+		}
+
+		return Game_PathFinding::Mode == Game_PathFinding::Modes::Incremental ? IncrementalSearch.ExpandedNodes : Game_PathFinding::SearchContext.ExpandedNodes;
+	}
+
+	// Entities in attack mode head for the tile after their own on the path towards the player instead of roaming
+	// Movement stays axis aligned, so only tiles next to the one of the entity are taken - the stale next tile of a deferred search is ignored until the entity is back on its path
+	inline void SteerEntity(const std::int_fast32_t Index)
+	{
+		const EntityStruct& Entity{ Entities[Index] };
+
+		if (!Entity.ValidPathFound || Entity.PathFindingNextTile == -1)
+		{
+			return;
+		}
+
+		const std::int_fast32_t Tile{ Game_LevelHandling::LevelMapWidth * static_cast<std::int_fast32_t>(EntityTransforms[Index].Pos.Y) + static_cast<std::int_fast32_t>(EntityTransforms[Index].Pos.X) };
+		const std::int_fast32_t Step{ Entity.PathFindingNextTile - Tile };
+		char Direction{};
+
+		if (Step == -1)
+		{
+			Direction = 'N';
+		}
+		else if (Step == 1)
+		{
+			Direction = 'S';
+		}
+		else if (Step == Game_LevelHandling::LevelMapWidth)
+		{
+			Direction = 'E';
+		}
+		else if (Step == -Game_LevelHandling::LevelMapWidth)
+		{
+			Direction = 'W';
+		}
+		else
+		{
+			return;
+		}
+
+		if (Direction != EntityStates[Index].Direction)
+		{
+			SwitchDirection(Index, Direction);
+		}
+	}
+
+	// Serves the queued A* searches within the budget of the tick, so many entities needing a new path at once (player turned a corner, door opened...)
+	// are spread over several ticks instead of stalling one
+	// Entities near the player come first, entities which waited long catch up
+	// Every search result depends only on its entity, so the parallel batches give the same paths as searching one after another
+	inline void ProcessPathRequests(lwmf::Multithreading& ThreadPool)
+	{
+		PathRequests.clear();
 
-			if (!Entity.IsDead && Entity.KillAnimEnabled && ++Entity.KillAnimCounter > Entity.KillAnimStepWidth)
+		for (std::int_fast32_t i{}; i < static_cast<std::int_fast32_t>(Entities.size()); ++i)
+		{
+			if (EntityStruct& Entity{ Entities[i] }; Entity.PathRequestedFlag)
 			{
-				if (Entity.KillAnimStep < static_cast<std::int_fast32_t>(EntityAssets[Entity.TypeNumber].KillTextures.size()) - 1)
+				if (EntityStates[i].IsDead || EntityStates[i].KillAnimEnabled)
 				{
-					++Entity.KillAnimStep;
+					Entity.PathRequestedFlag = false;
+					continue;
 				}
-				else
+
+				const float Distance{ std::abs(EntityTransforms[i].Pos.X - Player.Pos.X) + std::abs(EntityTransforms[i].Pos.Y - Player.Pos.Y) };
+				PathRequests.emplace_back(Distance - static_cast<float>(PathFindingTick - Entity.PathFindingTick) * PathRequestAgingFactor, i);
+			}
+		}
+
+		std::sort(PathRequests.begin(), PathRequests.end());
+		PathRequestExpandedNodes.resize(PathRequests.size());
+
+		const auto StartTime{ std::chrono::steady_clock::now() };
+		std::uint_fast32_t ExpandedNodes{};
+		std::size_t DoneRequests{};
+
+		while (DoneRequests < PathRequests.size())
+		{
+			// At least one batch is done per tick, so the queue never gets stuck
+			if (DoneRequests > 0 && ((Game_PathFinding::RequestNodeBudget > 0 && ExpandedNodes >= static_cast<std::uint_fast32_t>(Game_PathFinding::RequestNodeBudget))
+				|| (Game_PathFinding::RequestTimeBudget > 0 && std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - StartTime).count() >= Game_PathFinding::RequestTimeBudget)))
+			{
+				break;
+			}
+
+			const std::size_t BatchEnd{ std::min(DoneRequests + PathRequestBatchSize, PathRequests.size()) };
+
+			// A single search is not worth waking the workers
+			if (BatchEnd - DoneRequests == 1)
+			{
+				const std::int_fast32_t Index{ PathRequests[DoneRequests].second };
+				PathRequestExpandedNodes[DoneRequests] = SearchEntityPath(Index);
+			}
+			else
+			{
+				for (std::size_t i{ DoneRequests }; i < BatchEnd; ++i)
 				{
-					Entity.IsDead = true;
-					// ...and gets cleared from EntityMap, but the pile stays...
-					Entity.MovementBehaviour = 0;
-					EntityMap[static_cast<std::int_fast32_t>(Entity.Pos.X)][static_cast<std::int_fast32_t>(Entity.Pos.Y)] = EntityTypes::Clear;
+					ThreadPool.AddThread([i]
+					{
+						const std::int_fast32_t Index{ PathRequests[i].second };
+						PathRequestExpandedNodes[i] = SearchEntityPath(Index);
+					});
 				}
 
-				Entity.KillAnimCounter = 0;
-				break;
+				ThreadPool.WaitForThreads();
 			}
 
-			if (!Entity.IsDead && !Entity.KillAnimEnabled)
+			// Statistics are gathered on the main thread in request order
+			for (std::size_t i{ DoneRequests }; i < BatchEnd; ++i)
 			{
-				// Run A* pathfinding routine...
-				CalculateEntityPath(Entity);
+				ExpandedNodes += PathRequestExpandedNodes[i];
+				++PathCacheMisses;
+			}
 
-				switch (Entity.MovementBehaviour)
+			DoneRequests = BatchEnd;
+		}
+
+		DeferredPathRequests += PathRequests.size() - DoneRequests;
+	}
+
+	// Frees the search trees nobody needs anymore and the changes to the map all remaining ones caught up with
+	inline void TrimIncrementalSearches()
+	{
+		std::uint_fast32_t OldestVersion{ Game_PathFinding::TopologyVersion };
+
+		for (std::size_t i{}; i < IncrementalSearches.size(); ++i)
+		{
+			if (Game_PathFinding::IncrementalSearchStruct& Search{ IncrementalSearches[i] }; Search.Map != nullptr)
+			{
+				if (Game_PathFinding::Mode != Game_PathFinding::Modes::Incremental || EntityStates[i].IsDead)
 				{
-					case 0:
-					{
-						//
-						// Stationary
-						//
+					Search = {};
+				}
+				else
+				{
+					OldestVersion = std::min(OldestVersion, Search.TopologyVersion);
+				}
+			}
+		}
 
-						// Refresh ammo position on map once another entity moved over this position
-						if (Entity.Type == EntityTypes::AmmoBox && EntityMap[static_cast<std::int_fast32_t>(Entity.Pos.X)][static_cast<std::int_fast32_t>(Entity.Pos.Y)] == EntityTypes::Clear)
-						{
-							MarkEntityPositionOnMap(Entity);
-						}
-						break;
-					}
-					case 2:
+		Game_PathFinding::TrimChangedTiles(OldestVersion);
+	}
+
+	inline std::string GetPathCacheReport()
+	{
+		const std::uint_fast64_t Requests{ PathCacheHits + PathCacheMisses };
+
+		return "Path cache: " + std::to_string(PathCacheHits) + " hits, " + std::to_string(PathCacheMisses) + " misses (hit rate " + std::to_string(Requests > 0 ? PathCacheHits * 100 / Requests : 0) + "%), "
+			+ std::to_string(DeferredPathRequests) + " path requests deferred to a later tick";
+	}
+
+	inline void MoveEntities(lwmf::Multithreading& ThreadPool)
+	{
+		++PathFindingTick;
+		++SimulationTick;
+
+		// One search for all entities - only done if the player entered another tile or a door opened or closed
+		if (Game_PathFinding::Mode == Game_PathFinding::Modes::FlowField)
+		{
+			Game_PathFinding::UpdateFlowField(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, Game_LevelHandling::LevelMapHeight,
+				Game_LevelHandling::LevelMapWidth * static_cast<std::int_fast32_t>(Player.Pos.Y) + static_cast<std::int_fast32_t>(Player.Pos.X), false, Game_PathFinding::PlayerFlowField);
+		}
+
+		const std::int_fast32_t NumberOfEntities{ static_cast<std::int_fast32_t>(Entities.size()) };
+
+		// First phase - every entity only changes its own data and sees the occupancy grid as it was at the start of the tick
+		if (NumberOfEntities <= EntityUpdateBatchSize)
+		{
+			for (std::int_fast32_t Index{}; Index < NumberOfEntities; ++Index)
+			{
+				UpdateEntity(Index);
+			}
+		}
+		else
+		{
+			for (std::int_fast32_t BatchStart{}; BatchStart < NumberOfEntities; BatchStart += EntityUpdateBatchSize)
+			{
+				ThreadPool.AddThread([BatchStart, NumberOfEntities]
+				{
+					const std::int_fast32_t BatchEnd{ std::min(BatchStart + EntityUpdateBatchSize, NumberOfEntities) };
+
+					for (std::int_fast32_t Index{ BatchStart }; Index < BatchEnd; ++Index)
 					{
-						//
-						// Free roaming mode
-						//
+						UpdateEntity(Index);
+					}
+				});
+			}
 
-						const float EntityCollisionDetectionFactor{ Entity.MoveSpeed + EntityCollisionDetectionWallDist };
+			ThreadPool.WaitForThreads();
+		}
 
-						EntityMap[static_cast<std::int_fast32_t>(Entity.Pos.X)][static_cast<std::int_fast32_t>(Entity.Pos.Y)] = EntityTypes::Clear;
+		// Second phase - everything shared is changed on the main thread in entity order
+		for (std::int_fast32_t Index{}; Index < NumberOfEntities; ++Index)
+		{
+			CommitEntity(Index);
+		}
 
-						// Wait by chance
-						// Check if a chance hit occured and if no current timer is running
-						if (Entity.WaitTimer == 0 && Distribution666(RNG) == 99 && Entity.AttackMode == 0)
-						{
-							Entity.WaitTimer = static_cast<std::int_fast32_t>(Distribution200(RNG));
-						}
+		ProcessPathRequests(ThreadPool);
+		TrimIncrementalSearches();
+	}
+
+	inline void UpdateEntity(const std::int_fast32_t Index)
+	{
+		EntityTransformStruct& Transform{ EntityTransforms[Index] };
+		EntityStateStruct& State{ EntityStates[Index] };
+		EntityAnimationStruct& Animation{ EntityAnimations[Index] };
+		EntityIntentStruct& Intent{ EntityIntents[Index] };
+
+		Intent = {};
+		Intent.PreviousPos = Transform.Pos;
+
+		if (State.IsHit && --Animation.HitAnimCounter == 0)
+		{
+			State.IsHit = false;
+		}
 
-						// Switch textures for walking animations
-						if (Entity.WaitTimer > 0)
+		if (!State.IsDead && State.KillAnimEnabled && ++Animation.KillAnimCounter > Animation.KillAnimStepWidth)
+		{
+			if (Animation.KillAnimStep < static_cast<std::int_fast32_t>(EntityAssets[State.TypeNumber].KillTextures.size()) - 1)
+			{
+				++Animation.KillAnimStep;
+			}
+			else
+			{
+				State.IsDead = true;
+				// ...and gets removed from the occupancy grid in CommitEntity(), but the pile stays...
+				State.MovementBehaviour = 0;
+			}
+
+			Animation.KillAnimCounter = 0;
+			return;
+		}
+
+		if (!State.IsDead && !State.KillAnimEnabled)
+		{
+			// Run pathfinding routine...
+			Intent.PathCacheResult = CalculateEntityPath(Index);
+
+			switch (State.MovementBehaviour)
+			{
+				case 0:
+				{
+					//
+					// Stationary
+					//
+
+					break;
+				}
+				case 2:
+				{
+					//
+					// Free roaming mode
+					//
+
+					const float EntityCollisionDetectionFactor{ Transform.MoveSpeed + EntityCollisionDetectionWallDist };
+
+					// Wait by chance
+					// Check if a chance hit occured and if no current timer is running
+					if (Animation.WaitTimer == 0 && GetEntityRandomNumber(Index, RandomStreams::Wait, 666) == 99 && State.AttackMode == 0)
+					{
+						Animation.WaitTimer = static_cast<std::int_fast32_t>(GetEntityRandomNumber(Index, RandomStreams::WaitDuration, 200));
+					}
+
+					// Switch textures for walking animations
+					if (Animation.WaitTimer > 0)
+					{
+						--Animation.WaitTimer;
+						Animation.WalkAnimStep = 0;
+					}
+					else
+					{
+						if (EntityAssets[State.TypeNumber].WalkingTextures[0].size() == 1)
 						{
-							--Entity.WaitTimer;
-							Entity.WalkAnimStep = 0;
+							// Not animated
+							Animation.WalkAnimStep = 0;
 						}
 						else
 						{
-							if (EntityAssets[Entity.TypeNumber].WalkingTextures[0].size() == 1)
-							{
-								// Not animated
-								Entity.WalkAnimStep = 0;
-							}
-							else
+							// animated
+							if (++Animation.WalkAnimCounter > Animation.WalkAnimStepWidth)
 							{
-								// animated
-								if (++Entity.WalkAnimCounter > Entity.WalkAnimStepWidth)
-								{
-									Entity.WalkAnimStep < static_cast<std::int_fast32_t>(EntityAssets[Entity.TypeNumber].WalkingTextures[0].size()) - 1 ? ++Entity.WalkAnimStep : Entity.WalkAnimStep = 0;
-									Entity.WalkAnimCounter = 0;
-								}
+								Animation.WalkAnimStep < static_cast<std::int_fast32_t>(EntityAssets[State.TypeNumber].WalkingTextures[0].size()) - 1 ? ++Animation.WalkAnimStep : Animation.WalkAnimStep = 0;
+								Animation.WalkAnimCounter = 0;
 							}
-
-							// Move forward
-							Entity.Pos.X += Entity.Dir.X * Entity.MoveSpeed;
-							Entity.Pos.Y += Entity.Dir.Y * Entity.MoveSpeed;
 						}
 
-						// Switch textures for attack animations
-						if (Entity.AttackAnimEnabled && ++Entity.AttackAnimCounter > Entity.AttackAnimStepWidth)
+						if (State.AttackMode == 1 && State.Type == EntityTypes::Enemy)
 						{
-							if (Entity.AttackAnimStep < static_cast<std::int_fast32_t>(EntityAssets[Entity.TypeNumber].AttackTextures.size()) - 1)
-							{
-								++Entity.AttackAnimStep;
-							}
-							else
-							{
-								Entity.AttackAnimStep = 0;
-								Entity.AttackAnimEnabled = false;
-								Entity.AttackFinished = true;
-							}
-
-							Entity.AttackAnimCounter = 0;
+							SteerEntity(Index);
 						}
 
-						const std::int_fast32_t EntityPosXTemp{ static_cast<std::int_fast32_t>(Entity.Pos.X + Entity.Dir.X * EntityCollisionDetectionFactor) };
-						const std::int_fast32_t EntityPosYTemp{ static_cast<std::int_fast32_t>(Entity.Pos.Y + Entity.Dir.Y * EntityCollisionDetectionFactor) };
+						// Move forward
+						Transform.Pos.X += Transform.Dir.X * Transform.MoveSpeed;
+						Transform.Pos.Y += Transform.Dir.Y * Transform.MoveSpeed;
+					}
 
-						if (Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][EntityPosXTemp][EntityPosYTemp] != 0)
+					// Switch textures for attack animations
+					if (State.AttackAnimEnabled && ++Animation.AttackAnimCounter > Animation.AttackAnimStepWidth)
+					{
+						if (Animation.AttackAnimStep < static_cast<std::int_fast32_t>(EntityAssets[State.TypeNumber].AttackTextures.size()) - 1)
 						{
-							Entity.Pos.X -= Entity.Dir.X * Entity.MoveSpeed;
-							Entity.Pos.Y -= Entity.Dir.Y * Entity.MoveSpeed;
-
-							// Random choice of new direction (left or right)
-							ChangeEntityDirection(Entity, "lr"[rand() % 2]);
+							++Animation.AttackAnimStep;
 						}
-						// Turn backwards if stepping on another enemy or neutral entity
-						else if (EntityMap[EntityPosXTemp][EntityPosYTemp] == EntityTypes::Enemy
-							|| EntityMap[EntityPosXTemp][EntityPosYTemp] == EntityTypes::Neutral
-							|| EntityMap[EntityPosXTemp][EntityPosYTemp] == EntityTypes::Turret)
+						else
 						{
-							TurnEntityBackwards(Entity);
+							Animation.AttackAnimStep = 0;
+							State.AttackAnimEnabled = false;
+							State.AttackFinished = true;
 						}
-						// What happens if entity meets player?
-						else if (EntityMap[EntityPosXTemp][EntityPosYTemp] == EntityTypes::Player)
+
+						Animation.AttackAnimCounter = 0;
+					}
+
+					const std::int_fast32_t EntityPosXTemp{ static_cast<std::int_fast32_t>(Transform.Pos.X + Transform.Dir.X * EntityCollisionDetectionFactor) };
+					const std::int_fast32_t EntityPosYTemp{ static_cast<std::int_fast32_t>(Transform.Pos.Y + Transform.Dir.Y * EntityCollisionDetectionFactor) };
+
+					if (Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][EntityPosXTemp][EntityPosYTemp] != 0)
+					{
+						Transform.Pos.X -= Transform.Dir.X * Transform.MoveSpeed;
+						Transform.Pos.Y -= Transform.Dir.Y * Transform.MoveSpeed;
+
+						// Random choice of new direction (left or right)
+						ChangeEntityDirection(Index, "lr"[GetEntityRandomNumber(Index, RandomStreams::Turn, 2) - 1]);
+					}
+					// Turn backwards if stepping on another enemy or neutral entity
+					else if (IsOtherEntityOnTile(EntityPosXTemp, EntityPosYTemp, BlockingTypeMask, Index))
+					{
+						TurnEntityBackwards(Index);
+					}
+					// What happens if entity meets player?
+					else if (IsTileOccupied(EntityPosXTemp, EntityPosYTemp, GetTypeMask(EntityTypes::Player)))
+					{
+						// Deal damage to player
+						if (State.Type == EntityTypes::Enemy)
 						{
-							// Deal damage to player
-							if (Entity.Type == EntityTypes::Enemy)
-							{
-								Entity.Pos.X -= Entity.Dir.X * Entity.MoveSpeed;
-								Entity.Pos.Y -= Entity.Dir.Y * Entity.MoveSpeed;
-
-								if (--Entity.DamageHitrateCounter <= 0)
-								{
-									PlayAudio(Entity.TypeNumber, EntitySounds::Attack);
-									Entity.DamageHitrateCounter = Entity.DamageHitrate * static_cast<std::int_fast32_t>(FrameLock);
-									Entity.AttackAnimEnabled = true;
-
-									// Once it attacked, entity is in "rage" mode, so it will attack without a pause...
-									Entity.AttackMode = 1;
-								}
-							}
-							else if (Entity.Type == EntityTypes::Neutral)
+							Transform.Pos.X -= Transform.Dir.X * Transform.MoveSpeed;
+							Transform.Pos.Y -= Transform.Dir.Y * Transform.MoveSpeed;
+
+							if (--Entities[Index].DamageHitrateCounter <= 0)
 							{
-								TurnEntityBackwards(Entity);
+								Intent.AttackSoundFlag = true;
+								Entities[Index].DamageHitrateCounter = Entities[Index].DamageHitrate * static_cast<std::int_fast32_t>(FrameLock);
+								State.AttackAnimEnabled = true;
+
+								// Once it attacked, entity is in "rage" mode, so it will attack without a pause...
+								State.AttackMode = 1;
 							}
 						}
-
-						if (Entity.AttackFinished)
+						else if (State.Type == EntityTypes::Neutral)
 						{
-							Player.HurtPlayer(Entity.DamagePoints);
-							Entity.AttackFinished = false;
+							TurnEntityBackwards(Index);
 						}
+					}
 
-						MarkEntityPositionOnMap(Entity);
-						break;
+					if (State.AttackFinished)
+					{
+						Intent.DamagePoints = Entities[Index].DamagePoints;
+						Intent.HurtPlayerFlag = true;
+						State.AttackFinished = false;
 					}
 
-					default:{}
+					break;
 				}
+
+				default:{}
 			}
 		}
 	}
 
-	inline void GetEntityDistance()
+	inline void CommitEntity(const std::int_fast32_t Index)
 	{
-		const std::int_fast32_t NumberOfEntities{ static_cast<std::int_fast32_t>(Entities.size()) };
+		const EntityIntentStruct& Intent{ EntityIntents[Index] };
+		EntityTransformStruct& Transform{ EntityTransforms[Index] };
 
-		for (std::int_fast32_t Index{}; Index < NumberOfEntities; ++Index)
+		switch (Intent.PathCacheResult)
+		{
+			case PathCacheResults::Hit:
+			{
+				++PathCacheHits;
+				break;
+			}
+			case PathCacheResults::Miss:
+			{
+				++PathCacheMisses;
+				break;
+			}
+			default: {}
+		}
+
+		if (EntityStates[Index].IsDead)
+		{
+			UnlinkEntityFromTile(Index);
+			return;
+		}
+
+		// Entities which entered the same tile in this tick - the first one committed keeps it, the others step back and turn around
+		// Entities not committed yet are still linked to their previous tile, so the position they moved to is checked
+		if (const std::int_fast32_t Tile{ GetTile(static_cast<std::int_fast32_t>(Transform.Pos.X), static_cast<std::int_fast32_t>(Transform.Pos.Y)) }; Tile != EntityTiles[Index])
+		{
+			for (std::int_fast32_t Other{ TileFirstEntities[Tile] }; Other != -1; Other = EntityNextOnTile[Other])
+			{
+				if ((GetTypeMask(EntityStates[Other].Type) & BlockingTypeMask) != 0
+					&& GetTile(static_cast<std::int_fast32_t>(EntityTransforms[Other].Pos.X), static_cast<std::int_fast32_t>(EntityTransforms[Other].Pos.Y)) == Tile)
+				{
+					Transform.Pos = Intent.PreviousPos;
+					TurnEntityBackwards(Index);
+					break;
+				}
+			}
+		}
+
+		UpdateEntityTile(Index);
+
+		if (Intent.AttackSoundFlag)
+		{
+			PlayAudio(EntityStates[Index].TypeNumber, EntitySounds::Attack);
+		}
+
+		if (Intent.HurtPlayerFlag)
 		{
-			EntityOrder[Index] = { Index, lwmf::CalcEuclidianDistance<float>(Player.Pos.X, Entities[Index].Pos.X, Player.Pos.Y, Entities[Index].Pos.Y) };
+			Player.HurtPlayer(Intent.DamagePoints);
 		}
 	}
 
-	inline void SortEntities(const SortOrder SortOrder)
+	inline std::uint_fast32_t GetEntityRandomNumber(const std::int_fast32_t Index, const RandomStreams Stream, const std::uint_fast32_t Range)
+	{
+		// SplitMix64 finalizer
+		const auto Mix{ [](std::uint64_t Value)
+		{
+			Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBULL;
+			return Value ^ (Value >> 31);
+		} };
+
+		const std::uint64_t Value{ Mix(Mix(Mix(EntityRandomSeed ^ static_cast<std::uint64_t>(Index)) ^ SimulationTick) ^ static_cast<std::uint64_t>(Stream)) };
+
+		// Maps the upper 32 bits to 1...Range without a division
+		return 1 + static_cast<std::uint_fast32_t>(((Value >> 32) * Range) >> 32);
+	}
+
+	inline void UpdateEntityOrder()
 	{
-		switch (SortOrder)
+		const float InverseMatrix{ 1.0F / (Plane.X * Player.Dir.Y - Player.Dir.X * Plane.Y) };
+
+		// Entities which are picked up, behind the camera or left or right of the screen get a negative distance (same projection as in RenderEntities())
+		for (auto&& [Index, Distance] : EntityOrder)
 		{
-			case SortOrder::FrontToBack:
+			const lwmf::FloatPointStruct EntityPos{ EntityTransforms[Index].Pos.X - Player.Pos.X, EntityTransforms[Index].Pos.Y - Player.Pos.Y };
+			const float TransY{ InverseMatrix * (-Plane.Y * EntityPos.X + Plane.X * EntityPos.Y) };
+
+			Distance = -1.0F;
+
+			if (!EntityStates[Index].IsPickedUp && TransY > 0.0F)
 			{
-				std::sort(EntityOrder.begin(), EntityOrder.end(), [](auto& Left, auto& Right) {	return Left.second < Right.second; });
-				break;
+				const std::int_fast32_t EntitySizeTemp{ static_cast<std::int_fast32_t>(Canvas.Height / TransY) };
+				const std::int_fast32_t EntitySX{ static_cast<std::int_fast32_t>(Canvas.WidthMid * (1.0F + InverseMatrix * (Player.Dir.Y * EntityPos.X - Player.Dir.X * EntityPos.Y) / TransY)) };
+
+				if ((EntitySizeTemp >> 1) + EntitySX > 0 && (-EntitySizeTemp >> 1) + EntitySX < Canvas.Width)
+				{
+					Distance = EntityPos.X * EntityPos.X + EntityPos.Y * EntityPos.Y;
+				}
 			}
-			case SortOrder::BackToFront:
+		}
+
+		// Visible entities are moved to the front without changing their order, so they are still nearly sorted from the last frame
+		EntityOrderBuffer.clear();
+
+		for (const auto& Entry : EntityOrder)
+		{
+			if (Entry.second >= 0.0F)
 			{
-				std::sort(EntityOrder.begin(), EntityOrder.end(), [](auto& Left, auto& Right) {	return Left.second > Right.second; });
-				break;
+				EntityOrderBuffer.emplace_back(Entry);
 			}
-			default: {}
+		}
+
+		NumberOfVisibleEntities = static_cast<std::int_fast32_t>(EntityOrderBuffer.size());
+
+		for (const auto& Entry : EntityOrder)
+		{
+			if (Entry.second < 0.0F)
+			{
+				EntityOrderBuffer.emplace_back(Entry);
+			}
+		}
+
+		EntityOrder.swap(EntityOrderBuffer);
+
+		if (NumberOfVisibleEntities > EntityOrderRadixSortThreshold)
+		{
+			RadixSortEntityOrder();
+			return;
+		}
+
+		// Insertion sort - only a few entities change places from one frame to the next
+		for (std::int_fast32_t i{ 1 }; i < NumberOfVisibleEntities; ++i)
+		{
+			const std::pair<std::int_fast32_t, float> Entry{ EntityOrder[i] };
+			std::int_fast32_t j{ i };
+
+			for (; j > 0 && EntityOrder[j - 1].second > Entry.second; --j)
+			{
+				EntityOrder[j] = EntityOrder[j - 1];
+			}
+
+			EntityOrder[j] = Entry;
+		}
+	}
+
+	// LSD radix sort of the visible entities, four passes of 8 bits
+	// Distances are never negative, so their bit patterns sort the same as the floats
+	// The number of passes is even, so the sorted entities (and the hidden ones behind them) end up in EntityOrder again
+	inline void RadixSortEntityOrder()
+	{
+		for (std::uint_fast32_t Shift{}; Shift < 32; Shift += 8)
+		{
+			std::array<std::int_fast32_t, 257> Offsets{};
+
+			for (std::int_fast32_t i{}; i < NumberOfVisibleEntities; ++i)
+			{
+				++Offsets[((std::bit_cast<std::uint32_t>(EntityOrder[i].second) >> Shift) & 0xFF) + 1];
+			}
+
+			for (std::size_t i{ 1 }; i < Offsets.size(); ++i)
+			{
+				Offsets[i] += Offsets[i - 1];
+			}
+
+			for (std::int_fast32_t i{}; i < NumberOfVisibleEntities; ++i)
+			{
+				EntityOrderBuffer[Offsets[(std::bit_cast<std::uint32_t>(EntityOrder[i].second) >> Shift) & 0xFF]++] = EntityOrder[i];
+			}
+
+			EntityOrder.swap(EntityOrderBuffer);
 		}
 	}
 
-	inline void MarkEntityPositionOnMap(const EntityStruct& Entity)
+	inline constexpr std::uint_fast32_t GetTypeMask(const EntityTypes Type)
 	{
-		EntityMap[static_cast<std::int_fast32_t>(Entity.Pos.X)][static_cast<std::int_fast32_t>(Entity.Pos.Y)] = Entity.Type;
+		return 1U << static_cast<std::uint_fast32_t>(Type);
+	}
+
+	inline std::int_fast32_t GetTile(const std::int_fast32_t X, const std::int_fast32_t Y)
+	{
+		return Game_LevelHandling::LevelMapWidth * Y + X;
+	}
+
+	// Walks the (usually very short) list of the tile - needed if an entity left the tile or changed its type
+	inline void UpdateTileTypeMask(const std::int_fast32_t Tile)
+	{
+		std::uint_fast32_t TypeMask{ Tile == PlayerTile ? GetTypeMask(EntityTypes::Player) : 0 };
+
+		for (std::int_fast32_t Index{ TileFirstEntities[Tile] }; Index != -1; Index = EntityNextOnTile[Index])
+		{
+			TypeMask |= GetTypeMask(EntityStates[Index].Type);
+		}
+
+		TileTypeMasks[Tile] = TypeMask;
+	}
+
+	inline void LinkEntityToTile(const std::int_fast32_t Index)
+	{
+		const std::int_fast32_t Tile{ GetTile(static_cast<std::int_fast32_t>(EntityTransforms[Index].Pos.X), static_cast<std::int_fast32_t>(EntityTransforms[Index].Pos.Y)) };
+
+		EntityTiles[Index] = Tile;
+		EntityNextOnTile[Index] = TileFirstEntities[Tile];
+		TileFirstEntities[Tile] = Index;
+		TileTypeMasks[Tile] |= GetTypeMask(EntityStates[Index].Type);
+	}
+
+	inline void UnlinkEntityFromTile(const std::int_fast32_t Index)
+	{
+		const std::int_fast32_t Tile{ EntityTiles[Index] };
+
+		if (Tile == -1)
+		{
+			return;
+		}
+
+		std::int_fast32_t* Link{ &TileFirstEntities[Tile] };
+
+		while (*Link != Index)
+		{
+			Link = &EntityNextOnTile[*Link];
+		}
+
+		*Link = EntityNextOnTile[Index];
+		EntityNextOnTile[Index] = -1;
+		EntityTiles[Index] = -1;
+		UpdateTileTypeMask(Tile);
+	}
+
+	inline void UpdateEntityTile(const std::int_fast32_t Index)
+	{
+		if (EntityTiles[Index] == GetTile(static_cast<std::int_fast32_t>(EntityTransforms[Index].Pos.X), static_cast<std::int_fast32_t>(EntityTransforms[Index].Pos.Y)))
+		{
+			return;
+		}
+
+		UnlinkEntityFromTile(Index);
+		LinkEntityToTile(Index);
+	}
+
+	inline void SetPlayerTile(const std::int_fast32_t X, const std::int_fast32_t Y)
+	{
+		const std::int_fast32_t Tile{ GetTile(X, Y) };
+
+		if (Tile == PlayerTile)
+		{
+			return;
+		}
+
+		if (PlayerTile != -1)
+		{
+			TileTypeMasks[PlayerTile] &= ~GetTypeMask(EntityTypes::Player);
+		}
+
+		PlayerTile = Tile;
+		TileTypeMasks[Tile] |= GetTypeMask(EntityTypes::Player);
+	}
+
+	inline bool IsTileOccupied(const std::int_fast32_t X, const std::int_fast32_t Y, const std::uint_fast32_t TypeMask)
+	{
+		return (TileTypeMasks[GetTile(X, Y)] & TypeMask) != 0;
+	}
+
+	// Same as IsTileOccupied(), but the entity itself does not count
+	inline bool IsOtherEntityOnTile(const std::int_fast32_t X, const std::int_fast32_t Y, const std::uint_fast32_t TypeMask, const std::int_fast32_t Index)
+	{
+		const std::int_fast32_t Tile{ GetTile(X, Y) };
+
+		if ((TileTypeMasks[Tile] & TypeMask) == 0)
+		{
+			return false;
+		}
+
+		for (std::int_fast32_t Other{ TileFirstEntities[Tile] }; Other != -1; Other = EntityNextOnTile[Other])
+		{
+			if (Other != Index && (GetTypeMask(EntityStates[Other].Type) & TypeMask) != 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
 	}
 
 	inline void PlayAudio(const std::int_fast32_t TypeNumber, const EntitySounds EntitySound)
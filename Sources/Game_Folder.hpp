@@ -14,8 +14,12 @@
 inline const std::string LevelFolder{ "./DATA/Levels/" };
 inline const std::string GameConfigFolder{ "./DATA/GameConfig/" };
 
+// Pre-decoded assets of a level, built by NARCPacker (see "_BuildPacks.cmd")
+inline const std::string LevelPackFileName{ "Level.narcpak" };
+
 inline const std::string AssetsEntitiesFolder{ "./DATA/Assets_Entities/" };
 inline const std::string AssetsDoorsFolder{ "./DATA/Assets_Doors/" };
 inline const std::string AssetsWeaponsFolder{ "./DATA/Assets_Weapons/" };
 
+inline const std::string GFXFolder{ "./GFX/" };
 inline const std::string GFXEntitiesFolder{ "./GFX/Entities/" };
\ No newline at end of file
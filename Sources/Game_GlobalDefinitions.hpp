@@ -33,6 +33,13 @@ inline std::int_fast32_t NumberOfLevels{};
 inline bool VSync{};
 inline bool Fullscreen{};
 
+// Options from command line (see Game_Config::ParseCommandLine())
+inline bool ExitAfterLoadFlag{};
+inline bool CheckSIMDFlag{};
+inline bool BenchPNGFlag{};
+inline bool BenchPathFlag{};
+inline lwmf::TimelineFormat LoadTimelineFormat{ lwmf::TimelineFormat::Text };
+
 // Size of textures (width and height)
 inline std::int_fast32_t TextureSize{};
 inline std::int_fast32_t EntitySize{};
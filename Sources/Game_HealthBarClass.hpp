@@ -31,10 +31,10 @@ private:
 	std::int_fast32_t HealthBarWidth{};
 	std::int_fast32_t HealthBarFactor{};
 
-	std::int_fast32_t Green{};
-	std::int_fast32_t Red{};
-	std::int_fast32_t Orange{};
-	std::int_fast32_t Black{};
+	lwmf::PixelType Green{};
+	lwmf::PixelType Red{};
+	lwmf::PixelType Orange{};
+	lwmf::PixelType Black{};
 };
 
 inline void Game_HealthBarClass::Init()
@@ -0,0 +1,185 @@
+/*
+*****************************************
+*                                       *
+* Game_LevelAssets.hpp                  *
+*                                       *
+* (c) 2017 - 2020 Stefan Kubsch         *
+*****************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "Game_Folder.hpp"
+#include "Tools_ErrorHandling.hpp"
+#include "Game_AssetIndex.hpp"
+
+namespace Game_LevelAssets
+{
+
+
+	// Enumerates the files a level needs without loading anything
+	// Used by the level streaming (prefetch of the next level) and by NARCPacker
+	//
+	// All paths are stored exactly the way the game requests them, since they are the keys of the pack index and of the texture cache
+	// The searches have to be kept in sync with Game_LevelHandling, Game_SkyboxHandling, Game_EntityHandling, Game_Doors and Game_WeaponHandling!
+
+	struct LevelAssetsStruct final
+	{
+		std::vector<std::string> Images{};
+		std::vector<std::string> MapDataFiles{};
+	};
+
+	void AddImage(LevelAssetsStruct& Assets, const std::string& FileName);
+	void AddImageList(LevelAssetsStruct& Assets, const std::string& ListFileName, const std::string& Prefix);
+	std::vector<std::string> GetMapDataFiles(std::int_fast32_t Level);
+	void GatherLevelAssets(LevelAssetsStruct& Assets, std::int_fast32_t Level, std::int_fast32_t TextureSize, std::int_fast32_t EntitySize);
+	void GatherEntityAssets(LevelAssetsStruct& Assets, std::int_fast32_t Level, std::int_fast32_t EntitySize);
+	void GatherEntityAnimation(LevelAssetsStruct& Assets, const std::string& Path);
+	void GatherDoorAssets(LevelAssetsStruct& Assets);
+	void GatherWeaponAssets(LevelAssetsStruct& Assets);
+
+	//
+	// Functions
+	//
+
+	inline void AddImage(LevelAssetsStruct& Assets, const std::string& FileName)
+	{
+		for (const auto& Image : Assets.Images)
+		{
+			if (Image == FileName)
+			{
+				return;
+			}
+		}
+
+		Assets.Images.emplace_back(FileName);
+	}
+
+	inline void AddImageList(LevelAssetsStruct& Assets, const std::string& ListFileName, const std::string& Prefix)
+	{
+		if (Tools_ErrorHandling::CheckFileExistence(ListFileName, StopOnError))
+		{
+			std::ifstream ListFile(ListFileName, std::ios::in);
+			std::string Line;
+
+			while (std::getline(ListFile, Line))
+			{
+				AddImage(Assets, Prefix + Line);
+			}
+		}
+	}
+
+	inline std::vector<std::string> GetMapDataFiles(const std::int_fast32_t Level)
+	{
+		std::string LevelPath{ LevelFolder };
+		LevelPath += std::to_string(Level);
+		LevelPath += "/LevelData/";
+
+		// Order of Game_LevelHandling::LevelMapLayers
+		return { LevelPath + "MapFloorData.conf", LevelPath + "MapWallData.conf", LevelPath + "MapCeilingData.conf", LevelPath + "MapDoorData.conf" };
+	}
+
+	// Everything which is loaded on a level switch - door and weapon assets are loaded only once at startup
+	inline void GatherLevelAssets(LevelAssetsStruct& Assets, const std::int_fast32_t Level, const std::int_fast32_t TextureSize, const std::int_fast32_t EntitySize)
+	{
+		std::string LevelPath{ LevelFolder };
+		LevelPath += std::to_string(Level);
+		LevelPath += "/LevelData/";
+
+		Assets.MapDataFiles = GetMapDataFiles(Level);
+
+		// Same as in Game_LevelHandling::InitTextures()
+		AddImageList(Assets, LevelPath + "TexturesData.conf", "./GFX/LevelTextures/" + std::to_string(TextureSize) + "/");
+
+		// Same as in Game_SkyboxHandling::LoadSkyboxImage()
+		if (const std::string INIFile{ LevelPath + "SkyboxConfig.ini" }; Tools_ErrorHandling::CheckFileExistence(INIFile, StopOnError) && lwmf::ReadINIValue<bool>(INIFile, "SKYBOX", "SkyBoxEnabled"))
+		{
+			AddImage(Assets, lwmf::ReadINIValue<std::string>(INIFile, "SKYBOX", "SkyBoxImageName"));
+		}
+
+		GatherEntityAssets(Assets, Level, EntitySize);
+	}
+
+	inline void GatherEntityAssets(LevelAssetsStruct& Assets, const std::int_fast32_t Level, const std::int_fast32_t EntitySize)
+	{
+		// Same search as in Game_EntityHandling::InitEntityAssets()
+		std::vector<std::string> AssetTypeNames{};
+
+		std::string EntityDataFolder{ LevelFolder };
+		EntityDataFolder += std::to_string(Level);
+		EntityDataFolder += "/EntityData/";
+
+		const std::int_fast32_t NumberOfEntityDataFiles{ Game_AssetIndex::CountNumberedFiles(EntityDataFolder, "", ".ini", 0) };
+
+		for (std::int_fast32_t AssetFileIndex{}; AssetFileIndex < NumberOfEntityDataFiles; ++AssetFileIndex)
+		{
+			const std::string AssetTypeName{ lwmf::ReadINIValue<std::string>(EntityDataFolder + std::to_string(AssetFileIndex) + ".ini", "ENTITY", "EntityTypeName") };
+			bool SkipAssetFlag{};
+
+			for (const auto& Name : AssetTypeNames)
+			{
+				if (Name == AssetTypeName)
+				{
+					SkipAssetFlag = true;
+					break;
+				}
+			}
+
+			if (!SkipAssetFlag)
+			{
+				AssetTypeNames.emplace_back(AssetTypeName);
+
+				const std::string Path{ GFXEntitiesFolder + std::to_string(EntitySize) + "/" + AssetTypeName + "/" };
+				const std::int_fast32_t NumberOfDirections{ Game_AssetIndex::CountNumberedFolders(Path, 0) };
+
+				for (std::int_fast32_t DirectionIndex{}; DirectionIndex < NumberOfDirections; ++DirectionIndex)
+				{
+					GatherEntityAnimation(Assets, Path + std::to_string(DirectionIndex));
+				}
+
+				GatherEntityAnimation(Assets, Path + "Attack");
+				GatherEntityAnimation(Assets, Path + "Kill");
+			}
+		}
+	}
+
+	inline void GatherEntityAnimation(LevelAssetsStruct& Assets, const std::string& Path)
+	{
+		const std::int_fast32_t NumberOfTextures{ Game_AssetIndex::CountNumberedFiles(Path, "", ".png", 0) };
+
+		for (std::int_fast32_t TextureIndex{}; TextureIndex < NumberOfTextures; ++TextureIndex)
+		{
+			AddImage(Assets, Path + "/" + std::to_string(TextureIndex) + ".png");
+		}
+	}
+
+	inline void GatherDoorAssets(LevelAssetsStruct& Assets)
+	{
+		// Same search as in Game_Doors::InitDoorAssets()
+		const std::int_fast32_t NumberOfDoorTypes{ Game_AssetIndex::CountNumberedFiles(AssetsDoorsFolder, "Door_", "_Data.ini", 1) };
+
+		for (std::int_fast32_t Index{ 1 }; Index <= NumberOfDoorTypes; ++Index)
+		{
+			AddImage(Assets, lwmf::ReadINIValue<std::string>(AssetsDoorsFolder + "Door_" + std::to_string(Index) + "_Data.ini", "TEXTURE", "DoorTexture"));
+		}
+	}
+
+	inline void GatherWeaponAssets(LevelAssetsStruct& Assets)
+	{
+		// Same search as in Game_WeaponHandling::InitConfig() / InitTextures()
+		const std::int_fast32_t NumberOfWeapons{ Game_AssetIndex::CountNumberedFiles(AssetsWeaponsFolder, "Weapon_", "_Data.ini", 0) };
+
+		for (std::int_fast32_t Index{}; Index < NumberOfWeapons; ++Index)
+		{
+			AddImageList(Assets, AssetsWeaponsFolder + "Weapon_" + std::to_string(Index) + "_TexturesData.conf", "");
+			AddImageList(Assets, AssetsWeaponsFolder + "Weapon_" + std::to_string(Index) + "_MuzzleFlashTexturesData.conf", "");
+		}
+	}
+
+
+} // namespace Game_LevelAssets
\ No newline at end of file
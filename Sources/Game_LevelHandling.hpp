@@ -13,12 +13,15 @@
 #include <string>
 #include <vector>
 #include <fstream>
-#include <sstream>
+#include <utility>
+#include <string_view>
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_ErrorHandling.hpp"
 #include "GFX_ImageHandling.hpp"
 #include "GFX_LightingClass.hpp"
+#include "Game_LevelAssets.hpp"
+#include "Game_MapData.hpp"
 
 namespace Game_LevelHandling
 {
@@ -33,11 +36,13 @@ namespace Game_LevelHandling
 		Counter
 	};
 
+	void OpenLevelPack();
 	void InitConfig();
-	void ReadMapDataFile(const std::string& FileName, std::vector<std::vector<std::vector<std::int_fast32_t>>>& LevelMapVector, LevelMapLayers LevelMapLayer);
-	void InitMapData();
+	void ReadMapDataFile(const std::string& FileName, const lwmf::PackFile& Pack, std::vector<Game_MapData::MapLayerStruct>& LevelMapVector, LevelMapLayers LevelMapLayer);
+	void LoadMapData(std::int_fast32_t Level, const lwmf::PackFile& Pack, std::vector<Game_MapData::MapLayerStruct>& LevelMapVector);
+	void InitMapData(std::vector<Game_MapData::MapLayerStruct>&& StagedLevelMap);
 	void InitLights();
-	void InitTextures();
+	void InitTextures(GFX_ImageHandling::ImageBatchStruct& ImageBatch);
 	void InitBackgroundMusic();
 	void PlayBackgroundMusic(std::int_fast32_t Tracknumber);
 	void PauseBackgroundMusic(std::int_fast32_t Tracknumber);
@@ -48,13 +53,16 @@ namespace Game_LevelHandling
 	// Variables and constants
 	//
 
-	inline std::vector<std::vector<std::vector<std::int_fast32_t>>> LevelMap{};
-	inline std::vector<lwmf::TextureStruct> LevelTextures{};
+	inline std::vector<Game_MapData::MapLayerStruct> LevelMap{};
+	inline std::vector<lwmf::TextureHandle> LevelTextures{};
+
+	// Memory-mapped asset pack of the selected level - if there is none, all assets are loaded from their single files
+	inline lwmf::PackFile LevelPack{};
 
 	inline std::vector<GFX_LightingClass> StaticLights{};
 	inline std::vector<lwmf::MP3Player> BackgroundMusic;
 
-	// Variables used for map dimensions (used for Level*Map and EntityMap)
+	// Variables used for map dimensions (used for Level*Map and the occupancy grid in Game_EntityHandling)
 	inline std::int_fast32_t LevelMapWidth{};
 	inline std::int_fast32_t LevelMapHeight{};
 
@@ -65,6 +73,19 @@ namespace Game_LevelHandling
 	// Functions
 	//
 
+	inline void OpenLevelPack()
+	{
+		std::string PackFile{ LevelFolder };
+		PackFile += std::to_string(SelectedLevel);
+		PackFile += "/";
+		PackFile += LevelPackFileName;
+
+		if (LevelPack.Open(PackFile))
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Use asset pack " + PackFile + "...");
+		}
+	}
+
 	inline void InitConfig()
 	{
 		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Init level config...");
@@ -79,62 +100,52 @@ namespace Game_LevelHandling
 		}
 	}
 
-	inline void ReadMapDataFile(const std::string& FileName, std::vector<std::vector<std::vector<std::int_fast32_t>>>& LevelMapVector, const LevelMapLayers LevelMapLayer)
+	inline void ReadMapDataFile(const std::string& FileName, const lwmf::PackFile& Pack, std::vector<Game_MapData::MapLayerStruct>& LevelMapVector, const LevelMapLayers LevelMapLayer)
 	{
-		if (Tools_ErrorHandling::CheckFileExistence(FileName, StopOnError))
-		{
-			std::ifstream LevelMapDataFile(FileName, std::ios::in);
+		Game_MapData::MapLayerStruct& Layer{ LevelMapVector[static_cast<std::int_fast32_t>(LevelMapLayer)] };
 
-			std::vector<std::int_fast32_t> TempVectorCeiling{};
-			std::string Line;
+		// Map data in an asset pack is stored in the binary format - packs built before that format existed fall back to the files
+		if (std::string_view Blob; Pack.IsOpen() && Pack.GetBlob(FileName, Blob) && Game_MapData::IsBinaryMapLayer(Blob))
+		{
+			Game_MapData::ParseMapLayerBinary(Blob, Layer);
+		}
+		else
+		{
+			Game_MapData::ReadMapLayerFile(FileName, Layer);
+		}
 
-			while (std::getline(LevelMapDataFile, Line))
-			{
-				std::istringstream Stream(Line);
-				std::vector<std::int_fast32_t> TempVector{};
-				std::int_fast32_t TempInt{};
-				char Delimiter{ '\0' };
+		// double the last line for ceiling only to prevent a bad behaviour concerning lighting...
+		if (LevelMapLayer == LevelMapLayers::Ceiling && Layer.Width > 0)
+		{
+			Layer.Tiles.insert(Layer.Tiles.end(), Layer.Tiles.end() - Layer.Height, Layer.Tiles.end());
+			++Layer.Width;
+		}
+	}
 
-				while (Stream >> TempInt)
-				{
-					TempVector.emplace_back(TempInt);
-					Stream >> Delimiter;
-				}
+	// Does not touch the current level, so the next level can be loaded in the background (see Game_LevelStreaming)
+	inline void LoadMapData(const std::int_fast32_t Level, const lwmf::PackFile& Pack, std::vector<Game_MapData::MapLayerStruct>& LevelMapVector)
+	{
+		LevelMapVector.clear();
+		LevelMapVector.resize(static_cast<std::int_fast32_t>(LevelMapLayers::Counter));
 
-				LevelMapVector[static_cast<std::int_fast32_t>(LevelMapLayer)].emplace_back(TempVector);
-				TempVectorCeiling = std::move(TempVector);
-			}
+		const std::vector<std::string> MapDataFiles{ Game_LevelAssets::GetMapDataFiles(Level) };
 
-			// double the last line for ceiling only to prevent a bad behaviour concerning lighting...
-			if (LevelMapLayer == LevelMapLayers::Ceiling)
-			{
-				LevelMapVector[static_cast<std::int_fast32_t>(LevelMapLayer)].emplace_back(TempVectorCeiling);
-			}
+		for (std::int_fast32_t Layer{}; Layer < static_cast<std::int_fast32_t>(LevelMapLayers::Counter); ++Layer)
+		{
+			ReadMapDataFile(MapDataFiles[Layer], Pack, LevelMapVector, static_cast<LevelMapLayers>(Layer));
 		}
 	}
 
-	inline void InitMapData()
+	inline void InitMapData(std::vector<Game_MapData::MapLayerStruct>&& StagedLevelMap)
 	{
 		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Init map data...");
 
-		LevelMap.clear();
-		LevelMap.shrink_to_fit();
-		LevelMap.resize(static_cast<std::int_fast32_t>(LevelMapLayers::Counter));
-
-		std::string LevelPath{ LevelFolder };
-		LevelPath += std::to_string(SelectedLevel);
-		LevelPath += "/LevelData/";
-
-		ReadMapDataFile(LevelPath + "MapFloorData.conf", LevelMap, LevelMapLayers::Floor);
-		ReadMapDataFile(LevelPath + "MapWallData.conf", LevelMap, LevelMapLayers::Wall);
-		ReadMapDataFile(LevelPath + "MapCeilingData.conf", LevelMap, LevelMapLayers::Ceiling);
-		ReadMapDataFile(LevelPath + "MapDoorData.conf", LevelMap, LevelMapLayers::Door);
+		LevelMap = std::move(StagedLevelMap);
 
-		LevelMapWidth = static_cast<std::int_fast32_t>(LevelMap[static_cast<std::int_fast32_t>(LevelMapLayers::Wall)].size());
-		LevelMapHeight = static_cast<std::int_fast32_t>(LevelMap[static_cast<std::int_fast32_t>(LevelMapLayers::Wall)][0].size());
+		LevelMapWidth = LevelMap[static_cast<std::int_fast32_t>(LevelMapLayers::Wall)].Width;
+		LevelMapHeight = LevelMap[static_cast<std::int_fast32_t>(LevelMapLayers::Wall)].Height;
 	}
 
-
 	inline void InitLights()
 	{
 		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Init lights...");
@@ -165,7 +176,7 @@ namespace Game_LevelHandling
 		}
 	}
 
-	inline void InitTextures()
+	inline void InitTextures(GFX_ImageHandling::ImageBatchStruct& ImageBatch)
 	{
 		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load level textures...");
 
@@ -184,7 +195,12 @@ namespace Game_LevelHandling
 
 			while (std::getline(LevelTexturesDataFile, Line))
 			{
-				LevelTextures.emplace_back(GFX_ImageHandling::ImportTexture("./GFX/LevelTextures/" + std::to_string(TextureSize) + "/" + Line, TextureSize));
+				LevelTextures.emplace_back();
+
+				GFX_ImageHandling::RequestTextureHandle(ImageBatch, "./GFX/LevelTextures/" + std::to_string(TextureSize) + "/" + Line, TextureSize, [Index{ LevelTextures.size() - 1 }](const lwmf::TextureHandle& Texture)
+				{
+					LevelTextures[Index] = Texture;
+				});
 			}
 		}
 	}
@@ -0,0 +1,245 @@
+/*
+*****************************************
+*                                       *
+* Game_LevelStreaming.hpp               *
+*                                       *
+* (c) 2017 - 2020 Stefan Kubsch         *
+*****************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+
+#include "Game_GlobalDefinitions.hpp"
+#include "Game_Folder.hpp"
+#include "GFX_ImageHandling.hpp"
+#include "Game_LevelAssets.hpp"
+#include "Game_LevelHandling.hpp"
+
+namespace Game_LevelStreaming
+{
+
+
+	// Loads a level into a staging area without touching the level which is currently played
+	//
+	// StageLevel() starts a background thread which parses the map data and decodes all images of the level (level textures, skybox, entities)
+	// into the texture cache - the staging area holds handles to them until the level is swapped in
+	//
+	// CompleteStaging() is called at a frame boundary when the level shall be switched - it waits for whatever is left to do
+	// (the threadpool helps out) and reports the progress. Afterwards InitAndLoadLevel() only commits the staged data, the image batch
+	// takes the prefetched images without decoding anything, so mainly the GPU uploads are left for the main thread
+	//
+	// After every switch the next level is prefetched while the current level is played
+
+	struct StagedLevelStruct final
+	{
+		std::int_fast32_t Level{};
+		lwmf::PackFile Pack{};
+		Game_LevelAssets::LevelAssetsStruct Assets{};
+		std::vector<lwmf::TextureHandle> Textures{};
+		std::vector<std::exception_ptr> Exceptions{};
+		std::vector<Game_MapData::MapLayerStruct> LevelMap{};
+		GFX_ImageHandling::PrefetchedImages Images{};
+		std::exception_ptr Exception{};
+	};
+
+	void StageLevel(std::int_fast32_t Level);
+	void StageImages();
+	float GetProgress();
+	void CompleteStaging(std::int_fast32_t Level, lwmf::Multithreading& ThreadPool, const std::function<void(float)>& ShowProgress);
+	void ReleaseStagedLevel();
+	void Cancel();
+	std::int_fast32_t GetNextLevel();
+
+	//
+	// Variables and constants
+	//
+
+	// Written by the staging thread (and the helping threadpool) until CompleteStaging() has joined them, afterwards by the main thread only
+	inline StagedLevelStruct StagedLevel{};
+	inline std::thread StagingThread{};
+
+	inline std::atomic<std::size_t> NumberOfImages{};
+	inline std::atomic<std::size_t> NextImage{};
+	inline std::atomic<std::size_t> LoadedImages{};
+	inline std::atomic<bool> AssetsGatheredFlag{};
+	inline std::atomic<bool> StagingThreadFinishedFlag{};
+	inline std::atomic<bool> CancelFlag{};
+
+	// Main thread only - true as long as StagedLevel belongs to a level
+	inline bool StagingActiveFlag{};
+
+	//
+	// Functions
+	//
+
+	inline void StageLevel(const std::int_fast32_t Level)
+	{
+		if (StagingActiveFlag && StagedLevel.Level == Level)
+		{
+			return;
+		}
+
+		Cancel();
+		ReleaseStagedLevel();
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Stage level " + std::to_string(Level) + " in background...");
+
+		StagedLevel.Level = Level;
+		NumberOfImages = 0;
+		NextImage = 0;
+		LoadedImages = 0;
+		AssetsGatheredFlag = false;
+		StagingThreadFinishedFlag = false;
+		CancelFlag = false;
+		StagingActiveFlag = true;
+
+		StagingThread = std::thread([Level]
+		{
+			// Errors are stored and raised on the main thread by CompleteStaging()
+			try
+			{
+				StagedLevel.Pack.Open(LevelFolder + std::to_string(Level) + "/" + LevelPackFileName);
+
+				Game_LevelAssets::GatherLevelAssets(StagedLevel.Assets, Level, TextureSize, EntitySize);
+				StagedLevel.Textures.resize(StagedLevel.Assets.Images.size());
+				StagedLevel.Exceptions.resize(StagedLevel.Assets.Images.size());
+				NumberOfImages = StagedLevel.Assets.Images.size();
+				AssetsGatheredFlag = true;
+
+				Game_LevelHandling::LoadMapData(Level, StagedLevel.Pack, StagedLevel.LevelMap);
+				StageImages();
+			}
+			catch (...)
+			{
+				StagedLevel.Exception = std::current_exception();
+			}
+
+			StagingThreadFinishedFlag = true;
+		});
+
+		// The level which is played has priority
+		SetThreadPriority(StagingThread.native_handle(), THREAD_PRIORITY_BELOW_NORMAL);
+	}
+
+	inline void StageImages()
+	{
+		// Images are claimed one by one, so any number of threads can work on the same level
+		for (std::size_t Index{ NextImage++ }; Index < NumberOfImages && !CancelFlag; Index = NextImage++)
+		{
+			try
+			{
+				const std::string& FileName{ StagedLevel.Assets.Images[Index] };
+				lwmf::TextureViewStruct View{};
+				const bool Packed{ StagedLevel.Pack.IsOpen() && StagedLevel.Pack.GetTextureView(FileName, View) };
+
+				StagedLevel.Textures[Index] = GFX_ImageHandling::LoadTextureHandle(FileName, Packed ? &View : nullptr, Packed ? StagedLevel.Pack.FindEntry(FileName)->ContentHash : 0);
+			}
+			catch (...)
+			{
+				StagedLevel.Exceptions[Index] = std::current_exception();
+			}
+
+			++LoadedImages;
+		}
+	}
+
+	inline float GetProgress()
+	{
+		// Gathering the assets and parsing the map data count as one more step
+		const std::size_t Steps{ NumberOfImages + 1 };
+		const std::size_t DoneSteps{ LoadedImages + (StagingThreadFinishedFlag ? 1 : 0) };
+
+		return AssetsGatheredFlag ? static_cast<float>(DoneSteps) / static_cast<float>(Steps) : 0.0F;
+	}
+
+	inline void CompleteStaging(const std::int_fast32_t Level, lwmf::Multithreading& ThreadPool, const std::function<void(float)>& ShowProgress)
+	{
+		// Nothing to do if the level was prefetched already
+		StageLevel(Level);
+
+		bool HelpersStartedFlag{};
+
+		while (!StagingThreadFinishedFlag || LoadedImages < NumberOfImages)
+		{
+			// Images may only be claimed once the list of images is complete
+			if (!HelpersStartedFlag && AssetsGatheredFlag)
+			{
+				for (std::uint_fast32_t i{}; i < std::thread::hardware_concurrency(); ++i)
+				{
+					ThreadPool.AddThread([] { StageImages(); });
+				}
+
+				HelpersStartedFlag = true;
+			}
+
+			ShowProgress(GetProgress());
+			std::this_thread::sleep_for(std::chrono::milliseconds(LengthOfFrame));
+		}
+
+		ThreadPool.WaitForThreads();
+		StagingThread.join();
+		StagedLevel.Pack.Close();
+
+		ShowProgress(1.0F);
+
+		if (StagedLevel.Exception)
+		{
+			StagingActiveFlag = false;
+			std::rethrow_exception(StagedLevel.Exception);
+		}
+
+		for (std::size_t i{}; i < StagedLevel.Assets.Images.size(); ++i)
+		{
+			if (StagedLevel.Exceptions[i])
+			{
+				StagingActiveFlag = false;
+				std::rethrow_exception(StagedLevel.Exceptions[i]);
+			}
+
+			StagedLevel.Images.emplace(StagedLevel.Assets.Images[i], StagedLevel.Textures[i]);
+		}
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Level " + std::to_string(Level) + " staged (" + std::to_string(StagedLevel.Images.size()) + " images)...");
+	}
+
+	// Once the level was swapped in, it holds its own handles to the textures
+	inline void ReleaseStagedLevel()
+	{
+		StagedLevel.Pack.Close();
+		StagedLevel.Assets = {};
+		StagedLevel.Textures.clear();
+		StagedLevel.Textures.shrink_to_fit();
+		StagedLevel.Exceptions.clear();
+		StagedLevel.Exceptions.shrink_to_fit();
+		StagedLevel.LevelMap.clear();
+		StagedLevel.LevelMap.shrink_to_fit();
+		StagedLevel.Images.clear();
+		StagedLevel.Exception = nullptr;
+		StagingActiveFlag = false;
+	}
+
+	inline void Cancel()
+	{
+		if (StagingThread.joinable())
+		{
+			CancelFlag = true;
+			StagingThread.join();
+		}
+	}
+
+	inline std::int_fast32_t GetNextLevel()
+	{
+		return SelectedLevel < NumberOfLevels ? SelectedLevel + 1 : StartLevel;
+	}
+
+
+} // namespace Game_LevelStreaming
\ No newline at end of file
@@ -0,0 +1,344 @@
+/*
+*****************************************
+*                                       *
+* Game_MapData.hpp                      *
+*                                       *
+* (c) 2017 - 2020 Stefan Kubsch         *
+*****************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <fstream>
+#include <charconv>
+#include <algorithm>
+
+#include "Tools_ErrorHandling.hpp"
+
+namespace Game_MapData
+{
+
+
+	// Map layers come in two formats, the loader detects them automatically:
+	//
+	// Text ("MapWallData.conf" etc.) - one line per map row, values separated by ","
+	// Binary ("MapWallData.narcmap" next to the text file, or a blob in the asset pack) - MapLayerHeaderStruct followed by
+	// Width * Height uint16 tiles, optionally run-length encoded as (count, value) pairs of uint16
+	//
+	// If a binary file exists, it is used instead of the text file - it has to be rebuilt whenever the text file changes (see "_ConvertMaps.cmd")
+
+	// A layer is stored as one flat block, so Layer[X][Y] works the same way as with nested vectors
+	struct MapLayerStruct final
+	{
+		std::vector<std::int_fast32_t> Tiles{};
+		std::int_fast32_t Width{};
+		std::int_fast32_t Height{};
+
+		std::int_fast32_t* operator[](const std::int_fast32_t X)
+		{
+			return Tiles.data() + X * Height;
+		}
+
+		const std::int_fast32_t* operator[](const std::int_fast32_t X) const
+		{
+			return Tiles.data() + X * Height;
+		}
+	};
+
+	struct MapLayerHeaderStruct final
+	{
+		std::array<char, 8> Magic{};
+		std::uint32_t Version{};
+		std::uint32_t Flags{};
+		std::uint32_t Width{};
+		std::uint32_t Height{};
+		std::uint64_t DataSize{};
+	};
+
+	static_assert(sizeof(MapLayerHeaderStruct) == 32, "MapLayerHeaderStruct must not contain padding!");
+
+	bool ParseMapLayerText(std::string_view Text, MapLayerStruct& Layer);
+	bool IsBinaryMapLayer(std::string_view Data);
+	bool ParseMapLayerBinary(std::string_view Data, MapLayerStruct& Layer);
+	std::string EncodeMapLayer(const MapLayerStruct& Layer);
+	std::string GetBinaryMapLayerFileName(const std::string& FileName);
+	bool ReadFileContent(const std::string& FileName, std::string& Content);
+	bool ReadMapLayerFile(const std::string& FileName, MapLayerStruct& Layer);
+
+	//
+	// Variables and constants
+	//
+
+	inline constexpr std::array<char, 8> MapLayerMagic{ 'N', 'A', 'R', 'C', 'M', 'A', 'P', '\0' };
+	inline constexpr std::uint32_t MapLayerVersion{ 1 };
+	inline constexpr std::uint32_t MapLayerFlagRLE{ 1 };
+
+	//
+	// Functions
+	//
+
+	inline bool ParseMapLayerText(const std::string_view Text, MapLayerStruct& Layer)
+	{
+		Layer.Tiles.clear();
+		Layer.Width = 0;
+		Layer.Height = 0;
+
+		// Every value needs at least two characters (digit and delimiter)
+		Layer.Tiles.reserve(Text.size() >> 1);
+
+		std::vector<std::int_fast32_t> LineLengths{};
+		const char* Pos{ Text.data() };
+		const char* const End{ Text.data() + Text.size() };
+
+		while (Pos < End)
+		{
+			const char* LineEnd{ static_cast<const char*>(std::memchr(Pos, '\n', static_cast<std::size_t>(End - Pos))) };
+
+			if (LineEnd == nullptr)
+			{
+				LineEnd = End;
+			}
+
+			std::int_fast32_t LineLength{};
+
+			while (Pos < LineEnd)
+			{
+				// Everything which is not part of a number is a delimiter
+				if ((*Pos >= '0' && *Pos <= '9') || (*Pos == '-' && Pos + 1 < LineEnd && Pos[1] >= '0' && Pos[1] <= '9'))
+				{
+					std::int_fast32_t Value{};
+					const auto [Next, Error]{ std::from_chars(Pos, LineEnd, Value) };
+
+					if (Error != std::errc{})
+					{
+						NARCLog.AddEntry(lwmf::LogLevel::Critical, __FILENAME__, __LINE__, "ParseMapLayerText(): Value out of range in map data!");
+						return false;
+					}
+
+					Layer.Tiles.emplace_back(Value);
+					++LineLength;
+					Pos = Next;
+				}
+				else
+				{
+					++Pos;
+				}
+			}
+
+			// Lines without any value (e.g. trailing whitespace) are no map rows
+			if (LineLength > 0)
+			{
+				LineLengths.emplace_back(LineLength);
+			}
+
+			Pos = LineEnd + 1;
+		}
+
+		Layer.Width = static_cast<std::int_fast32_t>(LineLengths.size());
+		Layer.Height = LineLengths.empty() ? 0 : *std::max_element(LineLengths.begin(), LineLengths.end());
+
+		// Rows of different length are padded with 0, so every row can be indexed up to Height
+		if (static_cast<std::size_t>(Layer.Width * Layer.Height) != Layer.Tiles.size())
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Warn, __FILENAME__, __LINE__, "ParseMapLayerText(): Rows of map data differ in length, shorter rows are padded with 0!");
+
+			std::vector<std::int_fast32_t> PaddedTiles(static_cast<std::size_t>(Layer.Width * Layer.Height));
+			auto Source{ Layer.Tiles.begin() };
+
+			for (std::int_fast32_t X{}; X < Layer.Width; ++X)
+			{
+				std::copy(Source, Source + LineLengths[X], PaddedTiles.begin() + X * Layer.Height);
+				Source += LineLengths[X];
+			}
+
+			Layer.Tiles = std::move(PaddedTiles);
+		}
+
+		return true;
+	}
+
+	inline bool IsBinaryMapLayer(const std::string_view Data)
+	{
+		return Data.size() >= sizeof(MapLayerHeaderStruct) && std::memcmp(Data.data(), MapLayerMagic.data(), MapLayerMagic.size()) == 0;
+	}
+
+	inline bool ParseMapLayerBinary(const std::string_view Data, MapLayerStruct& Layer)
+	{
+		Layer.Tiles.clear();
+		Layer.Width = 0;
+		Layer.Height = 0;
+
+		MapLayerHeaderStruct Header{};
+
+		if (!IsBinaryMapLayer(Data))
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Critical, __FILENAME__, __LINE__, "ParseMapLayerBinary(): Not a binary map layer!");
+			return false;
+		}
+
+		std::memcpy(&Header, Data.data(), sizeof(Header));
+
+		const std::uint64_t NumberOfTiles{ static_cast<std::uint64_t>(Header.Width) * Header.Height };
+		const bool RLE{ (Header.Flags & MapLayerFlagRLE) != 0 };
+
+		if (Header.Version != MapLayerVersion || Header.Width > INT16_MAX || Header.Height > INT16_MAX || Header.DataSize != Data.size() - sizeof(Header)
+			|| (!RLE && Header.DataSize != NumberOfTiles * sizeof(std::uint16_t)) || (RLE && Header.DataSize % (2 * sizeof(std::uint16_t)) != 0))
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Critical, __FILENAME__, __LINE__, "ParseMapLayerBinary(): Binary map layer is corrupt or has the wrong version!");
+			return false;
+		}
+
+		Layer.Width = static_cast<std::int_fast32_t>(Header.Width);
+		Layer.Height = static_cast<std::int_fast32_t>(Header.Height);
+		Layer.Tiles.resize(static_cast<std::size_t>(NumberOfTiles));
+
+		const char* Pos{ Data.data() + sizeof(Header) };
+		const char* const End{ Data.data() + Data.size() };
+
+		const auto ReadValue{ [&Pos]
+		{
+			std::uint16_t Value{};
+			std::memcpy(&Value, Pos, sizeof(Value));
+			Pos += sizeof(Value);
+
+			return Value;
+		} };
+
+		if (!RLE)
+		{
+			for (auto&& Tile : Layer.Tiles)
+			{
+				Tile = ReadValue();
+			}
+
+			return true;
+		}
+
+		auto Tile{ Layer.Tiles.begin() };
+
+		while (Pos < End)
+		{
+			const std::uint16_t Count{ ReadValue() };
+			const std::uint16_t Value{ ReadValue() };
+
+			if (Count == 0 || Count > Layer.Tiles.end() - Tile)
+			{
+				NARCLog.AddEntry(lwmf::LogLevel::Critical, __FILENAME__, __LINE__, "ParseMapLayerBinary(): Run-length encoded map layer is corrupt!");
+				return false;
+			}
+
+			Tile = std::fill_n(Tile, Count, Value);
+		}
+
+		if (Tile != Layer.Tiles.end())
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Critical, __FILENAME__, __LINE__, "ParseMapLayerBinary(): Run-length encoded map layer is incomplete!");
+			return false;
+		}
+
+		return true;
+	}
+
+	// Returns an empty string if a tile does not fit into 16 bit
+	// Run-length encoding is used if it makes the layer smaller
+	inline std::string EncodeMapLayer(const MapLayerStruct& Layer)
+	{
+		if (Layer.Width > INT16_MAX || Layer.Height > INT16_MAX || std::any_of(Layer.Tiles.begin(), Layer.Tiles.end(), [](const std::int_fast32_t Tile) { return Tile < 0 || Tile > UINT16_MAX; }))
+		{
+			return {};
+		}
+
+		std::vector<std::uint16_t> Runs{};
+
+		for (std::size_t i{}; i < Layer.Tiles.size();)
+		{
+			std::size_t Count{ 1 };
+
+			while (i + Count < Layer.Tiles.size() && Layer.Tiles[i + Count] == Layer.Tiles[i] && Count < UINT16_MAX)
+			{
+				++Count;
+			}
+
+			Runs.emplace_back(static_cast<std::uint16_t>(Count));
+			Runs.emplace_back(static_cast<std::uint16_t>(Layer.Tiles[i]));
+			i += Count;
+		}
+
+		const bool RLE{ Runs.size() < Layer.Tiles.size() };
+		std::vector<std::uint16_t> Data{};
+
+		if (RLE)
+		{
+			Data = std::move(Runs);
+		}
+		else
+		{
+			Data.assign(Layer.Tiles.begin(), Layer.Tiles.end());
+		}
+
+		MapLayerHeaderStruct Header{};
+		Header.Magic = MapLayerMagic;
+		Header.Version = MapLayerVersion;
+		Header.Flags = RLE ? MapLayerFlagRLE : 0;
+		Header.Width = static_cast<std::uint32_t>(Layer.Width);
+		Header.Height = static_cast<std::uint32_t>(Layer.Height);
+		Header.DataSize = Data.size() * sizeof(std::uint16_t);
+
+		std::string Result(sizeof(Header) + Header.DataSize, '\0');
+		std::memcpy(Result.data(), &Header, sizeof(Header));
+
+		if (!Data.empty())
+		{
+			std::memcpy(Result.data() + sizeof(Header), Data.data(), Header.DataSize);
+		}
+
+		return Result;
+	}
+
+	inline std::string GetBinaryMapLayerFileName(const std::string& FileName)
+	{
+		return FileName.substr(0, FileName.find_last_of('.')) + ".narcmap";
+	}
+
+	inline bool ReadFileContent(const std::string& FileName, std::string& Content)
+	{
+		std::ifstream File(FileName, std::ios::in | std::ios::binary | std::ios::ate);
+
+		if (File.fail())
+		{
+			return false;
+		}
+
+		Content.resize(static_cast<std::size_t>(File.tellg()));
+		File.seekg(0);
+		File.read(Content.data(), static_cast<std::streamsize>(Content.size()));
+
+		return !File.fail();
+	}
+
+	inline bool ReadMapLayerFile(const std::string& FileName, MapLayerStruct& Layer)
+	{
+		std::string Content;
+
+		if (ReadFileContent(GetBinaryMapLayerFileName(FileName), Content))
+		{
+			return ParseMapLayerBinary(Content, Layer);
+		}
+
+		if (Tools_ErrorHandling::CheckFileExistence(FileName, StopOnError) && ReadFileContent(FileName, Content))
+		{
+			return IsBinaryMapLayer(Content) ? ParseMapLayerBinary(Content, Layer) : ParseMapLayerText(Content, Layer);
+		}
+
+		return false;
+	}
+
+
+} // namespace Game_MapData
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include "Game_DataStructures.hpp"
 #include "Game_LevelHandling.hpp"
 #include "Game_EntityHandling.hpp"
+#include "Game_PathFinding.hpp"
 
 class Game_MinimapClass final
 {
@@ -35,13 +36,13 @@ private:
 	lwmf::IntPointStruct Pos{};
 	std::int_fast32_t TileSize{ 6 };
 	std::int_fast32_t StartPosY{};
-	std::int_fast32_t PlayerColor{};
-	std::int_fast32_t EnemyColor{};
-	std::int_fast32_t NeutralColor{};
-	std::int_fast32_t AmmoBoxColor{};
-	std::int_fast32_t WallColor{};
-	std::int_fast32_t DoorColor{};
-	std::int_fast32_t WayPointColor{};
+	lwmf::PixelType PlayerColor{};
+	lwmf::PixelType EnemyColor{};
+	lwmf::PixelType NeutralColor{};
+	lwmf::PixelType AmmoBoxColor{};
+	lwmf::PixelType WallColor{};
+	lwmf::PixelType DoorColor{};
+	lwmf::PixelType WayPointColor{};
 	std::int_fast32_t WaypointOffset{};
 	bool ShowWaypoints{};
 	bool IsPreRendered{};
@@ -126,45 +127,50 @@ inline void Game_MinimapClass::DisplayRealtimeMap() const
 	{
 		for (std::int_fast32_t y{ StartPosY }, MapPosX{}; MapPosX < Game_LevelHandling::LevelMapWidth; ++MapPosX, y += TileSize)
 		{
-			switch (Game_EntityHandling::EntityMap[MapPosX][MapPosY])
+			// More than one type can be on a tile - the player is shown first, then enemies, neutral entities and ammo boxes
+			if (const std::uint_fast32_t TypeMask{ Game_EntityHandling::TileTypeMasks[Game_EntityHandling::GetTile(MapPosX, MapPosY)] }; (TypeMask & Game_EntityHandling::GetTypeMask(EntityTypes::Player)) != 0)
 			{
-				case EntityTypes::Player:
-				{
-					lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, PlayerColor, PlayerColor);
-					break;
-				}
-				case EntityTypes::Enemy: case EntityTypes::Turret:
-				{
-					lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, EnemyColor, EnemyColor);
-					break;
-				}
-				case EntityTypes::Neutral:
-				{
-					lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, NeutralColor, NeutralColor);
-					break;
-				}
-				case EntityTypes::AmmoBox:
-				{
-					lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, AmmoBoxColor, AmmoBoxColor);
-					break;
-				}
-				default: {}
+				lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, PlayerColor, PlayerColor);
+			}
+			else if ((TypeMask & (Game_EntityHandling::GetTypeMask(EntityTypes::Enemy) | Game_EntityHandling::GetTypeMask(EntityTypes::Turret))) != 0)
+			{
+				lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, EnemyColor, EnemyColor);
+			}
+			else if ((TypeMask & Game_EntityHandling::GetTypeMask(EntityTypes::Neutral)) != 0)
+			{
+				lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, NeutralColor, NeutralColor);
 			}
+			else if ((TypeMask & Game_EntityHandling::GetTypeMask(EntityTypes::AmmoBox)) != 0)
+			{
+				lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, AmmoBoxColor, AmmoBoxColor);
+			}
+		}
+	}
+
+	if (ShowWaypoints)
+	{
+		const auto DrawWayPoint{ [this](const std::int_fast32_t MapPosX, const std::int_fast32_t MapPosY)
+		{
+			lwmf::SetPixel(Canvas, Pos.X + MapPosY * TileSize + WaypointOffset, StartPosY + MapPosX * TileSize + WaypointOffset, WayPointColor);
+		} };
 
-			if (ShowWaypoints)
+		for (std::size_t Index{}; Index < Entities.size(); ++Index)
+		{
+			if (const EntityStruct& Entity{ Entities[Index] }; !EntityStates[Index].IsDead && Entity.ValidPathFound && (EntityStates[Index].Type == EntityTypes::Neutral || EntityStates[Index].Type == EntityTypes::Enemy))
 			{
-				for (auto& Entity : Entities)
+				if (Game_PathFinding::Mode == Game_PathFinding::Modes::FlowField)
+				{
+					// Same tiles as the waypoints of the A* search - from the tile of the entity up to the tile in front of the player
+					for (std::int_fast32_t Tile{ Entity.PathFindingStart }; Tile != -1 && Tile != Game_PathFinding::PlayerFlowField.Target; Tile = Game_PathFinding::GetNextTile(Game_PathFinding::PlayerFlowField, Tile))
+					{
+						DrawWayPoint(Tile % Game_LevelHandling::LevelMapWidth, Tile / Game_LevelHandling::LevelMapWidth);
+					}
+				}
+				else
 				{
-					if (!Entity.IsDead && (Entity.Type == EntityTypes::Neutral || Entity.Type == EntityTypes::Enemy))
+					for (const auto& WayPoint : Entity.PathFindingWayPoints)
 					{
-						for (auto& WayPoint : Entity.PathFindingWayPoints)
-						{
-							if (WayPoint.X == MapPosX && WayPoint.Y == MapPosY)
-							{
-								lwmf::SetPixel(Canvas, x + WaypointOffset, y + WaypointOffset, WayPointColor);
-								break;
-							}
-						}
+						DrawWayPoint(WayPoint.X, WayPoint.Y);
 					}
 				}
 			}
@@ -12,8 +12,15 @@
 #include <cstdint>
 #include <vector>
 #include <array>
-#include <list>
 #include <queue>
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <random>
+#include <chrono>
+#include <string>
+#include <limits>
+#include <functional>
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Game_LevelHandling.hpp"
@@ -22,12 +29,14 @@ namespace Game_PathFinding
 {
 
 
-	void GenerateFlattenedMap(std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height);
-	bool CalculatePath(std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Start, std::int_fast32_t Target, bool Diagonal, std::list<lwmf::IntPointStruct>& WayPoints);
-
-	//
-	// Variables and constants
-	//
+	enum class Modes : std::int_fast32_t
+	{
+		AStar,
+		JumpPointSearch,
+		Hierarchical,
+		Incremental,
+		FlowField
+	};
 
 	struct NodeStruct final
 	{
@@ -37,8 +46,228 @@ namespace Game_PathFinding
 		NodeStruct(std::int_fast32_t i, float c) : Index(i), Cost(c) {}
 	};
 
+	// Result of one search from the target over the whole map - every tile knows its cost to the target and the next tile on the way
+	// Entities chasing the same target read their next step from here instead of running a search each
+	struct FlowFieldStruct final
+	{
+		std::vector<float> Costs{};
+		std::vector<std::int_fast32_t> NextTiles{};
+		std::int_fast32_t Target{ -1 };
+		std::uint_fast32_t TopologyVersion{};
+		bool Diagonal{};
+	};
+
+	// Scratch memory of A* searches - kept between searches, so a search neither allocates nor clears anything
+	// A node's cost, priority, path and heap position are only valid if it is stamped with the generation of the current search
+	struct SearchContextStruct final
+	{
+		std::vector<float> Costs{};
+		std::vector<float> Priorities{};
+		std::vector<std::int_fast32_t> Paths{};
+		std::vector<std::int_fast32_t> HeapPositions{};
+		std::vector<std::uint_fast32_t> Generations{};
+		std::vector<std::int_fast32_t> Heap{};
+		std::uint_fast32_t Generation{};
+		// Nodes taken from the heap by the last search
+		std::uint_fast32_t ExpandedNodes{};
+		// Only used by hierarchical searches
+		std::vector<std::int_fast32_t> ClusterQueue{};
+		std::vector<std::int_fast32_t> AbstractPath{};
+	};
+
+	// Precalculated straight moves of jump point searches (JPS+) - per direction (east, west, south, north) and tile the number of steps to the
+	// first jump point of a move starting on the tile, or -(number of walkable tiles + 1) if the move hits a wall first
+	// Only used for the map it was calculated for and as long as its topology version is the current one
+	struct JumpDistancesStruct final
+	{
+		std::array<std::vector<std::int32_t>, 4> Distances{};
+		const std::vector<float>* Map{};
+		std::uint_fast32_t TopologyVersion{};
+		std::int_fast32_t Width{};
+		std::int_fast32_t Height{};
+		bool Diagonal{};
+	};
+
+	// Abstract graph of hierarchical searches (HPA*) - the map is split into clusters, neighbouring clusters are connected by transitions
+	// (pairs of walkable tiles facing each other across the border) and the costs between the transition tiles ("entrances") of a cluster are precalculated
+	struct ClusterStruct final
+	{
+		std::vector<std::int_fast32_t> Entrances{};
+		// Per entrance the entrances of neighbouring clusters which are reached in one step
+		std::vector<std::vector<std::int_fast32_t>> Links{};
+		// Costs between all entrances (row is the entrance the path starts at), FLT_MAX if there is no path inside the cluster
+		std::vector<float> Costs{};
+	};
+
+	// Only used for the map it was calculated for and as long as its topology version is the current one
+	struct HierarchyStruct final
+	{
+		std::vector<ClusterStruct> Clusters{};
+		// Per cluster the transitions to its neighbour on the east and on the south (tile in the cluster, tile in the neighbour)
+		std::vector<std::vector<std::pair<std::int_fast32_t, std::int_fast32_t>>> EastTransitions{};
+		std::vector<std::vector<std::pair<std::int_fast32_t, std::int_fast32_t>>> SouthTransitions{};
+		const std::vector<float>* Map{};
+		std::uint_fast32_t TopologyVersion{};
+		std::int_fast32_t Width{};
+		std::int_fast32_t Height{};
+		std::int_fast32_t ClustersX{};
+		std::int_fast32_t ClustersY{};
+		bool Diagonal{};
+	};
+
+	// Queue entry of incremental searches - ordered by Key first and Cost second
+	struct IncrementalNodeStruct final
+	{
+		float Key{};
+		float Cost{};
+		std::int_fast32_t Index{};
+	};
+
+	// Tile touched by an incremental search - Cost is the cost from Start ("g"), Lookahead the cost offered by the neighbours ("rhs")
+	struct IncrementalTileStruct final
+	{
+		std::int_fast32_t Index{ -1 };
+		float Cost{ FLT_MAX };
+		float Lookahead{ FLT_MAX };
+	};
+
+	// Search tree of an incremental search (LPA* as used by D* Lite), kept per pursuer and repaired when the target moves or tiles change
+	// Only the touched tiles are stored (hash table with open addressing, free entries have Index -1), so the memory depends on the size of the search and not of the map
+	// Tiles where cost and lookahead differ are queued - outdated queue entries are skipped when they come up and removed once the queue grew too much
+	struct IncrementalSearchStruct final
+	{
+		std::vector<IncrementalTileStruct> Tiles{};
+		std::size_t NumberOfTiles{};
+		std::vector<IncrementalNodeStruct> Queue{};
+		std::size_t QueueLimit{};
+		const std::vector<float>* Map{};
+		std::int_fast32_t Start{ -1 };
+		std::int_fast32_t Target{ -1 };
+		// Sum of the heuristic distances the target moved since the search started ("km"), keeps the keys in the queue valid lower bounds
+		float KeyModifier{};
+		std::uint_fast32_t TopologyVersion{};
+		// Nodes expanded by the last call of CalculateIncrementalPath()
+		std::uint_fast32_t ExpandedNodes{};
+		bool Diagonal{};
+	};
+
+	void GenerateFlattenedMap(std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height);
+	void SetWalkable(std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t X, std::int_fast32_t Y, bool Walkable);
+	void BeginSearch(SearchContextStruct& Context, std::int_fast32_t MapSize);
+	void VisitNode(SearchContextStruct& Context, std::int_fast32_t Node);
+	void MoveNodeUp(SearchContextStruct& Context, std::int_fast32_t Position);
+	void MoveNodeDown(SearchContextStruct& Context, std::int_fast32_t Position);
+	void PushNode(SearchContextStruct& Context, std::int_fast32_t Node, float Priority);
+	std::int_fast32_t PopNode(SearchContextStruct& Context);
+	bool CalculatePath(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Start, std::int_fast32_t Target, bool Diagonal, std::vector<lwmf::IntPointStruct>& WayPoints, SearchContextStruct& Context);
+	bool CalculatePath(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Start, std::int_fast32_t Target, bool Diagonal, std::vector<lwmf::IntPointStruct>& WayPoints);
+	bool IsWalkable(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t X, std::int_fast32_t Y);
+	bool IsForced(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t X, std::int_fast32_t Y, std::int_fast32_t DirX, std::int_fast32_t DirY, bool Diagonal);
+	std::size_t GetDirectionIndex(std::int_fast32_t DirX, std::int_fast32_t DirY);
+	void CalculateJumpDistanceLine(JumpDistancesStruct& JumpDistances, std::int_fast32_t Line, bool Horizontal);
+	void CalculateJumpDistances(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, bool Diagonal, JumpDistancesStruct& JumpDistances);
+	void UpdateJumpDistances(std::int_fast32_t X, std::int_fast32_t Y, JumpDistancesStruct& JumpDistances);
+	std::int_fast32_t LookupJump(const JumpDistancesStruct& JumpDistances, std::int_fast32_t X, std::int_fast32_t Y, std::int_fast32_t DirX, std::int_fast32_t DirY, std::int_fast32_t Target);
+	std::int_fast32_t Jump(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t X, std::int_fast32_t Y, std::int_fast32_t DirX, std::int_fast32_t DirY, std::int_fast32_t Target, bool Diagonal, const JumpDistancesStruct* JumpDistances);
+	bool CalculateJumpPointPath(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Start, std::int_fast32_t Target, bool Diagonal, std::vector<lwmf::IntPointStruct>& WayPoints, SearchContextStruct& Context);
+	bool CalculateJumpPointPath(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Start, std::int_fast32_t Target, bool Diagonal, std::vector<lwmf::IntPointStruct>& WayPoints);
+	std::int_fast32_t GetCluster(const HierarchyStruct& Hierarchy, std::int_fast32_t Tile);
+	std::size_t GetClusterPosition(const HierarchyStruct& Hierarchy, std::int_fast32_t Tile);
+	void CalculateTransitions(HierarchyStruct& Hierarchy, std::int_fast32_t Cluster, bool East);
+	void CalculateClusterCosts(const HierarchyStruct& Hierarchy, std::int_fast32_t Cluster, std::int_fast32_t From, std::array<float, 256>& Costs, std::vector<std::int_fast32_t>& Queue);
+	void BuildCluster(HierarchyStruct& Hierarchy, std::int_fast32_t Cluster, std::vector<std::int_fast32_t>& Queue);
+	void CalculateHierarchy(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, bool Diagonal, HierarchyStruct& Hierarchy);
+	void UpdateHierarchy(std::int_fast32_t X, std::int_fast32_t Y, HierarchyStruct& Hierarchy);
+	bool RefineHierarchicalSegment(const HierarchyStruct& Hierarchy, std::int_fast32_t From, std::int_fast32_t To, std::vector<lwmf::IntPointStruct>& WayPoints, SearchContextStruct& Context);
+	bool CalculateHierarchicalPath(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Start, std::int_fast32_t Target, bool Diagonal, std::vector<lwmf::IntPointStruct>& WayPoints, SearchContextStruct& Context);
+	bool CalculateHierarchicalPath(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Start, std::int_fast32_t Target, bool Diagonal, std::vector<lwmf::IntPointStruct>& WayPoints);
+	bool operator < (const IncrementalNodeStruct& Node1, const IncrementalNodeStruct& Node2);
+	bool CompareIncrementalNodes(const IncrementalNodeStruct& Node1, const IncrementalNodeStruct& Node2);
+	void GetNeighbours(std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Index, bool Diagonal, std::array<std::int_fast32_t, 8>& Neighbours);
+	std::size_t GetIncrementalTilePosition(const IncrementalSearchStruct& Search, std::int_fast32_t Index);
+	const IncrementalTileStruct& FindIncrementalTile(const IncrementalSearchStruct& Search, std::int_fast32_t Index);
+	IncrementalTileStruct& AddIncrementalTile(IncrementalSearchStruct& Search, std::int_fast32_t Index);
+	void CompactIncrementalQueue(IncrementalSearchStruct& Search, std::int_fast32_t Width);
+	IncrementalNodeStruct GetIncrementalKey(const IncrementalSearchStruct& Search, std::int_fast32_t Width, std::int_fast32_t Index);
+	void QueueIncrementalNode(IncrementalSearchStruct& Search, std::int_fast32_t Width, std::int_fast32_t Index);
+	void UpdateIncrementalNode(IncrementalSearchStruct& Search, const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Index);
+	void StartIncrementalSearch(IncrementalSearchStruct& Search, const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Start, std::int_fast32_t Target, bool Diagonal);
+	void RepairIncrementalSearch(IncrementalSearchStruct& Search, const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height);
+	bool CalculateIncrementalPath(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Start, std::int_fast32_t Target, bool Diagonal, std::vector<lwmf::IntPointStruct>& WayPoints, IncrementalSearchStruct& Search);
+	void TrimChangedTiles(std::uint_fast32_t OldestVersionInUse);
+	void CalculateFlowField(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Target, bool Diagonal, FlowFieldStruct& FlowField);
+	bool UpdateFlowField(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Target, bool Diagonal, FlowFieldStruct& FlowField);
+	std::int_fast32_t GetNextTile(const FlowFieldStruct& FlowField, std::int_fast32_t Start);
+	void GenerateRandomMap(std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t WallPercentage, std::mt19937& Random);
+	void GenerateRoomMap(std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t RoomSize, std::mt19937& Random);
+	void GenerateMazeMap(std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t CorridorWidth, std::mt19937& Random);
+	void GenerateBenchmarkQueries(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t NumberOfQueries, std::int_fast32_t MaxDistance, std::mt19937& Random, std::vector<std::pair<std::int_fast32_t, std::int_fast32_t>>& Queries);
+	std::int_fast64_t BenchmarkSearches(const std::vector<std::pair<std::int_fast32_t, std::int_fast32_t>>& Queries, std::int_fast32_t Passes, const std::function<bool(std::int_fast32_t, std::int_fast32_t)>& Search, std::int_fast32_t& PathsFound);
+	bool BenchmarkAStar(std::mt19937& Random);
+	bool BenchmarkHierarchical(std::mt19937& Random);
+	bool BenchmarkPathFinding();
+
+	//
+	// Variables and constants
+	//
+
+	// Set in GameConfig.ini - A* is the default, the other modes are opt-in
+	inline Modes Mode{ Modes::AStar };
+
+	// Budget per tick for A* searches of entities (microseconds and expanded nodes, 0 is unlimited)
+	// Set in GameConfig.ini
+	inline std::int_fast32_t RequestTimeBudget{};
+	inline std::int_fast32_t RequestNodeBudget{};
+
 	inline std::vector<float> FlattenedMap{};
 
+	// Increased whenever FlattenedMap changes (new level, doors opening or closing...), so results depending on it can be recalculated
+	inline std::uint_fast32_t TopologyVersion{};
+
+	// Tiles changed by SetWalkable() since the last GenerateFlattenedMap(), so incremental searches can repair just these
+	// ChangedTiles[i] raised TopologyVersion from ChangedTilesBaseVersion + i to ChangedTilesBaseVersion + i + 1
+	// Changes all searches caught up with are dropped by TrimChangedTiles(), and the oldest ones once there are more than MaxChangedTiles - searches lagging behind that far start over
+	inline std::vector<std::int_fast32_t> ChangedTiles{};
+	inline std::uint_fast32_t ChangedTilesBaseVersion{};
+	inline constexpr std::size_t MaxChangedTiles{ 1024 };
+
+	// Initial size of the tile hash table of incremental searches and the smallest queue size at which outdated entries are removed
+	inline constexpr std::size_t MinIncrementalTiles{ 256 };
+	inline constexpr std::size_t MinIncrementalQueueLimit{ 256 };
+
+	// Jump distances of FlattenedMap without diagonal moves (as used by the entities), only calculated in JumpPointSearch mode
+	inline JumpDistancesStruct FlattenedMapJumpDistances{};
+
+	// Edge length of the clusters of hierarchical searches in tiles
+	inline constexpr std::int_fast32_t ClusterSize{ 16 };
+
+	// Border openings up to this length get one transition in their middle, longer ones one at each end
+	inline constexpr std::int_fast32_t MaxSingleTransitionLength{ 6 };
+
+	// Abstract graph of FlattenedMap without diagonal moves (as used by the entities), only calculated in Hierarchical mode
+	inline HierarchyStruct FlattenedMapHierarchy{};
+
+	// Flow field towards the player, shared by all enemies and neutral entities
+	inline FlowFieldStruct PlayerFlowField{};
+
+	// Every thread searching paths uses its own context
+	inline thread_local SearchContextStruct SearchContext{};
+
+	// Synthetic maps of BenchmarkPathFinding() - edge lengths, share of wall tiles in percent and the seed, so every run searches the same maps and pairs
+	inline constexpr std::array<std::int_fast32_t, 7> BenchmarkMapSizes{ 16, 32, 64, 128, 256, 512, 1024 };
+	inline constexpr std::int_fast32_t BenchmarkWallPercentage{ 25 };
+	inline constexpr std::uint_fast32_t BenchmarkSeed{ 1 };
+
+	// Start/target pairs per map, their maximum distance on both axes (0 is anywhere on the map) and number of times they are searched
+	inline constexpr std::int_fast32_t BenchmarkQueries{ 100 };
+	inline constexpr std::array<std::int_fast32_t, 2> BenchmarkMaxDistances{ 0, 20 };
+	inline constexpr std::int_fast32_t BenchmarkPasses{ 3 };
+
+	// Hierarchical searches are compared with A* on larger maps (open, rooms and mazes) - with fewer pairs searched once, as A* takes up to a few hundred milliseconds there
+	inline constexpr std::array<std::int_fast32_t, 4> HierarchicalBenchmarkMapSizes{ 256, 512, 1024, 2048 };
+	inline constexpr std::int_fast32_t HierarchicalBenchmarkQueries{ 20 };
+	inline constexpr std::int_fast32_t HierarchicalBenchmarkPasses{ 1 };
+
 	//
 	// Functions
 	//
@@ -66,6 +295,37 @@ namespace Game_PathFinding
 				}
 			}
 		}
+
+		++TopologyVersion;
+		ChangedTiles.clear();
+		ChangedTilesBaseVersion = TopologyVersion;
+
+		if (Mode == Modes::JumpPointSearch)
+		{
+			CalculateJumpDistances(Map, Width, Height, false, FlattenedMapJumpDistances);
+		}
+		else if (Mode == Modes::Hierarchical)
+		{
+			CalculateHierarchy(Map, Width, Height, false, FlattenedMapHierarchy);
+		}
+	}
+
+	inline void SetWalkable(std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t X, const std::int_fast32_t Y, const bool Walkable)
+	{
+		Map[static_cast<std::size_t>(Width * Y + X)] = Walkable ? 1.0F : FLT_MAX;
+		ChangedTiles.emplace_back(Width * Y + X);
+		++TopologyVersion;
+		TrimChangedTiles(ChangedTilesBaseVersion);
+
+		if (FlattenedMapJumpDistances.Map == &Map)
+		{
+			UpdateJumpDistances(X, Y, FlattenedMapJumpDistances);
+		}
+
+		if (FlattenedMapHierarchy.Map == &Map)
+		{
+			UpdateHierarchy(X, Y, FlattenedMapHierarchy);
+		}
 	}
 
 	//
@@ -77,81 +337,1791 @@ namespace Game_PathFinding
 	// https://www.raywenderlich.com/3016-introduction-to-a-pathfinding
 	//
 
-	inline bool CalculatePath(std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Start, const std::int_fast32_t Target, bool Diagonal, std::list<lwmf::IntPointStruct>& WayPoints)
+	// Starts a new search - all nodes stamped with an older generation count as unvisited, so nothing has to be cleared
+	inline void BeginSearch(SearchContextStruct& Context, const std::int_fast32_t MapSize)
+	{
+		if (Context.Generations.size() != static_cast<std::size_t>(MapSize))
+		{
+			Context.Costs.resize(static_cast<std::size_t>(MapSize));
+			Context.Priorities.resize(static_cast<std::size_t>(MapSize));
+			Context.Paths.resize(static_cast<std::size_t>(MapSize));
+			Context.HeapPositions.resize(static_cast<std::size_t>(MapSize));
+			Context.Generations.assign(static_cast<std::size_t>(MapSize), 0);
+			Context.Generation = 0;
+		}
+
+		// Once in 4 billion searches the stamps wrap around and have to be reset
+		if (++Context.Generation == 0)
+		{
+			std::fill(Context.Generations.begin(), Context.Generations.end(), 0);
+			Context.Generation = 1;
+		}
+
+		Context.Heap.clear();
+		Context.ExpandedNodes = 0;
+	}
+
+	inline void VisitNode(SearchContextStruct& Context, const std::int_fast32_t Node)
+	{
+		if (Context.Generations[Node] != Context.Generation)
+		{
+			Context.Generations[Node] = Context.Generation;
+			Context.Costs[Node] = FLT_MAX;
+			Context.HeapPositions[Node] = -1;
+		}
+	}
+
+	inline void MoveNodeUp(SearchContextStruct& Context, std::int_fast32_t Position)
+	{
+		const std::int_fast32_t Node{ Context.Heap[Position] };
+
+		while (Position > 0)
+		{
+			const std::int_fast32_t Parent{ (Position - 1) >> 1 };
+
+			if (Context.Priorities[Context.Heap[Parent]] <= Context.Priorities[Node])
+			{
+				break;
+			}
+
+			Context.Heap[Position] = Context.Heap[Parent];
+			Context.HeapPositions[Context.Heap[Position]] = Position;
+			Position = Parent;
+		}
+
+		Context.Heap[Position] = Node;
+		Context.HeapPositions[Node] = Position;
+	}
+
+	inline void MoveNodeDown(SearchContextStruct& Context, std::int_fast32_t Position)
+	{
+		const std::int_fast32_t HeapSize{ static_cast<std::int_fast32_t>(Context.Heap.size()) };
+		const std::int_fast32_t Node{ Context.Heap[Position] };
+
+		while (true)
+		{
+			std::int_fast32_t Child{ (Position << 1) + 1 };
+
+			if (Child >= HeapSize)
+			{
+				break;
+			}
+
+			if (Child + 1 < HeapSize && Context.Priorities[Context.Heap[Child + 1]] < Context.Priorities[Context.Heap[Child]])
+			{
+				++Child;
+			}
+
+			if (Context.Priorities[Node] <= Context.Priorities[Context.Heap[Child]])
+			{
+				break;
+			}
+
+			Context.Heap[Position] = Context.Heap[Child];
+			Context.HeapPositions[Context.Heap[Position]] = Position;
+			Position = Child;
+		}
+
+		Context.Heap[Position] = Node;
+		Context.HeapPositions[Node] = Position;
+	}
+
+	// Adds the node to the heap or - if it is in the heap already - moves it up to its lower priority (decrease-key)
+	inline void PushNode(SearchContextStruct& Context, const std::int_fast32_t Node, const float Priority)
+	{
+		Context.Priorities[Node] = Priority;
+
+		if (Context.HeapPositions[Node] == -1)
+		{
+			Context.Heap.emplace_back(Node);
+			Context.HeapPositions[Node] = static_cast<std::int_fast32_t>(Context.Heap.size()) - 1;
+		}
+
+		MoveNodeUp(Context, Context.HeapPositions[Node]);
+	}
+
+	inline std::int_fast32_t PopNode(SearchContextStruct& Context)
+	{
+		const std::int_fast32_t Node{ Context.Heap.front() };
+
+		Context.Heap.front() = Context.Heap.back();
+		Context.Heap.pop_back();
+		Context.HeapPositions[Node] = -1;
+
+		if (!Context.Heap.empty())
+		{
+			MoveNodeDown(Context, 0);
+		}
+
+		return Node;
+	}
+
+	// WayPoints start with the tile of Start and end with the tile in front of Target
+	inline bool CalculatePath(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Start, const std::int_fast32_t Target, const bool Diagonal, std::vector<lwmf::IntPointStruct>& WayPoints, SearchContextStruct& Context)
 	{
-		const NodeStruct StartNode(Start, 0.0F);
-		const NodeStruct TargetNode(Target, 0.0F);
+		WayPoints.clear();
 
 		const std::int_fast32_t MapSize{ Width * Height };
-		const std::int_fast32_t TargetCalc1{ Target / Width };
-		const std::int_fast32_t TargetCalc2{ Target % Width };
-		std::vector<std::int_fast32_t> Paths(MapSize);
+
+		if (Start < 0 || Start >= MapSize || Target < 0 || Target >= MapSize)
+		{
+			return false;
+		}
+
+		const std::int_fast32_t TargetRow{ Target / Width };
+		const std::int_fast32_t TargetColumn{ Target % Width };
 		std::array<std::int_fast32_t, 8> Neighbours{};
-		std::vector<float> Costs(MapSize, FLT_MAX);
-		std::priority_queue<NodeStruct> NodesToVisit{};
 		bool PathFound{};
 
-		Costs[Start] = 0.0F;
-		NodesToVisit.push(StartNode);
+		BeginSearch(Context, MapSize);
+		VisitNode(Context, Start);
+		Context.Costs[Start] = 0.0F;
+		Context.Paths[Start] = Start;
+		PushNode(Context, Start, 0.0F);
 
-		while (!NodesToVisit.empty())
+		while (!Context.Heap.empty())
 		{
-			const NodeStruct Current{ NodesToVisit.top() };
+			const std::int_fast32_t Current{ PopNode(Context) };
+			++Context.ExpandedNodes;
 
-			if (Current.Index == TargetNode.Index)
+			if (Current == Target)
 			{
 				PathFound = true;
 				break;
 			}
 
-			NodesToVisit.pop();
-
-			const std::int_fast32_t Row{ Current.Index / Width };
-			const std::int_fast32_t Column{ Current.Index % Width };
-			const std::int_fast32_t IndexPlusWidth{ Current.Index + Width };
-			const std::int_fast32_t IndexMinusWidth{ Current.Index - Width };
+			const std::int_fast32_t Row{ Current / Width };
+			const std::int_fast32_t Column{ Current % Width };
+			const std::int_fast32_t IndexPlusWidth{ Current + Width };
+			const std::int_fast32_t IndexMinusWidth{ Current - Width };
 
 			Neighbours[0] = (Diagonal && Row > 0 && Column > 0) ? IndexMinusWidth - 1 : -1;
 			Neighbours[1] = (Row > 0) ? IndexMinusWidth : -1;
 			Neighbours[2] = (Diagonal && Row > 0 && Column + 1 < Width) ? IndexMinusWidth + 1 : -1;
-			Neighbours[3] = (Column > 0) ? Current.Index - 1 : -1;
-			Neighbours[4] = (Column + 1 < Width) ? Current.Index + 1 : -1;
+			Neighbours[3] = (Column > 0) ? Current - 1 : -1;
+			Neighbours[4] = (Column + 1 < Width) ? Current + 1 : -1;
 			Neighbours[5] = (Diagonal && Row + 1 < Height && Column > 0) ? IndexPlusWidth - 1 : -1;
 			Neighbours[6] = (Row + 1 < Height) ? IndexPlusWidth : -1;
 			Neighbours[7] = (Diagonal && Row + 1 < Height && Column + 1 < Width) ? IndexPlusWidth + 1 : -1;
 
-			for (std::int_fast32_t i{}; i < 8; ++i)
+			for (const std::int_fast32_t Neighbour : Neighbours)
 			{
-				if (Neighbours[i] >= 0)
+				if (Neighbour < 0 || Map[Neighbour] == FLT_MAX)
 				{
-					if (const float NewCost{ Costs[Current.Index] + Map[Neighbours[i]] }; NewCost < Costs[Neighbours[i]])
-					{
-						const float HeuristicCost{ Diagonal ? lwmf::CalcChebyshevDistance<float>(Neighbours[i] / Width, Neighbours[i] % Width, TargetCalc1, TargetCalc2) :
-							lwmf::CalcManhattanDistance<float>(Neighbours[i] / Width, Neighbours[i] % Width, TargetCalc1, TargetCalc2) };
+					continue;
+				}
 
-						NodesToVisit.push(NodeStruct(Neighbours[i], NewCost + HeuristicCost));
+				VisitNode(Context, Neighbour);
 
-						Costs[Neighbours[i]] = NewCost;
-						Paths[Neighbours[i]] = Current.Index;
-					}
+				if (const float NewCost{ Context.Costs[Current] + Map[Neighbour] }; NewCost < Context.Costs[Neighbour])
+				{
+					const float HeuristicCost{ Diagonal ? lwmf::CalcChebyshevDistance<float>(Neighbour / Width, TargetRow, Neighbour % Width, TargetColumn) :
+						lwmf::CalcManhattanDistance<float>(Neighbour / Width, TargetRow, Neighbour % Width, TargetColumn) };
+
+					Context.Costs[Neighbour] = NewCost;
+					Context.Paths[Neighbour] = Current;
+					PushNode(Context, Neighbour, NewCost + HeuristicCost);
+				}
+			}
+		}
+
+		if (!PathFound)
+		{
+			return false;
+		}
+
+		for (std::int_fast32_t Index{ Target }; Index != Start;)
+		{
+			Index = Context.Paths[Index];
+			WayPoints.emplace_back(Index % Width, Index / Width);
+		}
+
+		std::reverse(WayPoints.begin(), WayPoints.end());
+
+		return true;
+	}
+
+	inline bool CalculatePath(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Start, const std::int_fast32_t Target, const bool Diagonal, std::vector<lwmf::IntPointStruct>& WayPoints)
+	{
+		return CalculatePath(Map, Width, Height, Start, Target, Diagonal, WayPoints, SearchContext);
+	}
+
+	//
+	// Jump point search
+	//
+	// A* which skips the symmetric paths of uniform cost grids - instead of every tile only the "jump points" (tiles where the path may turn) are put on the heap
+	// Only valid for maps where all walkable tiles have the same cost, which is true for FlattenedMap
+	//
+	// See explanation here:
+	//
+	// https://harablog.wordpress.com/2011/09/07/jump-point-search/
+	// https://github.com/qiao/PathFinding.js (pruning rules for four neighbours)
+	//
+
+	inline bool IsWalkable(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t X, const std::int_fast32_t Y)
+	{
+		return X >= 0 && X < Width && Y >= 0 && Y < Height && Map[Width * Y + X] != FLT_MAX;
+	}
+
+	// Checks if a straight move has to stop on X/Y because a neighbour can only be reached optimally from here
+	inline bool IsForced(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t X, const std::int_fast32_t Y, const std::int_fast32_t DirX, const std::int_fast32_t DirY, const bool Diagonal)
+	{
+		if (Diagonal)
+		{
+			return DirX != 0 ?
+				(IsWalkable(Map, Width, Height, X + DirX, Y + 1) && !IsWalkable(Map, Width, Height, X, Y + 1)) || (IsWalkable(Map, Width, Height, X + DirX, Y - 1) && !IsWalkable(Map, Width, Height, X, Y - 1)) :
+				(IsWalkable(Map, Width, Height, X + 1, Y + DirY) && !IsWalkable(Map, Width, Height, X + 1, Y)) || (IsWalkable(Map, Width, Height, X - 1, Y + DirY) && !IsWalkable(Map, Width, Height, X - 1, Y));
+		}
+
+		return DirX != 0 ?
+			(IsWalkable(Map, Width, Height, X, Y - 1) && !IsWalkable(Map, Width, Height, X - DirX, Y - 1)) || (IsWalkable(Map, Width, Height, X, Y + 1) && !IsWalkable(Map, Width, Height, X - DirX, Y + 1)) :
+			(IsWalkable(Map, Width, Height, X - 1, Y) && !IsWalkable(Map, Width, Height, X - 1, Y - DirY)) || (IsWalkable(Map, Width, Height, X + 1, Y) && !IsWalkable(Map, Width, Height, X + 1, Y - DirY));
+	}
+
+	inline std::size_t GetDirectionIndex(const std::int_fast32_t DirX, const std::int_fast32_t DirY)
+	{
+		return DirX != 0 ? (DirX > 0 ? 0 : 1) : (DirY > 0 ? 2 : 3);
+	}
+
+	// Calculates one row (or column) for both directions, walking backwards against the direction of the move
+	inline void CalculateJumpDistanceLine(JumpDistancesStruct& JumpDistances, const std::int_fast32_t Line, const bool Horizontal)
+	{
+		const std::int_fast32_t Length{ Horizontal ? JumpDistances.Width : JumpDistances.Height };
+
+		for (const std::int_fast32_t Dir : { 1, -1 })
+		{
+			std::vector<std::int32_t>& Distances{ JumpDistances.Distances[Horizontal ? GetDirectionIndex(Dir, 0) : GetDirectionIndex(0, Dir)] };
+			std::int32_t Next{ -1 };
+
+			for (std::int_fast32_t i{ Dir > 0 ? Length - 1 : 0 }; i >= 0 && i < Length; i -= Dir)
+			{
+				const std::int_fast32_t X{ Horizontal ? i : Line };
+				const std::int_fast32_t Y{ Horizontal ? Line : i };
+				std::int32_t Distance{ -1 };
+
+				if (IsWalkable(*JumpDistances.Map, JumpDistances.Width, JumpDistances.Height, X, Y))
+				{
+					Distance = IsForced(*JumpDistances.Map, JumpDistances.Width, JumpDistances.Height, X, Y, Horizontal ? Dir : 0, Horizontal ? 0 : Dir, JumpDistances.Diagonal) ? 0 : (Next >= 0 ? Next + 1 : Next - 1);
 				}
+
+				Distances[static_cast<std::size_t>(JumpDistances.Width * Y + X)] = Distance;
+				Next = Distance;
+			}
+		}
+	}
+
+	// Without diagonal moves only horizontal moves are straight ones, vertical moves are searched like diagonal moves
+	inline void CalculateJumpDistances(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const bool Diagonal, JumpDistancesStruct& JumpDistances)
+	{
+		JumpDistances.Map = &Map;
+		JumpDistances.TopologyVersion = TopologyVersion;
+		JumpDistances.Width = Width;
+		JumpDistances.Height = Height;
+		JumpDistances.Diagonal = Diagonal;
+
+		for (std::size_t i{}; i < JumpDistances.Distances.size(); ++i)
+		{
+			JumpDistances.Distances[i].assign(i < 2 || Diagonal ? static_cast<std::size_t>(Width) * static_cast<std::size_t>(Height) : 0, -1);
+		}
+
+		for (std::int_fast32_t y{}; y < Height; ++y)
+		{
+			CalculateJumpDistanceLine(JumpDistances, y, true);
+		}
+
+		if (Diagonal)
+		{
+			for (std::int_fast32_t x{}; x < Width; ++x)
+			{
+				CalculateJumpDistanceLine(JumpDistances, x, false);
+			}
+		}
+	}
+
+	// A changed tile only changes the jump points of its own and the neighbouring rows and columns
+	inline void UpdateJumpDistances(const std::int_fast32_t X, const std::int_fast32_t Y, JumpDistancesStruct& JumpDistances)
+	{
+		for (std::int_fast32_t y{ std::max<std::int_fast32_t>(Y - 1, 0) }; y <= std::min<std::int_fast32_t>(Y + 1, JumpDistances.Height - 1); ++y)
+		{
+			CalculateJumpDistanceLine(JumpDistances, y, true);
+		}
+
+		if (JumpDistances.Diagonal)
+		{
+			for (std::int_fast32_t x{ std::max<std::int_fast32_t>(X - 1, 0) }; x <= std::min<std::int_fast32_t>(X + 1, JumpDistances.Width - 1); ++x)
+			{
+				CalculateJumpDistanceLine(JumpDistances, x, false);
 			}
 		}
 
-		std::int_fast32_t Index{ Target };
+		JumpDistances.TopologyVersion = TopologyVersion;
+	}
+
+	// Same result as a straight Jump() - the target stops the move if it lies on the way to the jump point (or wall)
+	inline std::int_fast32_t LookupJump(const JumpDistancesStruct& JumpDistances, const std::int_fast32_t X, const std::int_fast32_t Y, const std::int_fast32_t DirX, const std::int_fast32_t DirY, const std::int_fast32_t Target)
+	{
+		if (X < 0 || X >= JumpDistances.Width || Y < 0 || Y >= JumpDistances.Height)
+		{
+			return -1;
+		}
+
+		const std::int_fast32_t Index{ JumpDistances.Width * Y + X };
+		const std::int_fast32_t Distance{ JumpDistances.Distances[GetDirectionIndex(DirX, DirY)][static_cast<std::size_t>(Index)] };
+		const std::int_fast32_t LastStep{ Distance >= 0 ? Distance : -Distance - 2 };
+		const std::int_fast32_t TargetX{ Target % JumpDistances.Width };
+		const std::int_fast32_t TargetY{ Target / JumpDistances.Width };
+
+		if (const std::int_fast32_t TargetStep{ DirX != 0 ? (TargetY == Y ? (TargetX - X) * DirX : -1) : (TargetX == X ? (TargetY - Y) * DirY : -1) }; TargetStep >= 0 && TargetStep <= LastStep)
+		{
+			return Target;
+		}
+
+		return Distance >= 0 ? Index + Distance * (JumpDistances.Width * DirY + DirX) : -1;
+	}
+
+	// Walks from X/Y into the given direction and returns the first jump point, or -1 if a wall is hit first
+	inline std::int_fast32_t Jump(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, std::int_fast32_t X, std::int_fast32_t Y, const std::int_fast32_t DirX, const std::int_fast32_t DirY, const std::int_fast32_t Target, const bool Diagonal, const JumpDistancesStruct* JumpDistances)
+	{
+		if (JumpDistances != nullptr && (DirY == 0 || (DirX == 0 && Diagonal)))
+		{
+			return LookupJump(*JumpDistances, X, Y, DirX, DirY, Target);
+		}
 
-		while (Index != Start)
+		while (IsWalkable(Map, Width, Height, X, Y))
 		{
-			if (Paths[Index] != 0)
+			const std::int_fast32_t Index{ Width * Y + X };
+
+			if (Index == Target)
+			{
+				return Index;
+			}
+
+			if (DirX != 0 && DirY != 0)
+			{
+				if ((IsWalkable(Map, Width, Height, X - DirX, Y + DirY) && !IsWalkable(Map, Width, Height, X - DirX, Y))
+					|| (IsWalkable(Map, Width, Height, X + DirX, Y - DirY) && !IsWalkable(Map, Width, Height, X, Y - DirY)))
+				{
+					return Index;
+				}
+
+				// A diagonal move only continues if no straight move from here finds a jump point
+				if (Jump(Map, Width, Height, X + DirX, Y, DirX, 0, Target, Diagonal, JumpDistances) != -1 || Jump(Map, Width, Height, X, Y + DirY, 0, DirY, Target, Diagonal, JumpDistances) != -1)
+				{
+					return Index;
+				}
+			}
+			else if (IsForced(Map, Width, Height, X, Y, DirX, DirY, Diagonal))
+			{
+				return Index;
+			}
+			// Without diagonal moves, vertical moves are the "diagonal" ones - they only continue if no horizontal move from here finds a jump point
+			else if (!Diagonal && DirX == 0 && (Jump(Map, Width, Height, X + 1, Y, 1, 0, Target, Diagonal, JumpDistances) != -1 || Jump(Map, Width, Height, X - 1, Y, -1, 0, Target, Diagonal, JumpDistances) != -1))
 			{
-				WayPoints.emplace_front(Paths[Index] % Width, Paths[Index] / Width);
+				return Index;
 			}
 
-			Index = Paths[Index];
+			X += DirX;
+			Y += DirY;
 		}
 
-		return PathFound;
+		return -1;
 	}
 
+	inline bool CalculateJumpPointPath(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Start, const std::int_fast32_t Target, const bool Diagonal, std::vector<lwmf::IntPointStruct>& WayPoints, SearchContextStruct& Context)
+	{
+		WayPoints.clear();
+
+		const std::int_fast32_t MapSize{ Width * Height };
+
+		if (Start < 0 || Start >= MapSize || Target < 0 || Target >= MapSize)
+		{
+			return false;
+		}
+
+		const std::int_fast32_t TargetRow{ Target / Width };
+		const std::int_fast32_t TargetColumn{ Target % Width };
+		const JumpDistancesStruct* JumpDistances{ (FlattenedMapJumpDistances.Map == &Map && FlattenedMapJumpDistances.Diagonal == Diagonal && FlattenedMapJumpDistances.TopologyVersion == TopologyVersion) ? &FlattenedMapJumpDistances : nullptr };
+		std::array<lwmf::IntPointStruct, 8> Directions{};
+		bool PathFound{};
+
+		BeginSearch(Context, MapSize);
+		VisitNode(Context, Start);
+		Context.Costs[Start] = 0.0F;
+		Context.Paths[Start] = Start;
+		PushNode(Context, Start, 0.0F);
+
+		while (!Context.Heap.empty())
+		{
+			const std::int_fast32_t Current{ PopNode(Context) };
+			++Context.ExpandedNodes;
+
+			if (Current == Target)
+			{
+				PathFound = true;
+				break;
+			}
+
+			const std::int_fast32_t X{ Current % Width };
+			const std::int_fast32_t Y{ Current / Width };
+			std::size_t NumberOfDirections{};
+
+			// Prune the directions by the direction the node was reached from
+			if (Current == Start)
+			{
+				for (std::int_fast32_t DirY{ -1 }; DirY <= 1; ++DirY)
+				{
+					for (std::int_fast32_t DirX{ -1 }; DirX <= 1; ++DirX)
+					{
+						if ((DirX != 0 || DirY != 0) && (Diagonal || DirX == 0 || DirY == 0))
+						{
+							Directions[NumberOfDirections++] = { DirX, DirY };
+						}
+					}
+				}
+			}
+			else
+			{
+				const std::int_fast32_t Parent{ Context.Paths[Current] };
+				const std::int_fast32_t DirX{ (X > Parent % Width) - (X < Parent % Width) };
+				const std::int_fast32_t DirY{ (Y > Parent / Width) - (Y < Parent / Width) };
+
+				if (DirX != 0 && DirY != 0)
+				{
+					Directions[NumberOfDirections++] = { 0, DirY };
+					Directions[NumberOfDirections++] = { DirX, 0 };
+					Directions[NumberOfDirections++] = { DirX, DirY };
+
+					if (!IsWalkable(Map, Width, Height, X - DirX, Y))
+					{
+						Directions[NumberOfDirections++] = { -DirX, DirY };
+					}
+
+					if (!IsWalkable(Map, Width, Height, X, Y - DirY))
+					{
+						Directions[NumberOfDirections++] = { DirX, -DirY };
+					}
+				}
+				else if (Diagonal)
+				{
+					Directions[NumberOfDirections++] = { DirX, DirY };
+
+					if (!IsWalkable(Map, Width, Height, X + DirY, Y + DirX))
+					{
+						Directions[NumberOfDirections++] = { DirX + DirY, DirY + DirX };
+					}
+
+					if (!IsWalkable(Map, Width, Height, X - DirY, Y - DirX))
+					{
+						Directions[NumberOfDirections++] = { DirX - DirY, DirY - DirX };
+					}
+				}
+				else
+				{
+					Directions[NumberOfDirections++] = { DirX, DirY };
+					Directions[NumberOfDirections++] = { DirY, DirX };
+					Directions[NumberOfDirections++] = { -DirY, -DirX };
+				}
+			}
+
+			for (std::size_t i{}; i < NumberOfDirections; ++i)
+			{
+				const std::int_fast32_t JumpPoint{ Jump(Map, Width, Height, X + Directions[i].X, Y + Directions[i].Y, Directions[i].X, Directions[i].Y, Target, Diagonal, JumpDistances) };
+
+				if (JumpPoint == -1)
+				{
+					continue;
+				}
+
+				VisitNode(Context, JumpPoint);
+
+				// All tiles between two jump points lie on a straight or diagonal line
+				const std::int_fast32_t DistanceX{ std::abs(JumpPoint % Width - X) };
+				const std::int_fast32_t DistanceY{ std::abs(JumpPoint / Width - Y) };
+
+				if (const float NewCost{ Context.Costs[Current] + static_cast<float>(Diagonal ? std::max(DistanceX, DistanceY) : DistanceX + DistanceY) }; NewCost < Context.Costs[JumpPoint])
+				{
+					const float HeuristicCost{ Diagonal ? lwmf::CalcChebyshevDistance<float>(JumpPoint / Width, TargetRow, JumpPoint % Width, TargetColumn) :
+						lwmf::CalcManhattanDistance<float>(JumpPoint / Width, TargetRow, JumpPoint % Width, TargetColumn) };
+
+					Context.Costs[JumpPoint] = NewCost;
+					Context.Paths[JumpPoint] = Current;
+					PushNode(Context, JumpPoint, NewCost + HeuristicCost);
+				}
+			}
+		}
+
+		if (!PathFound)
+		{
+			return false;
+		}
+
+		// Fill in the tiles between the jump points, so the waypoints are the same as the ones of CalculatePath()
+		for (std::int_fast32_t Index{ Target }; Index != Start;)
+		{
+			const std::int_fast32_t Parent{ Context.Paths[Index] };
+			const std::int_fast32_t StepX{ (Parent % Width > Index % Width) - (Parent % Width < Index % Width) };
+			const std::int_fast32_t StepY{ (Parent / Width > Index / Width) - (Parent / Width < Index / Width) };
+
+			for (lwmf::IntPointStruct Tile{ Index % Width, Index / Width }; Width * Tile.Y + Tile.X != Parent;)
+			{
+				Tile.X += StepX;
+				Tile.Y += StepY;
+				WayPoints.emplace_back(Tile);
+			}
+
+			Index = Parent;
+		}
+
+		std::reverse(WayPoints.begin(), WayPoints.end());
+
+		return true;
+	}
+
+	inline bool CalculateJumpPointPath(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Start, const std::int_fast32_t Target, const bool Diagonal, std::vector<lwmf::IntPointStruct>& WayPoints)
+	{
+		return CalculateJumpPointPath(Map, Width, Height, Start, Target, Diagonal, WayPoints, SearchContext);
+	}
+
+	//
+	// Hierarchical pathfinding (HPA*)
+	//
+	// The search runs on the abstract graph of cluster entrances first, afterwards the path between two consecutive entrances is refined by A*
+	// So a query only touches the clusters along the way instead of the whole map - the paths are near optimal
+	//
+	// See explanation here:
+	//
+	// https://webdocs.cs.ualberta.ca/~mmueller/ps/hpastar.pdf
+	//
+
+	inline std::int_fast32_t GetCluster(const HierarchyStruct& Hierarchy, const std::int_fast32_t Tile)
+	{
+		return Tile / Hierarchy.Width / ClusterSize * Hierarchy.ClustersX + Tile % Hierarchy.Width / ClusterSize;
+	}
+
+	// Position of the tile inside its cluster
+	inline std::size_t GetClusterPosition(const HierarchyStruct& Hierarchy, const std::int_fast32_t Tile)
+	{
+		return static_cast<std::size_t>(Tile / Hierarchy.Width % ClusterSize * ClusterSize + Tile % Hierarchy.Width % ClusterSize);
+	}
+
+	// Finds the openings of the border to the neighbour on the east (or south) of the cluster
+	inline void CalculateTransitions(HierarchyStruct& Hierarchy, const std::int_fast32_t Cluster, const bool East)
+	{
+		std::vector<std::pair<std::int_fast32_t, std::int_fast32_t>>& Transitions{ East ? Hierarchy.EastTransitions[Cluster] : Hierarchy.SouthTransitions[Cluster] };
+		Transitions.clear();
+
+		const std::int_fast32_t ClusterX{ Cluster % Hierarchy.ClustersX };
+		const std::int_fast32_t ClusterY{ Cluster / Hierarchy.ClustersX };
+
+		if ((East && ClusterX + 1 >= Hierarchy.ClustersX) || (!East && ClusterY + 1 >= Hierarchy.ClustersY))
+		{
+			return;
+		}
+
+		const std::vector<float>& Map{ *Hierarchy.Map };
+		const std::int_fast32_t Length{ East ? std::min(ClusterSize, Hierarchy.Height - ClusterY * ClusterSize) : std::min(ClusterSize, Hierarchy.Width - ClusterX * ClusterSize) };
+		const std::int_fast32_t FirstTile{ East ? Hierarchy.Width * ClusterY * ClusterSize + ClusterX * ClusterSize + ClusterSize - 1 : Hierarchy.Width * (ClusterY * ClusterSize + ClusterSize - 1) + ClusterX * ClusterSize };
+		const std::int_fast32_t Step{ East ? Hierarchy.Width : 1 };
+		const std::int_fast32_t Across{ East ? 1 : Hierarchy.Width };
+		std::int_fast32_t OpeningStart{ -1 };
+
+		for (std::int_fast32_t i{}; i <= Length; ++i)
+		{
+			const std::int_fast32_t Tile{ FirstTile + i * Step };
+
+			if (i < Length && Map[Tile] != FLT_MAX && Map[Tile + Across] != FLT_MAX)
+			{
+				OpeningStart = OpeningStart == -1 ? i : OpeningStart;
+			}
+			else if (OpeningStart != -1)
+			{
+				if (const std::int_fast32_t OpeningLength{ i - OpeningStart }; OpeningLength <= MaxSingleTransitionLength)
+				{
+					const std::int_fast32_t Middle{ FirstTile + (OpeningStart + OpeningLength / 2) * Step };
+					Transitions.emplace_back(Middle, Middle + Across);
+				}
+				else
+				{
+					Transitions.emplace_back(FirstTile + OpeningStart * Step, FirstTile + OpeningStart * Step + Across);
+					Transitions.emplace_back(Tile - Step, Tile - Step + Across);
+				}
+
+				OpeningStart = -1;
+			}
+		}
+	}
+
+	// Search which does not leave the cluster, the costs are indexed by the position of the tile inside the cluster
+	// Walkable tiles all have the same cost, so the tiles are visited in the order they are reached (breadth-first) - a tile whose cost drops later
+	// (possible with other costs only) is just queued again
+	inline void CalculateClusterCosts(const HierarchyStruct& Hierarchy, const std::int_fast32_t Cluster, const std::int_fast32_t From, std::array<float, 256>& Costs, std::vector<std::int_fast32_t>& Queue)
+	{
+		static_assert(ClusterSize * ClusterSize == 256, "Size of Costs has to match ClusterSize!");
+
+		const std::vector<float>& Map{ *Hierarchy.Map };
+		const std::int_fast32_t Left{ Cluster % Hierarchy.ClustersX * ClusterSize };
+		const std::int_fast32_t Top{ Cluster / Hierarchy.ClustersX * ClusterSize };
+		const std::int_fast32_t ClusterWidth{ std::min(ClusterSize, Hierarchy.Width - Left) };
+		const std::int_fast32_t ClusterHeight{ std::min(ClusterSize, Hierarchy.Height - Top) };
+
+		Costs.fill(FLT_MAX);
+		Costs[GetClusterPosition(Hierarchy, From)] = 0.0F;
+		Queue.clear();
+		Queue.emplace_back(static_cast<std::int_fast32_t>(GetClusterPosition(Hierarchy, From)));
+
+		for (std::size_t Head{}; Head < Queue.size(); ++Head)
+		{
+			const std::int_fast32_t Position{ Queue[Head] };
+			const std::int_fast32_t X{ Position % ClusterSize };
+			const std::int_fast32_t Y{ Position / ClusterSize };
+
+			for (std::int_fast32_t NeighbourY{ std::max<std::int_fast32_t>(Y - 1, 0) }; NeighbourY <= std::min(Y + 1, ClusterHeight - 1); ++NeighbourY)
+			{
+				for (std::int_fast32_t NeighbourX{ std::max<std::int_fast32_t>(X - 1, 0) }; NeighbourX <= std::min(X + 1, ClusterWidth - 1); ++NeighbourX)
+				{
+					if ((NeighbourX == X && NeighbourY == Y) || (!Hierarchy.Diagonal && NeighbourX != X && NeighbourY != Y))
+					{
+						continue;
+					}
+
+					const std::int_fast32_t Neighbour{ NeighbourY * ClusterSize + NeighbourX };
+
+					if (const float TileCost{ Map[Hierarchy.Width * (Top + NeighbourY) + Left + NeighbourX] }; TileCost != FLT_MAX && Costs[Position] + TileCost < Costs[Neighbour])
+					{
+						Costs[Neighbour] = Costs[Position] + TileCost;
+						Queue.emplace_back(Neighbour);
+					}
+				}
+			}
+		}
+	}
+
+	// Collects the entrances of the cluster from the transitions of its four borders and calculates the costs between them
+	inline void BuildCluster(HierarchyStruct& Hierarchy, const std::int_fast32_t Cluster, std::vector<std::int_fast32_t>& Queue)
+	{
+		ClusterStruct& ClusterData{ Hierarchy.Clusters[Cluster] };
+		ClusterData.Entrances.clear();
+		ClusterData.Links.clear();
+
+		const auto AddLink{ [&ClusterData](const std::int_fast32_t Entrance, const std::int_fast32_t Link)
+		{
+			const auto Position{ std::find(ClusterData.Entrances.begin(), ClusterData.Entrances.end(), Entrance) };
+
+			if (Position == ClusterData.Entrances.end())
+			{
+				ClusterData.Entrances.emplace_back(Entrance);
+				ClusterData.Links.emplace_back(1, Link);
+			}
+			else
+			{
+				ClusterData.Links[static_cast<std::size_t>(Position - ClusterData.Entrances.begin())].emplace_back(Link);
+			}
+		} };
+
+		for (const auto& [Tile, Neighbour] : Hierarchy.EastTransitions[Cluster])
+		{
+			AddLink(Tile, Neighbour);
+		}
+
+		for (const auto& [Tile, Neighbour] : Hierarchy.SouthTransitions[Cluster])
+		{
+			AddLink(Tile, Neighbour);
+		}
+
+		if (Cluster % Hierarchy.ClustersX > 0)
+		{
+			for (const auto& [Tile, Neighbour] : Hierarchy.EastTransitions[Cluster - 1])
+			{
+				AddLink(Neighbour, Tile);
+			}
+		}
+
+		if (Cluster / Hierarchy.ClustersX > 0)
+		{
+			for (const auto& [Tile, Neighbour] : Hierarchy.SouthTransitions[Cluster - Hierarchy.ClustersX])
+			{
+				AddLink(Neighbour, Tile);
+			}
+		}
+
+		const std::size_t NumberOfEntrances{ ClusterData.Entrances.size() };
+		std::array<float, 256> Costs{};
+
+		ClusterData.Costs.resize(NumberOfEntrances * NumberOfEntrances);
+
+		for (std::size_t i{}; i < NumberOfEntrances; ++i)
+		{
+			CalculateClusterCosts(Hierarchy, Cluster, ClusterData.Entrances[i], Costs, Queue);
+
+			for (std::size_t j{}; j < NumberOfEntrances; ++j)
+			{
+				ClusterData.Costs[i * NumberOfEntrances + j] = Costs[GetClusterPosition(Hierarchy, ClusterData.Entrances[j])];
+			}
+		}
+	}
+
+	inline void CalculateHierarchy(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const bool Diagonal, HierarchyStruct& Hierarchy)
+	{
+		Hierarchy.Map = &Map;
+		Hierarchy.TopologyVersion = TopologyVersion;
+		Hierarchy.Width = Width;
+		Hierarchy.Height = Height;
+		Hierarchy.ClustersX = (Width + ClusterSize - 1) / ClusterSize;
+		Hierarchy.ClustersY = (Height + ClusterSize - 1) / ClusterSize;
+		Hierarchy.Diagonal = Diagonal;
+
+		const std::size_t NumberOfClusters{ static_cast<std::size_t>(Hierarchy.ClustersX) * static_cast<std::size_t>(Hierarchy.ClustersY) };
+		Hierarchy.Clusters.assign(NumberOfClusters, {});
+		Hierarchy.EastTransitions.assign(NumberOfClusters, {});
+		Hierarchy.SouthTransitions.assign(NumberOfClusters, {});
+
+		for (std::int_fast32_t Cluster{}; Cluster < static_cast<std::int_fast32_t>(NumberOfClusters); ++Cluster)
+		{
+			CalculateTransitions(Hierarchy, Cluster, true);
+			CalculateTransitions(Hierarchy, Cluster, false);
+		}
+
+		std::vector<std::int_fast32_t> Queue;
+
+		for (std::int_fast32_t Cluster{}; Cluster < static_cast<std::int_fast32_t>(NumberOfClusters); ++Cluster)
+		{
+			BuildCluster(Hierarchy, Cluster, Queue);
+		}
+	}
+
+	// A changed tile only changes its own cluster - and the neighbouring cluster if the tile is on their common border
+	inline void UpdateHierarchy(const std::int_fast32_t X, const std::int_fast32_t Y, HierarchyStruct& Hierarchy)
+	{
+		const std::int_fast32_t Cluster{ GetCluster(Hierarchy, Hierarchy.Width * Y + X) };
+		std::array<std::int_fast32_t, 3> ChangedClusters{ Cluster, -1, -1 };
+		std::size_t NumberOfChangedClusters{ 1 };
+
+		if (X % ClusterSize == ClusterSize - 1 && Cluster % Hierarchy.ClustersX + 1 < Hierarchy.ClustersX)
+		{
+			CalculateTransitions(Hierarchy, Cluster, true);
+			ChangedClusters[NumberOfChangedClusters++] = Cluster + 1;
+		}
+		else if (X % ClusterSize == 0 && Cluster % Hierarchy.ClustersX > 0)
+		{
+			CalculateTransitions(Hierarchy, Cluster - 1, true);
+			ChangedClusters[NumberOfChangedClusters++] = Cluster - 1;
+		}
+
+		if (Y % ClusterSize == ClusterSize - 1 && Cluster / Hierarchy.ClustersX + 1 < Hierarchy.ClustersY)
+		{
+			CalculateTransitions(Hierarchy, Cluster, false);
+			ChangedClusters[NumberOfChangedClusters++] = Cluster + Hierarchy.ClustersX;
+		}
+		else if (Y % ClusterSize == 0 && Cluster / Hierarchy.ClustersX > 0)
+		{
+			CalculateTransitions(Hierarchy, Cluster - Hierarchy.ClustersX, false);
+			ChangedClusters[NumberOfChangedClusters++] = Cluster - Hierarchy.ClustersX;
+		}
+
+		std::vector<std::int_fast32_t> Queue;
+
+		for (std::size_t i{}; i < NumberOfChangedClusters; ++i)
+		{
+			BuildCluster(Hierarchy, ChangedClusters[i], Queue);
+		}
+
+		Hierarchy.TopologyVersion = TopologyVersion;
+	}
+
+	// Appends the path from From to To without To - both are in the same cluster, or are neighbours on both sides of a border (a link)
+	// The search does not leave the cluster, so it costs at most one cluster no matter how large the map is
+	// Returns false if To cannot be reached from From inside the cluster
+	inline bool RefineHierarchicalSegment(const HierarchyStruct& Hierarchy, const std::int_fast32_t From, const std::int_fast32_t To, std::vector<lwmf::IntPointStruct>& WayPoints, SearchContextStruct& Context)
+	{
+		const std::int_fast32_t Width{ Hierarchy.Width };
+		const std::int_fast32_t Cluster{ GetCluster(Hierarchy, From) };
+
+		if (GetCluster(Hierarchy, To) != Cluster)
+		{
+			if (std::abs(From / Width - To / Width) + std::abs(From % Width - To % Width) != 1)
+			{
+				return false;
+			}
+
+			WayPoints.emplace_back(From % Width, From / Width);
+			return true;
+		}
+
+		std::array<float, 256> Costs{};
+		CalculateClusterCosts(Hierarchy, Cluster, To, Costs, Context.ClusterQueue);
+		Context.ExpandedNodes += static_cast<std::uint_fast32_t>(Context.ClusterQueue.size());
+
+		const std::int_fast32_t Left{ Cluster % Hierarchy.ClustersX * ClusterSize };
+		const std::int_fast32_t Top{ Cluster / Hierarchy.ClustersX * ClusterSize };
+		const std::int_fast32_t Right{ std::min(Left + ClusterSize, Width) - 1 };
+		const std::int_fast32_t Bottom{ std::min(Top + ClusterSize, Hierarchy.Height) - 1 };
+
+		// Costs are counted from To and grow with every step, so the neighbour with the lowest cost is always a step on a shortest path
+		for (std::int_fast32_t Tile{ From }; Tile != To;)
+		{
+			const std::int_fast32_t X{ Tile % Width };
+			const std::int_fast32_t Y{ Tile / Width };
+			float NextCost{ Costs[GetClusterPosition(Hierarchy, Tile)] };
+			std::int_fast32_t Next{ -1 };
+
+			for (std::int_fast32_t NeighbourY{ std::max(Y - 1, Top) }; NeighbourY <= std::min(Y + 1, Bottom); ++NeighbourY)
+			{
+				for (std::int_fast32_t NeighbourX{ std::max(X - 1, Left) }; NeighbourX <= std::min(X + 1, Right); ++NeighbourX)
+				{
+					if ((NeighbourX == X && NeighbourY == Y) || (!Hierarchy.Diagonal && NeighbourX != X && NeighbourY != Y))
+					{
+						continue;
+					}
+
+					if (const std::int_fast32_t Neighbour{ Width * NeighbourY + NeighbourX }; Costs[GetClusterPosition(Hierarchy, Neighbour)] < NextCost)
+					{
+						NextCost = Costs[GetClusterPosition(Hierarchy, Neighbour)];
+						Next = Neighbour;
+					}
+				}
+			}
+
+			if (Next == -1)
+			{
+				return false;
+			}
+
+			WayPoints.emplace_back(X, Y);
+			Tile = Next;
+		}
+
+		return true;
+	}
+
+	inline bool CalculateHierarchicalPath(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Start, const std::int_fast32_t Target, const bool Diagonal, std::vector<lwmf::IntPointStruct>& WayPoints, SearchContextStruct& Context)
+	{
+		const HierarchyStruct& Hierarchy{ FlattenedMapHierarchy };
+
+		const std::int_fast32_t MapSize{ Width * Height };
+
+		// Plain A* is used without an up-to-date abstract graph of this map, and for short distances - the detours over the entrances would cost more than they save
+		if (Hierarchy.Map != &Map || Hierarchy.Diagonal != Diagonal || Hierarchy.TopologyVersion != TopologyVersion
+			|| Start < 0 || Start >= MapSize || Target < 0 || Target >= MapSize || std::abs(Start / Width - Target / Width) + std::abs(Start % Width - Target % Width) <= ClusterSize)
+		{
+			return CalculatePath(Map, Width, Height, Start, Target, Diagonal, WayPoints, Context);
+		}
+
+		WayPoints.clear();
+
+		// Start and target are connected to the entrances of their clusters just for this search
+		const std::int_fast32_t StartCluster{ GetCluster(Hierarchy, Start) };
+		const std::int_fast32_t TargetCluster{ GetCluster(Hierarchy, Target) };
+		const std::int_fast32_t TargetRow{ Target / Width };
+		const std::int_fast32_t TargetColumn{ Target % Width };
+		std::array<float, 256> StartCosts{};
+		std::array<float, 256> TargetCosts{};
+		std::uint_fast32_t ExpandedNodes{};
+		bool PathFound{};
+
+		CalculateClusterCosts(Hierarchy, StartCluster, Start, StartCosts, Context.ClusterQueue);
+		CalculateClusterCosts(Hierarchy, TargetCluster, Target, TargetCosts, Context.ClusterQueue);
+
+		const auto AddEdge{ [&](const std::int_fast32_t Current, const std::int_fast32_t Node, const float Cost)
+		{
+			if (Cost == FLT_MAX)
+			{
+				return;
+			}
+
+			VisitNode(Context, Node);
+
+			if (const float NewCost{ Context.Costs[Current] + Cost }; NewCost < Context.Costs[Node])
+			{
+				const float HeuristicCost{ Diagonal ? lwmf::CalcChebyshevDistance<float>(Node / Width, TargetRow, Node % Width, TargetColumn) :
+					lwmf::CalcManhattanDistance<float>(Node / Width, TargetRow, Node % Width, TargetColumn) };
+
+				Context.Costs[Node] = NewCost;
+				Context.Paths[Node] = Current;
+				PushNode(Context, Node, NewCost + HeuristicCost);
+			}
+		} };
+
+		BeginSearch(Context, MapSize);
+		VisitNode(Context, Start);
+		Context.Costs[Start] = 0.0F;
+		Context.Paths[Start] = Start;
+		PushNode(Context, Start, 0.0F);
+
+		while (!Context.Heap.empty())
+		{
+			const std::int_fast32_t Current{ PopNode(Context) };
+			++ExpandedNodes;
+
+			if (Current == Target)
+			{
+				PathFound = true;
+				break;
+			}
+
+			const std::int_fast32_t Cluster{ GetCluster(Hierarchy, Current) };
+			const ClusterStruct& ClusterData{ Hierarchy.Clusters[Cluster] };
+
+			if (Current == Start)
+			{
+				for (const std::int_fast32_t Entrance : ClusterData.Entrances)
+				{
+					AddEdge(Current, Entrance, StartCosts[GetClusterPosition(Hierarchy, Entrance)]);
+				}
+			}
+
+			if (const auto Position{ std::find(ClusterData.Entrances.begin(), ClusterData.Entrances.end(), Current) }; Position != ClusterData.Entrances.end())
+			{
+				const std::size_t Index{ static_cast<std::size_t>(Position - ClusterData.Entrances.begin()) };
+				const std::size_t NumberOfEntrances{ ClusterData.Entrances.size() };
+
+				for (std::size_t i{}; i < NumberOfEntrances; ++i)
+				{
+					if (i != Index)
+					{
+						AddEdge(Current, ClusterData.Entrances[i], ClusterData.Costs[Index * NumberOfEntrances + i]);
+					}
+				}
+
+				for (const std::int_fast32_t Link : ClusterData.Links[Index])
+				{
+					AddEdge(Current, Link, Map[Link]);
+				}
+			}
+
+			if (Cluster == TargetCluster)
+			{
+				AddEdge(Current, Target, TargetCosts[GetClusterPosition(Hierarchy, Current)]);
+			}
+		}
+
+		// Transitions are only placed where a straight step crosses the border - with diagonal moves, a path squeezing diagonally through
+		// a corner on the border is only found by A*
+		if (!PathFound && Diagonal)
+		{
+			const bool Result{ CalculatePath(Map, Width, Height, Start, Target, Diagonal, WayPoints, Context) };
+			Context.ExpandedNodes += ExpandedNodes;
+			return Result;
+		}
+
+		if (!PathFound)
+		{
+			Context.ExpandedNodes = ExpandedNodes;
+			return false;
+		}
+
+		Context.AbstractPath.clear();
+
+		for (std::int_fast32_t Index{ Target }; Index != Start; Index = Context.Paths[Index])
+		{
+			Context.AbstractPath.emplace_back(Index);
+		}
+
+		Context.AbstractPath.emplace_back(Start);
+		std::reverse(Context.AbstractPath.begin(), Context.AbstractPath.end());
+
+		// Refine - every part of the abstract path lies within one cluster or crosses a border
+		Context.ExpandedNodes = ExpandedNodes;
+
+		for (std::size_t i{}; i + 1 < Context.AbstractPath.size(); ++i)
+		{
+			// Not expected with an up-to-date graph, but a part that cannot be refined must not leave a broken path behind
+			if (!RefineHierarchicalSegment(Hierarchy, Context.AbstractPath[i], Context.AbstractPath[i + 1], WayPoints, Context))
+			{
+				ExpandedNodes = Context.ExpandedNodes;
+				const bool Result{ CalculatePath(Map, Width, Height, Start, Target, Diagonal, WayPoints, Context) };
+				Context.ExpandedNodes += ExpandedNodes;
+				return Result;
+			}
+		}
+
+		return true;
+	}
+
+	inline bool CalculateHierarchicalPath(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Start, const std::int_fast32_t Target, const bool Diagonal, std::vector<lwmf::IntPointStruct>& WayPoints)
+	{
+		return CalculateHierarchicalPath(Map, Width, Height, Start, Target, Diagonal, WayPoints, SearchContext);
+	}
+
+	//
+	// Incremental search (LPA*, with the moving target handled as in D* Lite)
+	//
+	// The search tree of the last search is kept - when the target moves or tiles change, only the part of the tree depending on them is searched again
+	// The tree is rooted at Start, so a new start (the pursuer entered another tile) needs a new search, while the faster moving target only adds to KeyModifier
+	//
+	// See explanation here:
+	//
+	// http://idm-lab.org/bib/abstracts/papers/aaai02b.pdf (D* Lite)
+	// http://idm-lab.org/bib/abstracts/papers/aamas10a.pdf (Moving Target D* Lite)
+	//
+
+	inline bool operator < (const IncrementalNodeStruct& Node1, const IncrementalNodeStruct& Node2)
+	{
+		return Node1.Key < Node2.Key || (Node1.Key == Node2.Key && Node1.Cost < Node2.Cost);
+	}
+
+	// The standard heap functions build a max heap, so the order is turned around
+	inline bool CompareIncrementalNodes(const IncrementalNodeStruct& Node1, const IncrementalNodeStruct& Node2)
+	{
+		return Node2 < Node1;
+	}
+
+	// Unused entries (outside of the map, no diagonal moves) are set to -1
+	inline void GetNeighbours(const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Index, const bool Diagonal, std::array<std::int_fast32_t, 8>& Neighbours)
+	{
+		const std::int_fast32_t Row{ Index / Width };
+		const std::int_fast32_t Column{ Index % Width };
+		const std::int_fast32_t IndexPlusWidth{ Index + Width };
+		const std::int_fast32_t IndexMinusWidth{ Index - Width };
+
+		Neighbours[0] = (Diagonal && Row > 0 && Column > 0) ? IndexMinusWidth - 1 : -1;
+		Neighbours[1] = (Row > 0) ? IndexMinusWidth : -1;
+		Neighbours[2] = (Diagonal && Row > 0 && Column + 1 < Width) ? IndexMinusWidth + 1 : -1;
+		Neighbours[3] = (Column > 0) ? Index - 1 : -1;
+		Neighbours[4] = (Column + 1 < Width) ? Index + 1 : -1;
+		Neighbours[5] = (Diagonal && Row + 1 < Height && Column > 0) ? IndexPlusWidth - 1 : -1;
+		Neighbours[6] = (Row + 1 < Height) ? IndexPlusWidth : -1;
+		Neighbours[7] = (Diagonal && Row + 1 < Height && Column + 1 < Width) ? IndexPlusWidth + 1 : -1;
+	}
+
+	// Position of the tile in the hash table, or of the free entry it would be added at
+	inline std::size_t GetIncrementalTilePosition(const IncrementalSearchStruct& Search, const std::int_fast32_t Index)
+	{
+		const std::size_t Mask{ Search.Tiles.size() - 1 };
+		std::uint_fast32_t Hash{ static_cast<std::uint_fast32_t>(Index) * 0x9E3779B1U & 0xFFFFFFFFU };
+		std::size_t Position{ (Hash ^ (Hash >> 16)) & Mask };
+
+		while (Search.Tiles[Position].Index != Index && Search.Tiles[Position].Index != -1)
+		{
+			Position = (Position + 1) & Mask;
+		}
+
+		return Position;
+	}
+
+	// Untouched tiles return a free entry, which has neither cost nor lookahead
+	inline const IncrementalTileStruct& FindIncrementalTile(const IncrementalSearchStruct& Search, const std::int_fast32_t Index)
+	{
+		return Search.Tiles[GetIncrementalTilePosition(Search, Index)];
+	}
+
+	// The table is kept at most half full - growing it invalidates all references to its entries
+	inline IncrementalTileStruct& AddIncrementalTile(IncrementalSearchStruct& Search, const std::int_fast32_t Index)
+	{
+		std::size_t Position{ GetIncrementalTilePosition(Search, Index) };
+
+		if (Search.Tiles[Position].Index == Index)
+		{
+			return Search.Tiles[Position];
+		}
+
+		if ((Search.NumberOfTiles + 1) * 2 > Search.Tiles.size())
+		{
+			std::vector<IncrementalTileStruct> OldTiles(Search.Tiles.size() * 2);
+			OldTiles.swap(Search.Tiles);
+
+			for (const IncrementalTileStruct& Tile : OldTiles)
+			{
+				if (Tile.Index != -1)
+				{
+					Search.Tiles[GetIncrementalTilePosition(Search, Tile.Index)] = Tile;
+				}
+			}
+
+			Position = GetIncrementalTilePosition(Search, Index);
+		}
+
+		IncrementalTileStruct& Tile{ Search.Tiles[Position] };
+		Tile.Index = Index;
+		++Search.NumberOfTiles;
+
+		return Tile;
+	}
+
+	// Keeps one entry with the current key per queued tile which is still inconsistent
+	inline void CompactIncrementalQueue(IncrementalSearchStruct& Search, const std::int_fast32_t Width)
+	{
+		Search.Queue.erase(std::remove_if(Search.Queue.begin(), Search.Queue.end(), [&Search](const IncrementalNodeStruct& Node)
+		{
+			const IncrementalTileStruct& Tile{ FindIncrementalTile(Search, Node.Index) };
+			return Tile.Cost == Tile.Lookahead;
+		}), Search.Queue.end());
+
+		std::sort(Search.Queue.begin(), Search.Queue.end(), [](const IncrementalNodeStruct& Node1, const IncrementalNodeStruct& Node2) { return Node1.Index < Node2.Index; });
+		Search.Queue.erase(std::unique(Search.Queue.begin(), Search.Queue.end(), [](const IncrementalNodeStruct& Node1, const IncrementalNodeStruct& Node2) { return Node1.Index == Node2.Index; }), Search.Queue.end());
+
+		for (IncrementalNodeStruct& Node : Search.Queue)
+		{
+			Node = GetIncrementalKey(Search, Width, Node.Index);
+		}
+
+		std::make_heap(Search.Queue.begin(), Search.Queue.end(), CompareIncrementalNodes);
+		Search.QueueLimit = std::max(Search.Queue.size() * 2, MinIncrementalQueueLimit);
+	}
+
+	inline IncrementalNodeStruct GetIncrementalKey(const IncrementalSearchStruct& Search, const std::int_fast32_t Width, const std::int_fast32_t Index)
+	{
+		const IncrementalTileStruct& Tile{ FindIncrementalTile(Search, Index) };
+		const float Cost{ std::min(Tile.Cost, Tile.Lookahead) };
+
+		if (Cost == FLT_MAX)
+		{
+			return { FLT_MAX, FLT_MAX, Index };
+		}
+
+		const float HeuristicCost{ Search.Diagonal ? lwmf::CalcChebyshevDistance<float>(Index / Width, Search.Target / Width, Index % Width, Search.Target % Width) :
+			lwmf::CalcManhattanDistance<float>(Index / Width, Search.Target / Width, Index % Width, Search.Target % Width) };
+
+		return { Cost + HeuristicCost + Search.KeyModifier, Cost, Index };
+	}
+
+	inline void QueueIncrementalNode(IncrementalSearchStruct& Search, const std::int_fast32_t Width, const std::int_fast32_t Index)
+	{
+		Search.Queue.emplace_back(GetIncrementalKey(Search, Width, Index));
+		std::push_heap(Search.Queue.begin(), Search.Queue.end(), CompareIncrementalNodes);
+
+		if (Search.Queue.size() > Search.QueueLimit)
+		{
+			CompactIncrementalQueue(Search, Width);
+		}
+	}
+
+	// Recalculates the lookahead of a tile from its neighbours and queues the tile if it became inconsistent
+	inline void UpdateIncrementalNode(IncrementalSearchStruct& Search, const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Index)
+	{
+		if (Index == Search.Start)
+		{
+			return;
+		}
+
+		float Lookahead{ FLT_MAX };
+
+		if (Map[Index] != FLT_MAX)
+		{
+			std::array<std::int_fast32_t, 8> Neighbours{};
+			GetNeighbours(Width, Height, Index, Search.Diagonal, Neighbours);
+
+			for (const std::int_fast32_t Neighbour : Neighbours)
+			{
+				if (Neighbour >= 0)
+				{
+					if (const float NeighbourCost{ FindIncrementalTile(Search, Neighbour).Cost }; NeighbourCost != FLT_MAX)
+					{
+						Lookahead = std::min(Lookahead, NeighbourCost + Map[Index]);
+					}
+				}
+			}
+		}
+
+		// Untouched tiles without a lookahead stay untouched
+		if (FindIncrementalTile(Search, Index).Index == -1 && Lookahead == FLT_MAX)
+		{
+			return;
+		}
+
+		IncrementalTileStruct& Tile{ AddIncrementalTile(Search, Index) };
+		Tile.Lookahead = Lookahead;
+
+		if (Tile.Cost != Lookahead)
+		{
+			QueueIncrementalNode(Search, Width, Index);
+		}
+	}
+
+	// The hash table is cleared instead of freed, but shrunk if the last search needed much less of it
+	inline void StartIncrementalSearch(IncrementalSearchStruct& Search, const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Start, const std::int_fast32_t Target, const bool Diagonal)
+	{
+		if (Search.Tiles.size() < MinIncrementalTiles || Search.Tiles.size() > std::max(Search.NumberOfTiles * 8, MinIncrementalTiles))
+		{
+			std::size_t Size{ MinIncrementalTiles };
+
+			while (Size < Search.NumberOfTiles * 2)
+			{
+				Size *= 2;
+			}
+
+			Search.Tiles.assign(Size, {});
+		}
+		else
+		{
+			std::fill(Search.Tiles.begin(), Search.Tiles.end(), IncrementalTileStruct{});
+		}
+
+		Search.NumberOfTiles = 0;
+		Search.Queue.clear();
+		Search.QueueLimit = MinIncrementalQueueLimit;
+		Search.Map = &Map;
+		Search.Start = Start;
+		Search.Target = Target;
+		Search.KeyModifier = 0.0F;
+		Search.Diagonal = Diagonal;
+
+		AddIncrementalTile(Search, Start).Lookahead = 0.0F;
+		QueueIncrementalNode(Search, Width, Start);
+	}
+
+	// Expands inconsistent tiles until the cost of the target is known - all tiles with a smaller key are then consistent
+	inline void RepairIncrementalSearch(IncrementalSearchStruct& Search, const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height)
+	{
+		std::array<std::int_fast32_t, 8> Neighbours{};
+
+		while (!Search.Queue.empty())
+		{
+			const IncrementalNodeStruct Top{ Search.Queue.front() };
+
+			if (const IncrementalTileStruct& TargetTile{ FindIncrementalTile(Search, Search.Target) }; !(Top < GetIncrementalKey(Search, Width, Search.Target)) && TargetTile.Cost == TargetTile.Lookahead)
+			{
+				break;
+			}
+
+			std::pop_heap(Search.Queue.begin(), Search.Queue.end(), CompareIncrementalNodes);
+			Search.Queue.pop_back();
+
+			const std::int_fast32_t Current{ Top.Index };
+
+			// Tile was made consistent in the meantime
+			const IncrementalTileStruct CurrentTile{ FindIncrementalTile(Search, Current) };
+
+			if (CurrentTile.Cost == CurrentTile.Lookahead)
+			{
+				continue;
+			}
+
+			// Keys of queued tiles only grow (target moved) - requeue with the current key, or skip the entry if the tile was queued again with a smaller one
+			if (const IncrementalNodeStruct Key{ GetIncrementalKey(Search, Width, Current) }; Top < Key)
+			{
+				Search.Queue.emplace_back(Key);
+				std::push_heap(Search.Queue.begin(), Search.Queue.end(), CompareIncrementalNodes);
+				continue;
+			}
+			else if (Key < Top)
+			{
+				continue;
+			}
+
+			++Search.ExpandedNodes;
+			GetNeighbours(Width, Height, Current, Search.Diagonal, Neighbours);
+
+			if (CurrentTile.Cost > CurrentTile.Lookahead)
+			{
+				// Overconsistent - the tile got cheaper, pass it on to the neighbours
+				AddIncrementalTile(Search, Current).Cost = CurrentTile.Lookahead;
+
+				for (const std::int_fast32_t Neighbour : Neighbours)
+				{
+					if (Neighbour < 0 || Neighbour == Search.Start || Map[Neighbour] == FLT_MAX)
+					{
+						continue;
+					}
+
+					// Every walkable neighbour gets a lookahead here, so it can be added right away
+					const float NewCost{ CurrentTile.Lookahead + Map[Neighbour] };
+
+					if (IncrementalTileStruct& NeighbourTile{ AddIncrementalTile(Search, Neighbour) }; NewCost < NeighbourTile.Lookahead)
+					{
+						NeighbourTile.Lookahead = NewCost;
+
+						if (NeighbourTile.Cost != NewCost)
+						{
+							QueueIncrementalNode(Search, Width, Neighbour);
+						}
+					}
+				}
+			}
+			else
+			{
+				// Underconsistent - the tile got more expensive (or unreachable), the tile and its neighbours have to look for other ways
+				AddIncrementalTile(Search, Current).Cost = FLT_MAX;
+				UpdateIncrementalNode(Search, Map, Width, Height, Current);
+
+				for (const std::int_fast32_t Neighbour : Neighbours)
+				{
+					if (Neighbour >= 0)
+					{
+						UpdateIncrementalNode(Search, Map, Width, Height, Neighbour);
+					}
+				}
+			}
+		}
+	}
+
+	// Same as CalculatePath(), but continues the search kept in Search - a new search is only started if Start, the map or the diagonal setting changed,
+	// or if the tile changes since the last call are not logged anymore (new level)
+	inline bool CalculateIncrementalPath(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Start, const std::int_fast32_t Target, const bool Diagonal, std::vector<lwmf::IntPointStruct>& WayPoints, IncrementalSearchStruct& Search)
+	{
+		WayPoints.clear();
+		Search.ExpandedNodes = 0;
+
+		const std::int_fast32_t MapSize{ Width * Height };
+
+		if (Start < 0 || Start >= MapSize || Target < 0 || Target >= MapSize || Map.size() != static_cast<std::size_t>(MapSize))
+		{
+			return false;
+		}
+
+		if (Search.Map != &Map || Search.Start != Start || Search.Diagonal != Diagonal || Search.TopologyVersion < ChangedTilesBaseVersion)
+		{
+			StartIncrementalSearch(Search, Map, Width, Start, Target, Diagonal);
+		}
+		else
+		{
+			if (Search.Target != Target)
+			{
+				Search.KeyModifier += Diagonal ? lwmf::CalcChebyshevDistance<float>(Search.Target / Width, Target / Width, Search.Target % Width, Target % Width) :
+					lwmf::CalcManhattanDistance<float>(Search.Target / Width, Target / Width, Search.Target % Width, Target % Width);
+				Search.Target = Target;
+			}
+
+			// Entering a changed tile got cheaper or more expensive, which changes the lookaheads of the tile and of its neighbours (diagonal moves depend on them)
+			std::array<std::int_fast32_t, 8> Neighbours{};
+
+			for (std::uint_fast32_t Version{ Search.TopologyVersion }; Version < TopologyVersion; ++Version)
+			{
+				const std::int_fast32_t ChangedTile{ ChangedTiles[Version - ChangedTilesBaseVersion] };
+
+				UpdateIncrementalNode(Search, Map, Width, Height, ChangedTile);
+				GetNeighbours(Width, Height, ChangedTile, Diagonal, Neighbours);
+
+				for (const std::int_fast32_t Neighbour : Neighbours)
+				{
+					if (Neighbour >= 0)
+					{
+						UpdateIncrementalNode(Search, Map, Width, Height, Neighbour);
+					}
+				}
+			}
+		}
+
+		Search.TopologyVersion = TopologyVersion;
+		RepairIncrementalSearch(Search, Map, Width, Height);
+
+		if (FindIncrementalTile(Search, Target).Cost == FLT_MAX)
+		{
+			return false;
+		}
+
+		// Walk back from the target, always to the neighbour the tile is reached from cheapest
+		for (std::int_fast32_t Index{ Target }; Index != Start;)
+		{
+			std::array<std::int_fast32_t, 8> Neighbours{};
+			GetNeighbours(Width, Height, Index, Diagonal, Neighbours);
+
+			std::int_fast32_t Previous{ -1 };
+			float PreviousCost{ FLT_MAX };
+
+			for (const std::int_fast32_t Neighbour : Neighbours)
+			{
+				if (const float NeighbourCost{ Neighbour >= 0 ? FindIncrementalTile(Search, Neighbour).Cost : FLT_MAX }; Previous == -1 || NeighbourCost < PreviousCost)
+				{
+					Previous = Neighbour;
+					PreviousCost = NeighbourCost;
+				}
+			}
+
+			if (Previous == -1 || PreviousCost >= FindIncrementalTile(Search, Index).Cost || WayPoints.size() >= static_cast<std::size_t>(MapSize))
+			{
+				WayPoints.clear();
+				return false;
+			}
+
+			Index = Previous;
+			WayPoints.emplace_back(Index % Width, Index / Width);
+		}
+
+		std::reverse(WayPoints.begin(), WayPoints.end());
+
+		return true;
+	}
+
+	// OldestVersionInUse is the oldest topology version an incremental search still has to catch up from
+	inline void TrimChangedTiles(const std::uint_fast32_t OldestVersionInUse)
+	{
+		std::size_t DroppedTiles{ OldestVersionInUse > ChangedTilesBaseVersion ? std::min<std::size_t>(OldestVersionInUse - ChangedTilesBaseVersion, ChangedTiles.size()) : 0 };
+
+		// Half of the changes are dropped at once, so the log is not shifted on every change
+		if (ChangedTiles.size() - DroppedTiles > MaxChangedTiles)
+		{
+			DroppedTiles = ChangedTiles.size() - MaxChangedTiles / 2;
+		}
+
+		ChangedTiles.erase(ChangedTiles.begin(), ChangedTiles.begin() + static_cast<std::ptrdiff_t>(DroppedTiles));
+		ChangedTilesBaseVersion += static_cast<std::uint_fast32_t>(DroppedTiles);
+	}
+
+	//
+	// Flow field (Dijkstra map)
+	//
+	// One Dijkstra search starting at the target covers every tile of the map, see:
+	// https://www.redblobgames.com/pathfinding/tower-defense/
+	//
+
+	inline void CalculateFlowField(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Target, const bool Diagonal, FlowFieldStruct& FlowField)
+	{
+		const std::size_t MapSize{ static_cast<std::size_t>(Width) * static_cast<std::size_t>(Height) };
+
+		FlowField.Costs.assign(MapSize, FLT_MAX);
+		FlowField.NextTiles.assign(MapSize, -1);
+		FlowField.Target = Target;
+		FlowField.TopologyVersion = TopologyVersion;
+		FlowField.Diagonal = Diagonal;
+
+		if (Target < 0 || static_cast<std::size_t>(Target) >= MapSize)
+		{
+			return;
+		}
+
+		std::array<std::int_fast32_t, 8> Neighbours{};
+		std::priority_queue<NodeStruct> NodesToVisit{};
+
+		FlowField.Costs[Target] = 0.0F;
+		NodesToVisit.push(NodeStruct(Target, 0.0F));
+
+		while (!NodesToVisit.empty())
+		{
+			const NodeStruct Current{ NodesToVisit.top() };
+			NodesToVisit.pop();
+
+			// Tile was reached cheaper in the meantime
+			if (Current.Cost > FlowField.Costs[Current.Index])
+			{
+				continue;
+			}
+
+			const std::int_fast32_t Row{ Current.Index / Width };
+			const std::int_fast32_t Column{ Current.Index % Width };
+			const std::int_fast32_t IndexPlusWidth{ Current.Index + Width };
+			const std::int_fast32_t IndexMinusWidth{ Current.Index - Width };
+
+			Neighbours[0] = (Diagonal && Row > 0 && Column > 0) ? IndexMinusWidth - 1 : -1;
+			Neighbours[1] = (Row > 0) ? IndexMinusWidth : -1;
+			Neighbours[2] = (Diagonal && Row > 0 && Column + 1 < Width) ? IndexMinusWidth + 1 : -1;
+			Neighbours[3] = (Column > 0) ? Current.Index - 1 : -1;
+			Neighbours[4] = (Column + 1 < Width) ? Current.Index + 1 : -1;
+			Neighbours[5] = (Diagonal && Row + 1 < Height && Column > 0) ? IndexPlusWidth - 1 : -1;
+			Neighbours[6] = (Row + 1 < Height) ? IndexPlusWidth : -1;
+			Neighbours[7] = (Diagonal && Row + 1 < Height && Column + 1 < Width) ? IndexPlusWidth + 1 : -1;
+
+			// The search runs backwards - stepping from a neighbour onto the current tile costs as much as entering the current tile (same as in CalculatePath())
+			const float NewCost{ FlowField.Costs[Current.Index] + Map[Current.Index] };
+
+			for (const std::int_fast32_t Neighbour : Neighbours)
+			{
+				if (Neighbour >= 0 && Map[Neighbour] < FLT_MAX && NewCost < FlowField.Costs[Neighbour])
+				{
+					FlowField.Costs[Neighbour] = NewCost;
+					FlowField.NextTiles[Neighbour] = Current.Index;
+					NodesToVisit.push(NodeStruct(Neighbour, NewCost));
+				}
+			}
+		}
+	}
+
+	// Recalculates the flow field only if the target or the map changed, returns true if it was recalculated
+	inline bool UpdateFlowField(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Target, const bool Diagonal, FlowFieldStruct& FlowField)
+	{
+		if (FlowField.Target == Target && FlowField.TopologyVersion == TopologyVersion && FlowField.Diagonal == Diagonal && FlowField.Costs.size() == Map.size())
+		{
+			return false;
+		}
+
+		CalculateFlowField(Map, Width, Height, Target, Diagonal, FlowField);
+		return true;
+	}
+
+	// Returns -1 if the target cannot be reached from Start (or Start is the target)
+	inline std::int_fast32_t GetNextTile(const FlowFieldStruct& FlowField, const std::int_fast32_t Start)
+	{
+		return (Start >= 0 && static_cast<std::size_t>(Start) < FlowField.NextTiles.size()) ? FlowField.NextTiles[Start] : -1;
+	}
+
+
+	//
+	// Benchmark
+	//
+	// Times the searches on synthetic maps with the same start/target pairs on every run - results are written to NARC.log
+	//
+
+	inline void GenerateRandomMap(std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t WallPercentage, std::mt19937& Random)
+	{
+		// The raw output of std::mt19937 is the same with every standard library, the distributions are not
+		Map.assign(static_cast<std::size_t>(Width) * static_cast<std::size_t>(Height), 1.0F);
+
+		for (float& Tile : Map)
+		{
+			if (static_cast<std::int_fast32_t>(Random() % 100) < WallPercentage)
+			{
+				Tile = FLT_MAX;
+			}
+		}
+	}
+
+	// Square rooms with a door in the middle of every wall and a few random pillars
+	inline void GenerateRoomMap(std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t RoomSize, std::mt19937& Random)
+	{
+		GenerateRandomMap(Map, Width, Height, 2, Random);
+
+		for (std::int_fast32_t y{}; y < Height; ++y)
+		{
+			for (std::int_fast32_t x{}; x < Width; ++x)
+			{
+				if ((x % RoomSize == 0 && y % RoomSize != RoomSize / 2) || (y % RoomSize == 0 && x % RoomSize != RoomSize / 2))
+				{
+					Map[static_cast<std::size_t>(Width * y + x)] = FLT_MAX;
+				}
+			}
+		}
+	}
+
+	// Perfect maze (exactly one way between any two places) with corridors of CorridorWidth tiles and walls of one tile, carved by a depth-first walk over the cells
+	inline void GenerateMazeMap(std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t CorridorWidth, std::mt19937& Random)
+	{
+		Map.assign(static_cast<std::size_t>(Width) * static_cast<std::size_t>(Height), FLT_MAX);
+
+		const std::int_fast32_t CellStep{ CorridorWidth + 1 };
+		const std::int_fast32_t CellsX{ (Width - 1) / CellStep };
+		const std::int_fast32_t CellsY{ (Height - 1) / CellStep };
+		std::vector<std::uint_fast8_t> VisitedCells(static_cast<std::size_t>(CellsX) * static_cast<std::size_t>(CellsY));
+		std::vector<std::int_fast32_t> Stack{ 0 };
+
+		const auto Carve{ [&](const std::int_fast32_t Left, const std::int_fast32_t Top, const std::int_fast32_t CarveWidth, const std::int_fast32_t CarveHeight)
+		{
+			for (std::int_fast32_t y{ Top }; y < Top + CarveHeight; ++y)
+			{
+				std::fill_n(Map.begin() + Width * y + Left, CarveWidth, 1.0F);
+			}
+		} };
+
+		VisitedCells[0] = 1;
+		Carve(1, 1, CorridorWidth, CorridorWidth);
+
+		while (!Stack.empty())
+		{
+			const std::int_fast32_t Cell{ Stack.back() };
+			const std::int_fast32_t CellX{ Cell % CellsX };
+			const std::int_fast32_t CellY{ Cell / CellsX };
+			std::array<std::int_fast32_t, 4> Neighbours{};
+			std::size_t NumberOfNeighbours{};
+
+			if (CellX > 0 && VisitedCells[Cell - 1] == 0)
+			{
+				Neighbours[NumberOfNeighbours++] = Cell - 1;
+			}
+
+			if (CellX + 1 < CellsX && VisitedCells[Cell + 1] == 0)
+			{
+				Neighbours[NumberOfNeighbours++] = Cell + 1;
+			}
+
+			if (CellY > 0 && VisitedCells[Cell - CellsX] == 0)
+			{
+				Neighbours[NumberOfNeighbours++] = Cell - CellsX;
+			}
+
+			if (CellY + 1 < CellsY && VisitedCells[Cell + CellsX] == 0)
+			{
+				Neighbours[NumberOfNeighbours++] = Cell + CellsX;
+			}
+
+			if (NumberOfNeighbours == 0)
+			{
+				Stack.pop_back();
+				continue;
+			}
+
+			// The next cell and the wall towards it are carved as one rectangle
+			const std::int_fast32_t Next{ Neighbours[Random() % NumberOfNeighbours] };
+			const std::int_fast32_t NextX{ Next % CellsX };
+			const std::int_fast32_t NextY{ Next / CellsX };
+
+			Carve(1 + std::min(CellX, NextX) * CellStep, 1 + std::min(CellY, NextY) * CellStep, NextX != CellX ? CellStep + CorridorWidth : CorridorWidth, NextY != CellY ? CellStep + CorridorWidth : CorridorWidth);
+			VisitedCells[Next] = 1;
+			Stack.emplace_back(Next);
+		}
+	}
+
+	// MaxDistance limits the distance between start and target on both axes (0 is unlimited), both are always walkable
+	inline void GenerateBenchmarkQueries(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t NumberOfQueries, const std::int_fast32_t MaxDistance, std::mt19937& Random, std::vector<std::pair<std::int_fast32_t, std::int_fast32_t>>& Queries)
+	{
+		Queries.clear();
+
+		while (static_cast<std::int_fast32_t>(Queries.size()) < NumberOfQueries)
+		{
+			const std::int_fast32_t Start{ static_cast<std::int_fast32_t>(Random() % Map.size()) };
+			std::int_fast32_t Target{ static_cast<std::int_fast32_t>(Random() % Map.size()) };
+
+			if (MaxDistance > 0)
+			{
+				const std::int_fast32_t X{ Start % Width + static_cast<std::int_fast32_t>(Random() % (2 * MaxDistance + 1)) - MaxDistance };
+				const std::int_fast32_t Y{ Start / Width + static_cast<std::int_fast32_t>(Random() % (2 * MaxDistance + 1)) - MaxDistance };
+
+				if (X < 0 || X >= Width || Y < 0 || Y >= Height)
+				{
+					continue;
+				}
+
+				Target = Width * Y + X;
+			}
+
+			if (Map[Start] != FLT_MAX && Map[Target] != FLT_MAX)
+			{
+				Queries.emplace_back(Start, Target);
+			}
+		}
+	}
+
+	// Returns the fastest pass over all queries in nanoseconds
+	inline std::int_fast64_t BenchmarkSearches(const std::vector<std::pair<std::int_fast32_t, std::int_fast32_t>>& Queries, const std::int_fast32_t Passes, const std::function<bool(std::int_fast32_t, std::int_fast32_t)>& Search, std::int_fast32_t& PathsFound)
+	{
+		std::int_fast64_t FastestPass{ std::numeric_limits<std::int_fast64_t>::max() };
+
+		// The first search sizes the search context, so it is not measured
+		Search(Queries.front().first, Queries.front().second);
+
+		for (std::int_fast32_t Pass{}; Pass < Passes; ++Pass)
+		{
+			const auto StartTime{ std::chrono::steady_clock::now() };
+			PathsFound = 0;
+
+			for (const auto& [Start, Target] : Queries)
+			{
+				if (Search(Start, Target))
+				{
+					++PathsFound;
+				}
+			}
+
+			FastestPass = std::min<std::int_fast64_t>(FastestPass, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - StartTime).count());
+		}
+
+		return FastestPass;
+	}
+
+	// A* on maps with randomly placed walls from 16x16 to 1024x1024 tiles, with pairs anywhere on the map and nearby pairs
+	// Returns false if a map had no path at all, which means the maps or the search are broken
+	inline bool BenchmarkAStar(std::mt19937& Random)
+	{
+		std::vector<float> Map;
+		std::vector<std::pair<std::int_fast32_t, std::int_fast32_t>> Queries;
+		std::vector<lwmf::IntPointStruct> WayPoints;
+		bool Result{ true };
+
+		for (const std::int_fast32_t Size : BenchmarkMapSizes)
+		{
+			GenerateRandomMap(Map, Size, Size, BenchmarkWallPercentage, Random);
+
+			for (const std::int_fast32_t MaxDistance : BenchmarkMaxDistances)
+			{
+				GenerateBenchmarkQueries(Map, Size, Size, BenchmarkQueries, MaxDistance, Random, Queries);
+
+				std::uint_fast64_t ExpandedNodes{};
+				std::int_fast32_t PathsFound{};
+				const std::int_fast64_t Time{ BenchmarkSearches(Queries, BenchmarkPasses, [&](const std::int_fast32_t Start, const std::int_fast32_t Target)
+				{
+					const bool PathFound{ CalculatePath(Map, Size, Size, Start, Target, false, WayPoints) };
+					ExpandedNodes += SearchContext.ExpandedNodes;
+					return PathFound;
+				}, PathsFound) };
+
+				// Nodes were counted in the unmeasured first search and every pass
+				NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "A* " + std::to_string(Size) + "x" + std::to_string(Size) + (MaxDistance > 0 ? ", nearby pairs: " : ", random pairs: ") + std::to_string(Time / BenchmarkQueries) + " ns per search, "
+					+ std::to_string(ExpandedNodes / (static_cast<std::uint_fast64_t>(BenchmarkPasses) * BenchmarkQueries + 1)) + " nodes expanded per search, " + std::to_string(PathsFound) + " of " + std::to_string(BenchmarkQueries) + " paths found");
+
+				if (PathsFound == 0)
+				{
+					NARCLog.AddEntry(lwmf::LogLevel::Error, __FILENAME__, __LINE__, "BenchmarkAStar(): No path found on " + std::to_string(Size) + "x" + std::to_string(Size) + " map!");
+					Result = false;
+				}
+			}
+		}
+
+		return Result;
+	}
+
+	// Hierarchical searches against A* on the same pairs - open maps, rooms and mazes with wide and narrow corridors from 256x256 to 2048x2048 tiles
+	// The abstract graph is built like GenerateFlattenedMap() does in Hierarchical mode
+	// Returns false if both disagree on whether a path exists
+	inline bool BenchmarkHierarchical(std::mt19937& Random)
+	{
+		const std::array<std::string, 4> MapNames{ "Open map", "Rooms", "Maze with 3 tile corridors", "Maze with 1 tile corridors" };
+		std::vector<float> Map;
+		std::vector<std::pair<std::int_fast32_t, std::int_fast32_t>> Queries;
+		std::vector<lwmf::IntPointStruct> WayPoints;
+		bool Result{ true };
+
+		for (std::size_t MapType{}; MapType < MapNames.size(); ++MapType)
+		{
+			for (const std::int_fast32_t Size : HierarchicalBenchmarkMapSizes)
+			{
+				switch (MapType)
+				{
+					case 0:
+					{
+						GenerateRandomMap(Map, Size, Size, 0, Random);
+						break;
+					}
+					case 1:
+					{
+						GenerateRoomMap(Map, Size, Size, ClusterSize, Random);
+						break;
+					}
+					default:
+					{
+						GenerateMazeMap(Map, Size, Size, MapType == 2 ? 3 : 1, Random);
+					}
+				}
+
+				const auto StartTime{ std::chrono::steady_clock::now() };
+				CalculateHierarchy(Map, Size, Size, false, FlattenedMapHierarchy);
+				const std::int_fast64_t BuildTime{ std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - StartTime).count() };
+
+				for (const std::int_fast32_t MaxDistance : BenchmarkMaxDistances)
+				{
+					GenerateBenchmarkQueries(Map, Size, Size, HierarchicalBenchmarkQueries, MaxDistance, Random, Queries);
+
+					std::uint_fast64_t PathLength{};
+					std::uint_fast64_t HierarchicalPathLength{};
+					std::int_fast32_t PathsFound{};
+					std::int_fast32_t HierarchicalPathsFound{};
+
+					const std::int_fast64_t Time{ BenchmarkSearches(Queries, HierarchicalBenchmarkPasses, [&](const std::int_fast32_t Start, const std::int_fast32_t Target)
+					{
+						const bool PathFound{ CalculatePath(Map, Size, Size, Start, Target, false, WayPoints) };
+						PathLength += WayPoints.size();
+						return PathFound;
+					}, PathsFound) };
+
+					const std::int_fast64_t HierarchicalTime{ BenchmarkSearches(Queries, HierarchicalBenchmarkPasses, [&](const std::int_fast32_t Start, const std::int_fast32_t Target)
+					{
+						const bool PathFound{ CalculateHierarchicalPath(Map, Size, Size, Start, Target, false, WayPoints) };
+						HierarchicalPathLength += WayPoints.size();
+						return PathFound;
+					}, HierarchicalPathsFound) };
+
+					NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, MapNames[MapType] + " " + std::to_string(Size) + "x" + std::to_string(Size) + (MaxDistance > 0 ? ", nearby pairs: " : ", random pairs: ") + "A* " + std::to_string(Time / HierarchicalBenchmarkQueries / 1000) + " us, HPA* "
+						+ std::to_string(HierarchicalTime / HierarchicalBenchmarkQueries / 1000) + " us per search, HPA* paths " + std::to_string(PathLength > 0 ? (HierarchicalPathLength * 1000 / PathLength + 5) / 10 : 100) + "% of A* length, abstract graph built in " + std::to_string(BuildTime / 1000) + " ms");
+
+					if (PathsFound != HierarchicalPathsFound)
+					{
+						NARCLog.AddEntry(lwmf::LogLevel::Error, __FILENAME__, __LINE__, "BenchmarkHierarchical(): A* found " + std::to_string(PathsFound) + " paths, HPA* " + std::to_string(HierarchicalPathsFound) + " paths on " + MapNames[MapType] + " " + std::to_string(Size) + "x" + std::to_string(Size) + "!");
+						Result = false;
+					}
+				}
+			}
+		}
+
+		FlattenedMapHierarchy = {};
+
+		return Result;
+	}
+
+	inline bool BenchmarkPathFinding()
+	{
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Benchmarking path finding...");
+
+		std::mt19937 Random(BenchmarkSeed);
+		const bool AStarResult{ BenchmarkAStar(Random) };
+		const bool HierarchicalResult{ BenchmarkHierarchical(Random) };
+
+		return AStarResult && HierarchicalResult;
+	}
 
 } // namespace Game_PathFinding
\ No newline at end of file
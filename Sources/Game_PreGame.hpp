@@ -48,6 +48,17 @@ namespace Game_PreGame
 
 	inline void SetOptions()
 	{
+		// Benchmark runs must not wait for any input
+		if (ExitAfterLoadFlag)
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Exit after load - use default options...");
+
+			SelectedLevel = StartLevel;
+			Fullscreen = false;
+			VSync = false;
+			return;
+		}
+
 		std::cout << "***************\n* SET OPTIONS *\n***************\n\n";
 
 		SelectedLevel = NumberOfLevels > StartLevel ? Tools_Console::QuestionForValue("Please select Level (" + std::to_string(StartLevel) + " - " + std::to_string(NumberOfLevels) + "): ", StartLevel, NumberOfLevels) : StartLevel;
@@ -11,6 +11,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <cmath>
 #include <algorithm>
 
@@ -32,9 +33,19 @@ namespace Game_Raycaster
 		Floor
 	};
 
+	// Per column results of the ray casting, used to draw floor and ceiling row by row
+	struct FloorColumnStruct final
+	{
+		lwmf::FloatPointStruct FloorWall{};
+		float WallDistTemp{};
+		std::int_fast32_t LineStart{};
+		std::int_fast32_t LineEnd{};
+	};
+
 	void Init();
 	void RefreshSettings();
 	void CastGraphics(Renderpart Part);
+	void DrawFloorCeilingSpans(Renderpart Part, const std::vector<FloorColumnStruct>& FloorColumns, float FloorCeilingShading, std::int_fast32_t VerticalLookTemp);
 
 	//
 	// Variables and constants
@@ -97,6 +108,12 @@ namespace Game_Raycaster
 		const float FloorCeilingShading{ FogOfWarDistance + FogOfWarDistance * VerticalLookCamera };
 		const std::int_fast32_t VerticalLookTemp{ Canvas.Height + VerticalLook };
 
+		// Walls are shaded per column span, floor and ceiling per row span (see DrawFloorCeilingSpans())
+		const bool WallPartFlag{ Part == Renderpart::WallLeft || Part == Renderpart::WalLRight };
+		std::vector<lwmf::PixelType> SpanTexels(WallPartFlag ? static_cast<std::size_t>(Canvas.Height) : 0);
+		std::vector<lwmf::PixelType> SpanShaded(WallPartFlag ? static_cast<std::size_t>(Canvas.Height) : 0);
+		std::vector<FloorColumnStruct> FloorColumns(WallPartFlag ? 0 : static_cast<std::size_t>(Canvas.Width));
+
 		for (std::int_fast32_t x{ Start }; x < End; ++x)
 		{
 			const float Camera{ static_cast<float>(x + x) / static_cast<float>(Canvas.Width) - 1.0F };
@@ -197,7 +214,7 @@ namespace Game_Raycaster
 			float WallX{ WallSide ? Player.Pos.X + WallDist * RayDir.X : Player.Pos.Y + WallDist * RayDir.Y };
 			WallX -= static_cast<std::int_fast32_t>(WallX);
 
-			if (Part == Renderpart::WallLeft || Part == Renderpart::WalLRight)
+			if (WallPartFlag)
 			{
 				std::int_fast32_t TextureX{ static_cast<std::int_fast32_t>(WallX * TextureSize) & (TextureSize - 1) };
 
@@ -211,17 +228,34 @@ namespace Game_Raycaster
 					TextureX -= static_cast<std::int_fast32_t>(Doors[DoorNumber].CurrentOpenPercent / DoorTypes[Doors[DoorNumber].DoorType].MaximumOpenPercent);
 				}
 
+				const lwmf::TextureStruct& WallTexture{ DoorNumber > -1 ? Doors[DoorNumber].AnimTexture :
+					*Game_LevelHandling::LevelTextures[Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][static_cast<std::int_fast32_t>(MapPos.X)][static_cast<std::int_fast32_t>(MapPos.Y)] - 1] };
+				const std::int_fast32_t SpanLength{ std::max(LineEnd - LineStart, 0) };
+
 				for (std::int_fast32_t y{ LineStart }; y < LineEnd; ++y)
 				{
-					float WallY{ static_cast<std::int_fast32_t>((y + y - VerticalLookTemp + LineHeight) / LineHeight) * 0.5F };
-					WallY -= static_cast<std::int_fast32_t>(WallY);
-					const std::int_fast32_t TextureY{ ((y + y - VerticalLookTemp + LineHeight) * TextureSize / LineHeight) >> 1 };
-					const std::int_fast32_t WallTexel{ DoorNumber > -1 ? Doors[DoorNumber].AnimTexture.Pixels[TextureY * TextureSize + TextureX] :
-						Game_LevelHandling::LevelTextures[Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][static_cast<std::int_fast32_t>(MapPos.X)][static_cast<std::int_fast32_t>(MapPos.Y)] - 1].Pixels[TextureY * TextureSize + TextureX] };
+					SpanTexels[y - LineStart] = lwmf::GetPixel(WallTexture, TextureX, ((y + y - VerticalLookTemp + LineHeight) * TextureSize / LineHeight) >> 1);
+				}
+
+				const lwmf::PixelType* Span{ SpanTexels.data() };
+
+				if (Game_LevelHandling::LightingFlag && SpanLength > 0)
+				{
+					// Shade factor is constant for the whole column, light intensity only changes between the upper and lower half of the wall tile
+					lwmf::SIMDKernels.ShadePixels(SpanTexels.data(), SpanShaded.data(), static_cast<std::size_t>(SpanLength), WallDist, FogOfWarDistance);
 
-					if (Game_LevelHandling::LightingFlag)
+					for (std::int_fast32_t RunStart{ LineStart }; RunStart < LineEnd;)
 					{
-						std::int_fast32_t ShadedTexel{ lwmf::ShadeColor(WallTexel, WallDist, FogOfWarDistance) };
+						const std::int_fast32_t WallHalf{ (RunStart + RunStart - VerticalLookTemp + LineHeight) / LineHeight };
+						std::int_fast32_t RunEnd{ RunStart + 1 };
+
+						while (RunEnd < LineEnd && (RunEnd + RunEnd - VerticalLookTemp + LineHeight) / LineHeight == WallHalf)
+						{
+							++RunEnd;
+						}
+
+						float WallY{ WallHalf * 0.5F };
+						WallY -= static_cast<std::int_fast32_t>(WallY);
 
 						for (auto&& Light : Game_LevelHandling::StaticLights)
 						{
@@ -229,17 +263,21 @@ namespace Game_Raycaster
 							{
 								if (const float Intensity{ Light.GetIntensity(MapPos.X + WallX, MapPos.Y + WallY) }; Intensity > 0.0F)
 								{
-									ShadedTexel = lwmf::BlendColor(ShadedTexel, WallTexel, Intensity);
+									lwmf::PixelType* Run{ SpanShaded.data() + (RunStart - LineStart) };
+									lwmf::SIMDKernels.BlendPixels(Run, SpanTexels.data() + (RunStart - LineStart), Run, static_cast<std::size_t>(RunEnd - RunStart), Intensity);
 								}
 							}
 						}
 
-						lwmf::SetPixel(Canvas, x, y, ShadedTexel);
-					}
-					else
-					{
-						lwmf::SetPixel(Canvas, x, y, WallTexel);
+						RunStart = RunEnd;
 					}
+
+					Span = SpanShaded.data();
+				}
+
+				for (std::int_fast32_t y{ LineStart }; y < LineEnd; ++y)
+				{
+					lwmf::SetPixel(Canvas, x, y, Span[y - LineStart]);
 				}
 			}
 			else
@@ -268,91 +306,114 @@ namespace Game_Raycaster
 				Game_EntityHandling::ZBuffer[x] = WallDist;
 
 				LineEnd = std::clamp(LineEnd, 0, Canvas.Height);
-				const std::int_fast32_t TotalHeight{ Canvas.Height + std::abs(VerticalLook) };
-				const float WallDistTemp{ WallDist + WallDist * VerticalLookCamera };
+				FloorColumns[x] = { FloorWall, WallDist + WallDist * VerticalLookCamera, LineStart, LineEnd };
+			}
+		}
+
+		if (!WallPartFlag)
+		{
+			DrawFloorCeilingSpans(Part, FloorColumns, FloorCeilingShading, VerticalLookTemp);
+		}
+	}
 
-				for (std::int_fast32_t y{ LineEnd + 1 }; y <= TotalHeight; ++y)
+	inline void DrawFloorCeilingSpans(const Renderpart Part, const std::vector<FloorColumnStruct>& FloorColumns, const float FloorCeilingShading, const std::int_fast32_t VerticalLookTemp)
+	{
+		// The distance (and with it the shading) only depends on the row, so floor and ceiling are drawn as horizontal spans
+		// Light intensity changes per pixel, therefore lights are blended with one weight per pixel
+		const std::int_fast32_t Layer{ static_cast<std::int_fast32_t>(Part == Renderpart::Floor ? Game_LevelHandling::LevelMapLayers::Floor : Game_LevelHandling::LevelMapLayers::Ceiling) };
+		std::vector<lwmf::PixelType> SpanTexels(static_cast<std::size_t>(Canvas.Width));
+		std::vector<lwmf::PixelType> SpanWeights(static_cast<std::size_t>(Canvas.Width));
+		std::vector<lwmf::FloatPointStruct> SpanPositions(static_cast<std::size_t>(Canvas.Width));
+
+		for (std::int_fast32_t Row{}; Row < Canvas.Height; ++Row)
+		{
+			// Ceiling rows are the floor rows mirrored at the horizon
+			const std::int_fast32_t y{ Part == Renderpart::Floor ? Row : VerticalLookTemp - Row };
+			const float CurrentDist{ VerticalLookTemp / static_cast<float>(y + y - VerticalLookTemp) };
+			std::int_fast32_t SpanStart{};
+			std::int_fast32_t SpanLength{};
+
+			const auto DrawSpan{ [&]
+			{
+				if (SpanLength == 0)
 				{
-					const float CurrentDist{ VerticalLookTemp / static_cast<float>(y + y - VerticalLookTemp) };
-					const float FactorW{ CurrentDist / WallDistTemp };
-					const lwmf::FloatPointStruct Floor{ FactorW * FloorWall.X + (1.0F - FactorW) * Player.Pos.X, FactorW * FloorWall.Y + (1.0F - FactorW) * Player.Pos.Y };
+					return;
+				}
 
-					switch (Part)
-					{
-						case Renderpart::Floor:
-						{
-							// Draw floor
-							if (y < Canvas.Height)
-							{
-								const std::int_fast32_t FloorTexel{ Game_LevelHandling::LevelTextures[Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Floor)][static_cast<std::int_fast32_t>(Floor.X)][static_cast<std::int_fast32_t>(Floor.Y)] - 1].Pixels[(static_cast<std::int_fast32_t>(Floor.Y * TextureSize) & (TextureSize - 1)) * TextureSize + (static_cast<std::int_fast32_t>(Floor.X * TextureSize) & (TextureSize - 1))] };
+				lwmf::PixelType* Target{ Canvas.Pixels.data() + Row * Canvas.Stride + SpanStart };
 
-								if (Game_LevelHandling::LightingFlag)
-								{
-									std::int_fast32_t ShadedTexel{ lwmf::ShadeColor(FloorTexel, CurrentDist, FloorCeilingShading) };
-
-									for (auto&& Light : Game_LevelHandling::StaticLights)
-									{
-										if (Light.Location == static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Floor))
-										{
-											if (const float Intensity{ Light.GetIntensity(Floor.X, Floor.Y) }; Intensity > 0.0F)
-											{
-												ShadedTexel = lwmf::BlendColor(ShadedTexel, FloorTexel, Intensity);
-											}
-										}
-									}
-
-									lwmf::SetPixel(Canvas, x, y, ShadedTexel);
-								}
-								else
-								{
-									lwmf::SetPixel(Canvas, x, y, FloorTexel);
-								}
-							}
+				if (!Game_LevelHandling::LightingFlag)
+				{
+					lwmf::SIMDKernels.CopyPixels(SpanTexels.data(), Target, static_cast<std::size_t>(SpanLength));
+					return;
+				}
 
-							break;
-						}
+				lwmf::SIMDKernels.ShadePixels(SpanTexels.data(), Target, static_cast<std::size_t>(SpanLength), CurrentDist, FloorCeilingShading);
 
-						case Renderpart::Ceiling:
+				for (auto&& Light : Game_LevelHandling::StaticLights)
+				{
+					if (Light.Location == Layer)
+					{
+						for (std::int_fast32_t i{}; i < SpanLength; ++i)
 						{
-							const std::int_fast32_t LevelCeilingMapPos{ Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Ceiling)][static_cast<std::int_fast32_t>(Floor.X)][static_cast<std::int_fast32_t>(Floor.Y)] - 1};
-							const std::int_fast32_t TempY{ VerticalLookTemp - y };
+							SpanWeights[i] = lwmf::GetColorWeight(Light.GetIntensity(SpanPositions[i].X, SpanPositions[i].Y));
+						}
 
-							// Only render if ceiling is not transparent
-							// Transparent ceiling tile is marked as "-1" in "Level_MapCeilingData.conf"
-							if (LevelCeilingMapPos >= 0 && (TempY >= 0 && TempY <= LineStart))
+						// Only runs inside the light radius are blended, pixels out of reach keep their shaded color
+						for (std::int_fast32_t RunStart{}; RunStart < SpanLength;)
+						{
+							if (SpanWeights[RunStart] == 0)
 							{
-								const std::int_fast32_t CeilingTexel{ Game_LevelHandling::LevelTextures[LevelCeilingMapPos].Pixels[(static_cast<std::int_fast32_t>(Floor.Y * TextureSize) & (TextureSize - 1)) * TextureSize + (static_cast<std::int_fast32_t>(Floor.X * TextureSize) & (TextureSize - 1))] };
+								++RunStart;
+								continue;
+							}
 
-								if (Game_LevelHandling::LightingFlag)
-								{
-									std::int_fast32_t ShadedTexel{ lwmf::ShadeColor(CeilingTexel, CurrentDist, FloorCeilingShading) };
-
-									for (auto&& Light : Game_LevelHandling::StaticLights)
-									{
-										if (Light.Location == static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Ceiling))
-										{
-											if (const float Intensity{ Light.GetIntensity(Floor.X, Floor.Y) }; Intensity > 0.0F)
-											{
-												ShadedTexel = lwmf::BlendColor(ShadedTexel, CeilingTexel, Intensity);
-											}
-										}
-									}
-
-									lwmf::SetPixel(Canvas, x, TempY, ShadedTexel);
-								}
-								else
-								{
-									lwmf::SetPixel(Canvas, x, TempY, CeilingTexel);
-								}
+							std::int_fast32_t RunEnd{ RunStart + 1 };
+
+							while (RunEnd < SpanLength && SpanWeights[RunEnd] != 0)
+							{
+								++RunEnd;
 							}
 
-							break;
+							lwmf::SIMDKernels.BlendPixelsWeighted(Target + RunStart, SpanTexels.data() + RunStart, SpanWeights.data() + RunStart, Target + RunStart, static_cast<std::size_t>(RunEnd - RunStart));
+							RunStart = RunEnd;
 						}
-
-						default: {}
 					}
 				}
+			} };
+
+			for (std::int_fast32_t x{}; x < Canvas.Width; ++x)
+			{
+				const FloorColumnStruct& Column{ FloorColumns[x] };
+				std::int_fast32_t TextureIndex{ -1 };
+				lwmf::FloatPointStruct Floor{};
+
+				// Transparent ceiling tile is marked as "-1" in "Level_MapCeilingData.conf"
+				if (y > Column.LineEnd && (Part == Renderpart::Floor || Row <= Column.LineStart))
+				{
+					const float FactorW{ CurrentDist / Column.WallDistTemp };
+					Floor = { FactorW * Column.FloorWall.X + (1.0F - FactorW) * Player.Pos.X, FactorW * Column.FloorWall.Y + (1.0F - FactorW) * Player.Pos.Y };
+					TextureIndex = Game_LevelHandling::LevelMap[Layer][static_cast<std::int_fast32_t>(Floor.X)][static_cast<std::int_fast32_t>(Floor.Y)] - 1;
+				}
+
+				if (TextureIndex < 0)
+				{
+					DrawSpan();
+					SpanLength = 0;
+					continue;
+				}
+
+				if (SpanLength == 0)
+				{
+					SpanStart = x;
+				}
+
+				SpanTexels[SpanLength] = lwmf::GetPixel(*Game_LevelHandling::LevelTextures[TextureIndex], static_cast<std::int_fast32_t>(Floor.X * TextureSize) & (TextureSize - 1), static_cast<std::int_fast32_t>(Floor.Y * TextureSize) & (TextureSize - 1));
+				SpanPositions[SpanLength] = Floor;
+				++SpanLength;
 			}
+
+			DrawSpan();
 		}
 	}
 
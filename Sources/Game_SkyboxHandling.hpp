@@ -22,7 +22,7 @@ namespace Game_SkyboxHandling
 
 
 	void Init();
-	void LoadSkyboxImage();
+	void LoadSkyboxImage(GFX_ImageHandling::ImageBatchStruct& ImageBatch);
 	void Render();
 	void ClearSkyBox();
 
@@ -44,7 +44,7 @@ namespace Game_SkyboxHandling
 		SkyboxShader.LoadShader("Default", Canvas);
 	}
 
-	inline void LoadSkyboxImage()
+	inline void LoadSkyboxImage(GFX_ImageHandling::ImageBatchStruct& ImageBatch)
 	{
 		ClearSkyBox();
 
@@ -62,13 +62,14 @@ namespace Game_SkyboxHandling
 			{
 				NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load skybox image...");
 
-				const lwmf::TextureStruct TempTexture { GFX_ImageHandling::ImportImage(lwmf::ReadINIValue<std::string>(INIFile, "SKYBOX", "SkyBoxImageName"))	};
+				GFX_ImageHandling::RequestImageView(ImageBatch, lwmf::ReadINIValue<std::string>(INIFile, "SKYBOX", "SkyBoxImageName"), [](const lwmf::TextureViewStruct& TempTexture)
+				{
+					SkyboxWidth = TempTexture.Width;
+					SkyboxHeight = TempTexture.Height;
 
-				SkyboxWidth = TempTexture.Width;
-				SkyboxHeight = TempTexture.Height;
-
-				NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load skybox texture into GPU RAM...");
-				SkyboxShader.LoadTextureInGPU(TempTexture, &SkyboxShader.OGLTextureID);
+					NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load skybox texture into GPU RAM...");
+					SkyboxShader.LoadTextureInGPU(TempTexture, &SkyboxShader.OGLTextureID);
+				});
 			}
 		}
 	}
@@ -12,6 +12,7 @@
 #include <cstdint>
 #include <chrono>
 #include <string>
+#include <algorithm>
 
 #include "Game_GlobalDefinitions.hpp"
 #include "GFX_Window.hpp"
@@ -24,7 +25,8 @@ namespace Game_Transitions
 
 	void Init();
 	void LevelTransition();
-	void FizzleFade(std::int_fast32_t FadeColor, std::int_fast32_t Speed);
+	void UpdateLevelTransition(float Progress);
+	void FizzleFade(lwmf::PixelType FadeColor, std::int_fast32_t Speed);
 	void DeathSequence();
 
 	//
@@ -50,18 +52,32 @@ namespace Game_Transitions
 
 	inline void LevelTransition()
 	{
-		const std::int_fast32_t BlackNoAlpha{ lwmf::RGBAtoINT(0, 0, 0, 0) };
-		const std::string NextLevelText{ "...loading level number " + std::to_string(SelectedLevel) + "..." };
-		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "\n\n" + NextLevelText + "\n\n");
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "\n\n...loading level number " + std::to_string(SelectedLevel) + "...\n\n");
+
+		UpdateLevelTransition(0.0F);
+	}
+
+	// Called repeatedly while the level loads - Progress runs from 0.0F to 1.0F
+	inline void UpdateLevelTransition(const float Progress)
+	{
+		const lwmf::PixelType BlackNoAlpha{ lwmf::RGBAtoINT(0, 0, 0, 0) };
+		const lwmf::PixelType White{ lwmf::RGBAtoINT(255, 255, 255, 255) };
+		const std::int_fast32_t TextPosY{ Canvas.Height - GeneralText.GetFontHeight() - 50 };
+		const std::int_fast32_t BarWidth{ Canvas.Width >> 2 };
+		const std::int_fast32_t BarHeight{ 10 };
+		const std::int_fast32_t BarPosX{ Canvas.WidthMid - (BarWidth >> 1) };
+		const std::int_fast32_t BarPosY{ TextPosY - (BarHeight << 2) };
 
 		lwmf::ClearBuffer();
 		lwmf::ClearTexture(Canvas, BlackNoAlpha);
-		GeneralText.RenderTextCentered(NextLevelText, Canvas.Height - GeneralText.GetFontHeight() - 50);
+		GeneralText.RenderTextCentered("...loading level number " + std::to_string(SelectedLevel) + "...", TextPosY);
+		lwmf::Rectangle(Canvas, BarPosX, BarPosY, BarWidth, BarHeight, White);
+		lwmf::FilledRectangle(Canvas, BarPosX, BarPosY, static_cast<std::int_fast32_t>(static_cast<float>(BarWidth) * std::clamp(Progress, 0.0F, 1.0F)), BarHeight, White, White);
 		CanvasShader.RenderLWMFTexture(Canvas, true, 1.0F);
 		lwmf::SwapBuffer();
 	}
 
-	inline void FizzleFade(const std::int_fast32_t FadeColor, const std::int_fast32_t Speed)
+	inline void FizzleFade(const lwmf::PixelType FadeColor, const std::int_fast32_t Speed)
 	{
 		//
 		// This is my implementation of the famous "fizzle fade" as known from Wolfenstein 3D
@@ -122,8 +138,8 @@ namespace Game_Transitions
 
 	inline void DeathSequence()
 	{
-		const std::int_fast32_t Red{ lwmf::RGBAtoINT(255, 0, 0, 255) };
-		const std::int_fast32_t Black{ lwmf::RGBAtoINT(0, 0, 0, 255) };
+		const lwmf::PixelType Red{ lwmf::RGBAtoINT(255, 0, 0, 255) };
+		const lwmf::PixelType Black{ lwmf::RGBAtoINT(0, 0, 0, 255) };
 
 		lwmf::SetVSync(-1);
 		FizzleFade(Red, 50);
@@ -19,6 +19,7 @@
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_ErrorHandling.hpp"
+#include "Game_AssetIndex.hpp"
 #include "GFX_ImageHandling.hpp"
 #include "Game_DataStructures.hpp"
 #include "Game_LevelHandling.hpp"
@@ -56,7 +57,7 @@ namespace Game_WeaponHandling
 	};
 
 	void InitConfig();
-	void InitTextures();
+	void InitTextures(GFX_ImageHandling::ImageBatchStruct& ImageBatch);
 	void InitAudio();
 	void CheckForHit();
 	void HandleAmmoBoxPickup();
@@ -104,63 +105,53 @@ namespace Game_WeaponHandling
 		Weapons.clear();
 		Weapons.shrink_to_fit();
 
-		std::int_fast32_t Index{};
+		const std::int_fast32_t NumberOfWeapons{ Game_AssetIndex::CountNumberedFiles(AssetsWeaponsFolder, "Weapon_", "_Data.ini", 0) };
 
-		while (true)
+		for (std::int_fast32_t Index{}; Index < NumberOfWeapons; ++Index)
 		{
 			std::string INIFile{ AssetsWeaponsFolder };
 			INIFile += "Weapon_";
 			INIFile += std::to_string(Index);
 			INIFile += "_Data.ini";
 
-			if (Tools_ErrorHandling::CheckFileExistence(INIFile, ContinueOnError))
-			{
-				Weapons.emplace_back();
-
-				Weapons[Index].Number = Index;
-				Weapons[Index].Name = lwmf::ReadINIValue<std::string>(INIFile, "DATA", "Name");
-				Weapons[Index].Weight = lwmf::ReadINIValue<float>(INIFile, "DATA", "Weight");
-				Weapons[Index].Capacity = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DATA", "Capacity");
-				Weapons[Index].PaceFactor = lwmf::ReadINIValue<float>(INIFile, "DATA", "PaceFactor");
-				Weapons[Index].Damage = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DATA", "Damage");
-
-				if (const std::string WeaponTypeString{ lwmf::ReadINIValue<std::string>(INIFile, "DATA", "WeaponType") }; WeaponTypeString == "DirectHit")
-				{
-					Weapons[Index].Type = static_cast<std::int_fast32_t>(WeaponType::DirectHit);
-				}
-
-				Weapons[Index].CarriedAmmo = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DATA", "CarriedAmmo");
-				Weapons[Index].Cadence = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DATA", "Cadence");
-				Weapons[Index].WeaponRect.X = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "POSITION", "PosX");
-				Weapons[Index].WeaponRect.Y = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "POSITION", "PosY");
-				Weapons[Index].FadeInOutSpeed = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "POSITION", "FadeInOutSpeed");
-				Weapons[Index].MuzzleFlashDuration = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "MUZZLEFLASH", "MuzzleFlashDuration");
-				Weapons[Index].MuzzleFlashRect.X = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "MUZZLEFLASH", "MuzzleFlashPosX");
-				Weapons[Index].MuzzleFlashRect.Y = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "MUZZLEFLASH", "MuzzleFlashPosY");
-
-				// pre-load weapon
-				Weapons[Index].LoadedRounds = Weapons[Index].Capacity;
-
-				// Initial built of ammo info HUD strings
-				std::array<char, MaximumAmmoCapacityDigits> CapacityString{};
-				std::to_chars(CapacityString.data(), CapacityString.data() + CapacityString.size(), Weapons[Index].Capacity);
-				Weapons[Index].HUDAmmoInfo = std::string(CapacityString.data()) + "/" + std::string(CapacityString.data());
-
-				std::array<char, MaximumCarriedAmmoDigits> CarriedAmmoString{};
-				std::to_chars(CarriedAmmoString.data(), CarriedAmmoString.data() + CarriedAmmoString.size(), Weapons[Index].CarriedAmmo);
-				Weapons[Index].HUDCarriedAmmoInfo = "Carried:" + std::string(CarriedAmmoString.data());
+			Weapons.emplace_back();
 
-				// Load Shader
-				Weapons[Index].WeaponShader.LoadShader("Default", Canvas);
-				Weapons[Index].MuzzleFlashShader.LoadShader("Default", Canvas);
+			Weapons[Index].Number = Index;
+			Weapons[Index].Name = lwmf::ReadINIValue<std::string>(INIFile, "DATA", "Name");
+			Weapons[Index].Weight = lwmf::ReadINIValue<float>(INIFile, "DATA", "Weight");
+			Weapons[Index].Capacity = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DATA", "Capacity");
+			Weapons[Index].PaceFactor = lwmf::ReadINIValue<float>(INIFile, "DATA", "PaceFactor");
+			Weapons[Index].Damage = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DATA", "Damage");
 
-				++Index;
-			}
-			else
+			if (const std::string WeaponTypeString{ lwmf::ReadINIValue<std::string>(INIFile, "DATA", "WeaponType") }; WeaponTypeString == "DirectHit")
 			{
-				NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "No more weapon data found.");
-				break;
+				Weapons[Index].Type = static_cast<std::int_fast32_t>(WeaponType::DirectHit);
 			}
+
+			Weapons[Index].CarriedAmmo = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DATA", "CarriedAmmo");
+			Weapons[Index].Cadence = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DATA", "Cadence");
+			Weapons[Index].WeaponRect.X = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "POSITION", "PosX");
+			Weapons[Index].WeaponRect.Y = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "POSITION", "PosY");
+			Weapons[Index].FadeInOutSpeed = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "POSITION", "FadeInOutSpeed");
+			Weapons[Index].MuzzleFlashDuration = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "MUZZLEFLASH", "MuzzleFlashDuration");
+			Weapons[Index].MuzzleFlashRect.X = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "MUZZLEFLASH", "MuzzleFlashPosX");
+			Weapons[Index].MuzzleFlashRect.Y = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "MUZZLEFLASH", "MuzzleFlashPosY");
+
+			// pre-load weapon
+			Weapons[Index].LoadedRounds = Weapons[Index].Capacity;
+
+			// Initial built of ammo info HUD strings
+			std::array<char, MaximumAmmoCapacityDigits> CapacityString{};
+			std::to_chars(CapacityString.data(), CapacityString.data() + CapacityString.size(), Weapons[Index].Capacity);
+			Weapons[Index].HUDAmmoInfo = std::string(CapacityString.data()) + "/" + std::string(CapacityString.data());
+
+			std::array<char, MaximumCarriedAmmoDigits> CarriedAmmoString{};
+			std::to_chars(CarriedAmmoString.data(), CarriedAmmoString.data() + CarriedAmmoString.size(), Weapons[Index].CarriedAmmo);
+			Weapons[Index].HUDCarriedAmmoInfo = "Carried:" + std::string(CarriedAmmoString.data());
+
+			// Load Shader
+			Weapons[Index].WeaponShader.LoadShader("Default", Canvas);
+			Weapons[Index].MuzzleFlashShader.LoadShader("Default", Canvas);
 		}
 
 		if (Weapons.empty())
@@ -169,7 +160,7 @@ namespace Game_WeaponHandling
 		}
 	}
 
-	inline void InitTextures()
+	inline void InitTextures(GFX_ImageHandling::ImageBatchStruct& ImageBatch)
 	{
 		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load weapon textures...");
 
@@ -189,12 +180,13 @@ namespace Game_WeaponHandling
 
 				while (std::getline(WeaponTexturesData, Line))
 				{
-					const lwmf::TextureStruct TempTextureWeapon{ GFX_ImageHandling::ImportImage(Line) };
-
-					Weapon.WeaponRect.Width = TempTextureWeapon.Width;
-					Weapon.WeaponRect.Height = TempTextureWeapon.Height;
+					GFX_ImageHandling::RequestImageView(ImageBatch, Line, [&Weapon](const lwmf::TextureViewStruct& TempTextureWeapon)
+					{
+						Weapon.WeaponRect.Width = TempTextureWeapon.Width;
+						Weapon.WeaponRect.Height = TempTextureWeapon.Height;
 
-					Weapon.WeaponShader.LoadTextureInGPU(TempTextureWeapon, &Weapon.WeaponShader.OGLTextureID);
+						Weapon.WeaponShader.LoadTextureInGPU(TempTextureWeapon, &Weapon.WeaponShader.OGLTextureID);
+					});
 				}
 			}
 
@@ -212,12 +204,13 @@ namespace Game_WeaponHandling
 
 				while (std::getline(MuzzleFlashTextureData, Line))
 				{
-					const lwmf::TextureStruct TempTextureMuzzleFlash{ GFX_ImageHandling::ImportImage(Line) };
-
-					Weapon.MuzzleFlashRect.Width = TempTextureMuzzleFlash.Width;
-					Weapon.MuzzleFlashRect.Height = TempTextureMuzzleFlash.Height;
+					GFX_ImageHandling::RequestImageView(ImageBatch, Line, [&Weapon](const lwmf::TextureViewStruct& TempTextureMuzzleFlash)
+					{
+						Weapon.MuzzleFlashRect.Width = TempTextureMuzzleFlash.Width;
+						Weapon.MuzzleFlashRect.Height = TempTextureMuzzleFlash.Height;
 
-					Weapon.MuzzleFlashShader.LoadTextureInGPU(TempTextureMuzzleFlash, &Weapon.MuzzleFlashShader.OGLTextureID);
+						Weapon.MuzzleFlashShader.LoadTextureInGPU(TempTextureMuzzleFlash, &Weapon.MuzzleFlashShader.OGLTextureID);
+					});
 				}
 			}
 		}
@@ -295,16 +288,16 @@ namespace Game_WeaponHandling
 				if (!Endloop)
 				{
 					const float InverseMatrix{ 1.0F / (Plane.X * Player.Dir.Y - Player.Dir.X * Plane.Y) };
-					const std::int_fast32_t NumberOfEntities{ static_cast<std::int_fast32_t>(Entities.size()) };
 
-					for (std::int_fast32_t Index{}; Index < NumberOfEntities; ++Index)
+					// Front to back, so the first entity hit is the nearest one
+					for (std::int_fast32_t Index{}; Index < Game_EntityHandling::NumberOfVisibleEntities; ++Index)
 					{
-						if (!Entities[Game_EntityHandling::EntityOrder[Index].first].IsDead && !Endloop)
+						if (!EntityStates[Game_EntityHandling::EntityOrder[Index].first].IsDead && !Endloop)
 						{
 							const std::int_fast32_t TextureIndex{ Game_EntityHandling::GetEntityTextureIndex(Index) };
-							const lwmf::FloatPointStruct EntityPos{ Entities[Game_EntityHandling::EntityOrder[Index].first].Pos.X - Player.Pos.X, Entities[Game_EntityHandling::EntityOrder[Index].first].Pos.Y - Player.Pos.Y };
+							const lwmf::FloatPointStruct EntityPos{ EntityTransforms[Game_EntityHandling::EntityOrder[Index].first].Pos.X - Player.Pos.X, EntityTransforms[Game_EntityHandling::EntityOrder[Index].first].Pos.Y - Player.Pos.Y };
 							const float TransY{ InverseMatrix * (-Plane.Y * EntityPos.X + Plane.X * EntityPos.Y) };
-							const std::int_fast32_t vScreen{ static_cast<std::int_fast32_t>(Entities[Game_EntityHandling::EntityOrder[Index].first].MoveV / TransY) };
+							const std::int_fast32_t vScreen{ static_cast<std::int_fast32_t>(EntityTransforms[Game_EntityHandling::EntityOrder[Index].first].MoveV / TransY) };
 							const std::int_fast32_t EntitySizeTemp{ static_cast<std::int_fast32_t>(Canvas.Height / TransY) };
 							const std::int_fast32_t EntitySX{ static_cast<std::int_fast32_t>(Canvas.WidthMid * (1.0F + InverseMatrix * (Player.Dir.Y * EntityPos.X - Player.Dir.X * EntityPos.Y) / TransY)) };
 							const std::int_fast32_t LineEndX{ std::min((EntitySizeTemp >> 1) + EntitySX, Canvas.Width) };
@@ -318,9 +311,9 @@ namespace Game_WeaponHandling
 								const std::int_fast32_t TextureX{ ((x - ((-EntitySizeTemp >> 1) + EntitySX)) * EntitySize / EntitySizeTemp) };
 
 								if ((x == Canvas.WidthMid && TransY < Game_EntityHandling::ZBuffer[x]) &&
-									((EntityAssets[Entities[Entities[Game_EntityHandling::EntityOrder[Index].first].Number].TypeNumber].WalkingTextures[TextureIndex][Entities[Game_EntityHandling::EntityOrder[Index].first].WalkAnimStep].Pixels[TextureY * TextureSize + TextureX] & lwmf::AMask) != 0))
+									((lwmf::GetPixel(*EntityAssets[EntityStates[Game_EntityHandling::EntityOrder[Index].first].TypeNumber].WalkingTextures[TextureIndex][EntityAnimations[Game_EntityHandling::EntityOrder[Index].first].WalkAnimStep], TextureX, TextureY) & lwmf::AMask) != 0))
 								{
-									Game_EntityHandling::HandleEntityHit(Entities[Entities[Game_EntityHandling::EntityOrder[Index].first].Number]);
+									Game_EntityHandling::HandleEntityHit(Game_EntityHandling::EntityOrder[Index].first);
 
 									// Shot found its way, end loop
 									Endloop = true;
@@ -336,19 +329,26 @@ namespace Game_WeaponHandling
 
 	inline void HandleAmmoBoxPickup()
 	{
-		if (Game_EntityHandling::EntityMap[static_cast<std::int_fast32_t>(Player.Pos.X)][static_cast<std::int_fast32_t>(Player.Pos.Y)] == EntityTypes::AmmoBox)
+		const std::int_fast32_t Tile{ Game_EntityHandling::GetTile(static_cast<std::int_fast32_t>(Player.Pos.X), static_cast<std::int_fast32_t>(Player.Pos.Y)) };
+
+		if ((Game_EntityHandling::TileTypeMasks[Tile] & Game_EntityHandling::GetTypeMask(EntityTypes::AmmoBox)) != 0)
 		{
-			for (auto&& Entity : Entities)
+			// Only the entities on the players tile are checked, all ammo boxes on it are picked up
+			for (std::int_fast32_t Index{ Game_EntityHandling::TileFirstEntities[Tile] }; Index != -1;)
 			{
-				if (Entity.Type == EntityTypes::AmmoBox && static_cast<std::int_fast32_t>(Player.Pos.X) == static_cast<std::int_fast32_t>(Entity.Pos.X) && static_cast<std::int_fast32_t>(Player.Pos.Y) == static_cast<std::int_fast32_t>(Entity.Pos.Y))
+				// UnlinkEntityFromTile() resets the link to the next entity, so it has to be read before
+				const std::int_fast32_t Next{ Game_EntityHandling::EntityNextOnTile[Index] };
+
+				if (EntityStateStruct& State{ EntityStates[Index] }; State.Type == EntityTypes::AmmoBox)
 				{
-					Game_EntityHandling::PlayAudio(Entity.TypeNumber, Game_EntityHandling::EntitySounds::AmmoBoxPickup);
-					Entity.IsDead = true;
-					Entity.IsPickedUp = true;
+					Game_EntityHandling::PlayAudio(State.TypeNumber, Game_EntityHandling::EntitySounds::AmmoBoxPickup);
+					State.IsDead = true;
+					State.IsPickedUp = true;
+					Game_EntityHandling::UnlinkEntityFromTile(Index);
 
 					for (auto&& Weapon : Weapons)
 					{
-						if (const auto WP{ Entity.ContainedItem.find(Weapon.Name) }; Weapon.Name == WP->first)
+						if (const auto WP{ Entities[Index].ContainedItem.find(Weapon.Name) }; Weapon.Name == WP->first)
 						{
 							Weapon.CarriedAmmo += WP->second;
 							std::array<char, MaximumCarriedAmmoDigits> CarriedAmmoString{};
@@ -358,9 +358,9 @@ namespace Game_WeaponHandling
 							break;
 						}
 					}
-
-					break;
 				}
+
+				Index = Next;
 			}
 		}
 	}
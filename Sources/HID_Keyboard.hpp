@@ -54,6 +54,7 @@ namespace HID_Keyboard
 	// Menu item down		= VK_DOWN	= 40
 	// Menu item up			= VK_UP		= 38
 	// Select menu item		= ENTER		= 13
+	// Dump frame taskgraph	= G			= 71
 
 	inline std::int_fast32_t MovePlayerForwardKey{};
 	inline std::int_fast32_t MovePlayerBackwardKey{};
@@ -71,6 +72,7 @@ namespace HID_Keyboard
 	inline std::int_fast32_t MenuItemDownKey{};
 	inline std::int_fast32_t MenuItemUpKey{};
 	inline std::int_fast32_t MenuItemSelectKey{};
+	inline std::int_fast32_t DumpFrameGraphKey{};
 
 	//
 	// Functions
@@ -98,6 +100,7 @@ namespace HID_Keyboard
 			MenuItemDownKey = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "KEYBOARD", "MenuItemDownKey");
 			MenuItemUpKey = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "KEYBOARD", "MenuItemUpKey");
 			MenuItemSelectKey = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "KEYBOARD", "MenuItemSelectKey");
+			DumpFrameGraphKey = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "KEYBOARD", "DumpFrameGraphKey");
 
 			lwmf::RegisterRawInputDevice(lwmf::MainWindow, lwmf::DeviceIdentifier::HID_KEYBOARD);
 		}
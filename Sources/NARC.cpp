@@ -39,6 +39,9 @@
 // Establish logging for NARC itself - system-logging for lwmf is hardcoded!
 lwmf::Logging NARCLog("NARC.log");
 
+// Phases of loading the game and the levels - a report is written after every load (see WriteLoadTimeline())
+inline lwmf::Timeline LoadTimeline;
+
 // "Canvas" is the main render target in our game!
 inline lwmf::TextureStruct Canvas{};
 inline lwmf::ShaderClass CanvasShader{};
@@ -47,6 +50,7 @@ inline lwmf::ShaderClass CanvasShader{};
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_Console.hpp"
 #include "Tools_ErrorHandling.hpp"
+#include "Game_AssetIndex.hpp"
 #include "GFX_ImageHandling.hpp"
 #include "GFX_Window.hpp"
 #include "GFX_TextClass.hpp"
@@ -64,6 +68,7 @@ inline lwmf::ShaderClass CanvasShader{};
 #include "Game_PreGame.hpp"
 #include "Game_Config.hpp"
 #include "Game_LevelHandling.hpp"
+#include "Game_LevelStreaming.hpp"
 #include "Game_SkyboxHandling.hpp"
 #include "Game_PathFinding.hpp"
 #include "Game_EntityHandling.hpp"
@@ -84,6 +89,8 @@ inline lwmf::ShaderClass CanvasShader{};
 
 void InitAndLoadGameConfig();
 void InitAndLoadLevel();
+void WriteLoadTimeline();
+void BuildFrameGraph(lwmf::TaskGraph& FrameGraph);
 void MovePlayerAndCheckCollision();
 void ControlPlayerMovement();
 
@@ -93,31 +100,71 @@ inline Game_HealthBarClass HUDHealthBar;
 inline Game_MinimapClass HUDMinimap;
 inline Game_WeaponDisplayClass HUDWeaponDisplay;
 
+// Threadpool for the frame taskgraph and for decoding assets in parallel (level switches happen at a frame boundary)
+inline lwmf::Multithreading ThreadPool;
+
 inline bool HUDEnabled{ true };
+inline bool DumpFrameGraphFlag{};
+inline bool LevelSwitchRequestedFlag{};
 
 std::int_fast32_t WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPSTR lpCmdLine, _In_ int nShowCmd)
 {
 	UNREFERENCED_PARAMETER(hPrevInstance);
-	UNREFERENCED_PARAMETER(lpCmdLine);
 	UNREFERENCED_PARAMETER(nShowCmd);
 
 	lwmf::WindowInstance = hInstance;
 
+	const auto StartupTime{ std::chrono::steady_clock::now() };
+
+	Game_Config::ParseCommandLine(lpCmdLine);
+
+	// Used to verify that all kernel variants produce bit-identical results on a specific computer
+	if (CheckSIMDFlag)
+	{
+		lwmf::InitSIMD();
+		return lwmf::CheckSIMDKernels() ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	// Used to measure the PNG decoder on the real assets
+	if (BenchPNGFlag)
+	{
+		lwmf::InitSIMD();
+		return GFX_ImageHandling::BenchmarkDecoding(GFXFolder) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	// Used to measure the path finding modes on synthetic maps
+	if (BenchPathFlag)
+	{
+		return Game_PathFinding::BenchmarkPathFinding() ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
 	try
 	{
-		InitAndLoadGameConfig();
-		InitAndLoadLevel();
+		LoadTimeline.Measure("InitAndLoadGameConfig", InitAndLoadGameConfig);
+		LoadTimeline.Measure("InitAndLoadLevel", InitAndLoadLevel);
 	}
 	catch (const std::runtime_error&)
 	{
 		return EXIT_FAILURE;
 	}
 
-	NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Init multithreading threadpool...");
-	lwmf::Multithreading ThreadPool;
+	NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Startup took " + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - StartupTime).count()) + " ms...");
+	WriteLoadTimeline();
 
-	const std::int_fast32_t BlackNoAlpha{ lwmf::RGBAtoINT(0, 0, 0, 0) };
-	const std::int_fast32_t White{ lwmf::RGBAtoINT(255, 255, 255, 255) };
+	// Used to benchmark cold and warm starts
+	if (ExitAfterLoadFlag)
+	{
+		Tools_Cleanup::CloseAllAudio();
+		Tools_Cleanup::DestroySubsystems();
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Exit program after load...");
+
+		return EXIT_SUCCESS;
+	}
+
+	NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Build frame taskgraph...");
+	lwmf::TaskGraph FrameGraph;
+	BuildFrameGraph(FrameGraph);
+	NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, FrameGraph.GetGraphDescription());
 
 	// Main game loop
 	// fixed timestep method
@@ -156,12 +203,36 @@ std::int_fast32_t WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInst
 			DispatchMessage(&Message);
 		}
 
+		// The next level was prefetched in the background while this one was played - swap it in between two frames
+		if (LevelSwitchRequestedFlag)
+		{
+			LevelSwitchRequestedFlag = false;
+			SelectedLevel = Game_LevelStreaming::GetNextLevel();
+
+			try
+			{
+				LoadTimeline.Clear();
+				LoadTimeline.Measure("InitAndLoadLevel", InitAndLoadLevel);
+			}
+			catch (const std::runtime_error&)
+			{
+				return EXIT_FAILURE;
+			}
+
+			WriteLoadTimeline();
+
+			// Don't catch up on the time the switch took
+			Lag = 0;
+			EndTime = std::chrono::steady_clock::now();
+			continue;
+		}
+
 		while (Lag >= LengthOfFrame)
 		{
 			if (!GamePausedFlag)
 			{
 				ControlPlayerMovement();
-				Game_EntityHandling::MoveEntities();
+				Game_EntityHandling::MoveEntities(ThreadPool);
 				Game_Doors::OpenCloseDoors();
 				Game_WeaponHandling::ChangeWeapon();
 				Game_WeaponHandling::CheckReloadStatus();
@@ -173,30 +244,16 @@ std::int_fast32_t WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInst
 			Lag -= LengthOfFrame;
 		}
 
-		Game_EntityHandling::GetEntityDistance();
-
-		// Sort entities front to back for check if weapon hit first entity in front of player
-		SortEntities(Game_EntityHandling::SortOrder::FrontToBack);
-		Game_WeaponHandling::FireWeapon();
-
-		// Sort entities back to front to draw them in right order
-		SortEntities(Game_EntityHandling::SortOrder::BackToFront);
-
-		lwmf::ClearTexture(Canvas, BlackNoAlpha);
 		lwmf::FPSCounter();
 
-		ThreadPool.AddThread(&Game_Raycaster::CastGraphics, Game_Raycaster::Renderpart::WallLeft);
-		ThreadPool.AddThread(&Game_Raycaster::CastGraphics, Game_Raycaster::Renderpart::WalLRight);
-		ThreadPool.AddThread(&Game_Raycaster::CastGraphics, Game_Raycaster::Renderpart::Floor);
-		ThreadPool.AddThread(&Game_Raycaster::CastGraphics, Game_Raycaster::Renderpart::Ceiling);
-		ThreadPool.WaitForThreads();
-
-		Game_EntityHandling::RenderEntities();
+		// Entity sorting, hit test, raycaster, entity rendering and HUD - see BuildFrameGraph()
+		FrameGraph.Execute(ThreadPool);
 
-		if (HUDEnabled)
+		if (DumpFrameGraphFlag)
 		{
-			HUDHealthBar.Display();
-			lwmf::DisplayFPSCounter(Canvas, Canvas.Width - 70, 7, White);
+			NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, FrameGraph.GetFrameReport());
+			NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, Game_EntityHandling::GetPathCacheReport());
+			DumpFrameGraphFlag = false;
 		}
 
 		if (Player.IsDead && !GamePausedFlag)
@@ -208,12 +265,6 @@ std::int_fast32_t WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInst
 
 		Game_SkyboxHandling::Render();
 
-		if (HUDMinimap.Enabled)
-		{
-			// Display realtime data (entities, waypoints etc.)
-			HUDMinimap.DisplayRealtimeMap();
-		}
-
 		CanvasShader.RenderLWMFTexture(Canvas, true, 1.0F);
 		Game_WeaponHandling::DrawWeapon();
 
@@ -529,17 +580,8 @@ inline LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM l
 						{
 							if (NumberOfLevels > StartLevel)
 							{
-								SelectedLevel < NumberOfLevels ? ++SelectedLevel : SelectedLevel = StartLevel;
-
-								try
-								{
-									InitAndLoadLevel();
-								}
-								catch (const std::runtime_error&)
-								{
-									return EXIT_FAILURE;
-								}
-
+								// The switch itself happens in the main loop
+								LevelSwitchRequestedFlag = true;
 								break;
 							}
 						}
@@ -550,6 +592,12 @@ inline LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM l
 							break;
 						}
 
+						if (RawDev.data.keyboard.VKey == HID_Keyboard::DumpFrameGraphKey)
+						{
+							DumpFrameGraphFlag = true;
+							break;
+						}
+
 						if (RawDev.data.keyboard.VKey == HID_Keyboard::MovePlayerForwardKey)
 						{
 							HID_Keyboard::SetKeyState(HID_Keyboard::MovePlayerForwardKey, true);
@@ -619,64 +667,170 @@ inline LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM l
 
 inline void InitAndLoadGameConfig()
 {
-	lwmf::CheckForSSESupport();
-	Game_Config::Init();
-	Game_Config::GatherNumberOfLevels();
-
-	Tools_Console::CreateConsole();
-	Game_PreGame::ShowIntroHeader();
-	Game_PreGame::SetOptions();
-	Tools_Console::CloseConsole();
-
-	GFX_Window::Init();
-	HID_Keyboard::Init();
-	HID_Mouse::Init();
-	HID_Gamepad::Init();
-	MainMenu.Init();
-	Game_Transitions::Init();
-
-	Game_Raycaster::Init();
-	Game_WeaponHandling::InitConfig();
-	Game_WeaponHandling::InitTextures();
-	Game_WeaponHandling::InitAudio();
-	Game_Effects::InitEffects();
-	HUDWeaponDisplay.Init();
-	HUDHealthBar.Init();
-	HUDMinimap.Init();
-	Game_SkyboxHandling::Init();
-	Game_Doors::InitDoorAssets();
+	LoadTimeline.Measure("lwmf::InitSIMD", lwmf::InitSIMD);
+	LoadTimeline.Measure("Game_AssetIndex::Init", Game_AssetIndex::Init);
+	LoadTimeline.Measure("Game_Config::Init", Game_Config::Init);
+	LoadTimeline.Measure("Game_Config::GatherNumberOfLevels", Game_Config::GatherNumberOfLevels);
+
+	// Includes the time spent waiting for the user's input (unless "-exitafterload" is given)
+	LoadTimeline.Measure("Console, intro and options", []
+	{
+		Tools_Console::CreateConsole();
+		Game_PreGame::ShowIntroHeader();
+		Game_PreGame::SetOptions();
+		Tools_Console::CloseConsole();
+	});
+
+	LoadTimeline.Measure("GFX_Window::Init", GFX_Window::Init);
+	LoadTimeline.Measure("HID_Keyboard::Init", HID_Keyboard::Init);
+	LoadTimeline.Measure("HID_Mouse::Init", HID_Mouse::Init);
+	LoadTimeline.Measure("HID_Gamepad::Init", HID_Gamepad::Init);
+	LoadTimeline.Measure("MainMenu.Init", [] { MainMenu.Init(); });
+	LoadTimeline.Measure("Game_Transitions::Init", Game_Transitions::Init);
+
+	// Images are only requested here - they are decoded in parallel at the end and committed in request order
+	// Door and weapon assets are part of every level pack, so the pack of the first level serves them as well
+	LoadTimeline.Measure("Game_LevelHandling::OpenLevelPack", Game_LevelHandling::OpenLevelPack);
+	GFX_ImageHandling::ImageBatchStruct ImageBatch;
+	ImageBatch.Pack = &Game_LevelHandling::LevelPack;
+
+	LoadTimeline.Measure("Game_Raycaster::Init", Game_Raycaster::Init);
+	LoadTimeline.Measure("Game_WeaponHandling::InitConfig", Game_WeaponHandling::InitConfig);
+	LoadTimeline.Measure("Game_WeaponHandling::InitTextures", [&ImageBatch] { Game_WeaponHandling::InitTextures(ImageBatch); });
+	LoadTimeline.Measure("Game_WeaponHandling::InitAudio", Game_WeaponHandling::InitAudio);
+	LoadTimeline.Measure("Game_Effects::InitEffects", Game_Effects::InitEffects);
+	LoadTimeline.Measure("HUDWeaponDisplay.Init", [] { HUDWeaponDisplay.Init(); });
+	LoadTimeline.Measure("HUDHealthBar.Init", [] { HUDHealthBar.Init(); });
+	LoadTimeline.Measure("HUDMinimap.Init", [] { HUDMinimap.Init(); });
+	LoadTimeline.Measure("Game_SkyboxHandling::Init", Game_SkyboxHandling::Init);
+	LoadTimeline.Measure("Game_Doors::InitDoorAssets", [&ImageBatch] { Game_Doors::InitDoorAssets(ImageBatch); });
+
+	LoadTimeline.Measure("GFX_ImageHandling::LoadBatch", [&ImageBatch] { GFX_ImageHandling::LoadBatch(ImageBatch, ThreadPool); });
+	Game_LevelHandling::LevelPack.Close();
+
+	// Every INI file was parsed only once during the load phase
+	lwmf::ClearINICache();
 }
 
 inline void InitAndLoadLevel()
 {
-	Game_Transitions::LevelTransition();
-	Game_LevelHandling::InitConfig();
-	Game_LevelHandling::InitMapData();
-	Game_LevelHandling::InitLights();
-	Game_LevelHandling::InitTextures();
-	Game_LevelHandling::InitBackgroundMusic();
-
-	Game_PathFinding::GenerateFlattenedMap(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, Game_LevelHandling::LevelMapHeight);
-
-	Game_Doors::InitDoors();
-	Game_SkyboxHandling::LoadSkyboxImage();
-	HUDMinimap.PreRender();
-	Player.InitConfig();
-	Player.InitAudio();
-	Game_EntityHandling::InitEntityAssets();
-	Game_EntityHandling::InitEntities();
-	Game_Raycaster::RefreshSettings();
-
-	Game_EntityHandling::EntityMap[static_cast<std::int_fast32_t>(Player.Pos.X)][static_cast<std::int_fast32_t>(Player.Pos.Y)] = EntityTypes::Player;
+	// Map data and images are staged in the background - usually the level was prefetched already, so there is little left to wait for
+	LoadTimeline.Measure("Game_Transitions::LevelTransition", Game_Transitions::LevelTransition);
+	LoadTimeline.Measure("Game_LevelStreaming::CompleteStaging", [] { Game_LevelStreaming::CompleteStaging(SelectedLevel, ThreadPool, Game_Transitions::UpdateLevelTransition); });
+
+	// The asset pack serves everything the staging did not cover
+	LoadTimeline.Measure("Game_LevelHandling::OpenLevelPack", Game_LevelHandling::OpenLevelPack);
+	GFX_ImageHandling::ImageBatchStruct ImageBatch;
+	ImageBatch.Pack = &Game_LevelHandling::LevelPack;
+	ImageBatch.Prefetched = &Game_LevelStreaming::StagedLevel.Images;
+
+	LoadTimeline.Measure("Game_LevelHandling::InitConfig", Game_LevelHandling::InitConfig);
+	LoadTimeline.Measure("Game_LevelHandling::InitMapData", [] { Game_LevelHandling::InitMapData(std::move(Game_LevelStreaming::StagedLevel.LevelMap)); });
+	LoadTimeline.Measure("Game_LevelHandling::InitLights", Game_LevelHandling::InitLights);
+	LoadTimeline.Measure("Game_LevelHandling::InitTextures", [&ImageBatch] { Game_LevelHandling::InitTextures(ImageBatch); });
+	LoadTimeline.Measure("Game_LevelHandling::InitBackgroundMusic", Game_LevelHandling::InitBackgroundMusic);
+
+	LoadTimeline.Measure("Game_PathFinding::GenerateFlattenedMap", [] { Game_PathFinding::GenerateFlattenedMap(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, Game_LevelHandling::LevelMapHeight); });
+
+	LoadTimeline.Measure("Game_SkyboxHandling::LoadSkyboxImage", [&ImageBatch] { Game_SkyboxHandling::LoadSkyboxImage(ImageBatch); });
+	LoadTimeline.Measure("Game_EntityHandling::InitEntityAssets", [&ImageBatch] { Game_EntityHandling::InitEntityAssets(ImageBatch); });
+
+	// Everything below may use the decoded textures (e.g. doors copy the texture of their doortype)
+	LoadTimeline.Measure("GFX_ImageHandling::LoadBatch", [&ImageBatch] { GFX_ImageHandling::LoadBatch(ImageBatch, ThreadPool); });
+
+	// Nothing points into the pack anymore - all assets were either copied or uploaded to the GPU
+	// The level holds its own texture handles now
+	Game_LevelHandling::LevelPack.Close();
+	Game_LevelStreaming::ReleaseStagedLevel();
+
+	LoadTimeline.Measure("Game_Doors::InitDoors", Game_Doors::InitDoors);
+	LoadTimeline.Measure("HUDMinimap.PreRender", [] { HUDMinimap.PreRender(); });
+	LoadTimeline.Measure("Player.InitConfig", [] { Player.InitConfig(); });
+	LoadTimeline.Measure("Player.InitAudio", [] { Player.InitAudio(); });
+	LoadTimeline.Measure("Game_EntityHandling::InitEntities", Game_EntityHandling::InitEntities);
+	LoadTimeline.Measure("Game_Raycaster::RefreshSettings", Game_Raycaster::RefreshSettings);
+
+	Game_EntityHandling::SetPlayerTile(static_cast<std::int_fast32_t>(Player.Pos.X), static_cast<std::int_fast32_t>(Player.Pos.Y));
+
+	// Every INI file was parsed only once during the load phase
+	lwmf::ClearINICache();
+
+	// Prefetch the next level while this one is played
+	if (NumberOfLevels > StartLevel)
+	{
+		Game_LevelStreaming::StageLevel(Game_LevelStreaming::GetNextLevel());
+	}
+}
+
+inline void WriteLoadTimeline()
+{
+	const std::string FileName{ LoadTimelineFormat == lwmf::TimelineFormat::JSON ? "LoadTimeline.json" : "LoadTimeline.txt" };
+
+	NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Write load timeline to " + FileName + "...");
+	LoadTimeline.WriteReport(FileName, LoadTimelineFormat);
+}
+
+inline void BuildFrameGraph(lwmf::TaskGraph& FrameGraph)
+{
+	// Tasks are declared in their serial order, the graph derives the dependencies from the declared resources
+	// Everything which calls into OpenGL or audio has to stay on the main thread!
+
+	const std::int_fast32_t EntitiesResource{ FrameGraph.AddResource("Entities") };
+	const std::int_fast32_t EntityOrderResource{ FrameGraph.AddResource("EntityOrder") };
+	const std::int_fast32_t ZBufferResource{ FrameGraph.AddResource("ZBuffer") };
+	const std::int_fast32_t WeaponsResource{ FrameGraph.AddResource("Weapons") };
+	const std::int_fast32_t CanvasResource{ FrameGraph.AddResource("Canvas") };
+
+	// Sort the visible entities front to back - the hit test iterates them forwards, the renderer backwards
+	FrameGraph.AddTask("UpdateEntityOrder", lwmf::TaskAffinity::AnyThread, { { EntitiesResource, lwmf::TaskAccess::Read }, { EntityOrderResource, lwmf::TaskAccess::Write } },
+		[] { Game_EntityHandling::UpdateEntityOrder(); });
+
+	// Hit test uses the ZBuffer of the previous frame - the raycaster has to wait until it is done
+	FrameGraph.AddTask("FireWeapon", lwmf::TaskAffinity::MainThread, { { EntityOrderResource, lwmf::TaskAccess::Read }, { ZBufferResource, lwmf::TaskAccess::Read }, { EntitiesResource, lwmf::TaskAccess::Write }, { WeaponsResource, lwmf::TaskAccess::Write } },
+		[] { Game_WeaponHandling::FireWeapon(); });
+
+	FrameGraph.AddTask("ClearCanvas", lwmf::TaskAffinity::AnyThread, { { CanvasResource, lwmf::TaskAccess::Write } },
+		[] { lwmf::ClearTexture(Canvas, lwmf::RGBAtoINT(0, 0, 0, 0)); });
+
+	// The four raycaster parts write to disjoint areas of the canvas
+	FrameGraph.AddTask("CastWallLeft", lwmf::TaskAffinity::AnyThread, { { CanvasResource, lwmf::TaskAccess::SharedWrite } },
+		[] { Game_Raycaster::CastGraphics(Game_Raycaster::Renderpart::WallLeft); });
+	FrameGraph.AddTask("CastWallRight", lwmf::TaskAffinity::AnyThread, { { CanvasResource, lwmf::TaskAccess::SharedWrite } },
+		[] { Game_Raycaster::CastGraphics(Game_Raycaster::Renderpart::WalLRight); });
+	FrameGraph.AddTask("CastFloor", lwmf::TaskAffinity::AnyThread, { { CanvasResource, lwmf::TaskAccess::SharedWrite }, { ZBufferResource, lwmf::TaskAccess::SharedWrite } },
+		[] { Game_Raycaster::CastGraphics(Game_Raycaster::Renderpart::Floor); });
+	FrameGraph.AddTask("CastCeiling", lwmf::TaskAffinity::AnyThread, { { CanvasResource, lwmf::TaskAccess::SharedWrite }, { ZBufferResource, lwmf::TaskAccess::SharedWrite } },
+		[] { Game_Raycaster::CastGraphics(Game_Raycaster::Renderpart::Ceiling); });
+
+	FrameGraph.AddTask("RenderEntities", lwmf::TaskAffinity::AnyThread, { { EntitiesResource, lwmf::TaskAccess::Read }, { EntityOrderResource, lwmf::TaskAccess::Read }, { ZBufferResource, lwmf::TaskAccess::Read }, { CanvasResource, lwmf::TaskAccess::Write } },
+		[] { Game_EntityHandling::RenderEntities(); });
+
+	FrameGraph.AddTask("HUD", lwmf::TaskAffinity::AnyThread, { { CanvasResource, lwmf::TaskAccess::Write } },
+		[]
+		{
+			if (HUDEnabled)
+			{
+				HUDHealthBar.Display();
+				lwmf::DisplayFPSCounter(Canvas, Canvas.Width - 70, 7, lwmf::RGBAtoINT(255, 255, 255, 255));
+			}
+		});
+
+	// Display realtime data (entities, waypoints etc.)
+	FrameGraph.AddTask("MinimapRealtime", lwmf::TaskAffinity::AnyThread, { { EntitiesResource, lwmf::TaskAccess::Read }, { CanvasResource, lwmf::TaskAccess::Write } },
+		[]
+		{
+			if (HUDMinimap.Enabled)
+			{
+				HUDMinimap.DisplayRealtimeMap();
+			}
+		});
 }
 
 inline void MovePlayerAndCheckCollision()
 {
 	if (Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][Player.FuturePos.X][static_cast<std::int_fast32_t>(Player.Pos.Y)] == 0
 		&& Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][static_cast<std::int_fast32_t>(Player.Pos.X)][Player.FuturePos.Y] == 0
-		&& Game_EntityHandling::EntityMap[Player.FuturePos.X][Player.FuturePos.Y] != EntityTypes::Enemy
-		&& Game_EntityHandling::EntityMap[Player.FuturePos.X][Player.FuturePos.Y] != EntityTypes::Neutral
-		&& Game_EntityHandling::EntityMap[Player.FuturePos.X][Player.FuturePos.Y] != EntityTypes::Turret)
+		&& !Game_EntityHandling::IsTileOccupied(Player.FuturePos.X, Player.FuturePos.Y, Game_EntityHandling::GetTypeMask(EntityTypes::Enemy) | Game_EntityHandling::GetTypeMask(EntityTypes::Neutral) | Game_EntityHandling::GetTypeMask(EntityTypes::Turret)))
 	{
 		Player.Pos.X += Player.StepWidth.X;
 		Player.Pos.Y += Player.StepWidth.Y;
@@ -694,7 +848,6 @@ inline void MovePlayerAndCheckCollision()
 
 inline void ControlPlayerMovement()
 {
-	Game_EntityHandling::EntityMap[static_cast<std::int_fast32_t>(Player.Pos.X)][static_cast<std::int_fast32_t>(Player.Pos.Y)] = EntityTypes::Clear;
 	Game_WeaponHandling::WeaponPaceFlag = false;
 
 	if (GameControllerFlag && HID_Gamepad::GameController.ControllerID != -1)
@@ -796,5 +949,5 @@ inline void ControlPlayerMovement()
 		MovePlayerAndCheckCollision();
 	}
 
-	Game_EntityHandling::EntityMap[static_cast<std::int_fast32_t>(Player.Pos.X)][static_cast<std::int_fast32_t>(Player.Pos.Y)] = EntityTypes::Player;
+	Game_EntityHandling::SetPlayerTile(static_cast<std::int_fast32_t>(Player.Pos.X), static_cast<std::int_fast32_t>(Player.Pos.Y));
 }
\ No newline at end of file
@@ -0,0 +1,251 @@
+/*
+******************************************
+* NARCPacker                             *
+*                                        *
+* Offline asset packer for NARC          *
+*                                        *
+* NARCPacker.cpp                         *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+*                                        *
+******************************************
+*/
+
+// Bakes all assets a level needs into "DATA/Levels/<Level>/Level.narcpak":
+// level textures, skybox, entity animation sets, door and weapon textures (all pre-decoded) and the map data (binary map layers)
+//
+// With "--maps", it converts the map data of the levels to binary map layers ("MapWallData.conf" -> "MapWallData.narcmap" etc.) instead,
+// the game prefers them over the text files (see Game_MapData)
+//
+// Run it from the folder which contains DATA and GFX (see "_BuildPacks.cmd" and "_ConvertMaps.cmd")
+// Usage: NARCPacker [--maps] [Level ...] - without levels, all levels are processed
+//
+// Packs and binary map layers have to be rebuilt whenever one of their source files changes!
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <chrono>
+#include <stdexcept>
+#include <exception>
+
+// lightweight media framework - only the parts needed for decoding and packing, no window or OpenGL
+#define LWMF_LOGGINGENABLED
+#define LWMF_THROWEXCEPTIONS
+#include "./lwmf/lwmf_logging.hpp"
+
+inline lwmf::Logging LWMFSystemLog("lwmf_systemlog.log");
+
+#include "./lwmf/lwmf_simd.hpp"
+#include "./lwmf/lwmf_math.hpp"
+#include "./lwmf/lwmf_general.hpp"
+#include "./lwmf/lwmf_color.hpp"
+#include "./lwmf/lwmf_texture.hpp"
+#include "./lwmf/lwmf_png.hpp"
+#include "./lwmf/lwmf_pack.hpp"
+#include "./lwmf/lwmf_texturecache.hpp"
+#include "./lwmf/lwmf_multithreading.hpp"
+#include "./lwmf/lwmf_inifile.hpp"
+
+lwmf::Logging NARCLog("NARCPacker.log");
+
+#include "Game_Folder.hpp"
+#include "Tools_ErrorHandling.hpp"
+#include "Game_AssetIndex.hpp"
+#include "Game_LevelAssets.hpp"
+#include "Game_MapData.hpp"
+
+namespace NARCPacker
+{
+
+
+	std::string EncodeMapDataFile(const std::string& FileName);
+	void ConvertMapData(std::int_fast32_t Level);
+	void PackLevel(std::int_fast32_t Level, lwmf::Multithreading& ThreadPool);
+
+	//
+	// Variables and constants
+	//
+
+	inline std::int_fast32_t TextureSize{};
+	inline std::int_fast32_t EntitySize{};
+
+	//
+	// Functions
+	//
+
+	inline std::string EncodeMapDataFile(const std::string& FileName)
+	{
+		Game_MapData::MapLayerStruct Layer;
+		std::string Data;
+
+		if (Game_MapData::ReadMapLayerFile(FileName, Layer))
+		{
+			Data = Game_MapData::EncodeMapLayer(Layer);
+		}
+
+		if (Data.empty())
+		{
+			throw std::runtime_error("Error encoding " + FileName + " (map data must only contain values from 0 to 65535)");
+		}
+
+		return Data;
+	}
+
+	inline void ConvertMapData(const std::int_fast32_t Level)
+	{
+		std::cout << "Converting map data of level " << Level << "...\n";
+
+		for (const auto& MapDataFile : Game_LevelAssets::GetMapDataFiles(Level))
+		{
+			// Always convert the text file, an existing binary file may be outdated
+			const std::string BinaryFileName{ Game_MapData::GetBinaryMapLayerFileName(MapDataFile) };
+			std::remove(BinaryFileName.c_str());
+
+			const std::string Data{ EncodeMapDataFile(MapDataFile) };
+			std::ofstream BinaryFile(BinaryFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+
+			if (!BinaryFile.write(Data.data(), static_cast<std::streamsize>(Data.size())))
+			{
+				throw std::runtime_error("Error writing " + BinaryFileName);
+			}
+
+			std::cout << "   " << MapDataFile << " -> " << BinaryFileName << " (" << Data.size() << " bytes)\n";
+		}
+	}
+
+	inline void PackLevel(const std::int_fast32_t Level, lwmf::Multithreading& ThreadPool)
+	{
+		const auto StartTime{ std::chrono::steady_clock::now() };
+
+		std::cout << "Packing level " << Level << "...\n";
+
+		// Door and weapon assets are part of every pack, so the pack of the first level serves them at startup
+		Game_LevelAssets::LevelAssetsStruct Assets;
+		Game_LevelAssets::GatherLevelAssets(Assets, Level, TextureSize, EntitySize);
+		Game_LevelAssets::GatherDoorAssets(Assets);
+		Game_LevelAssets::GatherWeaponAssets(Assets);
+
+		std::vector<lwmf::TextureStruct> Textures(Assets.Images.size());
+		std::vector<std::uint64_t> ContentHashes(Assets.Images.size());
+		std::vector<std::exception_ptr> Exceptions(Assets.Images.size());
+
+		for (std::size_t i{}; i < Assets.Images.size(); ++i)
+		{
+			ThreadPool.AddThread([&Assets, &Textures, &ContentHashes, &Exceptions, i]
+			{
+				try
+				{
+					// The game hashes the PNG file the same way, so its texture cache matches packed and unpacked textures
+					if (std::vector<unsigned char> Buffer; lwmf::ReadPNGFile(Buffer, Assets.Images[i]))
+					{
+						ContentHashes[i] = lwmf::HashContent(Buffer.data(), Buffer.size());
+						lwmf::DecodePNG(Textures[i], Buffer, Assets.Images[i]);
+					}
+				}
+				catch (...)
+				{
+					Exceptions[i] = std::current_exception();
+				}
+			});
+		}
+
+		ThreadPool.WaitForThreads();
+
+		lwmf::PackWriter Pack;
+
+		for (std::size_t i{}; i < Assets.Images.size(); ++i)
+		{
+			if (Exceptions[i])
+			{
+				std::rethrow_exception(Exceptions[i]);
+			}
+
+			Pack.AddTexture(Assets.Images[i], Textures[i], ContentHashes[i]);
+		}
+
+		for (const auto& MapDataFile : Assets.MapDataFiles)
+		{
+			const std::string Blob{ EncodeMapDataFile(MapDataFile) };
+			Pack.AddBlob(MapDataFile, Blob.data(), Blob.size());
+		}
+
+		const std::string PackFileName{ LevelFolder + std::to_string(Level) + "/" + LevelPackFileName };
+
+		if (!Pack.Write(PackFileName))
+		{
+			throw std::runtime_error("Error writing " + PackFileName);
+		}
+
+		const auto Duration{ std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - StartTime) };
+
+		std::cout << "   " << Assets.Images.size() << " textures, " << Assets.MapDataFiles.size() << " map layers, " << (Pack.GetDataSize() >> 10) << " KiB -> " << PackFileName << " (" << Duration.count() << " ms)\n";
+	}
+
+
+} // namespace NARCPacker
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		if (const std::string INIFile{ GameConfigFolder + "GameConfig.ini" }; Tools_ErrorHandling::CheckFileExistence(INIFile, StopOnError))
+		{
+			NARCPacker::TextureSize = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "TEXTURES", "TextureSize");
+			NARCPacker::EntitySize = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "TEXTURES", "EntitySize");
+		}
+
+		lwmf::InitSIMD();
+		lwmf::Multithreading ThreadPool;
+		Game_AssetIndex::Init();
+
+		bool ConvertMapsFlag{};
+		std::vector<std::int_fast32_t> Levels{};
+
+		for (int i{ 1 }; i < argc; ++i)
+		{
+			if (std::string(argv[i]) == "--maps")
+			{
+				ConvertMapsFlag = true;
+			}
+			else
+			{
+				Levels.emplace_back(std::stoi(argv[i]));
+			}
+		}
+
+		if (Levels.empty())
+		{
+			// Levels are numbered from 1 upwards, same as in Game_Config::GatherNumberOfLevels()
+			const std::int_fast32_t NumberOfLevels{ Game_AssetIndex::CountNumberedFolders(LevelFolder, 1) };
+
+			for (std::int_fast32_t Level{ 1 }; Level <= NumberOfLevels; ++Level)
+			{
+				Levels.emplace_back(Level);
+			}
+		}
+
+		for (const auto Level : Levels)
+		{
+			if (ConvertMapsFlag)
+			{
+				NARCPacker::ConvertMapData(Level);
+			}
+			else
+			{
+				NARCPacker::PackLevel(Level, ThreadPool);
+			}
+		}
+	}
+	catch (const std::exception& Error)
+	{
+		std::cerr << "NARCPacker failed: " << Error.what() << "\nSee NARCPacker.log and lwmf_systemlog.log for details.\n";
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "Game_LevelHandling.hpp"
+#include "Game_LevelStreaming.hpp"
 #include "Game_EntityHandling.hpp"
 #include "Game_Doors.hpp"
 #include "Game_WeaponHandling.hpp"
@@ -29,6 +30,9 @@ namespace Tools_Cleanup
 	{
 		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Destroy subsystems...");
 
+		// Stop prefetching the next level
+		Game_LevelStreaming::Cancel();
+
 		lwmf::UnregisterRawInputDevice(lwmf::DeviceIdentifier::HID_MOUSE);
 		lwmf::UnregisterRawInputDevice(lwmf::DeviceIdentifier::HID_KEYBOARD);
 		lwmf::DeleteOpenGLContext();
@@ -35,7 +35,10 @@ namespace Tools_ErrorHandling
 
 	inline bool CheckFileExistence(const std::string& FileName, const bool ActionFlag)
 	{
-		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Checking for file existence " + FileName + "...");
+		if constexpr (lwmf::IsLogLevelEnabled(lwmf::LogLevel::Info))
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Checking for file existence " + FileName + "...");
+		}
 
 		bool Result{ true };
 
@@ -60,7 +63,10 @@ namespace Tools_ErrorHandling
 
 	inline bool CheckFolderExistence(const std::string& FolderName, const bool ActionFlag)
 	{
-		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Checking for folder existence " + FolderName + "...");
+		if constexpr (lwmf::IsLogLevelEnabled(lwmf::LogLevel::Info))
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Checking for folder existence " + FolderName + "...");
+		}
 
 		bool Result{ true };
 
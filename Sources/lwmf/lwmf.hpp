@@ -18,6 +18,7 @@
 
 // #define LWMF_LOGGINGENABLED in your application if you want to write any logsfiles
 // #define LWMF_THROWEXCEPTIONS in your application if you want to handle errors by exceptions
+// #define LWMF_MINIMUMLOGLEVEL in your application to drop lower log levels at compile time (e.g. "#define LWMF_MINIMUMLOGLEVEL Warn")
 
 #include "lwmf_logging.hpp"
 
@@ -43,10 +44,14 @@ inline lwmf::Logging LWMFSystemLog("lwmf_systemlog.log");
 #include "lwmf_texture.hpp"
 #include "lwmf_bmp.hpp"
 #include "lwmf_png.hpp"
+#include "lwmf_pack.hpp"
+#include "lwmf_texturecache.hpp"
 #include "lwmf_text.hpp"
 #include "lwmf_mp3player.hpp"
 #include "lwmf_gamepad.hpp"
 #include "lwmf_perlinnoise.hpp"
 #include "lwmf_fpscounter.hpp"
 #include "lwmf_multithreading.hpp"
+#include "lwmf_taskgraph.hpp"
+#include "lwmf_timeline.hpp"
 #include "lwmf_inifile.hpp"
\ No newline at end of file
@@ -63,9 +63,10 @@ namespace lwmf
 			CreateTexture(Texture, BMPInfo->biWidth, BMPInfo->biHeight, 0x00000000);
 
 			// Since we read the data from bottom upwards, we need to flip everything upside down
-			for (std::int_fast32_t Offset{}, y{ Texture.Height - 1 }; y >= 0; --y)
+			for (std::int_fast32_t y{ Texture.Height - 1 }; y >= 0; --y)
 			{
 				const std::int_fast32_t TempY{ y * Texture.Width };
+				std::int_fast32_t Offset{ (Texture.Height - 1 - y) * Texture.Stride };
 
 				for (std::int_fast32_t x{}; x < Texture.Width; ++x)
 				{
@@ -21,14 +21,14 @@ namespace lwmf
 {
 
 
-	void Circle(TextureStruct& Texture, std::int_fast32_t CenterX, std::int_fast32_t CenterY, std::int_fast32_t Radius, std::int_fast32_t Color);
-	void FilledCircle(TextureStruct& Texture, std::int_fast32_t CenterX, std::int_fast32_t CenterY, std::int_fast32_t Radius, std::int_fast32_t BorderColor, std::int_fast32_t FillColor);
+	void Circle(TextureStruct& Texture, std::int_fast32_t CenterX, std::int_fast32_t CenterY, std::int_fast32_t Radius, PixelType Color);
+	void FilledCircle(TextureStruct& Texture, std::int_fast32_t CenterX, std::int_fast32_t CenterY, std::int_fast32_t Radius, PixelType BorderColor, PixelType FillColor);
 
 	//
 	// Functions
 	//
 
-	inline void Circle(TextureStruct& Texture, const std::int_fast32_t CenterX, const std::int_fast32_t CenterY, std::int_fast32_t Radius, const std::int_fast32_t Color)
+	inline void Circle(TextureStruct& Texture, const std::int_fast32_t CenterX, const std::int_fast32_t CenterY, std::int_fast32_t Radius, const PixelType Color)
 	{
 		// Exit early if circle would not be visible (to small or coords are out of texture boundaries)
 		if (Radius <= 0 || (CenterX + Radius < 0 || CenterX - Radius > Texture.Width || CenterY + Radius < 0 || CenterY - Radius > Texture.Height))
@@ -44,10 +44,10 @@ namespace lwmf
 		{
 			do
 			{
-				Texture.Pixels[((CenterY + Point.Y) * Texture.Width) + (CenterX - Point.X)] = Color;
-				Texture.Pixels[((CenterY - Point.X) * Texture.Width) + (CenterX - Point.Y)] = Color;
-				Texture.Pixels[((CenterY - Point.Y) * Texture.Width) + (CenterX + Point.X)] = Color;
-				Texture.Pixels[((CenterY + Point.X) * Texture.Width) + (CenterX + Point.Y)] = Color;
+				Texture.Pixels[((CenterY + Point.Y) * Texture.Stride) + (CenterX - Point.X)] = Color;
+				Texture.Pixels[((CenterY - Point.X) * Texture.Stride) + (CenterX - Point.Y)] = Color;
+				Texture.Pixels[((CenterY - Point.Y) * Texture.Stride) + (CenterX + Point.X)] = Color;
+				Texture.Pixels[((CenterY + Point.X) * Texture.Stride) + (CenterX + Point.Y)] = Color;
 
 				Radius = Error;
 
@@ -86,7 +86,7 @@ namespace lwmf
 		}
 	}
 
-	inline void FilledCircle(TextureStruct& Texture, const std::int_fast32_t CenterX, const std::int_fast32_t CenterY, const std::int_fast32_t Radius, const std::int_fast32_t BorderColor, const std::int_fast32_t FillColor)
+	inline void FilledCircle(TextureStruct& Texture, const std::int_fast32_t CenterX, const std::int_fast32_t CenterY, const std::int_fast32_t Radius, const PixelType BorderColor, const PixelType FillColor)
 	{
 		// Exit early if circle would not be visible (to small or coords out of texture boundaries)
 		if (Radius <= 0 || (CenterX + Radius < 0 || CenterX - Radius > Texture.Width || CenterY + Radius < 0 || CenterY - Radius > Texture.Height))
@@ -11,12 +11,15 @@
 #pragma once
 
 #include <cstdint>
-#include <intrin.h>
 
 namespace lwmf
 {
 
 
+	// Packed 32-bit RGBA pixel (little-endian: R in the lowest byte)
+	// Used for all pixel buffers and color values, so memory layout is identical on all compilers
+	using PixelType = std::uint32_t;
+
 	struct ColorStructRGBA final
 	{
 		std::int_fast32_t Red{};
@@ -25,58 +28,91 @@ namespace lwmf
 		std::int_fast32_t Alpha{};
 	};
 
-	std::int_fast32_t RGBAtoINT(std::int_fast32_t Red, std::int_fast32_t Green, std::int_fast32_t Blue, std::int_fast32_t Alpha);
-	ColorStructRGBA INTtoRGBA(std::int_fast32_t Color);
-	std::int_fast32_t ShadeColor(std::int_fast32_t Color, float ShadeFactor, float Limit);
-	std::int_fast32_t BlendColor(std::int_fast32_t Color1, std::int_fast32_t Color2, float Ratio);
+	PixelType RGBAtoINT(std::int_fast32_t Red, std::int_fast32_t Green, std::int_fast32_t Blue, std::int_fast32_t Alpha);
+	ColorStructRGBA INTtoRGBA(PixelType Color);
+	PixelType GetColorWeight(float Ratio);
+	PixelType ScaleColor(PixelType Color, PixelType Weight);
+	PixelType MixColors(PixelType Color1, PixelType Color2, PixelType Weight);
+	PixelType ShadeColor(PixelType Color, float ShadeFactor, float Limit);
+	PixelType BlendColor(PixelType Color1, PixelType Color2, float Ratio);
 
 	//
 	// Variables and constants
 	//
 
 	// Define little-endian bitmasks
-	inline constexpr std::uint_fast32_t RMask{ 0x000000FF };
-	inline constexpr std::uint_fast32_t GMask{ 0x0000FF00 };
-	inline constexpr std::uint_fast32_t BMask{ 0x00FF0000 };
-	inline constexpr std::uint_fast32_t AMask{ 0xFF000000 };
+	inline constexpr PixelType RMask{ 0x000000FF };
+	inline constexpr PixelType GMask{ 0x0000FF00 };
+	inline constexpr PixelType BMask{ 0x00FF0000 };
+	inline constexpr PixelType AMask{ 0xFF000000 };
+	inline constexpr PixelType RBMask{ RMask | BMask };
+
+	// Shading and blending use 8.8 fixed point weights (0 - 256)
+	// Integer math makes the scalar functions and all lwmf_simd kernel variants bit-identical,
+	// independent of the floating point model and FMA contraction
+	inline constexpr PixelType ColorWeightOne{ 256 };
 
 	//
 	// Functions
 	//
 
-	inline std::int_fast32_t RGBAtoINT(const std::int_fast32_t Red, const std::int_fast32_t Green, const std::int_fast32_t Blue, const std::int_fast32_t Alpha)
+	inline PixelType RGBAtoINT(const std::int_fast32_t Red, const std::int_fast32_t Green, const std::int_fast32_t Blue, const std::int_fast32_t Alpha)
 	{
-		return static_cast<std::int_fast32_t>(static_cast<std::uint_fast32_t>(Red) + (static_cast<std::uint_fast32_t>(Green) << 8) + (static_cast<std::uint_fast32_t>(Blue) << 16) + (static_cast<std::uint_fast32_t>(Alpha) << 24));
+		return static_cast<PixelType>(Red) | (static_cast<PixelType>(Green) << 8) | (static_cast<PixelType>(Blue) << 16) | (static_cast<PixelType>(Alpha) << 24);
 	}
 
-	inline ColorStructRGBA INTtoRGBA(const std::int_fast32_t Color)
+	inline ColorStructRGBA INTtoRGBA(const PixelType Color)
 	{
-		return { (Color & static_cast<std::int_fast32_t>(RMask)), (Color & static_cast<std::int_fast32_t>(GMask)) >> 8, (Color & static_cast<std::int_fast32_t>(BMask)) >> 16, (Color & static_cast<std::int_fast32_t>(AMask)) >> 24 };
+		return { static_cast<std::int_fast32_t>(Color & RMask), static_cast<std::int_fast32_t>((Color & GMask) >> 8), static_cast<std::int_fast32_t>((Color & BMask) >> 16), static_cast<std::int_fast32_t>((Color & AMask) >> 24) };
 	}
 
-	inline std::int_fast32_t ShadeColor(const std::int_fast32_t Color, const float ShadeFactor, const float Limit)
+	inline PixelType GetColorWeight(const float Ratio)
 	{
-		if (ShadeFactor > Limit)
+		// Negated comparison also maps NaN to zero
+		if (!(Ratio > 0.0F))
 		{
-			return AMask;
+			return 0;
+		}
+
+		if (Ratio >= 1.0F)
+		{
+			return ColorWeightOne;
 		}
 
-		const float Weight{ (Limit - ShadeFactor) / Limit };
+		return static_cast<PixelType>(Ratio * static_cast<float>(ColorWeightOne));
+	}
 
-		return static_cast<std::int_fast32_t>(static_cast<float>(Color & RMask) * Weight)
-			| (static_cast<std::int_fast32_t>(static_cast<float>(Color & GMask) * Weight) & GMask)
-			| (static_cast<std::int_fast32_t>(static_cast<float>(Color & BMask) * Weight) & BMask)
-			| (static_cast<std::int_fast32_t>(Color & AMask));
+	inline PixelType ScaleColor(const PixelType Color, const PixelType Weight)
+	{
+		// Red and blue are scaled together - each product fits into its own 16-bit half
+		return ((((Color & RBMask) * Weight) >> 8) & RBMask)
+			| ((((Color >> 8) & RMask) * Weight) & GMask)
+			| (Color & AMask);
 	}
 
-	inline std::int_fast32_t BlendColor(const std::int_fast32_t Color1, const std::int_fast32_t Color2, const float Ratio)
+	inline PixelType MixColors(const PixelType Color1, const PixelType Color2, const PixelType Weight)
 	{
-		const __m128i ResultVec{ _mm_cvttps_epi32(_mm_add_ps(
-			_mm_mul_ps(_mm_setr_ps(static_cast<float>(Color1 & RMask), static_cast<float>(Color1 & GMask), static_cast<float>(Color1 & BMask), 0.0F), _mm_set_ps1(1.0F - Ratio)),
-			_mm_mul_ps(_mm_setr_ps(static_cast<float>(Color2 & RMask), static_cast<float>(Color2 & GMask), static_cast<float>(Color2 & BMask), 0.0F), _mm_set_ps1(Ratio)))) };
+		// Weight is the share of Color2, alpha is taken from Color2
+		const PixelType InverseWeight{ ColorWeightOne - Weight };
 
-		return static_cast<std::int_fast32_t>(_mm_extract_epi32(ResultVec, 0) | (_mm_extract_epi32(ResultVec, 1) & GMask) | (_mm_extract_epi32(ResultVec, 2) & BMask) | (Color2 & AMask));
+		return ((((Color1 & RBMask) * InverseWeight + (Color2 & RBMask) * Weight) >> 8) & RBMask)
+			| ((((Color1 >> 8) & RMask) * InverseWeight + ((Color2 >> 8) & RMask) * Weight) & GMask)
+			| (Color2 & AMask);
 	}
 
+	inline PixelType ShadeColor(const PixelType Color, const float ShadeFactor, const float Limit)
+	{
+		if (ShadeFactor > Limit)
+		{
+			return AMask;
+		}
+
+		return ScaleColor(Color, GetColorWeight((Limit - ShadeFactor) / Limit));
+	}
+
+	inline PixelType BlendColor(const PixelType Color1, const PixelType Color2, const float Ratio)
+	{
+		return MixColors(Color1, Color2, GetColorWeight(Ratio));
+	}
 
 } // namespace lwmf
\ No newline at end of file
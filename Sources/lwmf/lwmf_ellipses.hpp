@@ -20,21 +20,21 @@ namespace lwmf
 {
 
 
-	void DrawEllipsePoints(TextureStruct& Texture, const IntPointStruct& Point, const IntPointStruct& Center, std::int_fast32_t Color, bool SafeFlag);
-	void Ellipse(TextureStruct& Texture, std::int_fast32_t CenterX, std::int_fast32_t CenterY, std::int_fast32_t RadiusX, std::int_fast32_t RadiusY, std::int_fast32_t Color);
+	void DrawEllipsePoints(TextureStruct& Texture, const IntPointStruct& Point, const IntPointStruct& Center, PixelType Color, bool SafeFlag);
+	void Ellipse(TextureStruct& Texture, std::int_fast32_t CenterX, std::int_fast32_t CenterY, std::int_fast32_t RadiusX, std::int_fast32_t RadiusY, PixelType Color);
 
 	//
 	// Functions
 	//
 
-	inline void DrawEllipsePoints(TextureStruct& Texture, const IntPointStruct& Point, const IntPointStruct& Center, const std::int_fast32_t Color, const bool SafeFlag)
+	inline void DrawEllipsePoints(TextureStruct& Texture, const IntPointStruct& Point, const IntPointStruct& Center, const PixelType Color, const bool SafeFlag)
 	{
 		if (SafeFlag)
 		{
-			Texture.Pixels[((Center.Y + Point.Y) * Texture.Width) + (Center.X + Point.X)] = Color;
-			Texture.Pixels[((Center.Y + Point.Y) * Texture.Width) + (Center.X - Point.X)] = Color;
-			Texture.Pixels[((Center.Y - Point.Y) * Texture.Width) + (Center.X + Point.X)] = Color;
-			Texture.Pixels[((Center.Y - Point.Y) * Texture.Width) + (Center.X - Point.X)] = Color;
+			Texture.Pixels[((Center.Y + Point.Y) * Texture.Stride) + (Center.X + Point.X)] = Color;
+			Texture.Pixels[((Center.Y + Point.Y) * Texture.Stride) + (Center.X - Point.X)] = Color;
+			Texture.Pixels[((Center.Y - Point.Y) * Texture.Stride) + (Center.X + Point.X)] = Color;
+			Texture.Pixels[((Center.Y - Point.Y) * Texture.Stride) + (Center.X - Point.X)] = Color;
 		}
 		else
 		{
@@ -45,7 +45,7 @@ namespace lwmf
 		}
 	}
 
-	inline void Ellipse(TextureStruct& Texture, const std::int_fast32_t CenterX, const std::int_fast32_t CenterY, const std::int_fast32_t RadiusX, const std::int_fast32_t RadiusY, const std::int_fast32_t Color)
+	inline void Ellipse(TextureStruct& Texture, const std::int_fast32_t CenterX, const std::int_fast32_t CenterY, const std::int_fast32_t RadiusX, const std::int_fast32_t RadiusY, const PixelType Color)
 	{
 		// Exit early if ellipse would not be visible (to small or coords out of texture boundaries)
 		if ((RadiusX <= 0 && RadiusY <= 0) || CenterX + RadiusX < 0 || CenterX - RadiusX > Texture.Width || CenterY + RadiusY < 0 || CenterY - RadiusY > Texture.Height)
@@ -22,13 +22,13 @@ namespace lwmf
 {
 
 
-	void ScanlineFill(TextureStruct& Texture, const IntPointStruct& CenterPoint, std::int_fast32_t FillColor);
+	void ScanlineFill(TextureStruct& Texture, const IntPointStruct& CenterPoint, PixelType FillColor);
 
 	//
 	// Functions
 	//
 
-	inline void ScanlineFill(TextureStruct& Texture, const IntPointStruct& CenterPoint, const std::int_fast32_t FillColor)
+	inline void ScanlineFill(TextureStruct& Texture, const IntPointStruct& CenterPoint, const PixelType FillColor)
 	{
 		IntPointStruct Points{ CenterPoint };
 		std::vector<IntPointStruct> Stack{};
@@ -41,7 +41,7 @@ namespace lwmf
 
 			std::int_fast32_t x1{ Points.X };
 
-			while (x1 >= 0 && Texture.Pixels[Points.Y * Texture.Width + x1] != FillColor)
+			while (x1 >= 0 && Texture.Pixels[Points.Y * Texture.Stride + x1] != FillColor)
 			{
 				--x1;
 			}
@@ -50,28 +50,28 @@ namespace lwmf
 
 			bool Above{};
 			bool Below{};
-			const std::int_fast32_t TempY{ Points.Y * Texture.Width };
+			const std::int_fast32_t TempY{ Points.Y * Texture.Stride };
 
 			while (x1 < Texture.Width && Texture.Pixels[TempY + x1] != FillColor)
 			{
 				Texture.Pixels[TempY + x1] = FillColor;
 
-				if (!Above && Points.Y > 0 && Texture.Pixels[(Points.Y - 1) * Texture.Width + x1] != FillColor)
+				if (!Above && Points.Y > 0 && Texture.Pixels[(Points.Y - 1) * Texture.Stride + x1] != FillColor)
 				{
 					Stack.push_back({ x1, Points.Y - 1 });
 					Above = true;
 				}
-				else if (Above && Points.Y > 0 && Texture.Pixels[(Points.Y - 1) * Texture.Width + x1] == FillColor)
+				else if (Above && Points.Y > 0 && Texture.Pixels[(Points.Y - 1) * Texture.Stride + x1] == FillColor)
 				{
 					Above = false;
 				}
 
-				if (!Below && Points.Y < Texture.Height - 1 && Texture.Pixels[(Points.Y + 1) * Texture.Width + x1] != FillColor)
+				if (!Below && Points.Y < Texture.Height - 1 && Texture.Pixels[(Points.Y + 1) * Texture.Stride + x1] != FillColor)
 				{
 					Stack.push_back({ x1, Points.Y + 1 });
 					Below = true;
 				}
-				else if (Below && Points.Y < Texture.Height - 1 && Texture.Pixels[(Points.Y + 1) * Texture.Width + x1] == FillColor)
+				else if (Below && Points.Y < Texture.Height - 1 && Texture.Pixels[(Points.Y + 1) * Texture.Stride + x1] == FillColor)
 				{
 					Below = false;
 				}
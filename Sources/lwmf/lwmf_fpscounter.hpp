@@ -26,7 +26,7 @@ namespace lwmf
 
 
 	void FPSCounter();
-	void DisplayFPSCounter(TextureStruct& Texture, std::int_fast32_t PosX, std::int_fast32_t PosY, std::int_fast32_t Color);
+	void DisplayFPSCounter(TextureStruct& Texture, std::int_fast32_t PosX, std::int_fast32_t PosY, PixelType Color);
 
 	//
 	// Variables and constants
@@ -53,7 +53,7 @@ namespace lwmf
 		++FPSFrames;
 	}
 
-	inline void DisplayFPSCounter(TextureStruct& Texture, const std::int_fast32_t PosX, const std::int_fast32_t PosY, const std::int_fast32_t Color)
+	inline void DisplayFPSCounter(TextureStruct& Texture, const std::int_fast32_t PosX, const std::int_fast32_t PosY, const PixelType Color)
 	{
 		std::array<char, 6> FPSString{};
 		std::to_chars(FPSString.data(), FPSString.data() + FPSString.size(), FPS);
@@ -11,68 +11,302 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <string>
-#include <regex>
+#include <string_view>
 #include <vector>
 #include <fstream>
 #include <sstream>
+#include <iterator>
 #include <algorithm>
+#include <charconv>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <type_traits>
+#include <utility>
 
 #include "lwmf_logging.hpp"
+#include "lwmf_color.hpp"
 
 namespace lwmf
 {
 
 
+	// INI syntax:
+	//
+	// [Section]
+	// Key=Value # comment
+	// ; comment
+	//
+	// Spaces are ignored everywhere, a value ends at "#"
+	//
+	// An INIDocument reads and parses a file once, all sections, keys and values are views into the file content it owns
+	// ReadINIValue() takes its documents from a cache, so a file is parsed only once no matter how many values are read from it
+	// Call ClearINICache() at the end of a load phase to release the documents (and to notice changes to the files afterwards)
+
+	enum class INILineTypes : std::int_fast32_t
+	{
+		Other,
+		Section,
+		Value
+	};
+
+	class INIDocument final
+	{
+	public:
+		bool Load(const std::string& INIFileName);
+		void Parse(std::string&& FileContent);
+		bool GetString(std::string_view Section, std::string_view Key, std::string_view& Value) const;
+		template<typename T>bool GetValue(std::string_view Section, std::string_view Key, T& Value) const;
+		std::size_t GetNumberOfValues() const;
+
+	private:
+		struct KeyHash final
+		{
+			std::size_t operator()(const std::pair<std::string_view, std::string_view>& Key) const noexcept;
+		};
+
+		std::string Content{};
+		std::unordered_map<std::pair<std::string_view, std::string_view>, std::string_view, KeyHash> Values{};
+	};
+
+	using INIDocumentHandle = std::shared_ptr<const INIDocument>;
+
+	INILineTypes ClassifyINILine(std::string_view Line, std::string_view& Name, std::string_view& Value);
+	template<typename T>bool ConvertINIValue(std::string_view Text, T& Value);
+	INIDocumentHandle GetINIDocument(const std::string& INIFileName);
+	void ClearINICache();
 	template<typename T>T ReadINIValue(const std::string& INIFileName, const std::string& Section, const std::string& Key);
 	template<typename T>void WriteINIValue(const std::string& Section, const std::string& Key, T Value, const std::string& INIFileName);
-	std::int_fast32_t ReadINIValueRGBA(const std::string& INIFileName, const std::string& Section);
+	PixelType ReadINIValueRGBA(const std::string& INIFileName, const std::string& Section);
+
+	//
+	// Variables and constants
+	//
+
+	// Documents are shared, so clearing the cache never invalidates a document another thread is still reading from
+	inline std::unordered_map<std::string, INIDocumentHandle> INICache{};
+	inline std::mutex INICacheMutex{};
 
 	//
 	// Functions
 	//
 
-	template<typename T>T ReadINIValue(const std::string& INIFileName, const std::string& Section, const std::string& Key)
+	inline bool INIDocument::Load(const std::string& INIFileName)
 	{
-		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Reading value from INI file " + INIFileName + ": [" + Section + "] / " + Key + "...");
+		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Parse INI file " + INIFileName + "...");
 
-		const std::regex SectionTest(R"(\[(.*?)\])", std::regex::optimize | std::regex::icase);
-		const std::regex ValueTest(R"((\w+)=([^\#]+(?!\+{3})))", std::regex::optimize | std::regex::icase);
+		std::ifstream INIFile(INIFileName, std::ios::in | std::ios::binary);
 
-		T OutputVar{};
-		std::ifstream INIFile(INIFileName, std::ios::in);
-		std::smatch Match{};
-		std::string CurrentSection;
-		std::string Line;
-		bool ValueFound{};
+		if (INIFile.fail())
+		{
+			Parse({});
+			return false;
+		}
+
+		Parse(std::string(std::istreambuf_iterator<char>(INIFile), std::istreambuf_iterator<char>()));
+
+		return true;
+	}
+
+	inline void INIDocument::Parse(std::string&& FileContent)
+	{
+		Content = std::move(FileContent);
+		Values.clear();
+
+		std::string_view CurrentSection{};
+		std::size_t LineStart{};
 
-		while (std::getline(INIFile, Line))
+		while (LineStart < Content.size())
 		{
-			// Remove all spaces from line
-			Line.erase(std::remove(Line.begin(), Line.end(), ' '), Line.end());
+			std::size_t LineEnd{ Content.find('\n', LineStart) };
+
+			if (LineEnd == std::string::npos)
+			{
+				LineEnd = Content.size();
+			}
+
+			// Remove all spaces (and the CR of CRLF files) in place - the line only gets shorter, so all views stay inside the line
+			const auto LineBegin{ Content.begin() + static_cast<std::ptrdiff_t>(LineStart) };
+			const auto NewLineEnd{ std::remove_if(LineBegin, Content.begin() + static_cast<std::ptrdiff_t>(LineEnd), [](const char Char) { return Char == ' ' || Char == '\t' || Char == '\r'; }) };
+			std::string_view Name{};
+			std::string_view Value{};
 
-			if (Line.length() > 0)
+			switch (ClassifyINILine(std::string_view(Content.data() + LineStart, static_cast<std::size_t>(NewLineEnd - LineBegin)), Name, Value))
 			{
-				if (std::regex_search(Line, Match, SectionTest))
+				case INILineTypes::Section:
 				{
-					CurrentSection = Match[1];
+					CurrentSection = Name;
+					break;
 				}
-				else if (std::regex_search(Line, Match, ValueTest) && (CurrentSection == Section && Match[1] == Key))
+				case INILineTypes::Value:
 				{
-					LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "   Value : " + std::string(Match[2]));
-
-					// Convert Value to proper type
-					std::istringstream Stream(Match[2]);
-					std::string(typeid(T).name()) == "bool" ? Stream >> std::boolalpha >> OutputVar : Stream >> OutputVar;
-					ValueFound = true;
+					// The first occurrence of a key wins
+					Values.try_emplace(std::make_pair(CurrentSection, Name), Value);
 					break;
 				}
+				default: {}
 			}
+
+			LineStart = LineEnd + 1;
 		}
+	}
 
-		if (!ValueFound)
+	inline bool INIDocument::GetString(const std::string_view Section, const std::string_view Key, std::string_view& Value) const
+	{
+		if (const auto Entry{ Values.find(std::make_pair(Section, Key)) }; Entry != Values.end())
+		{
+			Value = Entry->second;
+			return true;
+		}
+
+		return false;
+	}
+
+	template<typename T>bool INIDocument::GetValue(const std::string_view Section, const std::string_view Key, T& Value) const
+	{
+		std::string_view Text{};
+
+		return GetString(Section, Key, Text) && ConvertINIValue(Text, Value);
+	}
+
+	inline std::size_t INIDocument::GetNumberOfValues() const
+	{
+		return Values.size();
+	}
+
+	inline std::size_t INIDocument::KeyHash::operator()(const std::pair<std::string_view, std::string_view>& Key) const noexcept
+	{
+		const std::size_t SectionHash{ std::hash<std::string_view>{}(Key.first) };
+
+		return SectionHash ^ (std::hash<std::string_view>{}(Key.second) + 0x9E3779B9 + (SectionHash << 6) + (SectionHash >> 2));
+	}
+
+	// Expects a line without spaces
+	inline INILineTypes ClassifyINILine(std::string_view Line, std::string_view& Name, std::string_view& Value)
+	{
+		// Skip UTF-8 byte order mark
+		if (Line.substr(0, 3) == "\xEF\xBB\xBF")
+		{
+			Line.remove_prefix(3);
+		}
+
+		if (Line.empty() || Line[0] == ';' || Line[0] == '#')
+		{
+			return INILineTypes::Other;
+		}
+
+		if (const std::size_t SectionEnd{ Line.find(']') }; Line[0] == '[' && SectionEnd != std::string_view::npos)
+		{
+			Name = Line.substr(1, SectionEnd - 1);
+			return INILineTypes::Section;
+		}
+
+		if (const std::size_t Separator{ Line.find('=') }; Separator != std::string_view::npos && Separator > 0)
 		{
-			LWMFSystemLog.AddEntry(LogLevel::Error, __FILENAME__, __LINE__, "Value [" + Section + "] / " + Key + " not found!");
+			Name = Line.substr(0, Separator);
+			Value = Line.substr(Separator + 1);
+			Value = Value.substr(0, Value.find('#'));
+
+			// Empty values are treated as missing
+			return Value.empty() ? INILineTypes::Other : INILineTypes::Value;
+		}
+
+		return INILineTypes::Other;
+	}
+
+	template<typename T>bool ConvertINIValue(std::string_view Text, T& Value)
+	{
+		if constexpr (std::is_same_v<T, std::string>)
+		{
+			Value.assign(Text);
+			return true;
+		}
+		else if constexpr (std::is_same_v<T, bool>)
+		{
+			Value = (Text == "true" || Text == "1");
+			return Value || Text == "false" || Text == "0";
+		}
+		else if constexpr (std::is_same_v<T, char>)
+		{
+			if (Text.empty())
+			{
+				return false;
+			}
+
+			Value = Text[0];
+			return true;
+		}
+		else
+		{
+			static_assert(std::is_arithmetic_v<T>, "ConvertINIValue(): Unsupported type!");
+
+			if (!Text.empty() && Text[0] == '+')
+			{
+				Text.remove_prefix(1);
+			}
+
+			// Trailing characters are ignored (e.g. "0.5F")
+			const auto [Pointer, Error]{ std::from_chars(Text.data(), Text.data() + Text.size(), Value) };
+
+			return Error == std::errc{};
+		}
+	}
+
+	inline INIDocumentHandle GetINIDocument(const std::string& INIFileName)
+	{
+		{
+			const std::unique_lock<std::mutex> lock(INICacheMutex);
+
+			if (const auto Entry{ INICache.find(INIFileName) }; Entry != INICache.end())
+			{
+				return Entry->second;
+			}
+		}
+
+		// Parsed outside of the lock - if two threads parse the same file at once, the first document is kept
+		auto Document{ std::make_shared<INIDocument>() };
+
+		// Missing files are not cached, they might be created later
+		if (!Document->Load(INIFileName))
+		{
+			return Document;
+		}
+
+		const std::unique_lock<std::mutex> lock(INICacheMutex);
+
+		return INICache.try_emplace(INIFileName, std::move(Document)).first->second;
+	}
+
+	inline void ClearINICache()
+	{
+		const std::unique_lock<std::mutex> lock(INICacheMutex);
+
+		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Clear INI cache (" + std::to_string(INICache.size()) + " files)...");
+
+		INICache.clear();
+	}
+
+	template<typename T>T ReadINIValue(const std::string& INIFileName, const std::string& Section, const std::string& Key)
+	{
+		T OutputVar{};
+		std::string_view Value{};
+
+		if (!GetINIDocument(INIFileName)->GetString(Section, Key, Value))
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Error, __FILENAME__, __LINE__, "Value [" + Section + "] / " + Key + " not found in " + INIFileName + "!");
+			return OutputVar;
+		}
+
+		if constexpr (IsLogLevelEnabled(LogLevel::Info))
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Reading value from INI file " + INIFileName + ": [" + Section + "] / " + Key + " = " + std::string(Value));
+		}
+
+		if (!ConvertINIValue(Value, OutputVar))
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Warn, __FILENAME__, __LINE__, "Value [" + Section + "] / " + Key + " in " + INIFileName + " has the wrong type!");
 		}
 
 		return OutputVar;
@@ -95,36 +329,55 @@ namespace lwmf
 
 		InputINIFile.close();
 
-		// Modify proper line and write back INI file
+		// Modify proper line and write back INI file - all other lines (including comments and formatting) stay untouched
 
-		const std::regex SectionTest(R"(\[(.*?)\])", std::regex::optimize | std::regex::icase);
-		const std::regex ValueTest(R"((\w+)=([^\#]+(?!\+{3})))", std::regex::optimize | std::regex::icase);
+		std::ostringstream ValueStream;
+		ValueStream << std::boolalpha << Value;
 
 		std::string CurrentSection;
-		std::ofstream OutputINIFile(INIFileName, std::ios::in);
-		std::smatch Match{};
+		bool ValueFound{};
 
 		for (auto&& Line : VectorOfStrings)
 		{
-			// Remove all spaces from line
-			Line.erase(std::remove(Line.begin(), Line.end(), ' '), Line.end());
+			std::string CompactLine{ Line };
+			CompactLine.erase(std::remove_if(CompactLine.begin(), CompactLine.end(), [](const char Char) { return Char == ' ' || Char == '\t' || Char == '\r'; }), CompactLine.end());
+
+			std::string_view Name{};
+			std::string_view OldValue{};
+			const INILineTypes LineType{ ClassifyINILine(CompactLine, Name, OldValue) };
 
-			if (std::regex_search(Line, Match, SectionTest))
+			if (LineType == INILineTypes::Section)
 			{
-				CurrentSection = Match[1];
+				CurrentSection = Name;
 			}
-			else if (std::regex_search(Line, Match, ValueTest) && (CurrentSection == Section && Match[1] == Key))
+			else if (LineType == INILineTypes::Value && !ValueFound && CurrentSection == Section && Name == Key)
 			{
-				Line << Key << "=" << Value << "\n";
+				Line = Key + "=" + ValueStream.str();
+				ValueFound = true;
 			}
+		}
+
+		if (!ValueFound)
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Warn, __FILENAME__, __LINE__, "Value [" + Section + "] / " + Key + " not found in " + INIFileName + ", nothing written!");
+			return;
+		}
+
+		std::ofstream OutputINIFile(INIFileName, std::ios::out | std::ios::trunc);
 
-			OutputINIFile << Line;
+		for (const auto& Line : VectorOfStrings)
+		{
+			OutputINIFile << Line << "\n";
 		}
 
 		OutputINIFile.close();
+
+		// A cached document of this file is outdated now
+		const std::unique_lock<std::mutex> lock(INICacheMutex);
+		INICache.erase(INIFileName);
 	}
 
-	inline std::int_fast32_t ReadINIValueRGBA(const std::string& INIFileName, const std::string& Section)
+	inline PixelType ReadINIValueRGBA(const std::string& INIFileName, const std::string& Section)
 	{
 		return RGBAtoINT(std::clamp(ReadINIValue<std::int_fast32_t>(INIFileName, Section, "Red"), 0, 255),
 							std::clamp(ReadINIValue<std::int_fast32_t>(INIFileName, Section, "Green"), 0, 255),
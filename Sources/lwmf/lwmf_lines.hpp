@@ -24,9 +24,9 @@ namespace lwmf
 
 	std::int_fast32_t FindRegion(std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t x, std::int_fast32_t y);
 	bool ClipLine(std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t x1, std::int_fast32_t y1, std::int_fast32_t x2, std::int_fast32_t y2, std::int_fast32_t& x3, std::int_fast32_t& y3, std::int_fast32_t& x4, std::int_fast32_t& y4);
-	void Line(TextureStruct& Texture, std::int_fast32_t x1, std::int_fast32_t y1, std::int_fast32_t x2, std::int_fast32_t y2, std::int_fast32_t Color);
-	void DrawPixelAA(TextureStruct& Texture, std::int_fast32_t x, std::int_fast32_t y, std::int_fast32_t Color, float Brightness);
-	void LineAA(TextureStruct& Texture, std::int_fast32_t x1, std::int_fast32_t y1, std::int_fast32_t x2, std::int_fast32_t y2, std::int_fast32_t Color);
+	void Line(TextureStruct& Texture, std::int_fast32_t x1, std::int_fast32_t y1, std::int_fast32_t x2, std::int_fast32_t y2, PixelType Color);
+	void DrawPixelAA(TextureStruct& Texture, std::int_fast32_t x, std::int_fast32_t y, PixelType Color, float Brightness);
+	void LineAA(TextureStruct& Texture, std::int_fast32_t x1, std::int_fast32_t y1, std::int_fast32_t x2, std::int_fast32_t y2, PixelType Color);
 
 	//
 	// Functions
@@ -121,7 +121,7 @@ namespace lwmf
 		return false;
 	}
 
-	inline void Line(TextureStruct& Texture, std::int_fast32_t x1, std::int_fast32_t y1, std::int_fast32_t x2, std::int_fast32_t y2, const std::int_fast32_t Color)
+	inline void Line(TextureStruct& Texture, std::int_fast32_t x1, std::int_fast32_t y1, std::int_fast32_t x2, std::int_fast32_t y2, const PixelType Color)
 	{
 		// Exit early if coords are completely out of texture boundaries
 		if ((x1 < 0 && x2 < 0) || (x1 > Texture.Width && x2 > Texture.Width) || (y1 < 0 && y2 < 0) || (y1 > Texture.Height && y2 > Texture.Height))
@@ -140,8 +140,7 @@ namespace lwmf
 				std::swap(x1, x2);
 			}
 
-			const auto Begin{ Texture.Pixels.begin() + y1 * Texture.Width };
-			std::fill(Begin + x1, Begin + x2 + 1, Color);
+			SIMDKernels.FillPixels(Texture.Pixels.data() + y1 * Texture.Stride + x1, static_cast<std::size_t>(x2 - x1 + 1), Color);
 
 			return;
 		}
@@ -159,7 +158,7 @@ namespace lwmf
 
 			for (std::int_fast32_t y{ y1 }; y <= y2; ++y)
 			{
-				Texture.Pixels[y * Texture.Width + x1] = Color;
+				Texture.Pixels[y * Texture.Stride + x1] = Color;
 			}
 
 			return;
@@ -201,7 +200,7 @@ namespace lwmf
 
 				for (std::int_fast32_t j{ StartY }; y1 <= LongLength; ++y1)
 				{
-					Texture.Pixels[y1 * Texture.Width + (j >> 16)] = Color;
+					Texture.Pixels[y1 * Texture.Stride + (j >> 16)] = Color;
 					j += DecInc;
 				}
 
@@ -212,7 +211,7 @@ namespace lwmf
 
 			for (std::int_fast32_t j{ StartY }; y1 >= LongLength; --y1)
 			{
-				Texture.Pixels[y1 * Texture.Width + (j >> 16)] = Color;
+				Texture.Pixels[y1 * Texture.Stride + (j >> 16)] = Color;
 				j -= DecInc;
 			}
 
@@ -227,7 +226,7 @@ namespace lwmf
 
 			for (std::int_fast32_t j{ StartX }; x1 <= LongLength; ++x1)
 			{
-				Texture.Pixels[(j >> 16) * Texture.Width + x1] = Color;
+				Texture.Pixels[(j >> 16) * Texture.Stride + x1] = Color;
 				j += DecInc;
 			}
 
@@ -238,7 +237,7 @@ namespace lwmf
 
 		for (std::int_fast32_t j{ StartX }; x1 >= LongLength; --x1)
 		{
-			Texture.Pixels[(j >> 16) * Texture.Width + x1] = Color;
+			Texture.Pixels[(j >> 16) * Texture.Stride + x1] = Color;
 			j -= DecInc;
 		}
 	}
@@ -253,7 +252,7 @@ namespace lwmf
 	// The algorithm is also described in "Graphics Gems" by Andrew S. Glassner (Academic Press)
 	// Chapter "Symmetric Double Step Line Algorithm", Brian Wyvill, page 101ff
 
-	inline void DrawPixelAA(TextureStruct& Texture, const std::int_fast32_t x, const std::int_fast32_t y, const std::int_fast32_t Color, const float Brightness)
+	inline void DrawPixelAA(TextureStruct& Texture, const std::int_fast32_t x, const std::int_fast32_t y, const PixelType Color, const float Brightness)
 	{
 		const ColorStructRGBA ModColor{ INTtoRGBA(Color) };
 
@@ -263,7 +262,7 @@ namespace lwmf
 			ModColor.Alpha));
 	}
 
-	inline void LineAA(TextureStruct& Texture, std::int_fast32_t x1, std::int_fast32_t y1, std::int_fast32_t x2, std::int_fast32_t y2, const std::int_fast32_t Color)
+	inline void LineAA(TextureStruct& Texture, std::int_fast32_t x1, std::int_fast32_t y1, std::int_fast32_t x2, std::int_fast32_t y2, const PixelType Color)
 	{
 		// Exit early if coords are completely out of texture boundaries
 		if ((x1 < 0 && x2 < 0) || (x1 > Texture.Width && x2 > Texture.Width) || (y1 < 0 && y2 < 0) || (y1 > Texture.Height && y2 > Texture.Height))
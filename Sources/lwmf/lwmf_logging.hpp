@@ -19,21 +19,29 @@
 // LogName.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Here is out message");
 //
 // Will be closed on proper exit of program automatically
+//
+// Entries are stored in a preallocated ring buffer and written to the file by a background thread, so adding an entry
+// neither formats the entry nor touches the file. Any number of threads may add entries without a lock
+//
+// Error and Critical entries are written (together with all entries added before) and flushed synchronously,
+// afterwards the logfile is closed and an exception is thrown (or the program exits)
 
 // This macro will return the current filename without any path information
 #define __FILENAME__ (std::strrchr(__FILE__, '\\') ? std::strrchr(__FILE__, '\\') + 1 : __FILE__)
 
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <string>
 #include <string_view>
 #include <array>
-#include <map>
+#include <vector>
 #include <exception>
 #include <stdexcept>
 #include <fstream>
-#include <sstream>
 #include <ctime>
-#include <iomanip>
+#include <atomic>
+#include <thread>
 
 // #define LWMF_LOGGINGENABLED in your application if you want to write any logsfiles
 #ifdef LWMF_LOGGINGENABLED
@@ -49,6 +57,12 @@
 	inline constexpr bool ThrowExceptions{ false };
 #endif
 
+// #define LWMF_MINIMUMLOGLEVEL in your application to drop all entries below the given level at compile time (e.g. #define LWMF_MINIMUMLOGLEVEL Warn)
+// Error and Critical entries are never dropped
+#ifndef LWMF_MINIMUMLOGLEVEL
+	#define LWMF_MINIMUMLOGLEVEL Info
+#endif
+
 namespace lwmf
 {
 
@@ -63,6 +77,11 @@ namespace lwmf
 		Critical
 	};
 
+	inline constexpr LogLevel MinimumLogLevel{ LogLevel::LWMF_MINIMUMLOGLEVEL };
+
+	// Use it to skip building expensive messages of disabled levels
+	constexpr bool IsLogLevelEnabled(LogLevel Level);
+
 	class Logging final
 	{
 	public:
@@ -76,11 +95,40 @@ namespace lwmf
 		void AddEntry(LogLevel Level, const char* Filename, std::int_fast32_t LineNumber, std::string_view Message);
 
 	private:
-		static std::string GetLocalTime();
+		struct EntryStruct final
+		{
+			std::atomic<std::uint64_t> Sequence{};
+			std::string Message{};
+			const char* Filename{};
+			std::time_t Time{};
+			std::int_fast32_t LineNumber{};
+			LogLevel Level{};
+		};
+
+		static constexpr std::size_t BufferSize{ 1024 };
+		static constexpr std::size_t ReservedMessageLength{ 256 };
+
+		static std::string GetLocalTime(std::time_t Time);
+		std::uint64_t Enqueue(LogLevel Level, const char* Filename, std::int_fast32_t LineNumber, std::string_view Message);
+		bool WriteEntries();
+		void WriterThread();
 
 		std::ofstream Logfile;
+		std::vector<EntryStruct> Entries;
+		std::thread Writer;
+		std::atomic<std::uint64_t> EnqueuePos{};
+		std::atomic<std::uint64_t> WrittenPos{};
+		std::atomic<std::uint64_t> PendingEntries{};
+		std::uint64_t DequeuePos{};
+		std::atomic<bool> OpenFlag{};
+		std::atomic<bool> StopFlag{};
 	};
 
+	constexpr bool IsLogLevelEnabled(const LogLevel Level)
+	{
+		return LoggingEnabled && (Level >= MinimumLogLevel || Level >= LogLevel::Error);
+	}
+
 	inline Logging::Logging(const std::string& Logfilename)
 	{
 		if (LoggingEnabled)
@@ -92,7 +140,19 @@ namespace lwmf
 				std::exit(EXIT_FAILURE);
 			}
 
-			Logfile << "lwmf logging\nlogging started at: " << GetLocalTime() << "\n" << std::string(180, '-') << std::endl;
+			Logfile << "lwmf logging\nlogging started at: " << GetLocalTime(std::time(nullptr)) << "\n" << std::string(180, '-') << "\n";
+			Logfile.flush();
+
+			Entries = std::vector<EntryStruct>(BufferSize);
+
+			for (std::size_t i{}; i < BufferSize; ++i)
+			{
+				Entries[i].Sequence.store(i, std::memory_order_relaxed);
+				Entries[i].Message.reserve(ReservedMessageLength);
+			}
+
+			OpenFlag = true;
+			Writer = std::thread(&Logging::WriterThread, this);
 		}
 	}
 
@@ -100,9 +160,20 @@ namespace lwmf
 	{
 		try
 		{
+			if (Writer.joinable())
+			{
+				StopFlag = true;
+				++PendingEntries;
+				PendingEntries.notify_one();
+				Writer.join();
+			}
+
+			// Entries added while the writer was shutting down
+			WriteEntries();
+
 			if (LoggingEnabled && Logfile.is_open())
 			{
-				Logfile << std::string(180, '-') << "\nlogging ended at: " << GetLocalTime() << std::endl;
+				Logfile << std::string(180, '-') << "\nlogging ended at: " << GetLocalTime(std::time(nullptr)) << std::endl;
 				Logfile.close();
 			}
 		}
@@ -114,61 +185,163 @@ namespace lwmf
 
 	inline void Logging::AddEntry(const LogLevel Level, const char* Filename, const std::int_fast32_t LineNumber, const std::string_view Message)
 	{
-		if (LoggingEnabled && Logfile.is_open())
+		if (!IsLogLevelEnabled(Level) || !OpenFlag.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		const std::uint64_t Pos{ Enqueue(Level, Filename, LineNumber, Message) };
+
+		if (Level == LogLevel::Error || Level == LogLevel::Critical)
 		{
-			std::map<LogLevel, std::string_view> ErrorTable
+			// Wait until the writer has written and flushed this entry (and closed the logfile)
+			for (std::uint64_t Written{ WrittenPos.load() }; Written <= Pos; Written = WrittenPos.load())
 			{
-				{ LogLevel::Info, "[INFO]" },
-				{ LogLevel::Trace, "[TRACE]" },
-				{ LogLevel::Debug, "[DEBUG]" },
-				{ LogLevel::Warn, "[WARNING]" },
-				{ LogLevel::Error, "[ERROR]" },
-				{ LogLevel::Critical, "[CRITICAL ERROR]" }
-			};
+				WrittenPos.wait(Written);
+			}
 
-			const std::map<LogLevel, std::string_view>::iterator ItErrorTable{ ErrorTable.find(Level) };
+			ThrowExceptions ? throw std::runtime_error(std::string(Message)) : std::exit(EXIT_FAILURE);
+		}
+	}
+
+	// Bounded multi-producer queue - a producer claims a position, fills the entry and publishes it by its sequence number
+	inline std::uint64_t Logging::Enqueue(const LogLevel Level, const char* Filename, const std::int_fast32_t LineNumber, const std::string_view Message)
+	{
+		std::uint64_t Pos{ EnqueuePos.load(std::memory_order_relaxed) };
+		EntryStruct* Entry{};
 
-			if (ItErrorTable != ErrorTable.end())
+		while (true)
+		{
+			Entry = &Entries[Pos & (BufferSize - 1)];
+
+			if (const std::uint64_t Sequence{ Entry->Sequence.load(std::memory_order_acquire) }; Sequence == Pos)
 			{
-				std::string MessageString{ GetLocalTime() };
+				if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (Sequence < Pos)
+			{
+				// Buffer is full - wait for the writer instead of dropping the entry
+				std::this_thread::yield();
+				Pos = EnqueuePos.load(std::memory_order_relaxed);
+			}
+			else
+			{
+				Pos = EnqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		Entry->Message.assign(Message);
+		Entry->Filename = Filename;
+		Entry->Time = std::time(nullptr);
+		Entry->LineNumber = LineNumber;
+		Entry->Level = Level;
+		Entry->Sequence.store(Pos + 1, std::memory_order_release);
+
+		++PendingEntries;
+		PendingEntries.notify_one();
+
+		return Pos;
+	}
+
+	// Writes all entries which are published without a gap, returns false if there was nothing to write
+	inline bool Logging::WriteEntries()
+	{
+		static constexpr std::array<std::string_view, 6> LevelNames{ "[INFO]", "[TRACE]", "[DEBUG]", "[WARNING]", "[ERROR]", "[CRITICAL ERROR]" };
+
+		const std::uint64_t FirstPos{ DequeuePos };
+		std::string MessageString;
+
+		while (!Entries.empty())
+		{
+			EntryStruct& Entry{ Entries[DequeuePos & (BufferSize - 1)] };
+
+			if (Entry.Sequence.load(std::memory_order_acquire) != DequeuePos + 1)
+			{
+				break;
+			}
+
+			if (Logfile.is_open())
+			{
+				MessageString = GetLocalTime(Entry.Time);
 				MessageString += " - ";
-				MessageString += ItErrorTable->second;
+				MessageString += LevelNames[static_cast<std::size_t>(Entry.Level)];
 				MessageString += " - ";
-				MessageString += Filename;
+				MessageString += Entry.Filename;
 				MessageString += "(";
-				MessageString += std::to_string(LineNumber);
+				MessageString += std::to_string(Entry.LineNumber);
 				MessageString += "): ";
-				MessageString += Message;
+				MessageString += Entry.Message;
 
-				if (Level == LogLevel::Error || Level == LogLevel::Critical)
+				if (Entry.Level == LogLevel::Error || Entry.Level == LogLevel::Critical)
 				{
-					Logfile << "\n" << GetLocalTime() << "\n" << MessageString << std::endl;
+					Logfile << "\n" << GetLocalTime(Entry.Time) << "\n" << MessageString << std::endl;
 					Logfile.close();
+					OpenFlag = false;
+				}
+				else
+				{
+					Logfile << MessageString << "\n";
+				}
+			}
+
+			// Long messages may have grown the buffer of the entry, it is kept for later use
+			Entry.Sequence.store(DequeuePos + BufferSize, std::memory_order_release);
+			++DequeuePos;
+		}
+
+		if (DequeuePos == FirstPos)
+		{
+			return false;
+		}
+
+		if (Logfile.is_open())
+		{
+			Logfile.flush();
+		}
+
+		PendingEntries -= DequeuePos - FirstPos;
+		WrittenPos.store(DequeuePos);
+		WrittenPos.notify_all();
 
-					ThrowExceptions ? throw std::runtime_error(std::string(Message)) : std::exit(EXIT_FAILURE);
+		return true;
+	}
+
+	inline void Logging::WriterThread()
+	{
+		while (!StopFlag)
+		{
+			if (!WriteEntries())
+			{
+				// Either nothing is pending, or an entry was claimed but is not published yet
+				if (const std::uint64_t Pending{ PendingEntries.load() }; Pending == 0)
+				{
+					PendingEntries.wait(0);
 				}
 				else
 				{
-					Logfile << MessageString << std::endl;
+					std::this_thread::yield();
 				}
 			}
 		}
+
+		WriteEntries();
 	}
 
-	inline std::string Logging::GetLocalTime()
+	inline std::string Logging::GetLocalTime(const std::time_t Time)
 	{
 		struct std::tm TimeObject {};
-		const std::time_t CurrentTime{ std::time(nullptr) };
-
-		localtime_s(&TimeObject, &CurrentTime);
+		localtime_s(&TimeObject, &Time);
 
 		// Format of time following ISO 8601
 		// https://de.wikipedia.org/wiki/ISO_8601
 
-		const std::string TimeFormat{ "%Y-%m-%dT%H:%M:%S" };
-		std::ostringstream TempStream;
-		TempStream << std::put_time(&TimeObject, TimeFormat.c_str());
-		return TempStream.str();
+		std::array<char, 32> TimeString{};
+		const std::size_t Length{ std::strftime(TimeString.data(), TimeString.size(), "%Y-%m-%dT%H:%M:%S", &TimeObject) };
+
+		return std::string(TimeString.data(), Length);
 	}
 
 
@@ -74,6 +74,7 @@ namespace lwmf
 	public:
 		void LoadShader(const std::string& ShaderName, const TextureStruct& Texture);
 		static void LoadTextureInGPU(const TextureStruct& Texture, GLuint* TextureID);
+		static void LoadTextureInGPU(const TextureViewStruct& Texture, GLuint* TextureID);
 		void RenderTexture(const GLuint* Texture, std::int_fast32_t PosX, std::int_fast32_t PosY, std::int_fast32_t Width, std::int_fast32_t Height, bool Blend, float Opacity);
 		void LoadStaticTextureInGPU(const TextureStruct& Texture, GLuint* TextureID, std::int_fast32_t PosX, std::int_fast32_t PosY, std::int_fast32_t Width, std::int_fast32_t Height);
 		void RenderStaticTexture(const GLuint* TextureID, bool Blend, float Opacity) const;
@@ -241,12 +242,19 @@ namespace lwmf
 	}
 
 	inline void ShaderClass::LoadTextureInGPU(const lwmf::TextureStruct& Texture, GLuint *TextureID)
+	{
+		LoadTextureInGPU(GetTextureView(Texture), TextureID);
+	}
+
+	inline void ShaderClass::LoadTextureInGPU(const lwmf::TextureViewStruct& Texture, GLuint *TextureID)
 	{
 		glCreateTextures(GL_TEXTURE_2D, 1, TextureID);
 		glCheckError();
 		glBindTexture(GL_TEXTURE_2D, *TextureID);
 		glCheckError();
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, Texture.Width, Texture.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, Texture.Pixels.data());
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, Texture.Stride);
+		glCheckError();
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, Texture.Width, Texture.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, Texture.Pixels);
 		glCheckError();
 		glTextureParameteri(*TextureID, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 		glCheckError();
@@ -300,6 +308,7 @@ namespace lwmf
 		glUseProgram(ShaderProgram);
 		glProgramUniform1f(ShaderProgram, OpacityLocation, Opacity);
 		glBindVertexArray(VertexArrayObject);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, Texture.Stride);
 		glTextureSubImage2D(OGLTextureID, 0, 0, 0, Texture.Width, Texture.Height, GL_RGBA, GL_UNSIGNED_BYTE, Texture.Pixels.data());
 		glBindTexture(GL_TEXTURE_2D, OGLTextureID);
 		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
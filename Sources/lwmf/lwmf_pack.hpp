@@ -0,0 +1,393 @@
+/*
+***************************************************************
+*                                                             *
+* lwmf_pack - lightweight media framework                     *
+*                                                             *
+* (C) 2019 - present by Stefan Kubsch                         *
+*                                                             *
+***************************************************************
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <unordered_map>
+#include <type_traits>
+
+#include "lwmf_texture.hpp"
+
+namespace lwmf
+{
+
+
+	// Asset pack - a single binary file holding pre-decoded textures and arbitrary data blobs
+	//
+	// Layout (all values little endian):
+	// PackHeaderStruct | data blobs | index (PackEntryStruct * EntryCount) | name table
+	//
+	// Every data blob starts on a PackAlignment boundary and textures are stored with the same row padding as TextureStruct,
+	// so a memory-mapped pack can be used without any decoding or copying
+
+	inline constexpr std::array<char, 8> PackMagic{ 'L', 'W', 'M', 'F', 'P', 'A', 'C', 'K' };
+	inline constexpr std::uint32_t PackVersion{ 2 };
+	inline constexpr std::size_t PackAlignment{ PixelBufferAlignment };
+
+	enum class PackEntryTypes : std::uint32_t
+	{
+		Texture,
+		Blob
+	};
+
+	struct PackHeaderStruct final
+	{
+		std::array<char, 8> Magic{};
+		std::uint32_t Version{};
+		std::uint32_t EntryCount{};
+		std::uint64_t IndexOffset{};
+		std::uint64_t NameTableOffset{};
+		std::uint64_t NameTableSize{};
+	};
+
+	struct PackEntryStruct final
+	{
+		std::uint64_t DataOffset{};
+		std::uint64_t DataSize{};
+		std::uint64_t ContentHash{}; // Hash of the source file, so caches can match packed and unpacked assets
+		std::uint32_t NameOffset{};
+		std::uint32_t NameLength{};
+		PackEntryTypes Type{};
+		std::int32_t Width{};
+		std::int32_t Height{};
+		std::int32_t Stride{};
+	};
+
+	static_assert(std::is_trivially_copyable_v<PackHeaderStruct> && sizeof(PackHeaderStruct) == 40, "PackHeaderStruct must match the file layout!");
+	static_assert(std::is_trivially_copyable_v<PackEntryStruct> && sizeof(PackEntryStruct) == 48, "PackEntryStruct must match the file layout!");
+
+	class PackWriter final
+	{
+	public:
+		void AddTexture(const std::string& Name, const TextureStruct& Texture, std::uint64_t ContentHash);
+		void AddBlob(const std::string& Name, const void* Source, std::size_t Size);
+		bool Contains(const std::string& Name) const;
+		std::size_t GetNumberOfEntries() const;
+		std::uint64_t GetDataSize() const;
+		bool Write(const std::string& FileName) const;
+
+	private:
+		void AddEntry(const std::string& Name, PackEntryTypes Type, std::int32_t Width, std::int32_t Height, std::int32_t Stride, std::uint64_t ContentHash, const void* Source, std::size_t Size);
+
+		std::vector<PackEntryStruct> Entries{};
+		std::unordered_map<std::string, std::size_t> EntryIndex{};
+		std::string NameTable{};
+		std::vector<char> Data{};
+	};
+
+	class PackFile final
+	{
+	public:
+		PackFile() = default;
+		PackFile(const PackFile&) = delete;
+		PackFile(PackFile&&) = delete;
+		PackFile& operator = (const PackFile&) = delete;
+		PackFile& operator = (PackFile&&) = delete;
+		~PackFile();
+
+		bool Open(const std::string& FileName);
+		void Close();
+		bool IsOpen() const;
+		const PackEntryStruct* FindEntry(std::string_view Name) const;
+		bool GetTextureView(std::string_view Name, TextureViewStruct& View) const;
+		bool GetBlob(std::string_view Name, std::string_view& Blob) const;
+
+	private:
+		bool Validate();
+
+		HANDLE FileHandle{ INVALID_HANDLE_VALUE };
+		HANDLE MappingHandle{};
+		const char* Base{};
+		std::uint64_t FileSize{};
+		const PackEntryStruct* Entries{};
+		std::unordered_map<std::string_view, const PackEntryStruct*> EntryIndex{};
+	};
+
+	//
+	// Functions
+	//
+
+	inline void PackWriter::AddTexture(const std::string& Name, const TextureStruct& Texture, const std::uint64_t ContentHash)
+	{
+		AddEntry(Name, PackEntryTypes::Texture, static_cast<std::int32_t>(Texture.Width), static_cast<std::int32_t>(Texture.Height), static_cast<std::int32_t>(Texture.Stride), ContentHash, Texture.Pixels.data(), static_cast<std::size_t>(Texture.Size) * sizeof(PixelType));
+	}
+
+	inline void PackWriter::AddBlob(const std::string& Name, const void* Source, const std::size_t Size)
+	{
+		AddEntry(Name, PackEntryTypes::Blob, 0, 0, 0, 0, Source, Size);
+	}
+
+	inline bool PackWriter::Contains(const std::string& Name) const
+	{
+		return EntryIndex.find(Name) != EntryIndex.end();
+	}
+
+	inline std::size_t PackWriter::GetNumberOfEntries() const
+	{
+		return Entries.size();
+	}
+
+	inline std::uint64_t PackWriter::GetDataSize() const
+	{
+		return static_cast<std::uint64_t>(Data.size());
+	}
+
+	inline void PackWriter::AddEntry(const std::string& Name, const PackEntryTypes Type, const std::int32_t Width, const std::int32_t Height, const std::int32_t Stride, const std::uint64_t ContentHash, const void* Source, const std::size_t Size)
+	{
+		// Assets referenced more than once are stored only once
+		if (Contains(Name))
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Trace, __FILENAME__, __LINE__, "lwmf::PackWriter: " + Name + " is already in pack!");
+			return;
+		}
+
+		PackEntryStruct Entry{};
+		// Data blobs start behind the header, which is padded to PackAlignment as well
+		Entry.DataOffset = PackAlignment + static_cast<std::uint64_t>(Data.size());
+		Entry.DataSize = static_cast<std::uint64_t>(Size);
+		Entry.ContentHash = ContentHash;
+		Entry.NameOffset = static_cast<std::uint32_t>(NameTable.size());
+		Entry.NameLength = static_cast<std::uint32_t>(Name.size());
+		Entry.Type = Type;
+		Entry.Width = Width;
+		Entry.Height = Height;
+		Entry.Stride = Stride;
+
+		const std::size_t PaddedSize{ (Size + PackAlignment - 1) & ~(PackAlignment - 1) };
+		const std::size_t Offset{ Data.size() };
+		Data.resize(Offset + PaddedSize);
+
+		if (Size > 0)
+		{
+			std::memcpy(Data.data() + Offset, Source, Size);
+		}
+
+		NameTable += Name;
+		EntryIndex.emplace(Name, Entries.size());
+		Entries.emplace_back(Entry);
+	}
+
+	inline bool PackWriter::Write(const std::string& FileName) const
+	{
+		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Write pack " + FileName + " (" + std::to_string(Entries.size()) + " entries)...");
+
+		std::ofstream File(FileName, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		if (File.fail())
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Error, __FILENAME__, __LINE__, "lwmf::PackWriter::Write(): Error creating " + FileName + "!");
+			return false;
+		}
+
+		PackHeaderStruct Header{};
+		Header.Magic = PackMagic;
+		Header.Version = PackVersion;
+		Header.EntryCount = static_cast<std::uint32_t>(Entries.size());
+		Header.IndexOffset = PackAlignment + static_cast<std::uint64_t>(Data.size());
+		Header.NameTableOffset = Header.IndexOffset + static_cast<std::uint64_t>(Entries.size() * sizeof(PackEntryStruct));
+		Header.NameTableSize = static_cast<std::uint64_t>(NameTable.size());
+
+		std::array<char, PackAlignment> HeaderBlock{};
+		std::memcpy(HeaderBlock.data(), &Header, sizeof(Header));
+
+		File.write(HeaderBlock.data(), static_cast<std::streamsize>(HeaderBlock.size()));
+		File.write(Data.data(), static_cast<std::streamsize>(Data.size()));
+		File.write(reinterpret_cast<const char*>(Entries.data()), static_cast<std::streamsize>(Entries.size() * sizeof(PackEntryStruct)));
+		File.write(NameTable.data(), static_cast<std::streamsize>(NameTable.size()));
+
+		if (File.fail())
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Error, __FILENAME__, __LINE__, "lwmf::PackWriter::Write(): Error writing " + FileName + "!");
+			return false;
+		}
+
+		return true;
+	}
+
+	inline PackFile::~PackFile()
+	{
+		Close();
+	}
+
+	inline bool PackFile::Open(const std::string& FileName)
+	{
+		Close();
+
+		FileHandle = CreateFileA(FileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+		// A missing pack is no error - callers fall back to the single asset files
+		if (FileHandle == INVALID_HANDLE_VALUE)
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "No pack " + FileName + " found.");
+			return false;
+		}
+
+		LARGE_INTEGER Size{};
+
+		if (GetFileSizeEx(FileHandle, &Size) == 0 || Size.QuadPart < static_cast<LONGLONG>(sizeof(PackHeaderStruct)))
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Warn, __FILENAME__, __LINE__, "lwmf::PackFile::Open(): " + FileName + " is no valid pack!");
+			Close();
+			return false;
+		}
+
+		FileSize = static_cast<std::uint64_t>(Size.QuadPart);
+		MappingHandle = CreateFileMappingA(FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (MappingHandle != nullptr)
+		{
+			Base = static_cast<const char*>(MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0));
+		}
+
+		if (Base == nullptr)
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Warn, __FILENAME__, __LINE__, "lwmf::PackFile::Open(): Error mapping " + FileName + "!");
+			Close();
+			return false;
+		}
+
+		if (!Validate())
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Warn, __FILENAME__, __LINE__, "lwmf::PackFile::Open(): " + FileName + " is no valid pack or was written by another version!");
+			Close();
+			return false;
+		}
+
+		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Mapped pack " + FileName + " (" + std::to_string(EntryIndex.size()) + " entries)...");
+
+		return true;
+	}
+
+	inline bool PackFile::Validate()
+	{
+		PackHeaderStruct Header{};
+		std::memcpy(&Header, Base, sizeof(Header));
+
+		if (Header.Magic != PackMagic || Header.Version != PackVersion
+			|| Header.IndexOffset % alignof(PackEntryStruct) != 0
+			|| Header.IndexOffset > FileSize || Header.EntryCount > (FileSize - Header.IndexOffset) / sizeof(PackEntryStruct)
+			|| Header.NameTableOffset > FileSize || Header.NameTableSize > FileSize - Header.NameTableOffset)
+		{
+			return false;
+		}
+
+		Entries = reinterpret_cast<const PackEntryStruct*>(Base + Header.IndexOffset);
+		const std::string_view NameTable(Base + Header.NameTableOffset, static_cast<std::size_t>(Header.NameTableSize));
+		EntryIndex.reserve(Header.EntryCount);
+
+		for (std::uint32_t i{}; i < Header.EntryCount; ++i)
+		{
+			const PackEntryStruct& Entry{ Entries[i] };
+
+			if (Entry.DataOffset % PackAlignment != 0 || Entry.DataOffset > FileSize || Entry.DataSize > FileSize - Entry.DataOffset
+				|| Entry.NameOffset > NameTable.size() || Entry.NameLength > NameTable.size() - Entry.NameOffset)
+			{
+				return false;
+			}
+
+			if (Entry.Type == PackEntryTypes::Texture
+				&& (Entry.Width <= 0 || Entry.Height <= 0 || Entry.Stride < Entry.Width
+				|| static_cast<std::uint64_t>(Entry.Stride) * static_cast<std::uint64_t>(Entry.Height) * sizeof(PixelType) > Entry.DataSize))
+			{
+				return false;
+			}
+
+			EntryIndex.emplace(NameTable.substr(Entry.NameOffset, Entry.NameLength), &Entry);
+		}
+
+		return true;
+	}
+
+	inline void PackFile::Close()
+	{
+		EntryIndex.clear();
+		Entries = nullptr;
+
+		if (Base != nullptr)
+		{
+			UnmapViewOfFile(Base);
+			Base = nullptr;
+		}
+
+		if (MappingHandle != nullptr)
+		{
+			CloseHandle(MappingHandle);
+			MappingHandle = nullptr;
+		}
+
+		if (FileHandle != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(FileHandle);
+			FileHandle = INVALID_HANDLE_VALUE;
+		}
+
+		FileSize = 0;
+	}
+
+	inline bool PackFile::IsOpen() const
+	{
+		return Base != nullptr;
+	}
+
+	inline const PackEntryStruct* PackFile::FindEntry(const std::string_view Name) const
+	{
+		if (const auto Entry{ EntryIndex.find(Name) }; Entry != EntryIndex.end())
+		{
+			return Entry->second;
+		}
+
+		return nullptr;
+	}
+
+	inline bool PackFile::GetTextureView(const std::string_view Name, TextureViewStruct& View) const
+	{
+		const PackEntryStruct* Entry{ FindEntry(Name) };
+
+		if (Entry == nullptr || Entry->Type != PackEntryTypes::Texture)
+		{
+			return false;
+		}
+
+		View.Pixels = reinterpret_cast<const PixelType*>(Base + Entry->DataOffset);
+		View.Width = Entry->Width;
+		View.Height = Entry->Height;
+		View.Stride = Entry->Stride;
+		View.WidthMid = View.Width >> 1;
+		View.HeightMid = View.Height >> 1;
+		View.Size = View.Stride * View.Height;
+
+		return true;
+	}
+
+	inline bool PackFile::GetBlob(const std::string_view Name, std::string_view& Blob) const
+	{
+		const PackEntryStruct* Entry{ FindEntry(Name) };
+
+		if (Entry == nullptr || Entry->Type != PackEntryTypes::Blob)
+		{
+			return false;
+		}
+
+		Blob = std::string_view(Base + Entry->DataOffset, static_cast<std::size_t>(Entry->DataSize));
+
+		return true;
+	}
+
+
+} // namespace lwmf
\ No newline at end of file
@@ -17,43 +17,43 @@
 namespace lwmf
 {
 
-	void SetPixel(TextureStruct& Texture, std::int_fast32_t x, std::int_fast32_t y, std::int_fast32_t Color);
-	void SetPixelSafe(TextureStruct& Texture, std::int_fast32_t x, std::int_fast32_t y, std::int_fast32_t Color);
-	std::int_fast32_t GetPixel(const TextureStruct& Texture, std::int_fast32_t x, std::int_fast32_t y);
-	std::int_fast32_t GetPixelSafe(const TextureStruct& Texture, std::int_fast32_t x, std::int_fast32_t y);
+	void SetPixel(TextureStruct& Texture, std::int_fast32_t x, std::int_fast32_t y, PixelType Color);
+	void SetPixelSafe(TextureStruct& Texture, std::int_fast32_t x, std::int_fast32_t y, PixelType Color);
+	PixelType GetPixel(const TextureStruct& Texture, std::int_fast32_t x, std::int_fast32_t y);
+	PixelType GetPixelSafe(const TextureStruct& Texture, std::int_fast32_t x, std::int_fast32_t y);
 
 	//
 	// Functions
 	//
 
-	inline void SetPixel(TextureStruct& Texture, const std::int_fast32_t x, const std::int_fast32_t y, const std::int_fast32_t Color)
+	inline void SetPixel(TextureStruct& Texture, const std::int_fast32_t x, const std::int_fast32_t y, const PixelType Color)
 	{
-		Texture.Pixels[y * Texture.Width + x] = Color;
+		Texture.Pixels[y * Texture.Stride + x] = Color;
 	}
 
-	inline void SetPixelSafe(TextureStruct& Texture, const std::int_fast32_t x, const std::int_fast32_t y, const std::int_fast32_t Color)
+	inline void SetPixelSafe(TextureStruct& Texture, const std::int_fast32_t x, const std::int_fast32_t y, const PixelType Color)
 	{
 		if (static_cast<std::uint_fast32_t>(x) >= static_cast<std::uint_fast32_t>(Texture.Width) || static_cast<std::uint_fast32_t>(y) >= static_cast<std::uint_fast32_t>(Texture.Height))
 		{
 			return;
 		}
 
-		Texture.Pixels[y * Texture.Width + x] = Color;
+		Texture.Pixels[y * Texture.Stride + x] = Color;
 	}
 
-	inline std::int_fast32_t GetPixel(const TextureStruct& Texture, const std::int_fast32_t x, const std::int_fast32_t y)
+	inline PixelType GetPixel(const TextureStruct& Texture, const std::int_fast32_t x, const std::int_fast32_t y)
 	{
-		return Texture.Pixels[y * Texture.Width + x];
+		return Texture.Pixels[y * Texture.Stride + x];
 	}
 
-	inline std::int_fast32_t GetPixelSafe(const TextureStruct& Texture, const std::int_fast32_t x, const std::int_fast32_t y)
+	inline PixelType GetPixelSafe(const TextureStruct& Texture, const std::int_fast32_t x, const std::int_fast32_t y)
 	{
 		if (static_cast<std::uint_fast32_t>(x) >= static_cast<std::uint_fast32_t>(Texture.Width) || static_cast<std::uint_fast32_t>(y) >= static_cast<std::uint_fast32_t>(Texture.Height))
 		{
 			return 0x00000000;
 		}
 
-		return Texture.Pixels[y * Texture.Width + x];
+		return Texture.Pixels[y * Texture.Stride + x];
 	}
 
 
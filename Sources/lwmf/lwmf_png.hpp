@@ -11,26 +11,38 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <array>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <atomic>
+#include <chrono>
+#include <limits>
 
 #include "lwmf_logging.hpp"
 #include "lwmf_texture.hpp"
 #include "lwmf_color.hpp"
+#include "lwmf_simd.hpp"
 
 namespace lwmf
 {
 
 
+	bool ReadPNGFile(std::vector<unsigned char>& Buffer, const std::string& FileName);
+	void DecodePNG(TextureStruct& Texture, const std::vector<unsigned char>& Buffer, const std::string& FileName);
 	void LoadPNG(TextureStruct& Texture, const std::string& FileName);
+	bool BenchmarkPNGDecoding(const std::vector<std::string>& FileNames, std::int_fast32_t Passes);
 
 	//
 	// Variables and constants
 	//
 
+	// Counts every successfully decoded PNG (used by lwmf::Timeline)
+	inline std::atomic<std::uint64_t> NumberOfDecodedPNGs{};
+
 	inline constexpr std::array<std::int_fast32_t, 29> LengthBase{ 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
 	inline constexpr std::array<std::int_fast32_t, 29> LengthExtra{ 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
 	inline constexpr std::array<std::int_fast32_t, 30> DistanceBase{ 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
@@ -43,295 +55,433 @@ namespace lwmf
 
 	struct Zlib
 	{
-		inline static std::int_fast32_t ReadBitFromStream(std::int_fast32_t& Bit, const unsigned char* Bits)
+		// Huffman codes are resolved by table lookup: the next FastBits bits of the stream index the primary table,
+		// codes longer than that continue in a second-level table that is linked from the primary entry
+		static constexpr std::int_fast32_t FastBits{ 10 };
+		static constexpr std::uint64_t FastMask{ (1U << FastBits) - 1 };
+		static constexpr std::uint32_t SubTableFlag{ 0x80 };
+
+		// Entries carry the decoded meaning of their symbol, so the block loop needs no further lookups
+		// A literal has none of these flags set, invalid entries hold the error code in their value bits
+		static constexpr std::uint32_t LengthFlag{ 0x40 };
+		static constexpr std::uint32_t EndOfBlockFlag{ 0x20 };
+		static constexpr std::uint32_t InvalidFlag{ 0x10 };
+		static constexpr std::uint32_t SymbolFlags{ LengthFlag | EndOfBlockFlag | InvalidFlag };
+		static constexpr std::uint32_t InvalidLiteral{ (11U << 16) | InvalidFlag };
+		static constexpr std::uint32_t InvalidDistance{ (18U << 16) | InvalidFlag };
+
+		// Slack behind the output position, so match copies can always move two whole 64-bit words
+		static constexpr std::size_t CopySlack{ 16 };
+
+		static constexpr std::array<std::uint8_t, 256> ReversedBytes{ []
 		{
-			const std::int_fast32_t Result{ static_cast<std::int_fast32_t>((Bits[Bit >> 3] >> (Bit & 0x7)) & 1) };
-			++Bit;
+			std::array<std::uint8_t, 256> Table{};
 
-			return Result;
-		}
+			for (std::uint32_t i{}; i < 256; ++i)
+			{
+				for (std::uint32_t Bit{}; Bit < 8; ++Bit)
+				{
+					Table[i] |= static_cast<std::uint8_t>(((i >> Bit) & 1) << (7 - Bit));
+				}
+			}
 
-		inline static std::int_fast32_t ReadBitsFromStream(std::int_fast32_t& Bit, const unsigned char* Bits, const std::int_fast32_t NBits)
+			return Table;
+		}() };
+
+		// Entry values per symbol: literals map to their byte, length codes to base length and extra bits
+		static constexpr std::array<std::uint32_t, 288> LiteralSymbols{ []
 		{
-			std::int_fast32_t Result{};
+			std::array<std::uint32_t, 288> Symbols{};
 
-			for (std::int_fast32_t i{}; i < NBits; ++i)
+			for (std::uint32_t i{}; i < 256; ++i)
 			{
-				Result += (ReadBitFromStream(Bit, Bits)) << i;
+				Symbols[i] = i << 16;
 			}
 
-			return Result;
-		}
+			Symbols[256] = EndOfBlockFlag;
+
+			for (std::size_t i{}; i < LengthBase.size(); ++i)
+			{
+				Symbols[257 + i] = (static_cast<std::uint32_t>(LengthBase[i]) << 16) | (static_cast<std::uint32_t>(LengthExtra[i]) << 8) | LengthFlag;
+			}
+
+			Symbols[286] = (16U << 16) | InvalidFlag;
+			Symbols[287] = (16U << 16) | InvalidFlag;
+
+			return Symbols;
+		}() };
+
+		static constexpr std::array<std::uint32_t, 32> DistanceSymbols{ []
+		{
+			std::array<std::uint32_t, 32> Symbols{};
+
+			for (std::size_t i{}; i < DistanceBase.size(); ++i)
+			{
+				Symbols[i] = (static_cast<std::uint32_t>(DistanceBase[i]) << 16) | (static_cast<std::uint32_t>(DistanceExtra[i]) << 8);
+			}
+
+			Symbols[30] = InvalidDistance;
+			Symbols[31] = InvalidDistance;
+
+			return Symbols;
+		}() };
+
+		static constexpr std::array<std::uint32_t, 19> CodeLengthSymbols{ []
+		{
+			std::array<std::uint32_t, 19> Symbols{};
+
+			for (std::uint32_t i{}; i < 19; ++i)
+			{
+				Symbols[i] = i << 16;
+			}
 
-		struct HuffmanTree
+			return Symbols;
+		}() };
+
+		struct HuffmanTable
 		{
-			inline std::int_fast32_t MakeFromLengths(const std::vector<std::int_fast32_t>& BitLength, const std::int_fast32_t MaximumBitLength)
+			// Deflate stores Huffman codes MSB first, so the tables are indexed by the bit-reversed code
+			static inline std::uint32_t ReverseCode(const std::uint32_t Code, const std::int_fast32_t Length)
+			{
+				return ((static_cast<std::uint32_t>(ReversedBytes[Code & 0xFF]) << 8) | ReversedBytes[(Code >> 8) & 0xFF]) >> (16 - Length);
+			}
+
+			// Entry layout: bits 16..31 symbol value (or offset of the second-level table), bits 8..11 extra bits, bits 4..6 symbol flags,
+			// bits 0..3 code length (or bits of the second-level table), bit 7 marks a link
+			// Symbols holds the value and flags of every symbol, bit patterns that belong to no code get the Invalid entry
+			inline std::int_fast32_t MakeFromLengths(const std::uint8_t* BitLength, const std::int_fast32_t NumCodes, const std::uint32_t* Symbols, const std::uint32_t Invalid)
 			{
-				const std::int_fast32_t NumCodes{ static_cast<std::int_fast32_t>(BitLength.size()) };
-				std::int_fast32_t TreePos{};
-				std::int_fast32_t NodeFilled{};
-				std::vector<std::int_fast32_t> Tree1D(NumCodes);
-				std::vector<std::int_fast32_t> BitLengthCount(MaximumBitLength + 1, 0);
-				std::vector<std::int_fast32_t> NextCode(MaximumBitLength + 1, 0);
+				std::array<std::int_fast32_t, 16> BitLengthCount{};
+				std::array<std::uint32_t, 16> NextCode{};
+				std::int_fast32_t MaxLength{};
+
+				for (std::int_fast32_t n{}; n < NumCodes; ++n)
+				{
+					++BitLengthCount[BitLength[n]];
+				}
+
+				BitLengthCount[0] = 0;
 
-				for (std::int_fast32_t Bits{}; Bits < NumCodes; ++Bits)
+				for (std::int_fast32_t Left{ 1 }, Bits{ 1 }; Bits < 16; ++Bits)
 				{
-					++BitLengthCount[BitLength[Bits]];
+					Left = (Left << 1) - BitLengthCount[Bits];
+
+					if (Left < 0)
+					{
+						return 55;
+					}
+
+					if (BitLengthCount[Bits] != 0)
+					{
+						MaxLength = Bits;
+					}
+
+					NextCode[Bits] = (NextCode[Bits - 1] + static_cast<std::uint32_t>(BitLengthCount[Bits - 1])) << 1;
 				}
 
-				for (std::int_fast32_t Bits{ 1 }; Bits <= MaximumBitLength; ++Bits)
+				// Canonical codes of one length are assigned in symbol order, so the symbols are sorted by code length first
+				std::array<std::int_fast32_t, 16> LengthStart{};
+				std::array<std::uint16_t, 288> SortedSymbols{};
+
+				for (std::int_fast32_t Bits{ 1 }; Bits < 16; ++Bits)
 				{
-					NextCode[Bits] = (NextCode[Bits - 1] + BitLengthCount[Bits - 1]) << 1;
+					LengthStart[Bits] = LengthStart[Bits - 1] + BitLengthCount[Bits - 1];
 				}
 
 				for (std::int_fast32_t n{}; n < NumCodes; ++n)
 				{
 					if (BitLength[n] != 0)
 					{
-						Tree1D[n] = NextCode[BitLength[n]]++;
+						SortedSymbols[LengthStart[BitLength[n]]++] = static_cast<std::uint16_t>(n);
 					}
 				}
 
-				Tree2D.clear();
-				Tree2D.shrink_to_fit();
-				Tree2D.resize((static_cast<std::size_t>(NumCodes) << 1), 32767);
+				// Codes are entered by increasing length into the first 2^Length entries, which are doubled after each length
+				// So every short code is written once and its repetitions for all longer bit patterns are made by whole block copies
+				Entries.resize(static_cast<std::size_t>(1) << FastBits);
+				Entries[0] = Invalid;
+				Entries[1] = Invalid;
 
-				for (std::int_fast32_t n{}; n < NumCodes; ++n)
+				std::int_fast32_t Index{};
+
+				for (std::int_fast32_t Length{ 1 }; Length <= FastBits; ++Length)
+				{
+					for (std::int_fast32_t i{}; i < BitLengthCount[Length]; ++i, ++Index)
+					{
+						Entries[ReverseCode(NextCode[Length]++, Length)] = Symbols[SortedSymbols[Index]] | static_cast<std::uint32_t>(Length);
+					}
+
+					if (Length < FastBits)
+					{
+						std::memcpy(Entries.data() + (static_cast<std::size_t>(1) << Length), Entries.data(), (static_cast<std::size_t>(1) << Length) * sizeof(std::uint32_t));
+					}
+				}
+
+				// Longer codes continue in second-level tables, linked from the entry of their first FastBits bits
+				const std::int_fast32_t SubBits{ std::max<std::int_fast32_t>(MaxLength - FastBits, 0) };
+
+				for (std::int_fast32_t Length{ FastBits + 1 }; Length <= MaxLength; ++Length)
 				{
-					for (std::int_fast32_t i{}; i < BitLength[n]; ++i)
+					for (std::int_fast32_t i{}; i < BitLengthCount[Length]; ++i, ++Index)
 					{
-						if (TreePos > NumCodes - 2)
+						const std::uint32_t Reversed{ ReverseCode(NextCode[Length]++, Length) };
+						const std::uint32_t Prefix{ Reversed & static_cast<std::uint32_t>(FastMask) };
+
+						if ((Entries[Prefix] & SubTableFlag) == 0)
 						{
-							return 55;
+							Entries[Prefix] = (static_cast<std::uint32_t>(Entries.size()) << 16) | SubTableFlag | static_cast<std::uint32_t>(SubBits);
+							Entries.resize(Entries.size() + (static_cast<std::size_t>(1) << SubBits), Invalid);
 						}
 
-						const std::int_fast32_t Bit{ (Tree1D[n] >> (BitLength[n] - i - 1)) & 1 };
+						const std::uint32_t Offset{ Entries[Prefix] >> 16 };
+						const std::uint32_t Entry{ Symbols[SortedSymbols[Index]] | static_cast<std::uint32_t>(Length) };
 
-						Tree2D[2 * TreePos + Bit] == 32767 ? (i + 1 == BitLength[n] ? (Tree2D[2 * TreePos + Bit] = n, TreePos = 0) : (Tree2D[2 * TreePos + Bit] = ++NodeFilled + NumCodes, TreePos = NodeFilled)) : TreePos = Tree2D[2 * TreePos + Bit] - NumCodes;
+						for (std::uint32_t j{ Reversed >> FastBits }; j < (1U << SubBits); j += (1U << (Length - FastBits)))
+						{
+							Entries[Offset + j] = Entry;
+						}
 					}
 				}
 
 				return 0;
 			}
 
-			inline std::int_fast32_t Decode(bool& Decoded, std::int_fast32_t& Result, std::int_fast32_t& TreePos, const std::int_fast32_t Bit) const
+			std::vector<std::uint32_t> Entries;
+		};
+
+		// LSB-first bit reader with a 64-bit buffer
+		// The hot loops work on a local copy, so the compiler can keep the whole state in registers
+		struct BitStreamStruct final
+		{
+			// Keeps at least 56 valid bits in the buffer - enough for a complete length/distance pair including all extra bits
+			inline void Refill()
 			{
-				const std::int_fast32_t NumCodes{ static_cast<std::int_fast32_t>(Tree2D.size()) >> 1 };
+				if (Pos + 8 <= Length)
+				{
+					std::uint64_t Word{};
+					std::memcpy(&Word, Data + Pos, 8);
 
-				if (TreePos >= NumCodes)
+					Buffer |= Word << Count;
+					Pos += static_cast<std::size_t>((63 - Count) >> 3);
+					Count |= 56;
+				}
+				else
 				{
-					return 11;
+					// Past the end zeros are shifted in, Inflate() detects the overrun afterwards
+					while (Count <= 56)
+					{
+						Buffer |= static_cast<std::uint64_t>(Pos < Length ? Data[Pos] : 0) << Count;
+						++Pos;
+						Count += 8;
+					}
 				}
+			}
 
-				Result = Tree2D[2 * TreePos + Bit];
-				Decoded = (Result < NumCodes);
-				TreePos = Decoded ? 0 : Result - NumCodes;
+			inline std::uint64_t ReadBits(const std::int_fast32_t NBits)
+			{
+				const std::uint64_t Result{ Buffer & ((static_cast<std::uint64_t>(1) << NBits) - 1) };
+				Buffer >>= NBits;
+				Count -= NBits;
 
-				return 0;
+				return Result;
 			}
 
-			std::vector<std::int_fast32_t> Tree2D;
+			// Consumes the code and returns its table entry (invalid entries have a code length of zero and consume nothing)
+			inline std::uint32_t DecodeEntry(const std::uint32_t* Table)
+			{
+				std::uint32_t Entry{ Table[Buffer & FastMask] };
+
+				if ((Entry & SubTableFlag) != 0)
+				{
+					Entry = Table[(Entry >> 16) + ((Buffer >> FastBits) & ((static_cast<std::uint64_t>(1) << (Entry & 0x0F)) - 1))];
+				}
+
+				const std::int_fast32_t CodeLength{ static_cast<std::int_fast32_t>(Entry & 0x0F) };
+
+				Buffer >>= CodeLength;
+				Count -= CodeLength;
+
+				return Entry;
+			}
+
+			inline std::size_t BytesConsumed() const
+			{
+				return Pos - static_cast<std::size_t>(Count >> 3);
+			}
+
+			const unsigned char* Data{};
+			std::size_t Length{};
+			std::size_t Pos{};
+			std::uint64_t Buffer{};
+			std::int_fast32_t Count{};
 		};
 
 		struct Inflator
 		{
 			std::int_fast32_t Error{};
 
-			inline void Inflate(std::vector<unsigned char>& Out, const std::vector<unsigned char>& In, const std::int_fast32_t InPos = 0)
+			inline void Inflate(std::vector<unsigned char>& Out, const unsigned char* Data, const std::size_t Length)
 			{
-				std::int_fast32_t BP{};
-				std::int_fast32_t Pos{};
-				std::int_fast32_t Final{};
+				Stream = BitStreamStruct{ Data, Length };
+				Pos = 0;
 				Error = 0;
 
+				std::uint64_t Final{};
+
 				while (Final == 0 && Error == 0)
 				{
-					if (BP >> 3 >= static_cast<std::int_fast32_t>(In.size()))
-					{
-						Error = 52;
-						return;
-					}
+					Stream.Refill();
 
-					Final = ReadBitFromStream(BP, &In[InPos]);
-					std::int_fast32_t BTYPE{ ReadBitFromStream(BP, &In[InPos]) };
-					BTYPE += (ReadBitFromStream(BP, &In[InPos]) << 1);
+					Final = Stream.ReadBits(1);
+					const std::uint64_t BTYPE{ Stream.ReadBits(2) };
 
-					if (BTYPE == 3)
+					switch (BTYPE)
 					{
-						Error = 20;
-						return;
+						case 0:
+						{
+							InflateNoCompression(Out);
+							break;
+						}
+						case 1:
+						{
+							const FixedTablesStruct& Fixed{ GetFixedTables() };
+							InflateHuffmanBlock(Out, Fixed.Literals, Fixed.Distances);
+							break;
+						}
+						case 2:
+						{
+							GetTreeInflateDynamic();
+
+							if (Error == 0)
+							{
+								InflateHuffmanBlock(Out, CodeTable, CodeTableD);
+							}
+
+							break;
+						}
+						default:
+						{
+							Error = 20;
+							return;
+						}
 					}
 
-					BTYPE == 0 ? InflateNoCompression(Out, &In[InPos], BP, Pos, static_cast<std::int_fast32_t>(In.size())) : InflateHuffmanBlock(Out, &In[InPos], BP, Pos, static_cast<std::int_fast32_t>(In.size()), BTYPE);
+					if (Error == 0 && Stream.BytesConsumed() > Stream.Length)
+					{
+						Error = 10;
+					}
 				}
 
 				if (Error == 0)
 				{
-					Out.resize(static_cast<std::size_t>(Pos));
+					Out.resize(Pos);
 				}
 			}
 
-			static inline void GenerateFixedTrees(HuffmanTree& Tree, HuffmanTree& TreeD)
+			struct FixedTablesStruct final
 			{
-				std::vector<std::int_fast32_t> BitLength(288, 8);
-				const std::vector<std::int_fast32_t> BitLengthD(32, 5);
-
-				for (std::int_fast32_t i{ 144 }; i <= 255; ++i)
-				{
-					BitLength[i] = 9;
-				}
-
-				for (std::int_fast32_t i{ 256 }; i <= 279; ++i)
-				{
-					BitLength[i] = 7;
-				}
-
-				Tree.MakeFromLengths(BitLength, 15);
-				TreeD.MakeFromLengths(BitLengthD, 15);
-			}
-
-			HuffmanTree CodeTree;
-			HuffmanTree CodeTreeD;
-			HuffmanTree CodeLengthCodeTree;
+				HuffmanTable Literals;
+				HuffmanTable Distances;
+			};
 
-			inline std::int_fast32_t HuffmanDecodeSymbol(const unsigned char* In, std::int_fast32_t& BP, const HuffmanTree& HuffCodeTree, const std::int_fast32_t InLength)
+			static inline const FixedTablesStruct& GetFixedTables()
 			{
-				bool Decoded{};
-
-				for (std::int_fast32_t CT{}, TreePos{};;)
+				static const FixedTablesStruct FixedTables{ []
 				{
-					if ((BP & 0x07) == 0 && (BP >> 3) > InLength)
-					{
-						Error = 10;
-						return 0;
-					}
+					FixedTablesStruct Tables;
+					std::array<std::uint8_t, 288> BitLength{};
+					std::array<std::uint8_t, 32> BitLengthD{};
 
-					Error = HuffCodeTree.Decode(Decoded, CT, TreePos, ReadBitFromStream(BP, In));
+					std::fill(BitLength.begin(), BitLength.begin() + 144, static_cast<std::uint8_t>(8));
+					std::fill(BitLength.begin() + 144, BitLength.begin() + 256, static_cast<std::uint8_t>(9));
+					std::fill(BitLength.begin() + 256, BitLength.begin() + 280, static_cast<std::uint8_t>(7));
+					std::fill(BitLength.begin() + 280, BitLength.end(), static_cast<std::uint8_t>(8));
+					BitLengthD.fill(5);
 
-					if (Error != 0)
-					{
-						return 0;
-					}
+					Tables.Literals.MakeFromLengths(BitLength.data(), 288, LiteralSymbols.data(), InvalidLiteral);
+					Tables.Distances.MakeFromLengths(BitLengthD.data(), 32, DistanceSymbols.data(), InvalidDistance);
 
-					if (Decoded)
-					{
-						return CT;
-					}
-				}
+					return Tables;
+				}() };
+
+				return FixedTables;
 			}
 
-			inline void GetTreeInflateDynamic(HuffmanTree& Tree, HuffmanTree& TreeD, const unsigned char* In, std::int_fast32_t& BP, const std::int_fast32_t InLength)
+			inline void GetTreeInflateDynamic()
 			{
-				if (BP >> 3 >= InLength - 2)
-				{
-					Error = 49;
-					return;
-				}
-
-				const std::int_fast32_t HLit{ ReadBitsFromStream(BP, In, 5) + 257 };
-				const std::int_fast32_t HDist{ ReadBitsFromStream(BP, In, 5) + 1 };
-				const std::int_fast32_t HCLength{ ReadBitsFromStream(BP, In, 4) + 4 };
-				std::vector<std::int_fast32_t> CodeLengthCode(19);
+				const std::int_fast32_t HLit{ static_cast<std::int_fast32_t>(Stream.ReadBits(5)) + 257 };
+				const std::int_fast32_t HDist{ static_cast<std::int_fast32_t>(Stream.ReadBits(5)) + 1 };
+				const std::int_fast32_t HCLength{ static_cast<std::int_fast32_t>(Stream.ReadBits(4)) + 4 };
+				std::array<std::uint8_t, 19> CodeLengthCode{};
 
-				for (std::int_fast32_t i{}; i < 19; ++i)
+				for (std::int_fast32_t i{}; i < HCLength; ++i)
 				{
-					CodeLengthCode[CLCL[i]] = (i < HCLength) ? ReadBitsFromStream(BP, In, 3) : 0;
+					Stream.Refill();
+					CodeLengthCode[CLCL[i]] = static_cast<std::uint8_t>(Stream.ReadBits(3));
 				}
 
-				Error = CodeLengthCodeTree.MakeFromLengths(CodeLengthCode, 7);
+				Error = CodeLengthCodeTable.MakeFromLengths(CodeLengthCode.data(), 19, CodeLengthSymbols.data(), InvalidLiteral);
 
 				if (Error != 0)
 				{
 					return;
 				}
 
-				std::vector<std::int_fast32_t> BitLength(288, 0);
-				std::vector<std::int_fast32_t> BitLengthD(32, 0);
+				// Literal/length and distance code lengths form one continuous sequence, so repeats may cross from one into the other
+				std::array<std::uint8_t, 320> BitLength{};
 				std::int_fast32_t i{};
-				std::int_fast32_t RepeatLength{};
 
 				while (i < HLit + HDist)
 				{
-					if (Error != 0)
+					Stream.Refill();
+
+					const std::uint32_t Entry{ Stream.DecodeEntry(CodeLengthCodeTable.Entries.data()) };
+
+					if ((Entry & InvalidFlag) != 0)
 					{
+						Error = 11;
 						return;
 					}
 
-					const std::int_fast32_t Code{ HuffmanDecodeSymbol(In, BP, CodeLengthCodeTree, InLength) };
+					const std::int_fast32_t Code{ static_cast<std::int_fast32_t>(Entry >> 16) };
 
 					if (Code <= 15)
 					{
-						i < HLit ? BitLength[i++] = Code : BitLengthD[i++ - HLit] = Code;
+						BitLength[i++] = static_cast<std::uint8_t>(Code);
+						continue;
 					}
-					else if (Code == 16)
-					{
-						if (BP >> 3 >= InLength)
-						{
-							Error = 50;
-							return;
-						}
 
-						RepeatLength = 3 + ReadBitsFromStream(BP, In, 2);
-						const std::int_fast32_t Value{ (i - 1) < HLit ? BitLength[i - 1] : BitLengthD[i - HLit - 1] };
+					std::uint8_t Value{};
+					std::int_fast32_t RepeatLength{};
 
-						for (std::int_fast32_t n{}; n < RepeatLength; ++n)
-						{
-							if (i >= HLit + HDist)
-							{
-								Error = 13;
-								return;
-							}
-
-							i < HLit ? BitLength[i++] = Value : BitLengthD[i++ - HLit] = Value;
-						}
-					}
-					else if (Code == 17)
+					if (Code == 16)
 					{
-						if (BP >> 3 >= InLength)
+						if (i == 0)
 						{
-							Error = 50;
+							Error = 54;
 							return;
 						}
 
-						RepeatLength = 3 + ReadBitsFromStream(BP, In, 3);
-
-						for (std::int_fast32_t n{}; n < RepeatLength; ++n)
-						{
-							if (i >= HLit + HDist)
-							{
-								Error = 14;
-								return;
-							}
-
-							i < HLit ? BitLength[i++] = 0 : BitLengthD[i++ - HLit] = 0;
-						}
+						Value = BitLength[i - 1];
+						RepeatLength = 3 + static_cast<std::int_fast32_t>(Stream.ReadBits(2));
 					}
-					else if (Code == 18)
+					else if (Code == 17)
 					{
-						if (BP >> 3 >= InLength)
-						{
-							Error = 50;
-							return;
-						}
-
-						RepeatLength = 11 + ReadBitsFromStream(BP, In, 7);
-
-						for (std::int_fast32_t n{}; n < RepeatLength; ++n)
-						{
-							if (i >= HLit + HDist)
-							{
-								Error = 15;
-								return;
-							}
-
-							i < HLit ? BitLength[i++] = 0 : BitLengthD[i++ - HLit] = 0;
-						}
+						RepeatLength = 3 + static_cast<std::int_fast32_t>(Stream.ReadBits(3));
 					}
 					else
 					{
-						Error = 16;
+						RepeatLength = 11 + static_cast<std::int_fast32_t>(Stream.ReadBits(7));
+					}
+
+					if (i + RepeatLength > HLit + HDist)
+					{
+						Error = 13;
 						return;
 					}
+
+					std::fill(BitLength.begin() + i, BitLength.begin() + i + RepeatLength, Value);
+					i += RepeatLength;
 				}
 
 				if (BitLength[256] == 0)
@@ -340,124 +490,167 @@ namespace lwmf
 					return;
 				}
 
-				Error = Tree.MakeFromLengths(BitLength, 15);
+				Error = CodeTable.MakeFromLengths(BitLength.data(), HLit, LiteralSymbols.data(), InvalidLiteral);
 
 				if (Error != 0)
 				{
 					return;
 				}
 
-				Error = TreeD.MakeFromLengths(BitLengthD, 15);
-
-				if (Error != 0)
-				{
-					return;
-				}
+				Error = CodeTableD.MakeFromLengths(BitLength.data() + HLit, HDist, DistanceSymbols.data(), InvalidDistance);
 			}
 
-			inline void InflateHuffmanBlock(std::vector<unsigned char>& Out, const unsigned char* In, std::int_fast32_t& BP, std::int_fast32_t& Pos, const std::int_fast32_t InLength, const std::int_fast32_t Type)
+			inline void InflateHuffmanBlock(std::vector<unsigned char>& Out, const HuffmanTable& Table, const HuffmanTable& TableD)
 			{
-				if (Type == 1)
-				{
-					GenerateFixedTrees(CodeTree, CodeTreeD);
-				}
-				else if (Type == 2)
-				{
-					GetTreeInflateDynamic(CodeTree, CodeTreeD, In, BP, InLength);
-
-					if (Error != 0)
-					{
-						return;
-					}
-				}
-
+				// Stores into the output buffer may alias any member, so the whole decoder state lives in locals here
+				BitStreamStruct Bits{ Stream };
+				const std::uint32_t* Literals{ Table.Entries.data() };
+				const std::uint32_t* Distances{ TableD.Entries.data() };
+				unsigned char* Target{ Out.data() };
+				std::size_t TargetSize{ Out.size() };
+				std::size_t TargetPos{ Pos };
+
+				// The loop is only left by break, testing the Error member per symbol would force a reload after every output byte
 				for (;;)
 				{
-					const std::int_fast32_t Code{ HuffmanDecodeSymbol(In, BP, CodeTree, InLength) };
+					Bits.Refill();
 
-					if (Error != 0 || Code == 256)
+					// Truncated streams would otherwise decode the zero padding endlessly
+					if (Bits.Pos > Bits.Length + 8)
 					{
-						return;
+						Error = 10;
+						break;
 					}
 
-					if (Code <= 255)
+					std::uint32_t Entry{ Bits.DecodeEntry(Literals) };
+
+					if ((Entry & SymbolFlags) == 0)
 					{
-						if (Pos >= static_cast<std::int_fast32_t>(Out.size()))
+						if (TargetPos + 2 > TargetSize)
 						{
-							Out.resize((static_cast<std::size_t>(Pos) + 1) << 1);
+							Out.resize(std::max(TargetPos + 2, TargetSize << 1));
+							Target = Out.data();
+							TargetSize = Out.size();
 						}
 
-						Out[Pos++] = static_cast<unsigned char>(Code);
-					}
-					else if (Code >= 257 && Code <= 285) //-V560
-					{
-						std::int_fast32_t Length{ LengthBase[Code - 257] };
+						Target[TargetPos++] = static_cast<unsigned char>(Entry >> 16);
+
+						// After a refill at least 41 bits are left behind the first literal, enough for a second one
+						Entry = Bits.DecodeEntry(Literals);
 
-						if ((BP >> 3) >= InLength) //-V1051
+						if ((Entry & SymbolFlags) == 0)
 						{
-							Error = 51;
-							return;
+							Target[TargetPos++] = static_cast<unsigned char>(Entry >> 16);
+							continue;
 						}
 
-						Length += ReadBitsFromStream(BP, In, LengthExtra[Code - 257]);
-						const std::int_fast32_t CodeD{ HuffmanDecodeSymbol(In, BP, CodeTreeD, InLength) };
-
-						if (Error != 0)
+						// A length/distance pair takes up to 48 bits
+						if (Bits.Count < 48)
 						{
-							return;
+							Bits.Refill();
 						}
+					}
 
-						if (CodeD > 29)
+					if ((Entry & LengthFlag) == 0)
+					{
+						if ((Entry & InvalidFlag) != 0)
 						{
-							Error = 18;
-							return;
+							Error = static_cast<std::int_fast32_t>(Entry >> 16);
 						}
 
-						std::int_fast32_t Distance{ DistanceBase[CodeD] };
+						break;
+					}
 
-						if ((BP >> 3) >= InLength)
-						{
-							Error = 51;
-							return;
-						}
+					const std::size_t Length{ static_cast<std::size_t>(Entry >> 16) + static_cast<std::size_t>(Bits.ReadBits(static_cast<std::int_fast32_t>((Entry >> 8) & 0x0F))) };
+					const std::uint32_t EntryD{ Bits.DecodeEntry(Distances) };
+
+					if ((EntryD & InvalidFlag) != 0)
+					{
+						Error = static_cast<std::int_fast32_t>(EntryD >> 16);
+						break;
+					}
 
-						Distance += ReadBitsFromStream(BP, In, DistanceExtra[CodeD]);
+					const std::size_t Distance{ static_cast<std::size_t>(EntryD >> 16) + static_cast<std::size_t>(Bits.ReadBits(static_cast<std::int_fast32_t>((EntryD >> 8) & 0x0F))) };
 
-						if (Pos + Length >= static_cast<std::int_fast32_t>(Out.size()))
+					if (Distance > TargetPos)
+					{
+						Error = 52;
+						break;
+					}
+
+					if (TargetPos + Length + CopySlack > TargetSize)
+					{
+						Out.resize(std::max(TargetPos + Length + CopySlack, TargetSize << 1));
+						Target = Out.data();
+						TargetSize = Out.size();
+					}
+
+					unsigned char* Destination{ Target + TargetPos };
+					const unsigned char* Source{ Destination - Distance };
+
+					// Distances of eight or more never read bytes of the same word that is being written, so whole words can be moved
+					// Most matches are short, the first two words are moved unconditionally
+					if (Distance >= 8)
+					{
+						std::uint64_t Word{};
+						std::memcpy(&Word, Source, 8);
+						std::memcpy(Destination, &Word, 8);
+						std::memcpy(&Word, Source + 8, 8);
+						std::memcpy(Destination + 8, &Word, 8);
+
+						for (std::size_t i{ 16 }; i < Length; i += 8)
 						{
-							Out.resize((static_cast<std::size_t>(Pos) + static_cast<std::size_t>(Length)) << 1);
+							std::memcpy(&Word, Source + i, 8);
+							std::memcpy(Destination + i, &Word, 8);
 						}
+					}
+					else if (Distance == 1)
+					{
+						std::memset(Destination, *Source, Length);
+					}
+					else
+					{
+						// Shorter distances repeat a pattern: the smallest multiple of the distance that spans eight bytes is copied bytewise,
+						// the rest is moved in words from that multiple back (RGBA images are full of Distance == 4)
+						const std::size_t Period{ Distance * ((Distance + 7) / Distance) };
+						const std::size_t Head{ std::min(Period, Length) };
 
-						for (std::int_fast32_t Back{ Pos - Distance }, i{}; i < Length; ++i)
+						for (std::size_t i{}; i < Head; ++i)
 						{
-							Out[Pos++] = Out[Back++];
+							Destination[i] = Source[i];
+						}
 
-							if (Back >= Pos)
-							{
-								Back = Pos - Distance;
-							}
+						for (std::size_t i{ Head }; i < Length; i += 8)
+						{
+							std::uint64_t Word{};
+							std::memcpy(&Word, Destination + i - Period, 8);
+							std::memcpy(Destination + i, &Word, 8);
 						}
 					}
+
+					TargetPos += Length;
 				}
+
+				Stream = Bits;
+				Pos = TargetPos;
 			}
 
-			inline void InflateNoCompression(std::vector<unsigned char>& Out, const unsigned char* In, std::int_fast32_t& BP, std::int_fast32_t& Pos, const std::int_fast32_t InLength)
+			inline void InflateNoCompression(std::vector<unsigned char>& Out)
 			{
-				while ((BP & 0x7) != 0)
-				{
-					++BP;
-				}
-
-				std::int_fast32_t p{ BP >> 4 };
+				// Skip to the next byte boundary and hand the bytes still held in the bit buffer back to the byte stream
+				Stream.ReadBits(Stream.Count & 7);
+				std::size_t p{ Stream.BytesConsumed() };
+				Stream.Buffer = 0;
+				Stream.Count = 0;
 
-				if (p >= InLength - 4)
+				if (p + 4 > Stream.Length)
 				{
 					Error = 52;
 					return;
 				}
 
-				const std::int_fast32_t Len{ In[p] + (In[p + 1] << 8) };
-				const std::int_fast32_t NLen{ In[p + 2] + (In[p + 3] << 8) };
+				const std::size_t Len{ static_cast<std::size_t>(Stream.Data[p] + (Stream.Data[p + 1] << 8)) };
+				const std::size_t NLen{ static_cast<std::size_t>(Stream.Data[p + 2] + (Stream.Data[p + 3] << 8)) };
 
 				p += 4;
 
@@ -467,24 +660,28 @@ namespace lwmf
 					return;
 				}
 
-				if (Pos + Len >= static_cast<std::int_fast32_t>(Out.size()))
-				{
-					Out.resize(static_cast<std::size_t>(Pos) + static_cast<std::size_t>(Len));
-				}
-
-				if (p + Len > InLength)
+				if (p + Len > Stream.Length)
 				{
 					Error = 23;
 					return;
 				}
 
-				for (std::int_fast32_t n{}; n < Len; ++n)
+				if (Pos + Len > Out.size())
 				{
-					Out[Pos++] = In[p++];
+					Out.resize(std::max(Pos + Len, Out.size() << 1));
 				}
 
-				BP = p << 3;
+				std::memcpy(Out.data() + Pos, Stream.Data + p, Len);
+
+				Pos += Len;
+				Stream.Pos = p + Len;
 			}
+
+			HuffmanTable CodeTable;
+			HuffmanTable CodeTableD;
+			HuffmanTable CodeLengthCodeTable;
+			BitStreamStruct Stream;
+			std::size_t Pos{};
 		};
 
 		inline std::int_fast32_t DeCompress(std::vector<unsigned char>& Out, const std::vector<unsigned char>& In) const
@@ -510,7 +707,7 @@ namespace lwmf
 			}
 
 			Inflator InflateThis;
-			InflateThis.Inflate(Out, In, 2);
+			InflateThis.Inflate(Out, In.data() + 2, In.size() - 2);
 			return InflateThis.Error;
 		}
 	};
@@ -535,7 +732,7 @@ namespace lwmf
 
 		std::int_fast32_t Error{};
 
-		inline void Decode(std::vector<unsigned char>& Out, const std::vector<unsigned char>& In, const std::int_fast32_t Size, const bool ConvertToRGBA)
+		inline void ReadChunks(std::vector<unsigned char>& ImageData, const std::vector<unsigned char>& In, const std::int_fast32_t Size)
 		{
 			Error = 0;
 
@@ -553,7 +750,6 @@ namespace lwmf
 			}
 
 			std::int_fast32_t Pos{ 33 };
-			std::vector<unsigned char> ImageData{};
 			bool ImageEnd{};
 			PNGInfo.KeyDefined = false;
 
@@ -568,7 +764,7 @@ namespace lwmf
 				const std::int_fast32_t ChunkLength{ Read32bitInt(&In[Pos]) };
 				Pos += 4;
 
-				if (Pos + ChunkLength >= Size)
+				if (ChunkLength < 0 || Pos + ChunkLength + 8 > Size)
 				{
 					Error = 35;
 					return;
@@ -673,7 +869,23 @@ namespace lwmf
 
 				Pos += 4;
 			}
+		}
+
+		inline void Decode(std::vector<unsigned char>& Out, const std::vector<unsigned char>& In, const std::int_fast32_t Size, const bool ConvertToRGBA)
+		{
+			std::vector<unsigned char> ImageData{};
+			ReadChunks(ImageData, In, Size);
+
+			if (Error != 0)
+			{
+				return;
+			}
 
+			DecodeImageData(Out, ImageData, ConvertToRGBA);
+		}
+
+		inline void DecodeImageData(std::vector<unsigned char>& Out, const std::vector<unsigned char>& ImageData, const bool ConvertToRGBA)
+		{
 			const std::int_fast32_t BitsPerPixel{ GetBpp(PNGInfo) };
 			std::vector<unsigned char> ScanLines(((PNGInfo.Width * (PNGInfo.Height * BitsPerPixel + 7)) >> 3) + PNGInfo.Height);
 
@@ -761,6 +973,152 @@ namespace lwmf
 			}
 		}
 
+		// Fast path for 8 bit, non-interlaced images (which covers all assets of NARC):
+		// Scanlines are inflated into one exactly sized buffer, unfiltered in place and converted row by row straight into the texture
+		// All other formats take the generic way via Decode() and an intermediate RGBA buffer
+		inline void DecodeToTexture(TextureStruct& Texture, const std::vector<unsigned char>& In, const std::int_fast32_t Size)
+		{
+			std::vector<unsigned char> ImageData{};
+			ReadChunks(ImageData, In, Size);
+
+			if (Error != 0)
+			{
+				return;
+			}
+
+			if (PNGInfo.BitDepth != 8 || PNGInfo.InterlaceMethod != 0)
+			{
+				std::vector<unsigned char> RGBA;
+				DecodeImageData(RGBA, ImageData, true);
+
+				if (Error != 0)
+				{
+					return;
+				}
+
+				CreateTexture(Texture, PNGInfo.Width, PNGInfo.Height, 0x00000000);
+
+				for (std::int_fast32_t Offset{}, y{}; y < Texture.Height; ++y)
+				{
+					const std::int_fast32_t TempY{ y * Texture.Stride };
+
+					for (std::int_fast32_t x{}; x < Texture.Width; ++x, Offset += 4)
+					{
+						Texture.Pixels[static_cast<std::size_t>(TempY) + static_cast<std::size_t>(x)] = RGBAtoINT(RGBA[Offset], RGBA[Offset + 1], RGBA[Offset + 2], RGBA[Offset + 3]);
+					}
+				}
+
+				return;
+			}
+
+			const std::int_fast32_t ByteWidth{ GetBpp(PNGInfo) >> 3 };
+			const std::int_fast32_t LineLength{ PNGInfo.Width * ByteWidth };
+			const std::size_t ScanLinesSize{ static_cast<std::size_t>(PNGInfo.Height) * static_cast<std::size_t>(LineLength + 1) };
+			// The scanline buffer is kept per thread, so loading many textures in a row does not fault in fresh pages for every image
+			static thread_local std::vector<unsigned char> ScanLines;
+			ScanLines.resize(ScanLinesSize + Zlib::CopySlack);
+
+			const Zlib zlib{};
+			Error = zlib.DeCompress(ScanLines, ImageData);
+
+			if (Error != 0)
+			{
+				return;
+			}
+
+			if (ScanLines.size() < ScanLinesSize)
+			{
+				Error = 91;
+				return;
+			}
+
+			std::array<PixelType, 256> Palette{};
+			const std::int_fast32_t PaletteEntries{ static_cast<std::int_fast32_t>(PNGInfo.Palette.size()) >> 2 };
+
+			for (std::int_fast32_t i{}; i < PaletteEntries; ++i)
+			{
+				Palette[i] = RGBAtoINT(PNGInfo.Palette[i << 2], PNGInfo.Palette[(i << 2) + 1], PNGInfo.Palette[(i << 2) + 2], PNGInfo.Palette[(i << 2) + 3]);
+			}
+
+			CreateTexture(Texture, PNGInfo.Width, PNGInfo.Height, 0x00000000);
+
+			for (std::int_fast32_t y{}; y < PNGInfo.Height; ++y)
+			{
+				unsigned char* Line{ &ScanLines[static_cast<std::size_t>(y) * static_cast<std::size_t>(LineLength + 1)] };
+				const unsigned char* PreviousLine{ y == 0 ? nullptr : Line - LineLength };
+
+				UnFilterScanline(Line + 1, Line + 1, PreviousLine, ByteWidth, Line[0], LineLength);
+
+				if (Error != 0)
+				{
+					return;
+				}
+
+				Error = ConvertScanline(&Texture.Pixels[static_cast<std::size_t>(y) * static_cast<std::size_t>(Texture.Stride)], Line + 1, PNGInfo, Palette, PaletteEntries);
+
+				if (Error != 0)
+				{
+					return;
+				}
+			}
+		}
+
+		static inline std::int_fast32_t ConvertScanline(PixelType* Target, const unsigned char* In, const Info& InfoIn, const std::array<PixelType, 256>& Palette, const std::int_fast32_t PaletteEntries)
+		{
+			switch (InfoIn.ColorType)
+			{
+				case 0:
+				{
+					for (std::int_fast32_t i{}; i < InfoIn.Width; ++i)
+					{
+						Target[i] = RGBAtoINT(In[i], In[i], In[i], (InfoIn.KeyDefined && In[i] == InfoIn.KeyR) ? 0 : 255);
+					}
+
+					break;
+				}
+				case 2:
+				{
+					for (std::int_fast32_t i{}, SrcOffset{}; i < InfoIn.Width; ++i, SrcOffset += 3)
+					{
+						Target[i] = RGBAtoINT(In[SrcOffset], In[SrcOffset + 1], In[SrcOffset + 2], (InfoIn.KeyDefined && In[SrcOffset] == InfoIn.KeyR && In[SrcOffset + 1] == InfoIn.KeyG && In[SrcOffset + 2] == InfoIn.KeyB) ? 0 : 255);
+					}
+
+					break;
+				}
+				case 3:
+				{
+					for (std::int_fast32_t i{}; i < InfoIn.Width; ++i)
+					{
+						if (In[i] >= PaletteEntries)
+						{
+							return 46;
+						}
+
+						Target[i] = Palette[In[i]];
+					}
+
+					break;
+				}
+				case 4:
+				{
+					for (std::int_fast32_t i{}, SrcOffset{}; i < InfoIn.Width; ++i, SrcOffset += 2)
+					{
+						Target[i] = RGBAtoINT(In[SrcOffset], In[SrcOffset], In[SrcOffset], In[SrcOffset + 1]);
+					}
+
+					break;
+				}
+				default:
+				{
+					// RGBA bytes already have the memory layout of PixelType (red in the lowest byte)
+					std::memcpy(Target, In, static_cast<std::size_t>(InfoIn.Width) * sizeof(PixelType));
+					break;
+				}
+			}
+
+			return 0;
+		}
+
 		inline void ReadPNGHeader(const std::vector<unsigned char>& In, const std::int_fast32_t InLength)
 		{
 			if (InLength < 29)
@@ -812,15 +1170,31 @@ namespace lwmf
 			Error = CheckColorValidity(PNGInfo.ColorType, PNGInfo.BitDepth);
 		}
 
+		// Recon and ScanLine may point to the same memory (in-place reconstruction)
 		inline void UnFilterScanline(unsigned char* Recon, const unsigned char* ScanLine, const unsigned char* PreCon, const std::int_fast32_t ByteWidth, const std::int_fast32_t FilterType, const std::int_fast32_t Length)
 		{
+			if (PreCon != nullptr && ActiveSIMDLevel != SIMDLevels::Scalar && FilterType >= 1 && FilterType <= 4)
+			{
+				if (ByteWidth == 4)
+				{
+					UnFilterScanlineSSE42<4>(Recon, ScanLine, PreCon, FilterType, Length);
+					return;
+				}
+
+				if (ByteWidth == 3)
+				{
+					UnFilterScanlineSSE42<3>(Recon, ScanLine, PreCon, FilterType, Length);
+					return;
+				}
+			}
+
 			switch (FilterType)
 			{
 				case 0:
 				{
-					for (std::int_fast32_t i{}; i < Length; ++i)
+					if (Recon != ScanLine)
 					{
-						Recon[i] = ScanLine[i];
+						std::memcpy(Recon, ScanLine, static_cast<std::size_t>(Length));
 					}
 
 					break;
@@ -922,6 +1296,111 @@ namespace lwmf
 			}
 		}
 
+		template<std::int_fast32_t ByteWidth>
+		LWMF_TARGET_SSE42 static inline __m128i LoadPixelSSE42(const unsigned char* Source)
+		{
+			std::int32_t Pixel{};
+			std::memcpy(&Pixel, Source, ByteWidth);
+
+			return _mm_cvtsi32_si128(Pixel);
+		}
+
+		template<std::int_fast32_t ByteWidth>
+		LWMF_TARGET_SSE42 static inline void StorePixelSSE42(unsigned char* Target, const __m128i Pixel)
+		{
+			const std::int32_t Value{ _mm_cvtsi128_si32(Pixel) };
+			std::memcpy(Target, &Value, ByteWidth);
+		}
+
+		// Sub, Average and Paeth depend on the reconstructed pixel to the left, so all channels of one pixel are processed per step
+		// Byte arithmetic wraps modulo 256 exactly like the scalar reference
+		template<std::int_fast32_t ByteWidth>
+		LWMF_TARGET_SSE42 static inline void UnFilterScanlineSSE42(unsigned char* Recon, const unsigned char* ScanLine, const unsigned char* PreCon, const std::int_fast32_t FilterType, const std::int_fast32_t Length)
+		{
+			const __m128i Zero{ _mm_setzero_si128() };
+
+			switch (FilterType)
+			{
+				case 1:
+				{
+					__m128i a{ Zero };
+
+					for (std::int_fast32_t i{}; i < Length; i += ByteWidth)
+					{
+						a = _mm_add_epi8(a, LoadPixelSSE42<ByteWidth>(ScanLine + i));
+						StorePixelSSE42<ByteWidth>(Recon + i, a);
+					}
+
+					break;
+				}
+				case 2:
+				{
+					std::int_fast32_t i{};
+
+					for (; i + 16 <= Length; i += 16)
+					{
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(Recon + i), _mm_add_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ScanLine + i)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(PreCon + i))));
+					}
+
+					for (; i < Length; ++i)
+					{
+						Recon[i] = ScanLine[i] + PreCon[i];
+					}
+
+					break;
+				}
+				case 3:
+				{
+					// _mm_avg_epu8 rounds up, subtracting the lost low bit gives the floor average the filter requires
+					const __m128i One{ _mm_set1_epi8(1) };
+					__m128i a{ Zero };
+
+					for (std::int_fast32_t i{}; i < Length; i += ByteWidth)
+					{
+						const __m128i b{ LoadPixelSSE42<ByteWidth>(PreCon + i) };
+						const __m128i Average{ _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), One)) };
+
+						a = _mm_add_epi8(Average, LoadPixelSSE42<ByteWidth>(ScanLine + i));
+						StorePixelSSE42<ByteWidth>(Recon + i, a);
+					}
+
+					break;
+				}
+				case 4:
+				{
+					// Predictor distances are computed in 16 bit lanes: |p - a| = |b - c|, |p - b| = |a - c|, |p - c| = |a + b - 2c|
+					__m128i a{ Zero };
+					__m128i b{ Zero };
+
+					for (std::int_fast32_t i{}; i < Length; i += ByteWidth)
+					{
+						const __m128i c{ b };
+						b = _mm_unpacklo_epi8(LoadPixelSSE42<ByteWidth>(PreCon + i), Zero);
+
+						const __m128i pa{ _mm_sub_epi16(b, c) };
+						const __m128i pb{ _mm_sub_epi16(a, c) };
+						const __m128i pc{ _mm_abs_epi16(_mm_add_epi16(pa, pb)) };
+						const __m128i AbsPa{ _mm_abs_epi16(pa) };
+						const __m128i AbsPb{ _mm_abs_epi16(pb) };
+						const __m128i Smallest{ _mm_min_epi16(pc, _mm_min_epi16(AbsPa, AbsPb)) };
+
+						__m128i Nearest{ _mm_blendv_epi8(c, b, _mm_cmpeq_epi16(Smallest, AbsPb)) };
+						Nearest = _mm_blendv_epi8(Nearest, a, _mm_cmpeq_epi16(Smallest, AbsPa));
+
+						const __m128i Pixel{ _mm_add_epi8(LoadPixelSSE42<ByteWidth>(ScanLine + i), _mm_packus_epi16(Nearest, Nearest)) };
+						StorePixelSSE42<ByteWidth>(Recon + i, Pixel);
+						a = _mm_unpacklo_epi8(Pixel, Zero);
+					}
+
+					break;
+				}
+				default:
+				{
+					break;
+				}
+			}
+		}
+
 		inline void Adam7(std::vector<unsigned char>& Out, unsigned char* LineN, unsigned char* LineO, const unsigned char* In, const std::int_fast32_t Width, const std::int_fast32_t PassLeft, const std::int_fast32_t PassTop, const std::int_fast32_t SpaceX, const std::int_fast32_t SpaceY, const std::int_fast32_t PassWidth, const std::int_fast32_t PassHeight, const std::int_fast32_t Bpp)
 		{
 			if (PassWidth == 0)
@@ -1216,7 +1695,7 @@ namespace lwmf
 		}
 	};
 
-	inline void LoadPNG(TextureStruct& Texture, const std::string& Filename)
+	inline bool ReadPNGFile(std::vector<unsigned char>& Buffer, const std::string& Filename)
 	{
 		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Load file " + Filename + "...");
 
@@ -1228,35 +1707,101 @@ namespace lwmf
 			strerror_s(ErrorMessage.data(), 100, errno);
 
 			LWMFSystemLog.AddEntry(LogLevel::Error, __FILENAME__, __LINE__, "lwmf::LoadPNG(): Error loading " + Filename + ": " + std::string(ErrorMessage.data()));
+
+			return false;
+		}
+
+		std::streamsize Size{};
+
+		if (File.seekg(0, std::ios::end).good())
+		{
+			Size = File.tellg();
 		}
-		else
+
+		if (File.seekg(0, std::ios::beg).good())
 		{
-			std::streamsize Size{};
+			Size -= File.tellg();
+		}
 
-			if (File.seekg(0, std::ios::end).good())
-			{
-				Size = File.tellg();
-			}
+		Buffer.resize(static_cast<std::size_t>(Size));
+		File.read(reinterpret_cast<char*>(Buffer.data()), Size);
+
+		return true;
+	}
 
-			if (File.seekg(0, std::ios::beg).good())
+	inline void DecodePNG(TextureStruct& Texture, const std::vector<unsigned char>& Buffer, const std::string& Filename)
+	{
+		PNG Decoder;
+		Decoder.DecodeToTexture(Texture, Buffer, static_cast<std::int_fast32_t>(Buffer.size()));
+
+		if (Decoder.Error != 0)
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Error, __FILENAME__, __LINE__, "lwmf::LoadPNG(): Error decoding " + Filename + " (error code " + std::to_string(Decoder.Error) + ")");
+			return;
+		}
+
+		NumberOfDecodedPNGs.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	inline void LoadPNG(TextureStruct& Texture, const std::string& Filename)
+	{
+		if (std::vector<unsigned char> Buffer; ReadPNGFile(Buffer, Filename))
+		{
+			DecodePNG(Texture, Buffer, Filename);
+		}
+	}
+
+	inline bool BenchmarkPNGDecoding(const std::vector<std::string>& FileNames, const std::int_fast32_t Passes)
+	{
+		// All files are read up front, so only decoding is measured (the same way LoadPNG() decodes into a texture)
+		// The fastest pass is reported, it is the least disturbed by other processes
+		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Benchmarking PNG decoding...");
+
+		std::vector<std::vector<unsigned char>> Buffers(FileNames.size());
+
+		for (std::size_t i{}; i < FileNames.size(); ++i)
+		{
+			if (!ReadPNGFile(Buffers[i], FileNames[i]))
 			{
-				Size -= File.tellg();
+				return false;
 			}
+		}
 
-			std::vector<unsigned char> Buffer(static_cast<std::size_t>(Size));
-			std::vector<unsigned char> ImageData;
-
-			File.read(reinterpret_cast<char*>(Buffer.data()), Size);
+		const std::int_fast32_t NumberOfPasses{ std::max<std::int_fast32_t>(Passes, 1) };
+		std::int_fast64_t FastestPass{ std::numeric_limits<std::int_fast64_t>::max() };
+		std::int_fast64_t AllPasses{};
+		std::size_t PixelBytes{};
 
-			PNG Decoder;
-			Decoder.Decode(ImageData, Buffer, static_cast<std::int_fast32_t>(Buffer.size()), true);
-			CreateTexture(Texture, Decoder.PNGInfo.Width, Decoder.PNGInfo.Height, 0x00000000);
+		for (std::int_fast32_t Pass{}; Pass < NumberOfPasses; ++Pass)
+		{
+			const auto StartTime{ std::chrono::steady_clock::now() };
+			PixelBytes = 0;
 
-			for (std::int_fast32_t Offset{}; Offset < Texture.Size; ++Offset)
+			for (std::size_t i{}; i < Buffers.size(); ++i)
 			{
-				Texture.Pixels[Offset] = RGBAtoINT(ImageData[Offset << 2], ImageData[(Offset << 2) + 1], ImageData[(Offset << 2) + 2], ImageData[(Offset << 2) + 3]);
+				PNG Decoder;
+				TextureStruct Texture;
+				Decoder.DecodeToTexture(Texture, Buffers[i], static_cast<std::int_fast32_t>(Buffers[i].size()));
+
+				if (Decoder.Error != 0)
+				{
+					LWMFSystemLog.AddEntry(LogLevel::Error, __FILENAME__, __LINE__, "lwmf::BenchmarkPNGDecoding(): Error decoding " + FileNames[i] + " (error code " + std::to_string(Decoder.Error) + ")");
+					return false;
+				}
+
+				PixelBytes += static_cast<std::size_t>(Texture.Width) * static_cast<std::size_t>(Texture.Height) * sizeof(PixelType);
 			}
+
+			const std::int_fast64_t PassTime{ std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - StartTime).count() };
+			FastestPass = std::min(FastestPass, PassTime);
+			AllPasses += PassTime;
 		}
+
+		// Bytes per microsecond equal megabytes per second
+		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Decoded " + std::to_string(Buffers.size()) + " PNGs (" + std::to_string(PixelBytes >> 10) + " KB of pixels) " + std::to_string(NumberOfPasses) + " times: fastest pass " + std::to_string(FastestPass) + " us, average " +
+			std::to_string(AllPasses / NumberOfPasses) + " us, " + std::to_string(static_cast<std::int_fast64_t>(PixelBytes) / std::max<std::int_fast64_t>(FastestPass, 1)) + " MB/s");
+
+		return true;
 	}
 
 
@@ -25,8 +25,8 @@ namespace lwmf
 
 	FloatPointStruct GetPolygonCentroid(const std::vector<FloatPointStruct>& Points);
 	bool PointInsidePolygon(const std::vector<FloatPointStruct>& Points, const FloatPointStruct& Point);
-	void Polygon(TextureStruct& Texture, const std::vector<IntPointStruct>& Points, std::int_fast32_t BorderColor);
-	void FilledPolygon(TextureStruct& Texture, const std::vector<IntPointStruct>& Points, std::int_fast32_t BorderColor, std::int_fast32_t FillColor);
+	void Polygon(TextureStruct& Texture, const std::vector<IntPointStruct>& Points, PixelType BorderColor);
+	void FilledPolygon(TextureStruct& Texture, const std::vector<IntPointStruct>& Points, PixelType BorderColor, PixelType FillColor);
 
 	//
 	// Functions
@@ -69,7 +69,7 @@ namespace lwmf
 		return Result;
 	}
 
-	inline void Polygon(TextureStruct& Texture, const std::vector<IntPointStruct>& Points, const std::int_fast32_t BorderColor)
+	inline void Polygon(TextureStruct& Texture, const std::vector<IntPointStruct>& Points, const PixelType BorderColor)
 	{
 		const std::size_t NumberOfPoints{ Points.size() };
 
@@ -88,7 +88,7 @@ namespace lwmf
 		Line(Texture, Points[NumberOfPoints - 1].X, Points[NumberOfPoints - 1].Y, Points[0].X, Points[0].Y, BorderColor);
 	}
 
-	inline void FilledPolygon(TextureStruct& Texture, const std::vector<IntPointStruct>& Points, const std::int_fast32_t BorderColor, const std::int_fast32_t FillColor)
+	inline void FilledPolygon(TextureStruct& Texture, const std::vector<IntPointStruct>& Points, const PixelType BorderColor, const PixelType FillColor)
 	{
 		const std::size_t NumberOfPoints{ Points.size() };
 
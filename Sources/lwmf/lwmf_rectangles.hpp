@@ -21,14 +21,14 @@
 namespace lwmf
 {
 
-	void Rectangle(TextureStruct& Texture, std::int_fast32_t PosX, std::int_fast32_t PosY, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Color);
-	void FilledRectangle(TextureStruct& Texture, std::int_fast32_t PosX, std::int_fast32_t PosY, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t BorderColor, std::int_fast32_t FillColor);
+	void Rectangle(TextureStruct& Texture, std::int_fast32_t PosX, std::int_fast32_t PosY, std::int_fast32_t Width, std::int_fast32_t Height, PixelType Color);
+	void FilledRectangle(TextureStruct& Texture, std::int_fast32_t PosX, std::int_fast32_t PosY, std::int_fast32_t Width, std::int_fast32_t Height, PixelType BorderColor, PixelType FillColor);
 
 	//
 	// Functions
 	//
 
-	inline void Rectangle(TextureStruct& Texture, const std::int_fast32_t PosX, const std::int_fast32_t PosY, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Color)
+	inline void Rectangle(TextureStruct& Texture, const std::int_fast32_t PosX, const std::int_fast32_t PosY, const std::int_fast32_t Width, const std::int_fast32_t Height, const PixelType Color)
 	{
 		// Exit early if rectangle would not be visible (to small or coords are out of texture boundaries)
 		if ((Width - 1 <= 0 || Height - 1 <= 0) || (PosX > Texture.Width || PosX + Width - 1 < 0 || PosY > Texture.Height || PosY + Height - 1 < 0))
@@ -42,7 +42,7 @@ namespace lwmf
 		Line(Texture, PosX + Width - 1, PosY, PosX + Width - 1, PosY + Height - 1, Color);
 	}
 
-	inline void FilledRectangle(TextureStruct& Texture, std::int_fast32_t PosX, const std::int_fast32_t PosY, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t BorderColor, const std::int_fast32_t FillColor)
+	inline void FilledRectangle(TextureStruct& Texture, std::int_fast32_t PosX, const std::int_fast32_t PosY, const std::int_fast32_t Width, const std::int_fast32_t Height, const PixelType BorderColor, const PixelType FillColor)
 	{
 		// Exit early if rectangle would not be visible (to small or coords are out of texture boundaries)
 		if ((Width <= 0 || Height <= 0) || (PosX > Texture.Width || PosX + Width - 1 < 0 || PosY > Texture.Height || PosY + Height - 1 < 0))
@@ -55,7 +55,7 @@ namespace lwmf
 		{
 			ClearTexture(Texture, FillColor);
 		}
-		// All the rest; we can use std::fill here...
+		// All the rest; we can fill row by row here...
 		else
 		{
 			const std::int_fast32_t StartX{ (PosX < 0 && (std::abs(0 - PosX) <= Width)) ? std::abs(0 - PosX) : 0 };
@@ -71,8 +71,7 @@ namespace lwmf
 			{
 				if (static_cast<std::uint_fast32_t>(TempPosY) < static_cast<std::uint_fast32_t>(Texture.Height))
 				{
-					const auto Begin{ Texture.Pixels.begin() + TempPosY * Texture.Width + PosX };
-					std::fill(Begin, Begin + TargetWidth - StartX, FillColor);
+					SIMDKernels.FillPixels(Texture.Pixels.data() + TempPosY * Texture.Stride + PosX, static_cast<std::size_t>(TargetWidth - StartX), FillColor);
 				}
 			}
 
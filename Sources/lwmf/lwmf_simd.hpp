@@ -10,38 +10,869 @@
 
 #pragma once
 
-#include <intrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+	#include <intrin.h>
+	#define LWMF_TARGET_SSE42
+	#define LWMF_TARGET_AVX2
+	#define LWMF_TARGET_AVX512
+#else
+	#include <immintrin.h>
+	#include <cpuid.h>
+	#define LWMF_TARGET_SSE42 __attribute__((target("sse4.2")))
+	#define LWMF_TARGET_AVX2 __attribute__((target("avx2")))
+	#define LWMF_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#endif
+
 #include <cstdint>
+#include <cstddef>
 #include <array>
+#include <string>
+#include <vector>
+#include <random>
+#include <numeric>
+#include <cstring>
+#include <algorithm>
 
 #include "lwmf_logging.hpp"
+#include "lwmf_color.hpp"
 
 namespace lwmf
 {
 
 
-	void CheckForSSESupport();
+	// Kernels are selected once at runtime (InitSIMD) dependent on the available instruction sets
+	// All variants of a kernel produce bit-identical results - "Scalar" is the reference implementation
+	enum class SIMDLevels : std::int_fast32_t
+	{
+		Scalar,
+		SSE42,
+		AVX2,
+		AVX512
+	};
+
+	struct CPUFeatureStruct final
+	{
+		bool SSE42{};
+		bool AVX2{};
+		bool AVX512{};
+	};
+
+	struct SIMDKernelStruct final
+	{
+		void (*FillPixels)(PixelType* Target, std::size_t Count, PixelType Color);
+		void (*CopyPixels)(const PixelType* Source, PixelType* Target, std::size_t Count);
+		void (*CopyPixelsTrans)(const PixelType* Source, PixelType* Target, std::size_t Count, PixelType TransparentColor);
+		void (*ShadePixels)(const PixelType* Source, PixelType* Target, std::size_t Count, float ShadeFactor, float Limit);
+		void (*BlendPixels)(const PixelType* Source1, const PixelType* Source2, PixelType* Target, std::size_t Count, float Ratio);
+		void (*BlendPixelsWeighted)(const PixelType* Source1, const PixelType* Source2, const PixelType* Weights, PixelType* Target, std::size_t Count);
+		void (*SamplePixels)(const PixelType* Source, PixelType* Target, std::size_t Count, std::int_fast32_t PosX, std::int_fast32_t StepX);
+	};
+
+	std::array<std::uint32_t, 4> CPUID(std::uint32_t Leaf, std::uint32_t SubLeaf);
+	std::uint64_t ReadXCR0();
+	CPUFeatureStruct DetectCPUFeatures();
+	bool IsSIMDLevelSupported(SIMDLevels Level);
+	bool SetSIMDLevel(SIMDLevels Level);
+	std::string GetSIMDLevelName(SIMDLevels Level);
+	void InitSIMD();
+	bool CheckSIMDKernels();
+
+	void FillPixelsScalar(PixelType* Target, std::size_t Count, PixelType Color);
+	void CopyPixelsScalar(const PixelType* Source, PixelType* Target, std::size_t Count);
+	void CopyPixelsTransScalar(const PixelType* Source, PixelType* Target, std::size_t Count, PixelType TransparentColor);
+	void ShadePixelsScalar(const PixelType* Source, PixelType* Target, std::size_t Count, float ShadeFactor, float Limit);
+	void BlendPixelsScalar(const PixelType* Source1, const PixelType* Source2, PixelType* Target, std::size_t Count, float Ratio);
+	void BlendPixelsWeightedScalar(const PixelType* Source1, const PixelType* Source2, const PixelType* Weights, PixelType* Target, std::size_t Count);
+	void SamplePixelsScalar(const PixelType* Source, PixelType* Target, std::size_t Count, std::int_fast32_t PosX, std::int_fast32_t StepX);
+
+	void FillPixelsSSE42(PixelType* Target, std::size_t Count, PixelType Color);
+	void CopyPixelsSSE42(const PixelType* Source, PixelType* Target, std::size_t Count);
+	void CopyPixelsTransSSE42(const PixelType* Source, PixelType* Target, std::size_t Count, PixelType TransparentColor);
+	void ShadePixelsSSE42(const PixelType* Source, PixelType* Target, std::size_t Count, float ShadeFactor, float Limit);
+	void BlendPixelsSSE42(const PixelType* Source1, const PixelType* Source2, PixelType* Target, std::size_t Count, float Ratio);
+	void BlendPixelsWeightedSSE42(const PixelType* Source1, const PixelType* Source2, const PixelType* Weights, PixelType* Target, std::size_t Count);
+
+	void FillPixelsAVX2(PixelType* Target, std::size_t Count, PixelType Color);
+	void CopyPixelsAVX2(const PixelType* Source, PixelType* Target, std::size_t Count);
+	void CopyPixelsTransAVX2(const PixelType* Source, PixelType* Target, std::size_t Count, PixelType TransparentColor);
+	void ShadePixelsAVX2(const PixelType* Source, PixelType* Target, std::size_t Count, float ShadeFactor, float Limit);
+	void BlendPixelsAVX2(const PixelType* Source1, const PixelType* Source2, PixelType* Target, std::size_t Count, float Ratio);
+	void BlendPixelsWeightedAVX2(const PixelType* Source1, const PixelType* Source2, const PixelType* Weights, PixelType* Target, std::size_t Count);
+	void SamplePixelsAVX2(const PixelType* Source, PixelType* Target, std::size_t Count, std::int_fast32_t PosX, std::int_fast32_t StepX);
+
+	void FillPixelsAVX512(PixelType* Target, std::size_t Count, PixelType Color);
+	void CopyPixelsAVX512(const PixelType* Source, PixelType* Target, std::size_t Count);
+	void CopyPixelsTransAVX512(const PixelType* Source, PixelType* Target, std::size_t Count, PixelType TransparentColor);
+	void ShadePixelsAVX512(const PixelType* Source, PixelType* Target, std::size_t Count, float ShadeFactor, float Limit);
+	void BlendPixelsAVX512(const PixelType* Source1, const PixelType* Source2, PixelType* Target, std::size_t Count, float Ratio);
+	void BlendPixelsWeightedAVX512(const PixelType* Source1, const PixelType* Source2, const PixelType* Weights, PixelType* Target, std::size_t Count);
+	void SamplePixelsAVX512(const PixelType* Source, PixelType* Target, std::size_t Count, std::int_fast32_t PosX, std::int_fast32_t StepX);
+
+	//
+	// Variables and constants
+	//
+
+	inline CPUFeatureStruct CPUFeatures{};
+	inline SIMDLevels ActiveSIMDLevel{ SIMDLevels::Scalar };
+
+	// Scalar kernels are bound until InitSIMD() was called, so everything works without initialisation
+	inline SIMDKernelStruct SIMDKernels{ FillPixelsScalar, CopyPixelsScalar, CopyPixelsTransScalar, ShadePixelsScalar, BlendPixelsScalar, BlendPixelsWeightedScalar, SamplePixelsScalar };
 
 	//
 	// Functions
 	//
 
-	inline void CheckForSSESupport()
+	//
+	// CPU feature detection
+	//
+
+	inline std::array<std::uint32_t, 4> CPUID(const std::uint32_t Leaf, const std::uint32_t SubLeaf)
+	{
+		std::array<std::uint32_t, 4> Registers{};
+
+		#if defined(_MSC_VER) && !defined(__clang__)
+			std::array<int, 4> CPUInfo{};
+			__cpuidex(CPUInfo.data(), static_cast<int>(Leaf), static_cast<int>(SubLeaf));
+			std::copy(CPUInfo.begin(), CPUInfo.end(), Registers.begin());
+		#else
+			__cpuid_count(Leaf, SubLeaf, Registers[0], Registers[1], Registers[2], Registers[3]);
+		#endif
+
+		return Registers;
+	}
+
+	inline std::uint64_t ReadXCR0()
+	{
+		#if defined(_MSC_VER) && !defined(__clang__)
+			return _xgetbv(0);
+		#else
+			std::uint32_t Low{};
+			std::uint32_t High{};
+			__asm__ volatile("xgetbv" : "=a"(Low), "=d"(High) : "c"(0));
+			return (static_cast<std::uint64_t>(High) << 32) | Low;
+		#endif
+	}
+
+	inline CPUFeatureStruct DetectCPUFeatures()
+	{
+		CPUFeatureStruct Features{};
+
+		const std::uint32_t MaxLeaf{ CPUID(0, 0)[0] };
+
+		if (MaxLeaf < 1)
+		{
+			return Features;
+		}
+
+		const std::array<std::uint32_t, 4> Leaf1{ CPUID(1, 0) };
+		Features.SSE42 = (Leaf1[2] & (1U << 20)) != 0;
+
+		// AVX needs CPU support and the OS saving the extended registers (OSXSAVE + XCR0)
+		if (MaxLeaf < 7 || (Leaf1[2] & (1U << 27)) == 0 || (Leaf1[2] & (1U << 28)) == 0)
+		{
+			return Features;
+		}
+
+		const std::uint64_t XCR0{ ReadXCR0() };
+		const std::array<std::uint32_t, 4> Leaf7{ CPUID(7, 0) };
+
+		// XMM + YMM state
+		if ((XCR0 & 0x06) == 0x06)
+		{
+			Features.AVX2 = (Leaf7[1] & (1U << 5)) != 0;
+
+			// Opmask + ZMM state, AVX-512 F and BW
+			if ((XCR0 & 0xE6) == 0xE6)
+			{
+				Features.AVX512 = (Leaf7[1] & (1U << 16)) != 0 && (Leaf7[1] & (1U << 30)) != 0;
+			}
+		}
+
+		return Features;
+	}
+
+	inline bool IsSIMDLevelSupported(const SIMDLevels Level)
+	{
+		switch (Level)
+		{
+			case SIMDLevels::Scalar:
+			{
+				return true;
+			}
+			case SIMDLevels::SSE42:
+			{
+				return CPUFeatures.SSE42;
+			}
+			case SIMDLevels::AVX2:
+			{
+				return CPUFeatures.AVX2;
+			}
+			case SIMDLevels::AVX512:
+			{
+				return CPUFeatures.AVX512;
+			}
+			default:
+			{
+				return false;
+			}
+		}
+	}
+
+	inline bool SetSIMDLevel(const SIMDLevels Level)
+	{
+		if (!IsSIMDLevelSupported(Level))
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Warn, __FILENAME__, __LINE__, "lwmf::SetSIMDLevel(): " + GetSIMDLevelName(Level) + " is not supported on this computer!");
+			return false;
+		}
+
+		switch (Level)
+		{
+			case SIMDLevels::Scalar:
+			{
+				SIMDKernels = { FillPixelsScalar, CopyPixelsScalar, CopyPixelsTransScalar, ShadePixelsScalar, BlendPixelsScalar, BlendPixelsWeightedScalar, SamplePixelsScalar };
+				break;
+			}
+			case SIMDLevels::SSE42:
+			{
+				// There is no gather in SSE, so sampling stays scalar
+				SIMDKernels = { FillPixelsSSE42, CopyPixelsSSE42, CopyPixelsTransSSE42, ShadePixelsSSE42, BlendPixelsSSE42, BlendPixelsWeightedSSE42, SamplePixelsScalar };
+				break;
+			}
+			case SIMDLevels::AVX2:
+			{
+				SIMDKernels = { FillPixelsAVX2, CopyPixelsAVX2, CopyPixelsTransAVX2, ShadePixelsAVX2, BlendPixelsAVX2, BlendPixelsWeightedAVX2, SamplePixelsAVX2 };
+				break;
+			}
+			case SIMDLevels::AVX512:
+			{
+				SIMDKernels = { FillPixelsAVX512, CopyPixelsAVX512, CopyPixelsTransAVX512, ShadePixelsAVX512, BlendPixelsAVX512, BlendPixelsWeightedAVX512, SamplePixelsAVX512 };
+				break;
+			}
+			default: {}
+		}
+
+		ActiveSIMDLevel = Level;
+		return true;
+	}
+
+	inline std::string GetSIMDLevelName(const SIMDLevels Level)
+	{
+		switch (Level)
+		{
+			case SIMDLevels::Scalar:
+			{
+				return "Scalar";
+			}
+			case SIMDLevels::SSE42:
+			{
+				return "SSE 4.2";
+			}
+			case SIMDLevels::AVX2:
+			{
+				return "AVX2";
+			}
+			case SIMDLevels::AVX512:
+			{
+				return "AVX-512";
+			}
+			default:
+			{
+				return "Unknown";
+			}
+		}
+	}
+
+	inline void InitSIMD()
+	{
+		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Checking for SIMD extensions...");
+
+		CPUFeatures = DetectCPUFeatures();
+
+		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "SSE 4.2: " + std::string(CPUFeatures.SSE42 ? "yes" : "no") + ", AVX2: " + std::string(CPUFeatures.AVX2 ? "yes" : "no") + ", AVX-512: " + std::string(CPUFeatures.AVX512 ? "yes" : "no"));
+
+		SIMDLevels Level{ SIMDLevels::Scalar };
+
+		if (CPUFeatures.AVX512)
+		{
+			Level = SIMDLevels::AVX512;
+		}
+		else if (CPUFeatures.AVX2)
+		{
+			Level = SIMDLevels::AVX2;
+		}
+		else if (CPUFeatures.SSE42)
+		{
+			Level = SIMDLevels::SSE42;
+		}
+
+		SetSIMDLevel(Level);
+
+		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Using " + GetSIMDLevelName(ActiveSIMDLevel) + " kernels!");
+	}
+
+	inline bool CheckSIMDKernels()
+	{
+		// Runs every variant supported by the CPU (InitSIMD() must have been called) and the scalar reference on the same random input
+		// Results are compared byte-by-byte, including padding behind the target span to catch writes past Count
+		// Odd counts and start offsets of 0 - 15 pixels cover the remainder handling and unaligned loads/stores of all variants
+		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Checking SIMD kernels against the scalar reference...");
+
+		constexpr std::size_t MaxOffset{ 16 };
+		constexpr std::size_t Padding{ 16 };
+		constexpr PixelType TransparentColor{ 0xFFFF00FF };
+		constexpr float Limit{ 10.0F };
+		constexpr std::array<float, 6> ShadeFactors{ 0.0F, 0.1F, 3.3F, 7.77F, 10.0F, 10.5F };
+		constexpr std::array<float, 6> Ratios{ 0.0F, 0.1F, 0.33F, 0.5F, 0.77F, 1.0F };
+		constexpr std::array<std::int_fast32_t, 3> SampleSteps{ 0x8000, 0x10000, 0x1C000 };
+
+		std::vector<std::size_t> Counts(68);
+		std::iota(Counts.begin(), Counts.end(), std::size_t{});
+		Counts.insert(Counts.end(), { 255, 1021 });
+
+		const std::size_t BufferSize{ MaxOffset + Counts.back() + Padding };
+
+		// Fixed seed, so a failing run can be reproduced
+		std::mt19937 Generator{ 0x4E415243 };
+		std::uniform_int_distribution<PixelType> PixelDistribution;
+		std::vector<PixelType> Source1(BufferSize);
+		std::vector<PixelType> Source2(BufferSize);
+		std::vector<PixelType> Weights(BufferSize);
+		std::vector<PixelType> SampleSource(2 * BufferSize);
+		std::vector<PixelType> Background(BufferSize);
+		std::generate(Source1.begin(), Source1.end(), [&] { return PixelDistribution(Generator) % 3 == 0 ? TransparentColor : PixelDistribution(Generator); });
+		std::generate(Source2.begin(), Source2.end(), [&] { return PixelDistribution(Generator); });
+		std::generate(Weights.begin(), Weights.end(), [&] { return PixelDistribution(Generator) % (ColorWeightOne + 1); });
+		std::generate(SampleSource.begin(), SampleSource.end(), [&] { return PixelDistribution(Generator); });
+		std::generate(Background.begin(), Background.end(), [&] { return PixelDistribution(Generator); });
+		const PixelType FillColor{ PixelDistribution(Generator) };
+
+		std::vector<PixelType> ReferenceTarget(BufferSize);
+		std::vector<PixelType> Target(BufferSize);
+		const SIMDKernelStruct Reference{ FillPixelsScalar, CopyPixelsScalar, CopyPixelsTransScalar, ShadePixelsScalar, BlendPixelsScalar, BlendPixelsWeightedScalar, SamplePixelsScalar };
+		const SIMDLevels PreviousLevel{ ActiveSIMDLevel };
+		bool PassedFlag{ true };
+
+		for (const SIMDLevels Level : { SIMDLevels::SSE42, SIMDLevels::AVX2, SIMDLevels::AVX512 })
+		{
+			if (!IsSIMDLevelSupported(Level))
+			{
+				LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, GetSIMDLevelName(Level) + " is not supported on this computer, skipped!");
+				continue;
+			}
+
+			SetSIMDLevel(Level);
+			const SIMDKernelStruct Kernels{ SIMDKernels };
+
+			for (const std::size_t Count : Counts)
+			{
+				for (std::size_t Offset{}; Offset < MaxOffset; ++Offset)
+				{
+					// Sources are misaligned differently from the target
+					const PixelType* Pixels1{ Source1.data() + MaxOffset - 1 - Offset };
+					const PixelType* Pixels2{ Source2.data() + (Offset * 7) % MaxOffset };
+					const PixelType* PixelWeights{ Weights.data() + (Offset * 3) % MaxOffset };
+
+					const auto Compare{ [&](const std::string& Kernel, const auto& Run)
+					{
+						ReferenceTarget = Background;
+						Target = Background;
+						Run(Reference, ReferenceTarget.data() + Offset);
+						Run(Kernels, Target.data() + Offset);
+
+						if (std::memcmp(ReferenceTarget.data(), Target.data(), BufferSize * sizeof(PixelType)) != 0)
+						{
+							LWMFSystemLog.AddEntry(LogLevel::Warn, __FILENAME__, __LINE__, "lwmf::CheckSIMDKernels(): " + Kernel + " (" + GetSIMDLevelName(Level) + ") differs from the scalar reference (count " + std::to_string(Count) + ", offset " + std::to_string(Offset) + ")!");
+							PassedFlag = false;
+						}
+					} };
+
+					Compare("FillPixels", [&](const SIMDKernelStruct& Variant, PixelType* Pixels) { Variant.FillPixels(Pixels, Count, FillColor); });
+					Compare("CopyPixels", [&](const SIMDKernelStruct& Variant, PixelType* Pixels) { Variant.CopyPixels(Pixels1, Pixels, Count); });
+					Compare("CopyPixelsTrans", [&](const SIMDKernelStruct& Variant, PixelType* Pixels) { Variant.CopyPixelsTrans(Pixels1, Pixels, Count, TransparentColor); });
+
+					for (const float ShadeFactor : ShadeFactors)
+					{
+						Compare("ShadePixels", [&](const SIMDKernelStruct& Variant, PixelType* Pixels) { Variant.ShadePixels(Pixels1, Pixels, Count, ShadeFactor, Limit); });
+					}
+
+					for (const float Ratio : Ratios)
+					{
+						Compare("BlendPixels", [&](const SIMDKernelStruct& Variant, PixelType* Pixels) { Variant.BlendPixels(Pixels1, Pixels2, Pixels, Count, Ratio); });
+					}
+
+					Compare("BlendPixelsWeighted", [&](const SIMDKernelStruct& Variant, PixelType* Pixels) { Variant.BlendPixelsWeighted(Pixels1, Pixels2, PixelWeights, Pixels, Count); });
+
+					for (const std::int_fast32_t StepX : SampleSteps)
+					{
+						Compare("SamplePixels", [&](const SIMDKernelStruct& Variant, PixelType* Pixels) { Variant.SamplePixels(SampleSource.data(), Pixels, Count, static_cast<std::int_fast32_t>(Offset << 12), StepX); });
+					}
+				}
+			}
+		}
+
+		SetSIMDLevel(PreviousLevel);
+
+		LWMFSystemLog.AddEntry(PassedFlag ? LogLevel::Info : LogLevel::Warn, __FILENAME__, __LINE__, PassedFlag ? "All SIMD kernels match the scalar reference!" : "SIMD kernels differ from the scalar reference!");
+
+		return PassedFlag;
+	}
+
+	//
+	// Scalar kernels (reference)
+	//
+
+	inline void FillPixelsScalar(PixelType* Target, const std::size_t Count, const PixelType Color)
+	{
+		std::fill_n(Target, Count, Color);
+	}
+
+	inline void CopyPixelsScalar(const PixelType* Source, PixelType* Target, const std::size_t Count)
+	{
+		std::copy_n(Source, Count, Target);
+	}
+
+	inline void CopyPixelsTransScalar(const PixelType* Source, PixelType* Target, const std::size_t Count, const PixelType TransparentColor)
+	{
+		for (std::size_t i{}; i < Count; ++i)
+		{
+			if (Source[i] != TransparentColor)
+			{
+				Target[i] = Source[i];
+			}
+		}
+	}
+
+	inline void ShadePixelsScalar(const PixelType* Source, PixelType* Target, const std::size_t Count, const float ShadeFactor, const float Limit)
+	{
+		if (ShadeFactor > Limit)
+		{
+			FillPixelsScalar(Target, Count, AMask);
+			return;
+		}
+
+		const PixelType Weight{ GetColorWeight((Limit - ShadeFactor) / Limit) };
+
+		for (std::size_t i{}; i < Count; ++i)
+		{
+			Target[i] = ScaleColor(Source[i], Weight);
+		}
+	}
+
+	inline void BlendPixelsScalar(const PixelType* Source1, const PixelType* Source2, PixelType* Target, const std::size_t Count, const float Ratio)
+	{
+		const PixelType Weight{ GetColorWeight(Ratio) };
+
+		for (std::size_t i{}; i < Count; ++i)
+		{
+			Target[i] = MixColors(Source1[i], Source2[i], Weight);
+		}
+	}
+
+	inline void BlendPixelsWeightedScalar(const PixelType* Source1, const PixelType* Source2, const PixelType* Weights, PixelType* Target, const std::size_t Count)
+	{
+		// Weights are 8.8 fixed point values (see lwmf::GetColorWeight), one per pixel
+		for (std::size_t i{}; i < Count; ++i)
+		{
+			Target[i] = MixColors(Source1[i], Source2[i], Weights[i]);
+		}
+	}
+
+	inline void SamplePixelsScalar(const PixelType* Source, PixelType* Target, const std::size_t Count, std::int_fast32_t PosX, const std::int_fast32_t StepX)
+	{
+		// PosX and StepX are 16.16 fixed point
+		for (std::size_t i{}; i < Count; ++i)
+		{
+			Target[i] = Source[PosX >> 16];
+			PosX += StepX;
+		}
+	}
+
+	//
+	// SSE 4.2 kernels (4 pixels per step)
+	//
+
+	LWMF_TARGET_SSE42 inline void FillPixelsSSE42(PixelType* Target, const std::size_t Count, const PixelType Color)
+	{
+		const __m128i ColorVec{ _mm_set1_epi32(static_cast<int>(Color)) };
+		std::size_t i{};
+
+		for (; i + 4 <= Count; i += 4)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Target + i), ColorVec);
+		}
+
+		FillPixelsScalar(Target + i, Count - i, Color);
+	}
+
+	LWMF_TARGET_SSE42 inline void CopyPixelsSSE42(const PixelType* Source, PixelType* Target, const std::size_t Count)
+	{
+		std::size_t i{};
+
+		for (; i + 4 <= Count; i += 4)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Target + i), _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source + i)));
+		}
+
+		CopyPixelsScalar(Source + i, Target + i, Count - i);
+	}
+
+	LWMF_TARGET_SSE42 inline void CopyPixelsTransSSE42(const PixelType* Source, PixelType* Target, const std::size_t Count, const PixelType TransparentColor)
+	{
+		const __m128i TransVec{ _mm_set1_epi32(static_cast<int>(TransparentColor)) };
+		std::size_t i{};
+
+		for (; i + 4 <= Count; i += 4)
+		{
+			const __m128i SourceVec{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source + i)) };
+			const __m128i TargetVec{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(Target + i)) };
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Target + i), _mm_blendv_epi8(SourceVec, TargetVec, _mm_cmpeq_epi32(SourceVec, TransVec)));
+		}
+
+		CopyPixelsTransScalar(Source + i, Target + i, Count - i, TransparentColor);
+	}
+
+	LWMF_TARGET_SSE42 inline void ShadePixelsSSE42(const PixelType* Source, PixelType* Target, const std::size_t Count, const float ShadeFactor, const float Limit)
+	{
+		if (ShadeFactor > Limit)
+		{
+			FillPixelsSSE42(Target, Count, AMask);
+			return;
+		}
+
+		// Same 8.8 fixed point math as lwmf::ScaleColor - 16-bit multiplies are exact since all products are below 65536
+		const __m128i WeightVec{ _mm_set1_epi16(static_cast<short>(GetColorWeight((Limit - ShadeFactor) / Limit))) };
+		const __m128i RMaskVec{ _mm_set1_epi32(static_cast<int>(RMask)) };
+		const __m128i GMaskVec{ _mm_set1_epi32(static_cast<int>(GMask)) };
+		const __m128i RBMaskVec{ _mm_set1_epi32(static_cast<int>(RBMask)) };
+		const __m128i AMaskVec{ _mm_set1_epi32(static_cast<int>(AMask)) };
+		std::size_t i{};
+
+		for (; i + 4 <= Count; i += 4)
+		{
+			const __m128i Pixels{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source + i)) };
+			const __m128i RedBlue{ _mm_and_si128(_mm_srli_epi32(_mm_mullo_epi16(_mm_and_si128(Pixels, RBMaskVec), WeightVec), 8), RBMaskVec) };
+			const __m128i Green{ _mm_and_si128(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi32(Pixels, 8), RMaskVec), WeightVec), GMaskVec) };
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Target + i), _mm_or_si128(_mm_or_si128(RedBlue, Green), _mm_and_si128(Pixels, AMaskVec)));
+		}
+
+		ShadePixelsScalar(Source + i, Target + i, Count - i, ShadeFactor, Limit);
+	}
+
+	LWMF_TARGET_SSE42 inline void BlendPixelsSSE42(const PixelType* Source1, const PixelType* Source2, PixelType* Target, const std::size_t Count, const float Ratio)
+	{
+		// Same 8.8 fixed point math as lwmf::MixColors - 16-bit multiplies and adds are exact since all sums are below 65536
+		const PixelType Weight{ GetColorWeight(Ratio) };
+		const __m128i WeightVec{ _mm_set1_epi16(static_cast<short>(Weight)) };
+		const __m128i InverseWeightVec{ _mm_set1_epi16(static_cast<short>(ColorWeightOne - Weight)) };
+		const __m128i RMaskVec{ _mm_set1_epi32(static_cast<int>(RMask)) };
+		const __m128i GMaskVec{ _mm_set1_epi32(static_cast<int>(GMask)) };
+		const __m128i RBMaskVec{ _mm_set1_epi32(static_cast<int>(RBMask)) };
+		const __m128i AMaskVec{ _mm_set1_epi32(static_cast<int>(AMask)) };
+		std::size_t i{};
+
+		for (; i + 4 <= Count; i += 4)
+		{
+			const __m128i Pixels1{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source1 + i)) };
+			const __m128i Pixels2{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source2 + i)) };
+			const __m128i RedBlue{ _mm_and_si128(_mm_srli_epi32(_mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(Pixels1, RBMaskVec), InverseWeightVec), _mm_mullo_epi16(_mm_and_si128(Pixels2, RBMaskVec), WeightVec)), 8), RBMaskVec) };
+			const __m128i Green{ _mm_and_si128(_mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi32(Pixels1, 8), RMaskVec), InverseWeightVec), _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi32(Pixels2, 8), RMaskVec), WeightVec)), GMaskVec) };
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Target + i), _mm_or_si128(_mm_or_si128(RedBlue, Green), _mm_and_si128(Pixels2, AMaskVec)));
+		}
+
+		BlendPixelsScalar(Source1 + i, Source2 + i, Target + i, Count - i, Ratio);
+	}
+
+	LWMF_TARGET_SSE42 inline void BlendPixelsWeightedSSE42(const PixelType* Source1, const PixelType* Source2, const PixelType* Weights, PixelType* Target, const std::size_t Count)
+	{
+		// Each 32-bit weight is duplicated into both 16-bit halves, so red and blue are weighted with a single multiply
+		const __m128i OneVec{ _mm_set1_epi16(static_cast<short>(ColorWeightOne)) };
+		const __m128i RMaskVec{ _mm_set1_epi32(static_cast<int>(RMask)) };
+		const __m128i GMaskVec{ _mm_set1_epi32(static_cast<int>(GMask)) };
+		const __m128i RBMaskVec{ _mm_set1_epi32(static_cast<int>(RBMask)) };
+		const __m128i AMaskVec{ _mm_set1_epi32(static_cast<int>(AMask)) };
+		std::size_t i{};
+
+		for (; i + 4 <= Count; i += 4)
+		{
+			const __m128i Pixels1{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source1 + i)) };
+			const __m128i Pixels2{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source2 + i)) };
+			const __m128i WeightLanes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(Weights + i)) };
+			const __m128i WeightVec{ _mm_or_si128(WeightLanes, _mm_slli_epi32(WeightLanes, 16)) };
+			const __m128i InverseWeightVec{ _mm_sub_epi16(OneVec, WeightVec) };
+			const __m128i RedBlue{ _mm_and_si128(_mm_srli_epi32(_mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(Pixels1, RBMaskVec), InverseWeightVec), _mm_mullo_epi16(_mm_and_si128(Pixels2, RBMaskVec), WeightVec)), 8), RBMaskVec) };
+			const __m128i Green{ _mm_and_si128(_mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi32(Pixels1, 8), RMaskVec), InverseWeightVec), _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi32(Pixels2, 8), RMaskVec), WeightVec)), GMaskVec) };
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Target + i), _mm_or_si128(_mm_or_si128(RedBlue, Green), _mm_and_si128(Pixels2, AMaskVec)));
+		}
+
+		BlendPixelsWeightedScalar(Source1 + i, Source2 + i, Weights + i, Target + i, Count - i);
+	}
+
+	//
+	// AVX2 kernels (8 pixels per step)
+	//
+
+	LWMF_TARGET_AVX2 inline void FillPixelsAVX2(PixelType* Target, const std::size_t Count, const PixelType Color)
+	{
+		const __m256i ColorVec{ _mm256_set1_epi32(static_cast<int>(Color)) };
+		std::size_t i{};
+
+		for (; i + 8 <= Count; i += 8)
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(Target + i), ColorVec);
+		}
+
+		FillPixelsScalar(Target + i, Count - i, Color);
+	}
+
+	LWMF_TARGET_AVX2 inline void CopyPixelsAVX2(const PixelType* Source, PixelType* Target, const std::size_t Count)
+	{
+		std::size_t i{};
+
+		for (; i + 8 <= Count; i += 8)
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(Target + i), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Source + i)));
+		}
+
+		CopyPixelsScalar(Source + i, Target + i, Count - i);
+	}
+
+	LWMF_TARGET_AVX2 inline void CopyPixelsTransAVX2(const PixelType* Source, PixelType* Target, const std::size_t Count, const PixelType TransparentColor)
+	{
+		const __m256i TransVec{ _mm256_set1_epi32(static_cast<int>(TransparentColor)) };
+		std::size_t i{};
+
+		for (; i + 8 <= Count; i += 8)
+		{
+			const __m256i SourceVec{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Source + i)) };
+			const __m256i TargetVec{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Target + i)) };
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(Target + i), _mm256_blendv_epi8(SourceVec, TargetVec, _mm256_cmpeq_epi32(SourceVec, TransVec)));
+		}
+
+		CopyPixelsTransScalar(Source + i, Target + i, Count - i, TransparentColor);
+	}
+
+	LWMF_TARGET_AVX2 inline void ShadePixelsAVX2(const PixelType* Source, PixelType* Target, const std::size_t Count, const float ShadeFactor, const float Limit)
 	{
-		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Checking for SSE 4.2 Extensions...");
+		if (ShadeFactor > Limit)
+		{
+			FillPixelsAVX2(Target, Count, AMask);
+			return;
+		}
 
-		std::array<std::int_fast32_t, 4> CPUInfo{};
-		__cpuid(CPUInfo.data(), 1);
+		const __m256i WeightVec{ _mm256_set1_epi16(static_cast<short>(GetColorWeight((Limit - ShadeFactor) / Limit))) };
+		const __m256i RMaskVec{ _mm256_set1_epi32(static_cast<int>(RMask)) };
+		const __m256i GMaskVec{ _mm256_set1_epi32(static_cast<int>(GMask)) };
+		const __m256i RBMaskVec{ _mm256_set1_epi32(static_cast<int>(RBMask)) };
+		const __m256i AMaskVec{ _mm256_set1_epi32(static_cast<int>(AMask)) };
+		std::size_t i{};
 
-		if ((CPUInfo[2] & (1 << 20)) == 0)
+		for (; i + 8 <= Count; i += 8)
 		{
-			LWMFSystemLog.AddEntry(LogLevel::Critical, __FILENAME__, __LINE__, "lwmf::CheckForSSESupport(): SSE 4.2 is not supported on this computer!");
+			const __m256i Pixels{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Source + i)) };
+			const __m256i RedBlue{ _mm256_and_si256(_mm256_srli_epi32(_mm256_mullo_epi16(_mm256_and_si256(Pixels, RBMaskVec), WeightVec), 8), RBMaskVec) };
+			const __m256i Green{ _mm256_and_si256(_mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(Pixels, 8), RMaskVec), WeightVec), GMaskVec) };
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(Target + i), _mm256_or_si256(_mm256_or_si256(RedBlue, Green), _mm256_and_si256(Pixels, AMaskVec)));
 		}
-		else
+
+		ShadePixelsScalar(Source + i, Target + i, Count - i, ShadeFactor, Limit);
+	}
+
+	LWMF_TARGET_AVX2 inline void BlendPixelsAVX2(const PixelType* Source1, const PixelType* Source2, PixelType* Target, const std::size_t Count, const float Ratio)
+	{
+		const PixelType Weight{ GetColorWeight(Ratio) };
+		const __m256i WeightVec{ _mm256_set1_epi16(static_cast<short>(Weight)) };
+		const __m256i InverseWeightVec{ _mm256_set1_epi16(static_cast<short>(ColorWeightOne - Weight)) };
+		const __m256i RMaskVec{ _mm256_set1_epi32(static_cast<int>(RMask)) };
+		const __m256i GMaskVec{ _mm256_set1_epi32(static_cast<int>(GMask)) };
+		const __m256i RBMaskVec{ _mm256_set1_epi32(static_cast<int>(RBMask)) };
+		const __m256i AMaskVec{ _mm256_set1_epi32(static_cast<int>(AMask)) };
+		std::size_t i{};
+
+		for (; i + 8 <= Count; i += 8)
+		{
+			const __m256i Pixels1{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Source1 + i)) };
+			const __m256i Pixels2{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Source2 + i)) };
+			const __m256i RedBlue{ _mm256_and_si256(_mm256_srli_epi32(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(Pixels1, RBMaskVec), InverseWeightVec), _mm256_mullo_epi16(_mm256_and_si256(Pixels2, RBMaskVec), WeightVec)), 8), RBMaskVec) };
+			const __m256i Green{ _mm256_and_si256(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(Pixels1, 8), RMaskVec), InverseWeightVec), _mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(Pixels2, 8), RMaskVec), WeightVec)), GMaskVec) };
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(Target + i), _mm256_or_si256(_mm256_or_si256(RedBlue, Green), _mm256_and_si256(Pixels2, AMaskVec)));
+		}
+
+		BlendPixelsScalar(Source1 + i, Source2 + i, Target + i, Count - i, Ratio);
+	}
+
+	LWMF_TARGET_AVX2 inline void BlendPixelsWeightedAVX2(const PixelType* Source1, const PixelType* Source2, const PixelType* Weights, PixelType* Target, const std::size_t Count)
+	{
+		const __m256i OneVec{ _mm256_set1_epi16(static_cast<short>(ColorWeightOne)) };
+		const __m256i RMaskVec{ _mm256_set1_epi32(static_cast<int>(RMask)) };
+		const __m256i GMaskVec{ _mm256_set1_epi32(static_cast<int>(GMask)) };
+		const __m256i RBMaskVec{ _mm256_set1_epi32(static_cast<int>(RBMask)) };
+		const __m256i AMaskVec{ _mm256_set1_epi32(static_cast<int>(AMask)) };
+		std::size_t i{};
+
+		for (; i + 8 <= Count; i += 8)
+		{
+			const __m256i Pixels1{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Source1 + i)) };
+			const __m256i Pixels2{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Source2 + i)) };
+			const __m256i WeightLanes{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Weights + i)) };
+			const __m256i WeightVec{ _mm256_or_si256(WeightLanes, _mm256_slli_epi32(WeightLanes, 16)) };
+			const __m256i InverseWeightVec{ _mm256_sub_epi16(OneVec, WeightVec) };
+			const __m256i RedBlue{ _mm256_and_si256(_mm256_srli_epi32(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(Pixels1, RBMaskVec), InverseWeightVec), _mm256_mullo_epi16(_mm256_and_si256(Pixels2, RBMaskVec), WeightVec)), 8), RBMaskVec) };
+			const __m256i Green{ _mm256_and_si256(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(Pixels1, 8), RMaskVec), InverseWeightVec), _mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(Pixels2, 8), RMaskVec), WeightVec)), GMaskVec) };
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(Target + i), _mm256_or_si256(_mm256_or_si256(RedBlue, Green), _mm256_and_si256(Pixels2, AMaskVec)));
+		}
+
+		BlendPixelsWeightedScalar(Source1 + i, Source2 + i, Weights + i, Target + i, Count - i);
+	}
+
+	LWMF_TARGET_AVX2 inline void SamplePixelsAVX2(const PixelType* Source, PixelType* Target, const std::size_t Count, std::int_fast32_t PosX, const std::int_fast32_t StepX)
+	{
+		const __m256i LaneOffsets{ _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(StepX))) };
+		std::size_t i{};
+
+		for (; i + 8 <= Count; i += 8)
+		{
+			const __m256i Indices{ _mm256_srli_epi32(_mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(PosX)), LaneOffsets), 16) };
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(Target + i), _mm256_i32gather_epi32(reinterpret_cast<const int*>(Source), Indices, 4));
+			PosX += StepX << 3;
+		}
+
+		SamplePixelsScalar(Source, Target + i, Count - i, PosX, StepX);
+	}
+
+	//
+	// AVX-512 kernels (16 pixels per step, remainder handled by masked stores)
+	//
+
+	LWMF_TARGET_AVX512 inline void FillPixelsAVX512(PixelType* Target, const std::size_t Count, const PixelType Color)
+	{
+		const __m512i ColorVec{ _mm512_set1_epi32(static_cast<int>(Color)) };
+		std::size_t i{};
+
+		for (; i + 16 <= Count; i += 16)
+		{
+			_mm512_storeu_si512(Target + i, ColorVec);
+		}
+
+		if (i < Count)
+		{
+			_mm512_mask_storeu_epi32(Target + i, static_cast<__mmask16>((1U << (Count - i)) - 1), ColorVec);
+		}
+	}
+
+	LWMF_TARGET_AVX512 inline void CopyPixelsAVX512(const PixelType* Source, PixelType* Target, const std::size_t Count)
+	{
+		std::size_t i{};
+
+		for (; i + 16 <= Count; i += 16)
+		{
+			_mm512_storeu_si512(Target + i, _mm512_loadu_si512(Source + i));
+		}
+
+		if (i < Count)
+		{
+			const __mmask16 TailMask{ static_cast<__mmask16>((1U << (Count - i)) - 1) };
+			_mm512_mask_storeu_epi32(Target + i, TailMask, _mm512_maskz_loadu_epi32(TailMask, Source + i));
+		}
+	}
+
+	LWMF_TARGET_AVX512 inline void CopyPixelsTransAVX512(const PixelType* Source, PixelType* Target, const std::size_t Count, const PixelType TransparentColor)
+	{
+		const __m512i TransVec{ _mm512_set1_epi32(static_cast<int>(TransparentColor)) };
+		std::size_t i{};
+
+		for (; i + 16 <= Count; i += 16)
+		{
+			const __m512i SourceVec{ _mm512_loadu_si512(Source + i) };
+			_mm512_mask_storeu_epi32(Target + i, _mm512_cmpneq_epi32_mask(SourceVec, TransVec), SourceVec);
+		}
+
+		if (i < Count)
+		{
+			const __mmask16 TailMask{ static_cast<__mmask16>((1U << (Count - i)) - 1) };
+			const __m512i SourceVec{ _mm512_maskz_loadu_epi32(TailMask, Source + i) };
+			_mm512_mask_storeu_epi32(Target + i, _mm512_mask_cmpneq_epi32_mask(TailMask, SourceVec, TransVec), SourceVec);
+		}
+	}
+
+	LWMF_TARGET_AVX512 inline void ShadePixelsAVX512(const PixelType* Source, PixelType* Target, const std::size_t Count, const float ShadeFactor, const float Limit)
+	{
+		if (ShadeFactor > Limit)
+		{
+			FillPixelsAVX512(Target, Count, AMask);
+			return;
+		}
+
+		const __m512i WeightVec{ _mm512_set1_epi16(static_cast<short>(GetColorWeight((Limit - ShadeFactor) / Limit))) };
+		const __m512i RMaskVec{ _mm512_set1_epi32(static_cast<int>(RMask)) };
+		const __m512i GMaskVec{ _mm512_set1_epi32(static_cast<int>(GMask)) };
+		const __m512i RBMaskVec{ _mm512_set1_epi32(static_cast<int>(RBMask)) };
+		const __m512i AMaskVec{ _mm512_set1_epi32(static_cast<int>(AMask)) };
+
+		for (std::size_t i{}; i < Count; i += 16)
+		{
+			const __mmask16 LoadMask{ Count - i >= 16 ? static_cast<__mmask16>(0xFFFF) : static_cast<__mmask16>((1U << (Count - i)) - 1) };
+			const __m512i Pixels{ _mm512_maskz_loadu_epi32(LoadMask, Source + i) };
+			const __m512i RedBlue{ _mm512_and_si512(_mm512_srli_epi32(_mm512_mullo_epi16(_mm512_and_si512(Pixels, RBMaskVec), WeightVec), 8), RBMaskVec) };
+			const __m512i Green{ _mm512_and_si512(_mm512_mullo_epi16(_mm512_and_si512(_mm512_srli_epi32(Pixels, 8), RMaskVec), WeightVec), GMaskVec) };
+			_mm512_mask_storeu_epi32(Target + i, LoadMask, _mm512_or_si512(_mm512_or_si512(RedBlue, Green), _mm512_and_si512(Pixels, AMaskVec)));
+		}
+	}
+
+	LWMF_TARGET_AVX512 inline void BlendPixelsAVX512(const PixelType* Source1, const PixelType* Source2, PixelType* Target, const std::size_t Count, const float Ratio)
+	{
+		const PixelType Weight{ GetColorWeight(Ratio) };
+		const __m512i WeightVec{ _mm512_set1_epi16(static_cast<short>(Weight)) };
+		const __m512i InverseWeightVec{ _mm512_set1_epi16(static_cast<short>(ColorWeightOne - Weight)) };
+		const __m512i RMaskVec{ _mm512_set1_epi32(static_cast<int>(RMask)) };
+		const __m512i GMaskVec{ _mm512_set1_epi32(static_cast<int>(GMask)) };
+		const __m512i RBMaskVec{ _mm512_set1_epi32(static_cast<int>(RBMask)) };
+		const __m512i AMaskVec{ _mm512_set1_epi32(static_cast<int>(AMask)) };
+
+		for (std::size_t i{}; i < Count; i += 16)
+		{
+			const __mmask16 LoadMask{ Count - i >= 16 ? static_cast<__mmask16>(0xFFFF) : static_cast<__mmask16>((1U << (Count - i)) - 1) };
+			const __m512i Pixels1{ _mm512_maskz_loadu_epi32(LoadMask, Source1 + i) };
+			const __m512i Pixels2{ _mm512_maskz_loadu_epi32(LoadMask, Source2 + i) };
+			const __m512i RedBlue{ _mm512_and_si512(_mm512_srli_epi32(_mm512_add_epi16(_mm512_mullo_epi16(_mm512_and_si512(Pixels1, RBMaskVec), InverseWeightVec), _mm512_mullo_epi16(_mm512_and_si512(Pixels2, RBMaskVec), WeightVec)), 8), RBMaskVec) };
+			const __m512i Green{ _mm512_and_si512(_mm512_add_epi16(_mm512_mullo_epi16(_mm512_and_si512(_mm512_srli_epi32(Pixels1, 8), RMaskVec), InverseWeightVec), _mm512_mullo_epi16(_mm512_and_si512(_mm512_srli_epi32(Pixels2, 8), RMaskVec), WeightVec)), GMaskVec) };
+			_mm512_mask_storeu_epi32(Target + i, LoadMask, _mm512_or_si512(_mm512_or_si512(RedBlue, Green), _mm512_and_si512(Pixels2, AMaskVec)));
+		}
+	}
+
+	LWMF_TARGET_AVX512 inline void BlendPixelsWeightedAVX512(const PixelType* Source1, const PixelType* Source2, const PixelType* Weights, PixelType* Target, const std::size_t Count)
+	{
+		const __m512i OneVec{ _mm512_set1_epi16(static_cast<short>(ColorWeightOne)) };
+		const __m512i RMaskVec{ _mm512_set1_epi32(static_cast<int>(RMask)) };
+		const __m512i GMaskVec{ _mm512_set1_epi32(static_cast<int>(GMask)) };
+		const __m512i RBMaskVec{ _mm512_set1_epi32(static_cast<int>(RBMask)) };
+		const __m512i AMaskVec{ _mm512_set1_epi32(static_cast<int>(AMask)) };
+		for (std::size_t i{}; i < Count; i += 16)
+		{
+			const __mmask16 LoadMask{ Count - i >= 16 ? static_cast<__mmask16>(0xFFFF) : static_cast<__mmask16>((1U << (Count - i)) - 1) };
+			const __m512i Pixels1{ _mm512_maskz_loadu_epi32(LoadMask, Source1 + i) };
+			const __m512i Pixels2{ _mm512_maskz_loadu_epi32(LoadMask, Source2 + i) };
+			const __m512i WeightLanes{ _mm512_maskz_loadu_epi32(LoadMask, Weights + i) };
+			const __m512i WeightVec{ _mm512_or_si512(WeightLanes, _mm512_slli_epi32(WeightLanes, 16)) };
+			const __m512i InverseWeightVec{ _mm512_sub_epi16(OneVec, WeightVec) };
+			const __m512i RedBlue{ _mm512_and_si512(_mm512_srli_epi32(_mm512_add_epi16(_mm512_mullo_epi16(_mm512_and_si512(Pixels1, RBMaskVec), InverseWeightVec), _mm512_mullo_epi16(_mm512_and_si512(Pixels2, RBMaskVec), WeightVec)), 8), RBMaskVec) };
+			const __m512i Green{ _mm512_and_si512(_mm512_add_epi16(_mm512_mullo_epi16(_mm512_and_si512(_mm512_srli_epi32(Pixels1, 8), RMaskVec), InverseWeightVec), _mm512_mullo_epi16(_mm512_and_si512(_mm512_srli_epi32(Pixels2, 8), RMaskVec), WeightVec)), GMaskVec) };
+			_mm512_mask_storeu_epi32(Target + i, LoadMask, _mm512_or_si512(_mm512_or_si512(RedBlue, Green), _mm512_and_si512(Pixels2, AMaskVec)));
+		}
+	}
+
+	LWMF_TARGET_AVX512 inline void SamplePixelsAVX512(const PixelType* Source, PixelType* Target, const std::size_t Count, std::int_fast32_t PosX, const std::int_fast32_t StepX)
+	{
+		const __m512i LaneOffsets{ _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(static_cast<int>(StepX))) };
+
+		for (std::size_t i{}; i < Count; i += 16)
 		{
-			LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "SSE 4.2 extension found!");
+			const __mmask16 LoadMask{ Count - i >= 16 ? static_cast<__mmask16>(0xFFFF) : static_cast<__mmask16>((1U << (Count - i)) - 1) };
+			const __m512i Indices{ _mm512_srli_epi32(_mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(PosX)), LaneOffsets), 16) };
+			_mm512_mask_storeu_epi32(Target + i, LoadMask, _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), LoadMask, Indices, Source, 4));
+			PosX += StepX << 4;
 		}
 	}
 
 
-} // namespace lwmf
+} // namespace lwmf
\ No newline at end of file
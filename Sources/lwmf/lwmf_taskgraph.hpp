@@ -0,0 +1,459 @@
+/*
+***************************************************************
+*                                                             *
+* lwmf_taskgraph - lightweight media framework                *
+*                                                             *
+* (C) 2019 - present by Stefan Kubsch                         *
+*                                                             *
+***************************************************************
+*/
+
+#pragma once
+
+// Example for usage:
+//
+// Create graph and resources once
+// lwmf::TaskGraph Graph;
+// const std::int_fast32_t Canvas{ Graph.AddResource("Canvas") };
+//
+// Add tasks in the order they would run serially - dependencies are derived from the declared accesses
+// Graph.AddTask("ClearCanvas", lwmf::TaskAffinity::AnyThread, { { Canvas, lwmf::TaskAccess::Write } }, [] { ... });
+// Graph.AddTask("LeftHalf", lwmf::TaskAffinity::AnyThread, { { Canvas, lwmf::TaskAccess::SharedWrite } }, [] { ... });
+// Graph.AddTask("RightHalf", lwmf::TaskAffinity::AnyThread, { { Canvas, lwmf::TaskAccess::SharedWrite } }, [] { ... });
+//
+// Run it every frame
+// Graph.Execute(ThreadPool);
+//
+// Rules:
+// Read			- waits for the last writer(s) of the resource
+// Write		- waits for the last writer(s) and all readers since then
+// SharedWrite	- like Write, but consecutive SharedWrites of one resource run concurrently (e.g. disjoint parts of a texture)
+//
+// If a task throws, the remaining tasks are skipped and the exception is rethrown by Execute() on the calling thread once all running tasks are done
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <initializer_list>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <utility>
+
+#include "lwmf_logging.hpp"
+#include "lwmf_multithreading.hpp"
+
+namespace lwmf
+{
+
+
+	enum class TaskAccess : std::int_fast32_t
+	{
+		Read,
+		Write,
+		SharedWrite
+	};
+
+	enum class TaskAffinity : std::int_fast32_t
+	{
+		AnyThread,
+		MainThread
+	};
+
+	struct TaskResourceStruct final
+	{
+		std::int_fast32_t Resource{};
+		TaskAccess Access{};
+	};
+
+	class TaskGraph final
+	{
+	public:
+		std::int_fast32_t AddResource(const std::string& Name);
+		std::int_fast32_t AddTask(const std::string& Name, TaskAffinity Affinity, std::initializer_list<TaskResourceStruct> Resources, std::function<void()>&& Function);
+		void Execute(Multithreading& ThreadPool);
+		std::string GetGraphDescription() const;
+		std::string GetFrameReport() const;
+		void Clear();
+
+	private:
+		struct TaskStruct final
+		{
+			std::function<void()> Function;
+			std::vector<std::int_fast32_t> Dependencies{};
+			std::vector<std::int_fast32_t> Dependents{};
+			std::vector<TaskResourceStruct> Resources{};
+			std::string Name;
+			std::chrono::steady_clock::time_point StartTime{};
+			std::chrono::steady_clock::time_point EndTime{};
+			std::int_fast32_t PendingDependencies{};
+			TaskAffinity Affinity{};
+		};
+
+		struct ResourceStruct final
+		{
+			std::vector<std::int_fast32_t> Writers{};
+			std::vector<std::int_fast32_t> Readers{};
+			std::vector<std::int_fast32_t> SharedWriteBarrier{};
+			std::string Name;
+			bool SharedWriteOpen{};
+		};
+
+		void AddDependency(std::int_fast32_t Task, std::int_fast32_t Dependency);
+		void Dispatch(std::int_fast32_t Task, Multithreading& ThreadPool);
+		void Complete(std::int_fast32_t Task, Multithreading& ThreadPool);
+		void RunTask(std::int_fast32_t Task);
+
+		std::vector<TaskStruct> Tasks{};
+		std::vector<ResourceStruct> Resources{};
+		std::vector<std::int_fast32_t> MainThreadQueue{};
+		std::vector<std::int_fast32_t> CompletedTasks{};
+		std::mutex CompletionMutex{};
+		std::condition_variable CompletionCondition{};
+		std::exception_ptr TaskException{};
+		std::atomic<bool> FailedFlag{};
+		std::chrono::steady_clock::time_point FrameStartTime{};
+		std::chrono::steady_clock::time_point FrameEndTime{};
+	};
+
+	inline std::int_fast32_t TaskGraph::AddResource(const std::string& Name)
+	{
+		Resources.emplace_back();
+		Resources.back().Name = Name;
+
+		return static_cast<std::int_fast32_t>(Resources.size()) - 1;
+	}
+
+	inline std::int_fast32_t TaskGraph::AddTask(const std::string& Name, const TaskAffinity Affinity, const std::initializer_list<TaskResourceStruct> TaskResources, std::function<void()>&& Function)
+	{
+		const std::int_fast32_t Index{ static_cast<std::int_fast32_t>(Tasks.size()) };
+
+		Tasks.emplace_back();
+		Tasks[Index].Name = Name;
+		Tasks[Index].Affinity = Affinity;
+		Tasks[Index].Function = std::move(Function);
+		Tasks[Index].Resources = TaskResources;
+
+		// Since tasks are added in their serial order, every dependency points to an earlier task - the index order is always a valid topological order
+		for (const auto& TaskResource : TaskResources)
+		{
+			if (static_cast<std::size_t>(TaskResource.Resource) >= Resources.size())
+			{
+				LWMFSystemLog.AddEntry(LogLevel::Error, __FILENAME__, __LINE__, "lwmf::TaskGraph::AddTask(): Task " + Name + " uses an unknown resource!");
+				continue;
+			}
+
+			ResourceStruct& Resource{ Resources[TaskResource.Resource] };
+
+			switch (TaskResource.Access)
+			{
+				case TaskAccess::Read:
+				{
+					for (const std::int_fast32_t Writer : Resource.Writers)
+					{
+						AddDependency(Index, Writer);
+					}
+
+					Resource.Readers.emplace_back(Index);
+					break;
+				}
+				case TaskAccess::Write:
+				{
+					for (const std::int_fast32_t Writer : Resource.Writers)
+					{
+						AddDependency(Index, Writer);
+					}
+
+					for (const std::int_fast32_t Reader : Resource.Readers)
+					{
+						AddDependency(Index, Reader);
+					}
+
+					Resource.Writers = { Index };
+					Resource.Readers.clear();
+					Resource.SharedWriteOpen = false;
+					break;
+				}
+				case TaskAccess::SharedWrite:
+				{
+					// Open a new group of concurrent writers if the previous access was no shared write
+					if (!Resource.SharedWriteOpen || !Resource.Readers.empty())
+					{
+						Resource.SharedWriteBarrier = Resource.Writers;
+						Resource.SharedWriteBarrier.insert(Resource.SharedWriteBarrier.end(), Resource.Readers.begin(), Resource.Readers.end());
+						Resource.Writers.clear();
+						Resource.Readers.clear();
+						Resource.SharedWriteOpen = true;
+					}
+
+					for (const std::int_fast32_t Barrier : Resource.SharedWriteBarrier)
+					{
+						AddDependency(Index, Barrier);
+					}
+
+					Resource.Writers.emplace_back(Index);
+					break;
+				}
+				default: {}
+			}
+		}
+
+		return Index;
+	}
+
+	inline void TaskGraph::Execute(Multithreading& ThreadPool)
+	{
+		const std::int_fast32_t NumberOfTasks{ static_cast<std::int_fast32_t>(Tasks.size()) };
+
+		MainThreadQueue.clear();
+		CompletedTasks.clear();
+		TaskException = nullptr;
+		FailedFlag = false;
+		FrameStartTime = std::chrono::steady_clock::now();
+
+		for (auto&& Task : Tasks)
+		{
+			Task.PendingDependencies = static_cast<std::int_fast32_t>(Task.Dependencies.size());
+		}
+
+		for (std::int_fast32_t i{}; i < NumberOfTasks; ++i)
+		{
+			if (Tasks[i].PendingDependencies == 0)
+			{
+				Dispatch(i, ThreadPool);
+			}
+		}
+
+		std::vector<std::int_fast32_t> Finished{};
+
+		for (std::int_fast32_t Remaining{ NumberOfTasks }; Remaining > 0;)
+		{
+			// Main thread tasks are run inline, in declaration order of their readiness
+			if (!MainThreadQueue.empty())
+			{
+				const std::int_fast32_t Task{ MainThreadQueue.front() };
+				MainThreadQueue.erase(MainThreadQueue.begin());
+				RunTask(Task);
+				Complete(Task, ThreadPool);
+				--Remaining;
+				continue;
+			}
+
+			{
+				std::unique_lock<std::mutex> Lock(CompletionMutex);
+				CompletionCondition.wait(Lock, [this] { return !CompletedTasks.empty(); });
+				Finished.swap(CompletedTasks);
+			}
+
+			for (const std::int_fast32_t Task : Finished)
+			{
+				Complete(Task, ThreadPool);
+				--Remaining;
+			}
+
+			Finished.clear();
+		}
+
+		// All tasks are done at this point, this only releases the futures of the pool
+		ThreadPool.WaitForThreads();
+		FrameEndTime = std::chrono::steady_clock::now();
+
+		if (TaskException)
+		{
+			std::rethrow_exception(std::exchange(TaskException, nullptr));
+		}
+	}
+
+	inline std::string TaskGraph::GetGraphDescription() const
+	{
+		const std::vector<std::string_view> AccessNames{ "R", "W", "SW" };
+		std::string Description{ "Taskgraph (" + std::to_string(Tasks.size()) + " tasks, " + std::to_string(Resources.size()) + " resources):\n" };
+
+		for (const auto& Task : Tasks)
+		{
+			Description += "   ";
+			Description += Task.Name;
+			Description += Task.Affinity == TaskAffinity::MainThread ? " [main]" : " [any]";
+			Description += " uses";
+
+			for (const auto& TaskResource : Task.Resources)
+			{
+				if (static_cast<std::size_t>(TaskResource.Resource) < Resources.size())
+				{
+					Description += " ";
+					Description += Resources[TaskResource.Resource].Name;
+					Description += "(";
+					Description += AccessNames[static_cast<std::size_t>(TaskResource.Access)];
+					Description += ")";
+				}
+			}
+
+			Description += ", waits for";
+
+			if (Task.Dependencies.empty())
+			{
+				Description += " -";
+			}
+
+			for (const std::int_fast32_t Dependency : Task.Dependencies)
+			{
+				Description += " ";
+				Description += Tasks[Dependency].Name;
+			}
+
+			Description += "\n";
+		}
+
+		return Description;
+	}
+
+	inline std::string TaskGraph::GetFrameReport() const
+	{
+		const std::int_fast32_t NumberOfTasks{ static_cast<std::int_fast32_t>(Tasks.size()) };
+
+		// Longest chain of task durations through the graph - tasks are stored in topological order
+		std::vector<long long> EarliestFinish(static_cast<std::size_t>(NumberOfTasks));
+		std::vector<std::int_fast32_t> Predecessor(static_cast<std::size_t>(NumberOfTasks), -1);
+		std::int_fast32_t CriticalEnd{ -1 };
+
+		std::string Report{ "Taskgraph frame report (times in microseconds, relative to frame start):\n" };
+
+		for (std::int_fast32_t i{}; i < NumberOfTasks; ++i)
+		{
+			const long long Start{ std::chrono::duration_cast<std::chrono::microseconds>(Tasks[i].StartTime - FrameStartTime).count() };
+			const long long End{ std::chrono::duration_cast<std::chrono::microseconds>(Tasks[i].EndTime - FrameStartTime).count() };
+			long long ChainStart{};
+
+			for (const std::int_fast32_t Dependency : Tasks[i].Dependencies)
+			{
+				if (EarliestFinish[Dependency] > ChainStart)
+				{
+					ChainStart = EarliestFinish[Dependency];
+					Predecessor[i] = Dependency;
+				}
+			}
+
+			EarliestFinish[i] = ChainStart + (End - Start);
+
+			if (CriticalEnd == -1 || EarliestFinish[i] > EarliestFinish[CriticalEnd])
+			{
+				CriticalEnd = i;
+			}
+
+			Report += "   " + Tasks[i].Name + ": " + std::to_string(Start) + " - " + std::to_string(End) + " (" + std::to_string(End - Start) + ")\n";
+		}
+
+		std::vector<std::string_view> CriticalPath{};
+
+		for (std::int_fast32_t Task{ CriticalEnd }; Task != -1; Task = Predecessor[Task])
+		{
+			CriticalPath.emplace_back(Tasks[Task].Name);
+		}
+
+		Report += "Critical path";
+
+		if (CriticalEnd != -1)
+		{
+			Report += " (" + std::to_string(EarliestFinish[CriticalEnd]) + " of " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(FrameEndTime - FrameStartTime).count()) + ")";
+		}
+
+		Report += ":";
+
+		for (auto Name{ CriticalPath.rbegin() }; Name != CriticalPath.rend(); ++Name)
+		{
+			Report += " ";
+			Report += *Name;
+
+			if (Name + 1 != CriticalPath.rend())
+			{
+				Report += " ->";
+			}
+		}
+
+		return Report;
+	}
+
+	inline void TaskGraph::Clear()
+	{
+		Tasks.clear();
+		Tasks.shrink_to_fit();
+		Resources.clear();
+		Resources.shrink_to_fit();
+	}
+
+	inline void TaskGraph::AddDependency(const std::int_fast32_t Task, const std::int_fast32_t Dependency)
+	{
+		if (Task != Dependency && std::find(Tasks[Task].Dependencies.begin(), Tasks[Task].Dependencies.end(), Dependency) == Tasks[Task].Dependencies.end())
+		{
+			Tasks[Task].Dependencies.emplace_back(Dependency);
+			Tasks[Dependency].Dependents.emplace_back(Task);
+		}
+	}
+
+	inline void TaskGraph::Dispatch(const std::int_fast32_t Task, Multithreading& ThreadPool)
+	{
+		if (Tasks[Task].Affinity == TaskAffinity::MainThread)
+		{
+			MainThreadQueue.emplace_back(Task);
+			return;
+		}
+
+		ThreadPool.AddThread([this, Task]
+		{
+			RunTask(Task);
+
+			{
+				const std::lock_guard<std::mutex> Lock(CompletionMutex);
+				CompletedTasks.emplace_back(Task);
+			}
+
+			CompletionCondition.notify_one();
+		});
+	}
+
+	inline void TaskGraph::Complete(const std::int_fast32_t Task, Multithreading& ThreadPool)
+	{
+		// Only called from the thread running Execute(), so the counters need no locking
+		for (const std::int_fast32_t Dependent : Tasks[Task].Dependents)
+		{
+			if (--Tasks[Dependent].PendingDependencies == 0)
+			{
+				Dispatch(Dependent, ThreadPool);
+			}
+		}
+	}
+
+	// Never throws - the first exception is kept for Execute(), otherwise a throwing pool task would never be marked complete and the graph would wait forever
+	inline void TaskGraph::RunTask(const std::int_fast32_t Task)
+	{
+		Tasks[Task].StartTime = std::chrono::steady_clock::now();
+
+		if (!FailedFlag.load(std::memory_order_acquire))
+		{
+			try
+			{
+				Tasks[Task].Function();
+			}
+			catch (...)
+			{
+				const std::lock_guard<std::mutex> Lock(CompletionMutex);
+
+				if (!TaskException)
+				{
+					TaskException = std::current_exception();
+				}
+
+				FailedFlag.store(true, std::memory_order_release);
+			}
+		}
+
+		Tasks[Task].EndTime = std::chrono::steady_clock::now();
+	}
+
+
+} // namespace lwmf
\ No newline at end of file
@@ -11,23 +11,90 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
+#include <new>
 #include <vector>
 #include <algorithm>
 #include <utility>
 #include <cmath>
+#include <cstring>
 
 #include "lwmf_general.hpp"
+#include "lwmf_color.hpp"
+#include "lwmf_simd.hpp"
 
 namespace lwmf
 {
 
 
+	// Pixel buffers start on a 64 byte boundary (one cache line), and every row is padded to a multiple of 64 bytes
+	// So each row starts aligned as well and aligned SIMD loads/stores can be used
+	inline constexpr std::size_t PixelBufferAlignment{ 64 };
+	inline constexpr std::int_fast32_t PixelRowAlignment{ static_cast<std::int_fast32_t>(PixelBufferAlignment / sizeof(PixelType)) };
+
+	template <typename T, std::size_t Alignment>
+	struct AlignedAllocator
+	{
+		using value_type = T;
+
+		template <typename U>
+		struct rebind
+		{
+			using other = AlignedAllocator<U, Alignment>;
+		};
+
+		AlignedAllocator() noexcept = default;
+
+		template <typename U>
+		explicit AlignedAllocator(const AlignedAllocator<U, Alignment>& /*Other*/) noexcept
+		{
+		}
+
+		T* allocate(const std::size_t Count)
+		{
+			return static_cast<T*>(::operator new(Count * sizeof(T), std::align_val_t{ Alignment }));
+		}
+
+		void deallocate(T* const Pointer, const std::size_t /*Count*/) noexcept
+		{
+			::operator delete(Pointer, std::align_val_t{ Alignment });
+		}
+
+		template <typename U>
+		bool operator==(const AlignedAllocator<U, Alignment>& /*Other*/) const noexcept
+		{
+			return true;
+		}
+
+		template <typename U>
+		bool operator!=(const AlignedAllocator<U, Alignment>& /*Other*/) const noexcept
+		{
+			return false;
+		}
+	};
+
+	using PixelBuffer = std::vector<PixelType, AlignedAllocator<PixelType, PixelBufferAlignment>>;
+
 	struct TextureStruct final
 	{
-		std::vector<std::int_fast32_t> Pixels{};
+		PixelBuffer Pixels{};
+		std::int_fast32_t Size{}; // Number of pixels in buffer (Stride * Height)
+		std::int_fast32_t Width{};
+		std::int_fast32_t Height{};
+		std::int_fast32_t Stride{}; // Pixels per row in buffer (Width rounded up to PixelRowAlignment)
+		std::int_fast32_t WidthMid{};
+		std::int_fast32_t HeightMid{};
+	};
+
+	// Read-only view of pixel data owned by someone else (e.g. a texture or a memory-mapped asset pack)
+	// Same layout as TextureStruct, so data can be used straight from the owner without copying
+	struct TextureViewStruct final
+	{
+		const PixelType* Pixels{};
 		std::int_fast32_t Size{};
 		std::int_fast32_t Width{};
 		std::int_fast32_t Height{};
+		std::int_fast32_t Stride{};
 		std::int_fast32_t WidthMid{};
 		std::int_fast32_t HeightMid{};
 	};
@@ -38,30 +105,71 @@ namespace lwmf
 		BILINEAR
 	};
 
+	std::int_fast32_t CalculateStride(std::int_fast32_t Width);
 	void SetTextureMetrics(TextureStruct& Texture, std::int_fast32_t Width, std::int_fast32_t Height);
-	void CreateTexture(TextureStruct& Texture, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Color);
+	TextureViewStruct GetTextureView(const TextureStruct& Texture);
+	void CreateTextureFromView(TextureStruct& Texture, const TextureViewStruct& View);
+	void CreateTexture(TextureStruct& Texture, std::int_fast32_t Width, std::int_fast32_t Height, PixelType Color);
 	void CropTexture(TextureStruct& Texture, std::int_fast32_t x, std::int_fast32_t y, std::int_fast32_t Width, std::int_fast32_t Height);
 	void ResizeTexture(TextureStruct& Texture, std::int_fast32_t TargetWidth, std::int_fast32_t TargetHeight, FilterModes FilterMode);
 	void BlitTexture(const TextureStruct& SourceTexture, TextureStruct& TargetTexture, std::int_fast32_t PosX, std::int_fast32_t PosY);
-	void BlitTransTexture(const TextureStruct& SourceTexture, TextureStruct& TargetTexture, std::int_fast32_t PosX, std::int_fast32_t PosY, std::int_fast32_t TransparentColor);
-	void BlitTransTexturePart(const TextureStruct& SourceTexture, std::int_fast32_t SourcePosX, std::int_fast32_t SourcePosY, TextureStruct& TargetTexture, std::int_fast32_t DestPosX, std::int_fast32_t DestPosY, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t TransparentColor);
+	void BlitTransTexture(const TextureStruct& SourceTexture, TextureStruct& TargetTexture, std::int_fast32_t PosX, std::int_fast32_t PosY, PixelType TransparentColor);
+	void BlitTransTexturePart(const TextureStruct& SourceTexture, std::int_fast32_t SourcePosX, std::int_fast32_t SourcePosY, TextureStruct& TargetTexture, std::int_fast32_t DestPosX, std::int_fast32_t DestPosY, std::int_fast32_t Width, std::int_fast32_t Height, PixelType TransparentColor);
 	void RotateTexture(TextureStruct& Texture, std::int_fast32_t RotCenterX, std::int_fast32_t RotCenterY, float Angle);
-	void ClearTexture(TextureStruct& Texture, std::int_fast32_t Color);
+	void ClearTexture(TextureStruct& Texture, PixelType Color);
 
 	//
 	// Functions
 	//
 
+	inline std::int_fast32_t CalculateStride(const std::int_fast32_t Width)
+	{
+		return (Width + PixelRowAlignment - 1) & ~(PixelRowAlignment - 1);
+	}
+
 	inline void SetTextureMetrics(TextureStruct& Texture, const std::int_fast32_t Width, const std::int_fast32_t Height)
 	{
 		Texture.Width = Width;
 		Texture.Height = Height;
+		Texture.Stride = CalculateStride(Width);
 		Texture.WidthMid = Width >> 1;
 		Texture.HeightMid = Height >> 1;
-		Texture.Size = Width * Height;
+		Texture.Size = Texture.Stride * Height;
 	}
 
-	inline void CreateTexture(TextureStruct& Texture, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Color)
+	inline TextureViewStruct GetTextureView(const TextureStruct& Texture)
+	{
+		return { Texture.Pixels.data(), Texture.Size, Texture.Width, Texture.Height, Texture.Stride, Texture.WidthMid, Texture.HeightMid };
+	}
+
+	inline void CreateTextureFromView(TextureStruct& Texture, const TextureViewStruct& View)
+	{
+		// Exit early if texture size would be zero
+		if (View.Width <= 0 || View.Height <= 0)
+		{
+			return;
+		}
+
+		SetTextureMetrics(Texture, View.Width, View.Height);
+		Texture.Pixels.clear();
+		Texture.Pixels.shrink_to_fit();
+		Texture.Pixels.resize(static_cast<std::size_t>(Texture.Size));
+
+		// Views with the default row padding are copied in one go
+		if (View.Stride == Texture.Stride)
+		{
+			std::memcpy(Texture.Pixels.data(), View.Pixels, static_cast<std::size_t>(Texture.Size) * sizeof(PixelType));
+		}
+		else
+		{
+			for (std::int_fast32_t y{}; y < View.Height; ++y)
+			{
+				std::memcpy(Texture.Pixels.data() + y * Texture.Stride, View.Pixels + y * View.Stride, static_cast<std::size_t>(View.Width) * sizeof(PixelType));
+			}
+		}
+	}
+
+	inline void CreateTexture(TextureStruct& Texture, const std::int_fast32_t Width, const std::int_fast32_t Height, const PixelType Color)
 	{
 		// Exit early if texture size would be zero
 		if (Width <= 0 || Height <= 0)
@@ -93,22 +201,18 @@ namespace lwmf
 			return;
 		}
 
-		std::vector<std::int_fast32_t>TempBuffer(Width * Height);
-		std::int_fast32_t SourceVerticalOffset{ y * Texture.Width };
+		const std::int_fast32_t TargetStride{ CalculateStride(Width) };
+		PixelBuffer TempBuffer(static_cast<std::size_t>(TargetStride) * static_cast<std::size_t>(Height));
+		std::int_fast32_t SourceVerticalOffset{ y * Texture.Stride + x };
 		std::int_fast32_t TargetVerticalOffset{};
 
 		for (std::int_fast32_t i{}; i < Height; ++i)
 		{
-			for (std::int_fast32_t TargetHorizontalOffset{}, SourceHorizontalOffset{ x }, j{}; j < Width; ++j)
-			{
-				TempBuffer[static_cast<std::size_t>(TargetVerticalOffset) + static_cast<std::size_t>(TargetHorizontalOffset)] = Texture.Pixels[static_cast<std::size_t>(SourceVerticalOffset) + static_cast<std::size_t>(SourceHorizontalOffset)];
+			const auto SourceOffset{ Texture.Pixels.begin() + SourceVerticalOffset };
+			std::copy(SourceOffset, SourceOffset + Width, TempBuffer.begin() + TargetVerticalOffset);
 
-				++TargetHorizontalOffset;
-				++SourceHorizontalOffset;
-			}
-
-			TargetVerticalOffset += Width;
-			SourceVerticalOffset += Texture.Width;
+			TargetVerticalOffset += TargetStride;
+			SourceVerticalOffset += Texture.Stride;
 		}
 
 		Texture.Pixels = std::move(TempBuffer);
@@ -123,7 +227,8 @@ namespace lwmf
 			return;
 		}
 
-		std::vector<std::int_fast32_t> TempBuffer(TargetWidth * TargetHeight);
+		const std::int_fast32_t TargetStride{ CalculateStride(TargetWidth) };
+		PixelBuffer TempBuffer(static_cast<std::size_t>(TargetStride) * static_cast<std::size_t>(TargetHeight));
 
 		switch (FilterMode)
 		{
@@ -131,14 +236,10 @@ namespace lwmf
 			{
 				const IntPointStruct Ratio{ ((Texture.Width << 16) / TargetWidth) + 1, ((Texture.Height << 16) / TargetHeight) + 1 };
 
-				for (std::int_fast32_t Offset{}, i{}; i < TargetHeight; ++i)
+				for (std::int_fast32_t i{}; i < TargetHeight; ++i)
 				{
-					const std::int_fast32_t TempY{ ((i * Ratio.Y) >> 16) * Texture.Width };
-
-					for (std::int_fast32_t j{}; j < TargetWidth; ++j)
-					{
-						TempBuffer[static_cast<std::size_t>(Offset++)] = Texture.Pixels[static_cast<std::size_t>(TempY) + static_cast<std::size_t>(((j * Ratio.X) >> 16))];
-					}
+					const std::int_fast32_t TempY{ ((i * Ratio.Y) >> 16) * Texture.Stride };
+					SIMDKernels.SamplePixels(Texture.Pixels.data() + TempY, TempBuffer.data() + i * TargetStride, static_cast<std::size_t>(TargetWidth), 0, Ratio.X);
 				}
 				break;
 			}
@@ -146,11 +247,12 @@ namespace lwmf
 			{
 				const FloatPointStruct Ratio{ static_cast<float>((Texture.Width - 1)) / TargetWidth, static_cast<float>((Texture.Height - 1)) / TargetHeight };
 
-				for (std::int_fast32_t Offset{}, i{}; i < TargetHeight; ++i)
+				for (std::int_fast32_t i{}; i < TargetHeight; ++i)
 				{
 					const float TempRatioY{ Ratio.Y * i };
 					const std::int_fast32_t PosY{ static_cast<std::int_fast32_t>(TempRatioY) };
-					const std::int_fast32_t TempY{ PosY * Texture.Width };
+					const std::int_fast32_t TempY{ PosY * Texture.Stride };
+					std::int_fast32_t Offset{ i * TargetStride };
 					const float Height{ TempRatioY - PosY };
 
 					for (std::int_fast32_t j{}; j < TargetWidth; ++j)
@@ -159,10 +261,10 @@ namespace lwmf
 						const std::int_fast32_t PosX{ static_cast<std::int_fast32_t>(TempRatioX) };
 						const std::int_fast32_t Index{ TempY + PosX };
 
-						const std::int_fast32_t P1{ Texture.Pixels[static_cast<std::size_t>(Index)] };
-						const std::int_fast32_t P2{ Texture.Pixels[static_cast<std::size_t>(Index) + 1] };
-						const std::int_fast32_t P3{ Texture.Pixels[static_cast<std::size_t>(Index) + static_cast<std::size_t>(Texture.Width)] };
-						const std::int_fast32_t P4{ Texture.Pixels[static_cast<std::size_t>(Index) + static_cast<std::size_t>(Texture.Width) + 1] };
+						const PixelType P1{ Texture.Pixels[static_cast<std::size_t>(Index)] };
+						const PixelType P2{ Texture.Pixels[static_cast<std::size_t>(Index) + 1] };
+						const PixelType P3{ Texture.Pixels[static_cast<std::size_t>(Index) + static_cast<std::size_t>(Texture.Stride)] };
+						const PixelType P4{ Texture.Pixels[static_cast<std::size_t>(Index) + static_cast<std::size_t>(Texture.Stride) + 1] };
 
 						const float Width{ TempRatioX - PosX };
 						const float t1{ (1.0F - Width) * (1.0F - Height) };
@@ -174,7 +276,7 @@ namespace lwmf
 							static_cast<std::int_fast32_t>((P1 & 255) * t1 + (P2 & 255) * t2 + (P3 & 255) * t3 + (P4 & 255) * t4),
 							static_cast<std::int_fast32_t>(((P1 >> 8) & 255) * t1 + ((P2 >> 8) & 255) * t2 + ((P3 >> 8) & 255) * t3 + ((P4 >> 8) & 255) * t4),
 							static_cast<std::int_fast32_t>(((P1 >> 16) & 255) * t1 + ((P2 >> 16) & 255) * t2 + ((P3 >> 16) & 255) * t3 + ((P4 >> 16) & 255) * t4)
-							, AMask);
+							, 255);
 					}
 				}
 				break;
@@ -210,14 +312,13 @@ namespace lwmf
 			{
 				if (static_cast<std::uint_fast32_t>(ty) < static_cast<std::uint_fast32_t>(TargetTexture.Height))
 				{
-					const auto SourceOffset{ SourceTexture.Pixels.begin() + sy * SourceTexture.Width + StartX};
-					std::copy(SourceOffset, SourceOffset + TargetWidth - StartX, TargetTexture.Pixels.begin() + ty * TargetTexture.Width + PosX + StartX);
+					SIMDKernels.CopyPixels(SourceTexture.Pixels.data() + sy * SourceTexture.Stride + StartX, TargetTexture.Pixels.data() + ty * TargetTexture.Stride + PosX + StartX, static_cast<std::size_t>(TargetWidth - StartX));
 				}
 			}
 		}
 	}
 
-	inline void BlitTransTexture(const TextureStruct& SourceTexture, TextureStruct& TargetTexture, const std::int_fast32_t PosX, const std::int_fast32_t PosY, const std::int_fast32_t TransparentColor)
+	inline void BlitTransTexture(const TextureStruct& SourceTexture, TextureStruct& TargetTexture, const std::int_fast32_t PosX, const std::int_fast32_t PosY, const PixelType TransparentColor)
 	{
 		// Exit early if coords are out of texture boundaries
 		if (PosX + SourceTexture.Width < 0 || PosY + SourceTexture.Height < 0 || PosX > TargetTexture.Width || PosY > TargetTexture.Height)
@@ -228,54 +329,38 @@ namespace lwmf
 		// Case 1: Bitmap fits 1:1 into target texture
 		if (PosX == 0 && PosY == 0 && TargetTexture.Width == SourceTexture.Width && TargetTexture.Height == SourceTexture.Height)
 		{
-			for (std::int_fast32_t i{}; i < SourceTexture.Size; ++i)
-			{
-				if (SourceTexture.Pixels[i] != TransparentColor)
-				{
-					TargetTexture.Pixels[i] = SourceTexture.Pixels[i];
-				}
-			}
+			SIMDKernels.CopyPixelsTrans(SourceTexture.Pixels.data(), TargetTexture.Pixels.data(), static_cast<std::size_t>(SourceTexture.Size), TransparentColor);
 		}
 		// Case 2: Bitmap fits (= smaller than target texture and within boundaries)
 		else if (PosX >= 0 && PosY >= 0 && SourceTexture.Width + PosX <= TargetTexture.Width && SourceTexture.Height + PosY <= TargetTexture.Height)
 		{
 			for (std::int_fast32_t sy{}, ty{ PosY }; sy < SourceTexture.Height; ++sy, ++ty)
 			{
-				const std::int_fast32_t SourceOffset{ sy * SourceTexture.Width };
-				const std::int_fast32_t TargetOffset{ ty * TargetTexture.Width + PosX };
-
-				for (std::int_fast32_t x{}; x < SourceTexture.Width; ++x)
-				{
-					if (SourceTexture.Pixels[SourceOffset + x] != TransparentColor)
-					{
-						TargetTexture.Pixels[TargetOffset + x] = SourceTexture.Pixels[SourceOffset + x];
-					}
-				}
+				SIMDKernels.CopyPixelsTrans(SourceTexture.Pixels.data() + sy * SourceTexture.Stride, TargetTexture.Pixels.data() + ty * TargetTexture.Stride + PosX, static_cast<std::size_t>(SourceTexture.Width), TransparentColor);
 			}
 		}
-		// Case 3: Each pixel has to be checked if within boundaries
+		// Case 3: Clip each row to target texture boundaries
 		else
 		{
+			const std::int_fast32_t StartX{ std::max<std::int_fast32_t>(0, -PosX) };
+			const std::int_fast32_t EndX{ std::min(SourceTexture.Width, TargetTexture.Width - PosX) };
+
+			if (EndX <= StartX)
+			{
+				return;
+			}
+
 			for (std::int_fast32_t sy{}, ty{ PosY }; sy < SourceTexture.Height; ++sy, ++ty)
 			{
 				if (static_cast<std::uint_fast32_t>(ty) < static_cast<std::uint_fast32_t>(TargetTexture.Height))
 				{
-					const std::int_fast32_t SourceOffset{ sy * SourceTexture.Width };
-					const std::int_fast32_t TargetOffset{ ty * TargetTexture.Width + PosX };
-
-					for (std::int_fast32_t x{}; x < SourceTexture.Width; ++x)
-					{
-						if (static_cast<std::uint_fast32_t>(PosX + x) < static_cast<std::uint_fast32_t>(TargetTexture.Width) && SourceTexture.Pixels[SourceOffset + x] != TransparentColor)
-						{
-							TargetTexture.Pixels[TargetOffset + x] = SourceTexture.Pixels[SourceOffset + x];
-						}
-					}
+					SIMDKernels.CopyPixelsTrans(SourceTexture.Pixels.data() + sy * SourceTexture.Stride + StartX, TargetTexture.Pixels.data() + ty * TargetTexture.Stride + PosX + StartX, static_cast<std::size_t>(EndX - StartX), TransparentColor);
 				}
 			}
 		}
 	}
 
-	inline void BlitTransTexturePart(const TextureStruct& SourceTexture, const std::int_fast32_t SourcePosX, const std::int_fast32_t SourcePosY, TextureStruct& TargetTexture, const std::int_fast32_t DestPosX, const std::int_fast32_t DestPosY, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t TransparentColor)
+	inline void BlitTransTexturePart(const TextureStruct& SourceTexture, const std::int_fast32_t SourcePosX, const std::int_fast32_t SourcePosY, TextureStruct& TargetTexture, const std::int_fast32_t DestPosX, const std::int_fast32_t DestPosY, const std::int_fast32_t Width, const std::int_fast32_t Height, const PixelType TransparentColor)
 	{
 		// Exit early if source coords are out of source texture boundaries
 		if (SourcePosX >= SourceTexture.Width || SourcePosY >= SourceTexture.Height || SourcePosX < 0 || SourcePosY < 0)
@@ -290,23 +375,18 @@ namespace lwmf
 		}
 
 		const std::int_fast32_t SourceYMax{ ((SourcePosY + Height) >= SourceTexture.Height) ? SourceTexture.Height : SourcePosY + Height };
-		const std::int_fast32_t SourceXMax{ ((SourcePosX + Width) >= SourceTexture.Width) ? SourceTexture.Width : SourcePosX + Width };
+		const std::int_fast32_t SourceXMax{ std::min(((SourcePosX + Width) >= SourceTexture.Width) ? SourceTexture.Width : SourcePosX + Width, SourcePosX + TargetTexture.Width - DestPosX) };
+
+		if (SourceXMax <= SourcePosX)
+		{
+			return;
+		}
 
 		for (std::int_fast32_t sy{ SourcePosY }, ty{ DestPosY }; sy < SourceYMax; ++sy, ++ty)
 		{
 			if (static_cast<std::uint_fast32_t>(ty) < static_cast<std::uint_fast32_t>(TargetTexture.Height))
 			{
-				const std::int_fast32_t TargetOffset{ ty * TargetTexture.Width };
-
-				for (std::int_fast32_t sx{ SourcePosX }, tx{ DestPosX }; sx < SourceXMax; ++sx, ++tx)
-				{
-					const std::int_fast32_t SourcePoint{ sy * SourceTexture.Width + sx };
-
-					if (static_cast<std::uint_fast32_t>(tx) < static_cast<std::uint_fast32_t>(TargetTexture.Width) && SourceTexture.Pixels[SourcePoint] != TransparentColor)
-					{
-						TargetTexture.Pixels[TargetOffset + tx] = SourceTexture.Pixels[SourcePoint];
-					}
-				}
+				SIMDKernels.CopyPixelsTrans(SourceTexture.Pixels.data() + sy * SourceTexture.Stride + SourcePosX, TargetTexture.Pixels.data() + ty * TargetTexture.Stride + DestPosX, static_cast<std::size_t>(SourceXMax - SourcePosX), TransparentColor);
 			}
 		}
 	}
@@ -319,7 +399,7 @@ namespace lwmf
 			return;
 		}
 
-		std::vector<std::int_fast32_t> TempBuffer(Texture.Size);
+		PixelBuffer TempBuffer(static_cast<std::size_t>(Texture.Size));
 
 		const float c{ std::cosf(Angle) };
 		const float s{ std::sinf(Angle) };
@@ -327,7 +407,7 @@ namespace lwmf
 		for (std::int_fast32_t y{}; y < Texture.Height; ++y)
 		{
 			const float fy{ static_cast<float>(y - RotCenterY) };
-			const std::int_fast32_t TargetOffset{ y * Texture.Width };
+			const std::int_fast32_t TargetOffset{ y * Texture.Stride };
 
 			for (std::int_fast32_t x{}; x < Texture.Width; ++x)
 			{
@@ -337,7 +417,7 @@ namespace lwmf
 
 				if (static_cast<std::uint_fast32_t>(SourceX) < static_cast<std::uint_fast32_t>(Texture.Width) && static_cast<std::uint_fast32_t>(SourceY) < static_cast<std::uint_fast32_t>(Texture.Height))
 				{
-					TempBuffer[TargetOffset + x] = Texture.Pixels[SourceY * Texture.Width + SourceX];
+					TempBuffer[TargetOffset + x] = Texture.Pixels[SourceY * Texture.Stride + SourceX];
 				}
 			}
 		}
@@ -345,9 +425,9 @@ namespace lwmf
 		Texture.Pixels = std::move(TempBuffer);
 	}
 
-	inline void ClearTexture(TextureStruct& Texture, const std::int_fast32_t Color)
+	inline void ClearTexture(TextureStruct& Texture, const PixelType Color)
 	{
-		std::fill(Texture.Pixels.begin(), Texture.Pixels.end(), Color);
+		SIMDKernels.FillPixels(Texture.Pixels.data(), Texture.Pixels.size(), Color);
 	}
 
 
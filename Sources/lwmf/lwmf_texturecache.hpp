@@ -0,0 +1,212 @@
+/*
+***************************************************************
+*                                                             *
+* lwmf_texturecache - lightweight media framework             *
+*                                                             *
+* (C) 2019 - present by Stefan Kubsch                         *
+*                                                             *
+***************************************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <memory>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <utility>
+
+#include "lwmf_texture.hpp"
+
+namespace lwmf
+{
+
+
+	// Shared, immutable texture - the texture stays alive as long as any handle (or the cache) holds it
+	using TextureHandle = std::shared_ptr<const TextureStruct>;
+
+	// Process-wide registry of decoded textures, keyed by name and content hash
+	//
+	// A lookup only hits if the content hash still matches, so changed files are decoded again
+	// Textures nobody holds a handle to anymore stay cached until Trim() needs their memory (least recently used first)
+	// Textures which are still in use are never evicted, so the budget can be exceeded temporarily
+	// Find() and Insert() may be called from several threads
+
+	class TextureCache final
+	{
+	public:
+		TextureHandle Find(const std::string& Name, std::uint64_t ContentHash);
+		TextureHandle Insert(const std::string& Name, std::uint64_t ContentHash, TextureStruct&& Texture);
+		void SetBudget(std::size_t Bytes);
+		void Trim();
+		void Clear();
+		std::size_t GetCachedBytes();
+		std::string GetStatistics();
+
+	private:
+		struct EntryStruct final
+		{
+			TextureHandle Texture{};
+			std::uint64_t ContentHash{};
+			std::size_t Bytes{};
+			std::list<std::string>::iterator LRUPosition{};
+		};
+
+		void Remove(std::unordered_map<std::string, EntryStruct>::iterator Entry);
+
+		std::unordered_map<std::string, EntryStruct> Entries{};
+		std::list<std::string> LRUList{}; // Most recently used first
+		std::mutex CacheMutex{};
+		std::size_t Budget{ 256 << 20 };
+		std::size_t CachedBytes{};
+		std::uint_fast64_t Hits{};
+		std::uint_fast64_t Misses{};
+		std::uint_fast64_t Evictions{};
+	};
+
+	std::uint64_t HashContent(const void* Data, std::size_t Size);
+
+	//
+	// Functions
+	//
+
+	inline TextureHandle TextureCache::Find(const std::string& Name, const std::uint64_t ContentHash)
+	{
+		const std::unique_lock<std::mutex> lock(CacheMutex);
+
+		if (const auto Entry{ Entries.find(Name) }; Entry != Entries.end() && Entry->second.ContentHash == ContentHash)
+		{
+			LRUList.splice(LRUList.begin(), LRUList, Entry->second.LRUPosition);
+			++Hits;
+
+			return Entry->second.Texture;
+		}
+
+		++Misses;
+
+		return nullptr;
+	}
+
+	inline TextureHandle TextureCache::Insert(const std::string& Name, const std::uint64_t ContentHash, TextureStruct&& Texture)
+	{
+		TextureHandle Handle{ std::make_shared<const TextureStruct>(std::move(Texture)) };
+		const std::unique_lock<std::mutex> lock(CacheMutex);
+
+		// An outdated version is only dropped from the cache - handles to it stay valid
+		if (const auto Entry{ Entries.find(Name) }; Entry != Entries.end())
+		{
+			Remove(Entry);
+		}
+
+		LRUList.emplace_front(Name);
+
+		EntryStruct& NewEntry{ Entries[Name] };
+		NewEntry.Texture = Handle;
+		NewEntry.ContentHash = ContentHash;
+		NewEntry.Bytes = Handle->Pixels.size() * sizeof(PixelType);
+		NewEntry.LRUPosition = LRUList.begin();
+		CachedBytes += NewEntry.Bytes;
+
+		return Handle;
+	}
+
+	inline void TextureCache::SetBudget(const std::size_t Bytes)
+	{
+		{
+			const std::unique_lock<std::mutex> lock(CacheMutex);
+			Budget = Bytes;
+		}
+
+		Trim();
+	}
+
+	inline void TextureCache::Trim()
+	{
+		const std::unique_lock<std::mutex> lock(CacheMutex);
+
+		for (auto Position{ LRUList.end() }; CachedBytes > Budget && Position != LRUList.begin();)
+		{
+			--Position;
+
+			// use_count() == 1 means only the cache holds the texture
+			if (const auto Entry{ Entries.find(*Position) }; Entry->second.Texture.use_count() == 1)
+			{
+				Position = std::next(Position);
+				Remove(Entry);
+				++Evictions;
+			}
+		}
+	}
+
+	inline void TextureCache::Clear()
+	{
+		const std::unique_lock<std::mutex> lock(CacheMutex);
+
+		Entries.clear();
+		LRUList.clear();
+		CachedBytes = 0;
+	}
+
+	inline std::size_t TextureCache::GetCachedBytes()
+	{
+		const std::unique_lock<std::mutex> lock(CacheMutex);
+
+		return CachedBytes;
+	}
+
+	inline std::string TextureCache::GetStatistics()
+	{
+		const std::unique_lock<std::mutex> lock(CacheMutex);
+
+		return "Texture cache: " + std::to_string(Entries.size()) + " textures, " + std::to_string(CachedBytes >> 10) + " of " + std::to_string(Budget >> 10) + " KiB, "
+			+ std::to_string(Hits) + " hits, " + std::to_string(Misses) + " misses, " + std::to_string(Evictions) + " evictions";
+	}
+
+	inline void TextureCache::Remove(const std::unordered_map<std::string, EntryStruct>::iterator Entry)
+	{
+		CachedBytes -= Entry->second.Bytes;
+		LRUList.erase(Entry->second.LRUPosition);
+		Entries.erase(Entry);
+	}
+
+	inline std::uint64_t HashContent(const void* Data, const std::size_t Size)
+	{
+		// 64 bit multiply/xorshift hash over 8 byte words - fast enough to hash every asset on load, but not cryptographic
+		constexpr std::uint64_t Prime{ 0x9E3779B97F4A7C15ULL };
+
+		const auto Mix{ [](std::uint64_t Value)
+		{
+			Value ^= Value >> 30;
+			Value *= 0xBF58476D1CE4E5B9ULL;
+			Value ^= Value >> 27;
+			Value *= 0x94D049BB133111EBULL;
+			return Value ^ (Value >> 31);
+		} };
+
+		const auto* Bytes{ static_cast<const unsigned char*>(Data) };
+		std::uint64_t Hash{ static_cast<std::uint64_t>(Size) * Prime };
+		std::size_t Pos{};
+
+		for (; Pos + sizeof(std::uint64_t) <= Size; Pos += sizeof(std::uint64_t))
+		{
+			std::uint64_t Word{};
+			std::memcpy(&Word, Bytes + Pos, sizeof(Word));
+			Hash = (Hash ^ Mix(Word)) * Prime;
+		}
+
+		if (Pos < Size)
+		{
+			std::uint64_t Word{};
+			std::memcpy(&Word, Bytes + Pos, Size - Pos);
+			Hash = (Hash ^ Mix(Word)) * Prime;
+		}
+
+		return Mix(Hash);
+	}
+
+
+} // namespace lwmf
\ No newline at end of file
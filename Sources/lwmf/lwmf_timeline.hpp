@@ -0,0 +1,277 @@
+/*
+***************************************************************
+*                                                             *
+* lwmf_timeline - lightweight media framework                 *
+*                                                             *
+* (C) 2019 - present by Stefan Kubsch                         *
+*                                                             *
+***************************************************************
+*/
+
+#pragma once
+
+// Example for usage:
+//
+// Create
+// lwmf::Timeline LoadTimeline;
+//
+// Wrap steps in phases - phases which are started while another one is running become its children
+// LoadTimeline.Measure("LoadLevel", []
+// {
+//		LoadTimeline.Measure("ReadMap", [] { ... });
+//		LoadTimeline.Measure("DecodeTextures", [] { ... });
+// });
+//
+// Write report
+// LoadTimeline.WriteReport("Timeline.json", lwmf::TimelineFormat::JSON);
+//
+// Every phase records wall time, CPU time, bytes read, decoded PNGs and growth of the peak working set
+// CPU time, bytes read and working set are counted for the whole process (including all worker threads)
+// Phases have to be started and ended on the same thread
+
+#define NOMINMAX
+#include <Windows.h>
+#include <psapi.h>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <fstream>
+
+#include "lwmf_logging.hpp"
+#include "lwmf_png.hpp"
+
+namespace lwmf
+{
+
+
+	enum class TimelineFormat : std::int_fast32_t
+	{
+		Text,
+		JSON
+	};
+
+	class Timeline final
+	{
+	public:
+		void BeginPhase(const std::string& Name);
+		void EndPhase();
+		template<typename Function>void Measure(const std::string& Name, Function&& Step);
+		std::string GetReport(TimelineFormat Format) const;
+		void WriteReport(const std::string& FileName, TimelineFormat Format) const;
+		void Clear();
+
+	private:
+		struct CountersStruct final
+		{
+			std::chrono::steady_clock::time_point Time{};
+			std::uint64_t CPUTime{};
+			std::uint64_t BytesRead{};
+			std::uint64_t DecodedImages{};
+			std::uint64_t PeakWorkingSet{};
+		};
+
+		struct PhaseStruct final
+		{
+			std::string Name;
+			CountersStruct Start{};
+			CountersStruct End{};
+			std::int_fast32_t Depth{};
+		};
+
+		static CountersStruct GetCounters();
+		static std::string EscapeJSON(std::string_view Text);
+		std::string GetTextReport() const;
+		void AppendJSONPhases(std::string& Report, std::size_t& Index, std::int_fast32_t Depth) const;
+
+		std::vector<PhaseStruct> Phases{};
+		std::vector<std::size_t> OpenPhases{};
+	};
+
+	inline void Timeline::BeginPhase(const std::string& Name)
+	{
+		Phases.emplace_back();
+		Phases.back().Name = Name;
+		Phases.back().Depth = static_cast<std::int_fast32_t>(OpenPhases.size());
+		OpenPhases.emplace_back(Phases.size() - 1);
+
+		// Read the counters last, so the bookkeeping above is not part of the phase
+		Phases.back().Start = GetCounters();
+	}
+
+	inline void Timeline::EndPhase()
+	{
+		const CountersStruct Counters{ GetCounters() };
+
+		if (OpenPhases.empty())
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Warn, __FILENAME__, __LINE__, "lwmf::Timeline::EndPhase(): No phase was started!");
+			return;
+		}
+
+		Phases[OpenPhases.back()].End = Counters;
+		OpenPhases.pop_back();
+	}
+
+	template<typename Function>inline void Timeline::Measure(const std::string& Name, Function&& Step)
+	{
+		BeginPhase(Name);
+
+		try
+		{
+			Step();
+		}
+		catch (...)
+		{
+			EndPhase();
+			throw;
+		}
+
+		EndPhase();
+	}
+
+	inline std::string Timeline::GetReport(const TimelineFormat Format) const
+	{
+		if (!OpenPhases.empty())
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Warn, __FILENAME__, __LINE__, "lwmf::Timeline::GetReport(): " + std::to_string(OpenPhases.size()) + " phase(s) not ended yet!");
+		}
+
+		if (Format == TimelineFormat::Text)
+		{
+			return GetTextReport();
+		}
+
+		std::string Report{ "{\n\t\"phases\": [" };
+		std::size_t Index{};
+
+		AppendJSONPhases(Report, Index, 0);
+		Report += "\n\t]\n}\n";
+
+		return Report;
+	}
+
+	inline void Timeline::WriteReport(const std::string& FileName, const TimelineFormat Format) const
+	{
+		std::ofstream ReportFile(FileName, std::ios::out | std::ios::trunc);
+
+		if (ReportFile.fail())
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Warn, __FILENAME__, __LINE__, "lwmf::Timeline::WriteReport(): Cannot write " + FileName + "!");
+			return;
+		}
+
+		ReportFile << GetReport(Format);
+	}
+
+	inline void Timeline::Clear()
+	{
+		Phases.clear();
+		OpenPhases.clear();
+	}
+
+	inline Timeline::CountersStruct Timeline::GetCounters()
+	{
+		CountersStruct Counters{};
+		const HANDLE Process{ GetCurrentProcess() };
+
+		// FILETIME is given in 100 ns units
+		if (FILETIME CreationTime{}, ExitTime{}, KernelTime{}, UserTime{}; GetProcessTimes(Process, &CreationTime, &ExitTime, &KernelTime, &UserTime) != 0)
+		{
+			Counters.CPUTime = ((static_cast<std::uint64_t>(KernelTime.dwHighDateTime) << 32) | KernelTime.dwLowDateTime) + ((static_cast<std::uint64_t>(UserTime.dwHighDateTime) << 32) | UserTime.dwLowDateTime);
+		}
+
+		if (IO_COUNTERS IOCounters{}; GetProcessIoCounters(Process, &IOCounters) != 0)
+		{
+			Counters.BytesRead = IOCounters.ReadTransferCount;
+		}
+
+		if (PROCESS_MEMORY_COUNTERS MemoryCounters{}; GetProcessMemoryInfo(Process, &MemoryCounters, sizeof(MemoryCounters)) != 0)
+		{
+			Counters.PeakWorkingSet = MemoryCounters.PeakWorkingSetSize;
+		}
+
+		Counters.DecodedImages = NumberOfDecodedPNGs.load(std::memory_order_relaxed);
+		Counters.Time = std::chrono::steady_clock::now();
+
+		return Counters;
+	}
+
+	inline std::string Timeline::EscapeJSON(const std::string_view Text)
+	{
+		std::string Result;
+		Result.reserve(Text.size());
+
+		for (const char Char : Text)
+		{
+			if (Char == '"' || Char == '\\')
+			{
+				Result += '\\';
+			}
+
+			Result += static_cast<unsigned char>(Char) < 32 ? ' ' : Char;
+		}
+
+		return Result;
+	}
+
+	inline std::string Timeline::GetTextReport() const
+	{
+		std::string Report{ "Timeline report (times in ms, read and peak working set delta in KiB):\n" };
+		std::array<char, 256> Line{};
+
+		std::snprintf(Line.data(), Line.size(), "%-56s%12s%12s%12s%8s%12s\n", "Phase", "Wall", "CPU", "Read", "PNGs", "Peak WS");
+		Report += Line.data();
+
+		for (const auto& Phase : Phases)
+		{
+			const std::string Name{ std::string(static_cast<std::size_t>(Phase.Depth) * 3, ' ') + Phase.Name };
+
+			std::snprintf(Line.data(), Line.size(), "%-56s%12.1f%12.1f%12llu%8llu%12llu\n", Name.c_str(),
+				std::chrono::duration<double, std::milli>(Phase.End.Time - Phase.Start.Time).count(),
+				static_cast<double>(Phase.End.CPUTime - Phase.Start.CPUTime) / 10000.0,
+				static_cast<unsigned long long>((Phase.End.BytesRead - Phase.Start.BytesRead) >> 10),
+				static_cast<unsigned long long>(Phase.End.DecodedImages - Phase.Start.DecodedImages),
+				static_cast<unsigned long long>((Phase.End.PeakWorkingSet - Phase.Start.PeakWorkingSet) >> 10));
+			Report += Line.data();
+		}
+
+		return Report;
+	}
+
+	// Phases are stored in the order they were started, so the children of a phase are the following phases one level deeper
+	inline void Timeline::AppendJSONPhases(std::string& Report, std::size_t& Index, const std::int_fast32_t Depth) const
+	{
+		const std::string Indent(static_cast<std::size_t>(Depth) + 2, '\t');
+		bool FirstFlag{ true };
+
+		while (Index < Phases.size() && Phases[Index].Depth == Depth)
+		{
+			const PhaseStruct& Phase{ Phases[Index++] };
+
+			Report += FirstFlag ? "\n" : ",\n";
+			FirstFlag = false;
+
+			Report += Indent + "{ \"name\": \"" + EscapeJSON(Phase.Name) + "\""
+				+ ", \"wall_ms\": " + std::to_string(std::chrono::duration<double, std::milli>(Phase.End.Time - Phase.Start.Time).count())
+				+ ", \"cpu_ms\": " + std::to_string(static_cast<double>(Phase.End.CPUTime - Phase.Start.CPUTime) / 10000.0)
+				+ ", \"bytes_read\": " + std::to_string(Phase.End.BytesRead - Phase.Start.BytesRead)
+				+ ", \"decoded_pngs\": " + std::to_string(Phase.End.DecodedImages - Phase.Start.DecodedImages)
+				+ ", \"peak_working_set_delta\": " + std::to_string(Phase.End.PeakWorkingSet - Phase.Start.PeakWorkingSet);
+
+			if (Index < Phases.size() && Phases[Index].Depth > Depth)
+			{
+				Report += ", \"phases\": [";
+				AppendJSONPhases(Report, Index, Depth + 1);
+				Report += "\n" + Indent + "]";
+			}
+
+			Report += " }";
+		}
+	}
+
+
+} // namespace lwmf
\ No newline at end of file
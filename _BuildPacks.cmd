@@ -0,0 +1,2 @@
+x64\Release\NARCPacker.exe %*
+pause
\ No newline at end of file
@@ -0,0 +1,2 @@
+x64\Release\NARCPacker.exe --maps %*
+pause
\ No newline at end of file